@@ -1,68 +1,68 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#if !defined(AFX_DG_H__FGRTY_5GR39H_98TQ_H)
-#define AFX_DG_H__FGRTY_5GR39H_98TQ_H
-
-#include "dgTypes.h"
-
-#include "dgRef.h"
-#include "dgCRC.h"
-#include "dgObb.h"
-#include "dgRtti.h"
-#include "dgList.h"
-#include "dgTree.h"
-#include "dgNode.h"
-#include "dgHeap.h"
-#include "dgArray.h"
-#include "dgStack.h"
-#include "dgDebug.h"
-#include "dgGraph.h"
-#include "dgPlane.h"
-#include "dgGoogol.h"
-#include "dgVector.h"
-#include "dgMatrix.h"
-#include "dgMemory.h"
-#include "dgRandom.h"
-#include "dgThread.h"
-#include "dgFastQueue.h"
-#include "dgSPDMatrix.h"
-#include "dgPolyhedra.h"
-#include "dgThreadHive.h"
-#include "dgPathFinder.h"
-#include "dgRefCounter.h"
-#include "dgQuaternion.h"
-#include "dgAsyncThread.h"
-#include "dgMutexThread.h"
-#include "dgConvexHull3d.h"
-#include "dgConvexHull4d.h"
-#include "dgIntersections.h"
-#include "dgGeneralVector.h"
-#include "dgGeneralMatrix.h"
-#include "dgThreadProfiler.h"
-#include "dgAABBPolygonSoup.h"
-#include "dgSmallDeterminant.h"
-#include "dgPolygonSoupBuilder.h"
-#include "dgPolygonSoupDatabase.h"
-#include "dgPolyhedraMassProperties.h"
-#include "dgDelaunayTetrahedralization.h"
-
-#endif
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(AFX_DG_H__FGRTY_5GR39H_98TQ_H)
+#define AFX_DG_H__FGRTY_5GR39H_98TQ_H
+
+#include "dgTypes.h"
+
+#include "dgRef.h"
+#include "dgCRC.h"
+#include "dgObb.h"
+#include "dgRtti.h"
+#include "dgList.h"
+#include "dgTree.h"
+#include "dgNode.h"
+#include "dgHeap.h"
+#include "dgArray.h"
+#include "dgStack.h"
+#include "dgDebug.h"
+#include "dgGraph.h"
+#include "dgPlane.h"
+#include "dgGoogol.h"
+#include "dgVector.h"
+#include "dgMatrix.h"
+#include "dgMemory.h"
+#include "dgRandom.h"
+#include "dgThread.h"
+#include "dgFastQueue.h"
+#include "dgSPDMatrix.h"
+#include "dgPolyhedra.h"
+#include "dgThreadHive.h"
+#include "dgPathFinder.h"
+#include "dgRefCounter.h"
+#include "dgQuaternion.h"
+#include "dgAsyncThread.h"
+#include "dgMutexThread.h"
+#include "dgConvexHull3d.h"
+#include "dgConvexHull4d.h"
+#include "dgIntersections.h"
+#include "dgGeneralVector.h"
+#include "dgGeneralMatrix.h"
+#include "dgThreadProfiler.h"
+#include "dgAABBPolygonSoup.h"
+#include "dgSmallDeterminant.h"
+#include "dgPolygonSoupBuilder.h"
+#include "dgPolygonSoupDatabase.h"
+#include "dgPolyhedraMassProperties.h"
+#include "dgDelaunayTetrahedralization.h"
+
+#endif
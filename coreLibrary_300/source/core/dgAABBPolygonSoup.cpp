@@ -1,1280 +1,1954 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgStdafx.h"
-#include "dgHeap.h"
-#include "dgStack.h"
-#include "dgList.h"
-#include "dgMatrix.h"
-#include "dgAABBPolygonSoup.h"
-#include "dgPolygonSoupBuilder.h"
-
-
-#define DG_STACK_DEPTH 512
-
-
-DG_MSC_VECTOR_ALIGMENT
-class dgAABBPolygonSoup::dgNodeBuilder: public dgAABBPolygonSoup::dgNode
-{
-	public:
-	dgNodeBuilder (const dgVector& p0, const dgVector& p1)
-		:dgNode()
-		,m_left (NULL)
-		,m_right (NULL)
-		,m_parent (NULL)
-		,m_indexBox0(0)
-		,m_indexBox1(0)
-		,m_enumeration(-1)
-		,m_faceIndex(0)
-		,m_indexCount(0)
-		,m_faceIndices(NULL)
-	{
-		SetBox (p0, p1);
-	}
-
-	dgNodeBuilder (const dgVector* const vertexArray, dgInt32 faceIndex, dgInt32 indexCount, const dgInt32* const indexArray)
-		:dgNode()
-		,m_left (NULL)
-		,m_right (NULL)
-		,m_parent (NULL)
-		,m_indexBox0(0)
-		,m_indexBox1(0)
-		,m_enumeration(-1)
-		,m_faceIndex(faceIndex)
-		,m_indexCount(indexCount)
-		,m_faceIndices(indexArray)
-	{
-		dgVector minP ( dgFloat32 (1.0e15f)); 
-		dgVector maxP (-dgFloat32 (1.0e15f)); 
-		for (dgInt32 i = 0; i < indexCount; i ++) {
-			dgInt32 index = indexArray[i];
-			const dgVector& p (vertexArray[index]);
-			minP = p.GetMin(minP); 
-			maxP = p.GetMax(maxP); 
-		}
-		minP -= dgVector (dgFloat32 (1.0e-3f));
-		maxP += dgVector (dgFloat32 (1.0e-3f));
-		minP = minP & dgVector::m_triplexMask;
-		maxP = maxP & dgVector::m_triplexMask;
-		SetBox (minP, maxP);
-	}
-
-	dgNodeBuilder (dgNodeBuilder* const left, dgNodeBuilder* const right)
-		:dgNode()
-		,m_left(left)
-		,m_right(right)
-		,m_parent(NULL)
-		,m_indexBox0(0)
-		,m_indexBox1(0)
-		,m_enumeration(-1)
-		,m_faceIndex(0)
-		,m_indexCount(0)
-		,m_faceIndices(NULL)
-	{
-		m_left->m_parent = this;
-		m_right->m_parent = this;
-
-		dgVector p0 (left->m_p0.GetMin(right->m_p0));
-		dgVector p1 (left->m_p1.GetMax(right->m_p1));
-		SetBox(p0, p1);
-	}
-
-	void SetBox (const dgVector& p0, const dgVector& p1)
-	{
-		m_p0 = p0;
-		m_p1 = p1;
-		m_size = m_p1 - m_p0;
-		m_origin = (m_p1 + m_p0).Scale4 (dgFloat32 (0.5f));
-		m_area = m_size.DotProduct4(m_size.ShiftTripleRight()).m_x;
-	}
-
-	static dgFloat32 CalculateSurfaceArea (dgNodeBuilder* const node0, dgNodeBuilder* const node1, dgVector& minBox, dgVector& maxBox)
-	{
-		minBox = node0->m_p0.GetMin(node1->m_p0);
-		maxBox = node0->m_p1.GetMax(node1->m_p1);
-
-		dgVector side0 ((maxBox - minBox).Scale4 (dgFloat32 (0.5f)));
-		dgVector side1 (side0.m_y, side0.m_z, side0.m_x, dgFloat32 (0.0f));
-		return side0.DotProduct4(side1).m_x;
-	}
-
-
-	dgVector m_p0;
-	dgVector m_p1;
-	dgVector m_size;
-	dgVector m_origin;
-	dgFloat32 m_area;
-	
-	dgNodeBuilder* m_left;
-	dgNodeBuilder* m_right;
-	dgNodeBuilder* m_parent;
-	dgInt32 m_indexBox0;
-	dgInt32 m_indexBox1;
-	dgInt32 m_enumeration;
-	dgInt32 m_faceIndex;
-	dgInt32 m_indexCount;
-	const dgInt32* m_faceIndices;
-} DG_GCC_VECTOR_ALIGMENT;
-
-
-
-class dgAABBPolygonSoup::dgSpliteInfo
-{
-	public:
-	dgSpliteInfo (dgNodeBuilder* const boxArray, dgInt32 boxCount)
-	{
-		dgVector minP ( dgFloat32 (1.0e15f)); 
-		dgVector maxP (-dgFloat32 (1.0e15f)); 
-
-		if (boxCount == 2) {
-			m_axis = 1;
-			for (dgInt32 i = 0; i < boxCount; i ++) {
-				const dgNodeBuilder& box = boxArray[i];
-				const dgVector& p0 = box.m_p0;
-				const dgVector& p1 = box.m_p1;
-				minP = minP.GetMin (p0); 
-				maxP = maxP.GetMax (p1); 
-			}
-
-		} else {
-			dgVector median (dgFloat32 (0.0f));
-			dgVector varian (dgFloat32 (0.0f));
-			for (dgInt32 i = 0; i < boxCount; i ++) {
-				const dgNodeBuilder& box = boxArray[i];
-
-				const dgVector& p0 = box.m_p0;
-				const dgVector& p1 = box.m_p1;
-
-				minP = minP.GetMin (p0); 
-				maxP = maxP.GetMax (p1); 
-				dgVector p ((p0 + p1).CompProduct4(dgVector::m_half));
-
-				median += p;
-				varian += p.CompProduct4(p);
-			}
-
-			varian = varian.Scale4 (dgFloat32 (boxCount)) - median.CompProduct4(median);
-
-			dgInt32 index = 0;
-			dgFloat32 maxVarian = dgFloat32 (-1.0e10f);
-			for (dgInt32 i = 0; i < 3; i ++) {
-				if (varian[i] > maxVarian) {
-					index = i;
-					maxVarian = varian[i];
-				}
-			}
-
-			dgVector center = median.Scale4 (dgFloat32 (1.0f) / dgFloat32 (boxCount));
-			dgFloat32 test = center[index];
-			dgInt32 i0 = 0;
-			dgInt32 i1 = boxCount - 1;
-			do {    
-				for (; i0 <= i1; i0 ++) {
-					const dgNodeBuilder& box = boxArray[i0];
-					dgFloat32 val = (box.m_p0[index] + box.m_p1[index]) * dgFloat32 (0.5f);
-					if (val > test) {
-						break;
-					}
-				}
-
-				for (; i1 >= i0; i1 --) {
-					const dgNodeBuilder& box = boxArray[i1];
-					dgFloat32 val = (box.m_p0[index] + box.m_p1[index]) * dgFloat32 (0.5f);
-					if (val < test) {
-						break;
-					}
-				}
-
-				if (i0 < i1)	{
-					dgSwap(boxArray[i0], boxArray[i1]);
-					i0++; 
-					i1--;
-				}
-			} while (i0 <= i1);
-
-			if (i0 > 0){
-				i0 --;
-			}
-			if ((i0 + 1) >= boxCount) {
-				i0 = boxCount - 2;
-			}
-
-			m_axis = i0 + 1;
-		}
-
-		dgAssert (maxP.m_x - minP.m_x >= dgFloat32 (0.0f));
-		dgAssert (maxP.m_y - minP.m_y >= dgFloat32 (0.0f));
-		dgAssert (maxP.m_z - minP.m_z >= dgFloat32 (0.0f));
-		m_p0 = minP;
-		m_p1 = maxP;
-	}
-
-	dgInt32 m_axis;
-	dgVector m_p0;
-	dgVector m_p1;
-};
-
-
-
-dgAABBPolygonSoup::dgAABBPolygonSoup ()
-	:dgPolygonSoupDatabase()
-	,m_nodesCount(0)
-	,m_indexCount(0)
-	,m_aabb(NULL)
-	,m_indices(NULL)
-{
-}
-
-dgAABBPolygonSoup::~dgAABBPolygonSoup ()
-{
-	if (m_aabb) {
-		dgFreeStack (m_aabb);
-		dgFreeStack (m_indices);
-	}
-}
-
-
-void dgAABBPolygonSoup::ImproveNodeFitness (dgNodeBuilder* const node) const
-{
-	dgAssert (node->m_left);
-	dgAssert (node->m_right);
-
-	if (node->m_parent)	{
-		if (node->m_parent->m_left == node) {
-			dgFloat32 cost0 = node->m_area;
-
-			dgVector cost1P0;
-			dgVector cost1P1;		
-			dgFloat32 cost1 = dgNodeBuilder::CalculateSurfaceArea (node->m_right, node->m_parent->m_right, cost1P0, cost1P1);
-
-			dgVector cost2P0;
-			dgVector cost2P1;		
-			dgFloat32 cost2 = dgNodeBuilder::CalculateSurfaceArea (node->m_left, node->m_parent->m_right, cost2P0, cost2P1);
-
-			if ((cost1 <= cost0) && (cost1 <= cost2)) {
-				dgNodeBuilder* const parent = node->m_parent;
-				node->m_p0 = parent->m_p0;
-				node->m_p1 = parent->m_p1;
-				node->m_area = parent->m_area; 
-				node->m_size = parent->m_size;
-				node->m_origin = parent->m_origin;
-
-				if (parent->m_parent) {
-					if (parent->m_parent->m_left == parent) {
-						parent->m_parent->m_left = node;
-					} else {
-						dgAssert (parent->m_parent->m_right == parent);
-						parent->m_parent->m_right = node;
-					}
-				}
-				node->m_parent = parent->m_parent;
-				parent->m_parent = node;
-				node->m_right->m_parent = parent;
-				parent->m_left = node->m_right;
-				node->m_right = parent;
-				parent->m_p0 = cost1P0;
-				parent->m_p1 = cost1P1;		
-				parent->m_area = cost1;
-				parent->m_size = (parent->m_p1 - parent->m_p0).Scale3(dgFloat32 (0.5f));
-				parent->m_origin = (parent->m_p1 + parent->m_p0).Scale3(dgFloat32 (0.5f));
-
-			} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
-				dgNodeBuilder* const parent = node->m_parent;
-				node->m_p0 = parent->m_p0;
-				node->m_p1 = parent->m_p1;
-				node->m_area = parent->m_area; 
-				node->m_size = parent->m_size;
-				node->m_origin = parent->m_origin;
-
-				if (parent->m_parent) {
-					if (parent->m_parent->m_left == parent) {
-						parent->m_parent->m_left = node;
-					} else {
-						dgAssert (parent->m_parent->m_right == parent);
-						parent->m_parent->m_right = node;
-					}
-				}
-				node->m_parent = parent->m_parent;
-				parent->m_parent = node;
-				node->m_left->m_parent = parent;
-				parent->m_left = node->m_left;
-				node->m_left = parent;
-
-				parent->m_p0 = cost2P0;
-				parent->m_p1 = cost2P1;		
-				parent->m_area = cost2;
-				parent->m_size = (parent->m_p1 - parent->m_p0).Scale3(dgFloat32 (0.5f));
-				parent->m_origin = (parent->m_p1 + parent->m_p0).Scale3(dgFloat32 (0.5f));
-			}
-		} else {
-			dgFloat32 cost0 = node->m_area;
-
-			dgVector cost1P0;
-			dgVector cost1P1;		
-			dgFloat32 cost1 = dgNodeBuilder::CalculateSurfaceArea (node->m_left, node->m_parent->m_left, cost1P0, cost1P1);
-
-			dgVector cost2P0;
-			dgVector cost2P1;		
-			dgFloat32 cost2 = dgNodeBuilder::CalculateSurfaceArea (node->m_right, node->m_parent->m_left, cost2P0, cost2P1);
-
-			if ((cost1 <= cost0) && (cost1 <= cost2)) {
-				dgNodeBuilder* const parent = node->m_parent;
-				node->m_p0 = parent->m_p0;
-				node->m_p1 = parent->m_p1;
-				node->m_area = parent->m_area; 
-				node->m_size = parent->m_size;
-				node->m_origin = parent->m_origin;
-
-				if (parent->m_parent) {
-					if (parent->m_parent->m_left == parent) {
-						parent->m_parent->m_left = node;
-					} else {
-						dgAssert (parent->m_parent->m_right == parent);
-						parent->m_parent->m_right = node;
-					}
-				}
-				node->m_parent = parent->m_parent;
-				parent->m_parent = node;
-				node->m_left->m_parent = parent;
-				parent->m_right = node->m_left;
-				node->m_left = parent;
-
-				parent->m_p0 = cost1P0;
-				parent->m_p1 = cost1P1;		
-				parent->m_area = cost1;
-				parent->m_size = (parent->m_p1 - parent->m_p0).Scale3(dgFloat32 (0.5f));
-				parent->m_origin = (parent->m_p1 + parent->m_p0).Scale3(dgFloat32 (0.5f));
-
-			} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
-				dgNodeBuilder* const parent = node->m_parent;
-				node->m_p0 = parent->m_p0;
-				node->m_p1 = parent->m_p1;
-				node->m_area = parent->m_area; 
-				node->m_size = parent->m_size;
-				node->m_origin = parent->m_origin;
-
-				if (parent->m_parent) {
-					if (parent->m_parent->m_left == parent) {
-						parent->m_parent->m_left = node;
-					} else {
-						dgAssert (parent->m_parent->m_right == parent);
-						parent->m_parent->m_right = node;
-					}
-				}
-				node->m_parent = parent->m_parent;
-				parent->m_parent = node;
-				node->m_right->m_parent = parent;
-				parent->m_right = node->m_right;
-				node->m_right = parent;
-
-				parent->m_p0 = cost2P0;
-				parent->m_p1 = cost2P1;		
-				parent->m_area = cost2;
-				parent->m_size = (parent->m_p1 - parent->m_p0).Scale3(dgFloat32 (0.5f));
-				parent->m_origin = (parent->m_p1 + parent->m_p0).Scale3(dgFloat32 (0.5f));
-			}
-		}
-	} else {
-		// in the future I can handle this but it is too much work for little payoff
-	}
-}
-
-
-dgFloat32 dgAABBPolygonSoup::CalculateFaceMaxSize (const dgVector* const vertex, dgInt32 indexCount, const dgInt32* const indexArray) const
-{
-	dgFloat32 maxSize = dgFloat32 (0.0f);
-	dgInt32 index = indexArray[indexCount - 1];
-	dgVector p0 (vertex[index]);
-	for (dgInt32 i = 0; i < indexCount; i ++) {
-		dgInt32 index = indexArray[i];
-		dgVector p1 (vertex[index]);
-
-		dgVector dir (p1 - p0);
-		dir = dir.Scale3 (dgRsqrt (dir % dir));
-
-		dgFloat32 maxVal = dgFloat32 (-1.0e10f);
-		dgFloat32 minVal = dgFloat32 ( 1.0e10f);
-		for (dgInt32 j = 0; j < indexCount; j ++) {
-			dgInt32 index = indexArray[j];
-			dgVector q (vertex[index]);
-			dgFloat32 val = dir % q;
-			minVal = dgMin(minVal, val);
-			maxVal = dgMax(maxVal, val);
-		}
-
-		dgFloat32 size = maxVal - minVal;
-		maxSize = dgMax(maxSize, size);
-		p0 = p1;
-	}
-
-	return dgFloor (maxSize + dgFloat32 (1.0f));
-}
-
-
-
-
-void dgAABBPolygonSoup::GetAABB (dgVector& p0, dgVector& p1) const
-{
-	if (m_aabb) { 
-		GetNodeAABB (m_aabb, p0, p1);
-	} else {
-		p0 = dgVector (dgFloat32 (0.0f));
-		p1 = dgVector (dgFloat32 (0.0f));
-	}
-}
-
-
-
-void dgAABBPolygonSoup::CalculateAdjacendy ()
-{
-	dgVector p0;
-	dgVector p1;
-	GetAABB (p0, p1);
-	dgFastAABBInfo box (p0, p1);
-	ForAllSectors (box, dgVector (dgFloat32 (0.0f)), dgFloat32 (1.0f), CalculateAllFaceEdgeNormals, this);
-
-	for (dgInt32 i = 0; i < m_nodesCount; i ++) {
-		const dgNode* const node = &m_aabb[i];
-		if (node->m_left.IsLeaf()) {
-			dgInt32 vCount = node->m_left.GetCount();
-			dgInt32 index = dgInt32 (node->m_left.GetIndex());
-			dgInt32* const face = &m_indices[index];
-			for (dgInt32 j = 0; j < vCount; j ++) {
-				if (face[vCount + 2 + j] == -1) {
-					face[vCount + 2 + j] = face[vCount + 1];
-				}
-			}
-		}
-
-		if (node->m_right.IsLeaf()) {
-			dgInt32 vCount = node->m_right.GetCount();
-			dgInt32 index = dgInt32 (node->m_right.GetIndex());
-			dgInt32* const face = &m_indices[index];
-			for (dgInt32 j = 0; j < vCount; j ++) {
-				if (face[vCount + 2 + j] == -1) {
-					face[vCount + 2 + j] = face[vCount + 1];
-				}
-			}
-		}
-	}
-}
-
-
-dgIntersectStatus dgAABBPolygonSoup::CalculateAllFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance)
-{
-	dgInt32 stride = dgInt32 (strideInBytes / sizeof (dgFloat32));
-
-	AdjacentdFaces adjacentFaces;
-	adjacentFaces.m_count = indexCount;
-	adjacentFaces.m_index = (dgInt32*) indexArray;
-
-	dgVector n (&polygon[indexArray[indexCount + 1] * stride]);
-	dgVector p (&polygon[indexArray[0] * stride]);
-	adjacentFaces.m_normal = dgPlane (n, - (n % p));
-
-	dgAssert (indexCount < dgInt32 (sizeof (adjacentFaces.m_edgeMap) / sizeof (adjacentFaces.m_edgeMap[0])));
-
-	dgInt32 edgeIndex = indexCount - 1;
-	dgInt32 i0 = indexArray[indexCount - 1];
-	dgVector p0 ( dgFloat32 (1.0e15f),  dgFloat32 (1.0e15f),  dgFloat32 (1.0e15f), dgFloat32 (0.0f)); 
-	dgVector p1 (-dgFloat32 (1.0e15f), -dgFloat32 (1.0e15f), -dgFloat32 (1.0e15f), dgFloat32 (0.0f)); 
-	for (dgInt32 i = 0; i < indexCount; i ++) {
-		dgInt32 i1 = indexArray[i];
-		dgInt32 index = i1 * stride;
-		dgVector p (&polygon[index]);
-//		p0.m_x = dgMin (p.m_x, p0.m_x); 
-//		p0.m_y = dgMin (p.m_y, p0.m_y); 
-//		p0.m_z = dgMin (p.m_z, p0.m_z); 
-//		p1.m_x = dgMax (p.m_x, p1.m_x); 
-//		p1.m_y = dgMax (p.m_y, p1.m_y); 
-//		p1.m_z = dgMax (p.m_z, p1.m_z); 
-		p0 = p0.GetMin(p);
-		p1 = p1.GetMax(p);
-		adjacentFaces.m_edgeMap[edgeIndex] = (dgInt64 (i1) << 32) + i0;
-		edgeIndex = i;
-		i0 = i1;
-	}
-
-	dgFloat32 padding = dgFloat32 (1.0f/16.0f);
-	p0.m_x -= padding;
-	p0.m_y -= padding;
-	p0.m_z -= padding;
-	p1.m_x += padding;
-	p1.m_y += padding;
-	p1.m_z += padding;
-
-	dgAABBPolygonSoup* const me = (dgAABBPolygonSoup*) context;
-	dgFastAABBInfo box (p0, p1);
-	me->ForAllSectors (box, dgVector (dgFloat32 (0.0f)), dgFloat32 (1.0f), CalculateDisjointedFaceEdgeNormals, &adjacentFaces);
-	return t_ContinueSearh;
-}
-
-
-dgIntersectStatus dgAABBPolygonSoup::CalculateDisjointedFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance)
-{
-	#define DG_WELDING_TOL (1.0e-2f)
-	#define DG_WELDING_TOL2 (DG_WELDING_TOL * DG_WELDING_TOL)
-
-	AdjacentdFaces& adjacentFaces = *((AdjacentdFaces*)context);
-
-	if (adjacentFaces.m_index != indexArray) {	
-		dgInt32 adjacentCount = adjacentFaces.m_count;
-		dgInt32 stride = dgInt32 (strideInBytes / sizeof (dgFloat32));
-
-		dgInt32 j0 = adjacentCount - 1;
-		dgInt32 indexJ0 = adjacentFaces.m_index[adjacentCount - 1];
-		for (dgInt32 j = 0; j < adjacentCount; j ++) {
-			dgInt32 indexJ1 = adjacentFaces.m_index[j];
-			dgBigVector q0 (&polygon[indexJ1 * stride]);
-			dgBigVector q1 (&polygon[indexJ0 * stride]);
-			dgBigVector q1q0 (q1 - q0);
-			dgFloat64 q1q0Mag2 = q1q0 % q1q0;
-
-			dgInt32 indexI0 = indexArray[indexCount - 1];
-			for (dgInt32 i = 0; i < indexCount; i ++) {
-				dgInt32 indexI1 = indexArray[i];
-				dgBigVector p0 (&polygon[indexI0 * stride]);
-				dgBigVector p1 (&polygon[indexI1 * stride]);
-				dgBigVector p1p0 (p1 - p0);
-				dgFloat64 dot = p1p0 % q1q0;
-				if (dot > 0.0f) {
-					dgFloat64 q1p0Mag2 = p1p0 % p1p0;
-					if ((dot * dot) >= (q1p0Mag2 * q1q0Mag2 * dgFloat64(0.99995f))) {
-						dgFloat64 x0 = q0 % q1q0;
-						dgFloat64 x1 = q1 % q1q0;
-						dgFloat64 y0 = p0 % q1q0;
-						dgFloat64 y1 = p1 % q1q0;
-						dgAssert (x1 > x0);
-						dgAssert (y1 > y0);
-						if (!((y0 >= x1) || (y1 <= x0))) {
-							dgFloat64 t = ((p0 - q0) % q1q0) / q1q0Mag2;
-							dgBigVector q (q0 + q1q0.Scale3(t));
-							dgBigVector dist (p0 - q);
-							dgFloat64 err2 = dist % dist;
-							if (err2 < DG_WELDING_TOL2) {
-								dgFloat32 maxDist = dgFloat32 (0.0f);
-								for (dgInt32 k = 0; k < indexCount; k ++) {
-									dgVector r (&polygon[indexArray[k] * stride]);
-									dgFloat32 dist = adjacentFaces.m_normal.Evalue(r);
-									if (dgAbsf (dist) > dgAbsf (maxDist)) {
-										maxDist = dist;
-									}
-								}
-
-								if (adjacentFaces.m_index[j0 + adjacentCount + 2] == -1) {
-									if (maxDist < -dgFloat32 (1.0e-3f)) {
-										adjacentFaces.m_index[j0 + adjacentCount + 2] = indexArray[indexCount + 1];
-									} else {
-										adjacentFaces.m_index[j0 + adjacentCount + 2] = adjacentFaces.m_index[adjacentCount + 1];
-									}
-								} else {
-									if (maxDist < -dgFloat32 (1.0e-3f)) {
-										dgBigVector n0 (adjacentFaces.m_normal[0], adjacentFaces.m_normal[1], adjacentFaces.m_normal[2], dgFloat64(0.0f));
-										dgBigVector n1 (&polygon[adjacentFaces.m_index[j0 + adjacentCount + 2] * stride]);
-										dgBigVector n2 (&polygon[indexArray[indexCount + 1] * stride]);
-
-										dgBigVector tilt0 (n0 * n1); 
-										dgBigVector tilt1 (n0 * n2); 
-										dgFloat64 dist0 (q1q0 % tilt0);
-										dgFloat64 dist1 (q1q0 % tilt1);
-										if (dist0 < dist1) {
-											adjacentFaces.m_index[j0 + adjacentCount + 2] = indexArray[indexCount + 1];
-										}
-									} else {
-										adjacentFaces.m_index[j0 + adjacentCount + 2] = adjacentFaces.m_index[adjacentCount + 1];
-									}
-								}
-								break;
-							}
-						}
-					}
-				}
-				indexI0 = indexI1;
-			}
-			j0 = j;
-			indexJ0 = indexJ1;
-		}
-	}
-	return t_ContinueSearh;
-}
-
-
-
-dgAABBPolygonSoup::dgNodeBuilder* dgAABBPolygonSoup::BuildTopDown (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator) const
-{
-	dgAssert (firstBox >= 0);
-	dgAssert (lastBox >= 0);
-
-	if (lastBox == firstBox) {
-		return &leafArray[firstBox];
-	} else {
-		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1);
-
-		dgNodeBuilder* const parent = new (*allocator) dgNodeBuilder (info.m_p0, info.m_p1);
-		*allocator = *allocator + 1;
-
-		dgAssert (parent);
-		parent->m_right = BuildTopDown (leafArray, firstBox + info.m_axis, lastBox, allocator);
-		parent->m_right->m_parent = parent;
-
-		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + info.m_axis - 1, allocator);
-		parent->m_left->m_parent = parent;
-		return parent;
-	}
-}
-
-
-
-
-
-void dgAABBPolygonSoup::Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild)
-{
-	if (builder.m_faceCount == 0) {
-		return;
-	}
-	dgAssert (builder.m_faceCount >= 1);
-	m_strideInBytes = sizeof (dgTriplex);
-	m_nodesCount = ((builder.m_faceCount - 1) < 1) ? 1 : builder.m_faceCount - 1;
-	m_aabb = (dgNode*) dgMallocStack (sizeof (dgNode) * m_nodesCount);
-	m_indexCount = builder.m_indexCount * 2 + builder.m_faceCount;
-	if (builder.m_faceCount == 1) {
-		m_indexCount *= 2;
-	}
-	m_indices = (dgInt32*) dgMallocStack (sizeof (dgInt32) * m_indexCount);
-	dgStack<dgVector> tmpVertexArrayCont(builder.m_vertexCount + builder.m_normalCount + builder.m_faceCount * 2 + 4);
-
-	dgVector* const tmpVertexArray = &tmpVertexArrayCont[0];
-	for (dgInt32 i = 0; i < builder.m_vertexCount; i ++) {
-		tmpVertexArray[i] = builder.m_vertexPoints[i];
-	}
-
-	for (dgInt32 i = 0; i < builder.m_normalCount; i ++) {
-		tmpVertexArray[i + builder.m_vertexCount] = builder.m_normalPoints[i];
-	}
-
-	const dgInt32* const indices = &builder.m_vertexIndex[0];
-	dgStack<dgNodeBuilder> constructor (builder.m_faceCount * 2 + 16); 
-
-	dgInt32 polygonIndex = 0;
-	dgInt32 allocatorIndex = 0;
-	if (builder.m_faceCount == 1) {
-		dgInt32 indexCount = builder.m_faceVertexCount[0] - 1;
-		new (&constructor[allocatorIndex]) dgNodeBuilder (&tmpVertexArray[0], 0, indexCount, &indices[0]);
-		allocatorIndex ++;
-	}
-	for (dgInt32 i = 0; i < builder.m_faceCount; i ++) {
-		dgInt32 indexCount = builder.m_faceVertexCount[i] - 1;
-		new (&constructor[allocatorIndex]) dgNodeBuilder (&tmpVertexArray[0], i, indexCount, &indices[polygonIndex]);
-		allocatorIndex ++;
-		polygonIndex += (indexCount + 1);
-	}
-
-	dgNodeBuilder* contructorAllocator = &constructor[allocatorIndex];
-	dgNodeBuilder* root = BuildTopDown (&constructor[0], 0, allocatorIndex - 1, &contructorAllocator);
-
-	dgAssert (root);
-	if (root->m_left) {
-
-		dgAssert (root->m_right);
-		dgList<dgNodeBuilder*> list (builder.m_allocator);
-		dgList<dgNodeBuilder*> stack (builder.m_allocator);
-		stack.Append(root);
-		while (stack.GetCount()) {
-			dgList<dgNodeBuilder*>::dgListNode* const stackNode = stack.GetLast();
-			dgNodeBuilder* const node = stackNode->GetInfo();
-			stack.Remove(stackNode);
-
-			if (node->m_left) {
-				dgAssert (node->m_right);
-				list.Append(node);
-				stack.Append(node->m_right);
-				stack.Append(node->m_left);
-			} 
-		}
-
-		dgFloat64 newCost = dgFloat32 (1.0e20f);
-		dgFloat64 prevCost = newCost;
-		do {
-			prevCost = newCost;
-			for (dgList<dgNodeBuilder*>::dgListNode* listNode = list.GetFirst(); listNode; listNode = listNode->GetNext()) {
-				dgNodeBuilder* const node = listNode->GetInfo();
-				ImproveNodeFitness (node);
-			}
-
-			newCost = dgFloat32 (0.0f);
-			for (dgList<dgNodeBuilder*>::dgListNode* listNode = list.GetFirst(); listNode; listNode = listNode->GetNext()) {
-				dgNodeBuilder* const node = listNode->GetInfo();
-				newCost += node->m_area;
-			}
-		} while (newCost < (prevCost * dgFloat32 (0.9999f)));
-
-		root = list.GetLast()->GetInfo();
-		while (root->m_parent) {
-			root = root->m_parent;
-		}
-	}
-
-	dgList<dgNodeBuilder*> list (builder.m_allocator);
-
-	list.Append(root);
-	dgInt32 nodeIndex = 0;
-	while (list.GetCount())  {
-		dgNodeBuilder* const node = list.GetFirst()->GetInfo();
-		list.Remove(list.GetFirst());
-
-		if (node->m_left) {
-			node->m_enumeration = nodeIndex;
-			nodeIndex ++;
-			dgAssert (node->m_right);
-			list.Append(node->m_left);
-			list.Append(node->m_right);
-		}
-	}
-	dgAssert(!list.GetCount());
-
-	dgInt32 aabbBase = builder.m_vertexCount + builder.m_normalCount;
-
-
-	dgVector* const aabbPoints = &tmpVertexArray[aabbBase];
-
-
-	dgInt32 vertexIndex = 0;
-	dgInt32 aabbNodeIndex = 0;
-	list.Append(root);
-	dgInt32 indexMap = 0;
-	while (list.GetCount())  {
-
-		dgNodeBuilder* const node = list.GetFirst()->GetInfo();
-		list.Remove(list.GetFirst());
-
-		if (node->m_enumeration >= 0) {
-			dgAssert (node->m_left);
-			dgAssert (node->m_right);
-			dgNode& aabbNode = m_aabb[aabbNodeIndex];
-			aabbNodeIndex ++;
-			dgAssert (aabbNodeIndex <= m_nodesCount);
-
-			if (node->m_parent) {
-				if (node->m_parent->m_left == node) {
-					m_aabb[node->m_parent->m_enumeration].m_left = dgNode::dgLeafNodePtr (dgUnsigned32 (&m_aabb[node->m_enumeration] - m_aabb));
-				} else {
-					dgAssert (node->m_parent->m_right == node);
-					m_aabb[node->m_parent->m_enumeration].m_right = dgNode::dgLeafNodePtr (dgUnsigned32 (&m_aabb[node->m_enumeration] - m_aabb));
-				}
-			}
-
-			aabbPoints[vertexIndex + 0] = node->m_p0;
-			aabbPoints[vertexIndex + 1] = node->m_p1;
-
-			aabbNode.m_indexBox0 = aabbBase + vertexIndex;
-			aabbNode.m_indexBox1 = aabbBase + vertexIndex + 1;
-
-			vertexIndex += 2;
-
-		} else {
-			dgAssert (!node->m_left);
-			dgAssert (!node->m_right);
-
-			if (node->m_parent) {
-				if (node->m_parent->m_left == node) {
-					m_aabb[node->m_parent->m_enumeration].m_left = dgNode::dgLeafNodePtr (node->m_indexCount, indexMap);
-				} else {
-					dgAssert (node->m_parent->m_right == node);
-					m_aabb[node->m_parent->m_enumeration].m_right = dgNode::dgLeafNodePtr (node->m_indexCount, indexMap);
-				}
-			}
-
-			// index format i0, i1, i2, ... , id, normal, e0Normal, e1Normal, e2Normal, ..., faceSize
-			for (dgInt32 j = 0; j < node->m_indexCount; j ++) {
-				m_indices[indexMap + j] = node->m_faceIndices[j];
-				m_indices[indexMap + j + node->m_indexCount + 2] = -1;
-			}
-
-			// face attribute
-			m_indices[indexMap + node->m_indexCount] = node->m_faceIndices[node->m_indexCount];
-			// face normal
-			m_indices[indexMap + node->m_indexCount + 1] = builder.m_vertexCount + builder.m_normalIndex[node->m_faceIndex];
-			// face size
-			m_indices[indexMap + node->m_indexCount * 2 + 2] = dgInt32 (CalculateFaceMaxSize (&tmpVertexArray[0], node->m_indexCount, node->m_faceIndices));
-
-			indexMap += node->m_indexCount * 2 + 3;
-		}
-
-		if (node->m_left) {
-			dgAssert (node->m_right);
-			list.Append(node->m_left);
-			list.Append(node->m_right);
-		}
-	}
-
-	dgStack<dgInt32> indexArray (vertexIndex);
-	dgInt32 aabbPointCount = dgVertexListToIndexList (&aabbPoints[0].m_x, sizeof (dgVector), sizeof (dgTriplex), 0, vertexIndex, &indexArray[0], dgFloat32 (1.0e-6f));
-
-	m_vertexCount = aabbBase + aabbPointCount;
-	m_localVertex = (dgFloat32*) dgMallocStack (sizeof (dgTriplex) * m_vertexCount);
-
-	dgTriplex* const dstPoints = (dgTriplex*)m_localVertex;
-	for (dgInt32 i = 0; i < m_vertexCount; i ++) {
-		dstPoints[i].m_x = tmpVertexArray[i].m_x;
-		dstPoints[i].m_y = tmpVertexArray[i].m_y;
-		dstPoints[i].m_z = tmpVertexArray[i].m_z;
-	}
-
-	for (dgInt32 i = 0; i < m_nodesCount; i ++) {
-		dgNode& box = m_aabb[i];
-
-		dgInt32 j = box.m_indexBox0 - aabbBase;
-		box.m_indexBox0 = indexArray[j] + aabbBase;
-
-		j = box.m_indexBox1 - aabbBase;
-		box.m_indexBox1 = indexArray[j] + aabbBase;
-	}
-
-	if (builder.m_faceCount == 1) {
-		m_aabb[0].m_right = dgNode::dgLeafNodePtr (0, 0);
-	}
-//	CalculateAdjacendy();
-}
-
-void dgAABBPolygonSoup::Serialize (dgSerialize callback, void* const userData) const
-{
-	callback (userData, &m_vertexCount, sizeof (dgInt32));
-	callback (userData, &m_indexCount, sizeof (dgInt32));
-	callback (userData, &m_nodesCount, sizeof (dgInt32));
-	callback (userData, &m_nodesCount, sizeof (dgInt32));
-	if (m_aabb) {
-		callback (userData,  m_localVertex, sizeof (dgTriplex) * m_vertexCount);
-		callback (userData,  m_indices, sizeof (dgInt32) * m_indexCount);
-		callback (userData, m_aabb, sizeof (dgNode) * m_nodesCount);
-	}
-}
-
-void dgAABBPolygonSoup::Deserialize (dgDeserialize callback, void* const userData, dgInt32 revisionNumber)
-{
-	m_strideInBytes = sizeof (dgTriplex);
-	callback (userData, &m_vertexCount, sizeof (dgInt32));
-	callback (userData, &m_indexCount, sizeof (dgInt32));
-	callback (userData, &m_nodesCount, sizeof (dgInt32));
-	callback (userData, &m_nodesCount, sizeof (dgInt32));
-
-	if (m_vertexCount) {
-		m_localVertex = (dgFloat32*) dgMallocStack (sizeof (dgTriplex) * m_vertexCount);
-		m_indices = (dgInt32*) dgMallocStack (sizeof (dgInt32) * m_indexCount);
-		m_aabb = (dgNode*) dgMallocStack (sizeof (dgNode) * m_nodesCount);
-
-		callback (userData, m_localVertex, sizeof (dgTriplex) * m_vertexCount);
-		callback (userData, m_indices, sizeof (dgInt32) * m_indexCount);
-		callback (userData, m_aabb, sizeof (dgNode) * m_nodesCount);
-	} else {
-		m_localVertex = NULL;
-		m_indices = NULL;
-		m_aabb = NULL;
-	}
-}
-
-
-dgVector dgAABBPolygonSoup::ForAllSectorsSupportVectex (const dgVector& dir) const
-{
-	dgVector supportVertex (dgFloat32 (0.0f));
-	if (m_aabb) {
-		dgFloat32 aabbProjection[DG_STACK_DEPTH];
-		const dgNode *stackPool[DG_STACK_DEPTH];
-
-		dgInt32 stack = 1;
-		stackPool[0] = m_aabb;
-		aabbProjection[0] = dgFloat32 (1.0e10f);
-		const dgTriplex* const boxArray = (dgTriplex*)m_localVertex;
-		
-
-		dgFloat32 maxProj = dgFloat32 (-1.0e20f); 
-		dgInt32 ix = (dir[0] > dgFloat32 (0.0f)) ? 1 : 0;
-		dgInt32 iy = (dir[1] > dgFloat32 (0.0f)) ? 1 : 0;
-		dgInt32 iz = (dir[2] > dgFloat32 (0.0f)) ? 1 : 0;
-
-		while (stack) {
-			dgFloat32 boxSupportValue;
-
-			stack--;
-			boxSupportValue = aabbProjection[stack];
-			if (boxSupportValue > maxProj) {
-				dgFloat32 backSupportDist = dgFloat32 (0.0f);
-				dgFloat32 frontSupportDist = dgFloat32 (0.0f);
-				const dgNode* const me = stackPool[stack];
-				if (me->m_left.IsLeaf()) {
-					backSupportDist = dgFloat32 (-1.0e20f);
-					dgInt32 index = dgInt32 (me->m_left.GetIndex());
-					dgInt32 vCount = me->m_left.GetCount();
-					dgVector vertex (dgFloat32 (0.0f));
-					for (dgInt32 j = 0; j < vCount; j ++) {
-						dgInt32 i0 = m_indices[index + j] * dgInt32 (sizeof (dgTriplex) / sizeof (dgFloat32));
-						dgVector p (&boxArray[i0].m_x);
-						dgFloat32 dist = p % dir;
-						if (dist > backSupportDist) {
-							backSupportDist = dist;
-							vertex = p;
-						}
-					}
-
-					if (backSupportDist > maxProj) {
-						maxProj = backSupportDist;
-						supportVertex = vertex; 
-					}
-
-				} else {
-					dgVector box[2];
-					const dgNode* const node = me->m_left.GetNode(m_aabb);
-					box[0].m_x = boxArray[node->m_indexBox0].m_x;
-					box[0].m_y = boxArray[node->m_indexBox0].m_y;
-					box[0].m_z = boxArray[node->m_indexBox0].m_z;
-					box[1].m_x = boxArray[node->m_indexBox1].m_x;
-					box[1].m_y = boxArray[node->m_indexBox1].m_y;
-					box[1].m_z = boxArray[node->m_indexBox1].m_z;
-
-					dgVector supportPoint (box[ix].m_x, box[iy].m_y, box[iz].m_z, dgFloat32 (0.0));
-					backSupportDist = supportPoint % dir;
-				}
-
-				if (me->m_right.IsLeaf()) {
-					frontSupportDist = dgFloat32 (-1.0e20f);
-					dgInt32 index = dgInt32 (me->m_right.GetIndex());
-					dgInt32 vCount = me->m_right.GetCount();
-					dgVector vertex (dgFloat32 (0.0f));
-					for (dgInt32 j = 0; j < vCount; j ++) {
-						dgInt32 i0 = m_indices[index + j] * dgInt32 (sizeof (dgTriplex) / sizeof (dgFloat32));
-						dgVector p (&boxArray[i0].m_x);
-						dgFloat32 dist = p % dir;
-						if (dist > frontSupportDist) {
-							frontSupportDist = dist;
-							vertex = p;
-						}
-					}
-					if (frontSupportDist > maxProj) {
-						maxProj = frontSupportDist;
-						supportVertex = vertex; 
-					}
-
-				} else {
-					dgVector box[2];
-					const dgNode* const node = me->m_right.GetNode(m_aabb);
-					box[0].m_x = boxArray[node->m_indexBox0].m_x;
-					box[0].m_y = boxArray[node->m_indexBox0].m_y;
-					box[0].m_z = boxArray[node->m_indexBox0].m_z;
-					box[1].m_x = boxArray[node->m_indexBox1].m_x;
-					box[1].m_y = boxArray[node->m_indexBox1].m_y;
-					box[1].m_z = boxArray[node->m_indexBox1].m_z;
-
-					dgVector supportPoint (box[ix].m_x, box[iy].m_y, box[iz].m_z, dgFloat32 (0.0f));
-					frontSupportDist = supportPoint % dir;
-				}
-
-				if (frontSupportDist >= backSupportDist) {
-					if (!me->m_left.IsLeaf()) {
-						aabbProjection[stack] = backSupportDist;
-						stackPool[stack] = me->m_left.GetNode(m_aabb);
-						stack++;
-					}
-
-					if (!me->m_right.IsLeaf()) {
-						aabbProjection[stack] = frontSupportDist;
-						stackPool[stack] = me->m_right.GetNode(m_aabb);
-						stack++;
-					}
-
-				} else {
-
-					if (!me->m_right.IsLeaf()) {
-						aabbProjection[stack] = frontSupportDist;
-						stackPool[stack] = me->m_right.GetNode(m_aabb);
-						stack++;
-					}
-
-					if (!me->m_left.IsLeaf()) {
-						aabbProjection[stack] = backSupportDist;
-						stackPool[stack] = me->m_left.GetNode(m_aabb);
-						stack++;
-					}
-				}
-			}
-		}
-	}
-	return supportVertex;
-}
-
-
-void dgAABBPolygonSoup::ForAllSectorsRayHit (const dgFastRayTest& raySrc, dgFloat32 maxParam, dgRayIntersectCallback callback, void* const context) const
-{
-	const dgNode *stackPool[DG_STACK_DEPTH];
-	dgFloat32 distance[DG_STACK_DEPTH];
-	dgFastRayTest ray (raySrc);
-
-	dgInt32 stack = 1;
-	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
-
-	stackPool[0] = m_aabb;
-	distance[0] = m_aabb->RayDistance(ray, vertexArray);
-	while (stack) {
-		stack --;
-		dgFloat32 dist = distance[stack];
-		if (dist > maxParam) {
-			break;
-		} else {
-			const dgNode *const me = stackPool[stack];
-			if (me->m_left.IsLeaf()) {
-				dgInt32 vCount = me->m_left.GetCount();
-				if (vCount > 0) {
-					dgInt32 index = dgInt32 (me->m_left.GetIndex());
-					dgFloat32 param = callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), &m_indices[index], vCount);
-					dgAssert (param >= dgFloat32 (0.0f));
-					if (param < maxParam) {
-						maxParam = param;
-						if (maxParam == dgFloat32 (0.0f)) {
-							break;
-						}
-					}
-				}
-
-			} else {
-				const dgNode* const node = me->m_left.GetNode(m_aabb);
-				dgFloat32 dist = node->RayDistance(ray, vertexArray);
-				if (dist < maxParam) {
-					dgInt32 j = stack;
-					for ( ; j && (dist > distance[j - 1]); j --) {
-						stackPool[j] = stackPool[j - 1];
-						distance[j] = distance[j - 1];
-					}
-					dgAssert (stack < DG_STACK_DEPTH);
-					stackPool[j] = node;
-					distance[j] = dist;
-					stack++;
-				}
-			}
-
-			if (me->m_right.IsLeaf()) {
-				dgInt32 vCount = me->m_right.GetCount();
-				if (vCount > 0) {
-					dgInt32 index = dgInt32 (me->m_right.GetIndex());
-					dgFloat32 param = callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), &m_indices[index], vCount);
-					dgAssert (param >= dgFloat32 (0.0f));
-					if (param < maxParam) {
-						maxParam = param;
-						if (maxParam == dgFloat32 (0.0f)) {
-							break;
-						}
-					}
-				}
-
-			} else {
-				const dgNode* const node = me->m_right.GetNode(m_aabb);
-				dgFloat32 dist = node->RayDistance(ray, vertexArray);
-				if (dist < maxParam) {
-					dgInt32 j = stack;
-					for ( ; j && (dist > distance[j - 1]); j --) {
-						stackPool[j] = stackPool[j - 1];
-						distance[j] = distance[j - 1];
-					}
-					dgAssert (stack < DG_STACK_DEPTH);
-					stackPool[j] = node;
-					distance[j] = dist;
-					stack++;
-				}
-			}
-		}
-	}
-}
-
-
-void dgAABBPolygonSoup::ForAllSectors (const dgFastAABBInfo& obbAabbInfo, const dgVector& boxDistanceTravel, dgFloat32 m_maxT, dgAABBIntersectCallback callback, void* const context) const
-{
-
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][0]) - obbAabbInfo.m_absDir[0][0]) < dgFloat32 (1.0e-4f));
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[1][1]) - obbAabbInfo.m_absDir[1][1]) < dgFloat32 (1.0e-4f));
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[2][2]) - obbAabbInfo.m_absDir[2][2]) < dgFloat32 (1.0e-4f));
-
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][1]) - obbAabbInfo.m_absDir[1][0]) < dgFloat32 (1.0e-4f));
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][2]) - obbAabbInfo.m_absDir[2][0]) < dgFloat32 (1.0e-4f));
-	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[1][2]) - obbAabbInfo.m_absDir[2][1]) < dgFloat32 (1.0e-4f));
-
-	if (m_aabb) {
-		dgFloat32 distance[DG_STACK_DEPTH];
-		const dgNode* stackPool[DG_STACK_DEPTH];
-
-		const dgInt32 stride = sizeof (dgTriplex) / sizeof (dgFloat32);
-		const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
-
-		if ((boxDistanceTravel % boxDistanceTravel) < dgFloat32 (1.0e-8f)) {
-
-			dgInt32 stack = 1;
-			stackPool[0] = m_aabb;
-			distance[0] = m_aabb->BoxPenetration(obbAabbInfo, vertexArray);
-			while (stack) {
-				stack --;
-				dgFloat32 dist = distance[stack];
-				if (dist > dgFloat32 (0.0f)) {
-					const dgNode* const me = stackPool[stack];
-					if (me->m_left.IsLeaf()) {
-						dgInt32 index = dgInt32 (me->m_left.GetIndex());
-						dgInt32 vCount = me->m_left.GetCount();
-						if (vCount > 0) {
-							const dgInt32* const indices = &m_indices[index];
-							dgInt32 normalIndex = indices[vCount + 1];
-							dgVector faceNormal (&vertexArray[normalIndex].m_x);
-							dgFloat32 dist1 = obbAabbInfo.PolygonBoxDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x);
-							if (dist1 > dgFloat32 (0.0f)) {
-								dgAssert (vCount >= 3);
-								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, dist1) == t_StopSearh) {
-									return;
-								}
-							}
-						}
-
-					} else {
-						const dgNode* const node = me->m_left.GetNode(m_aabb);
-						dgFloat32 dist = node->BoxPenetration(obbAabbInfo, vertexArray);
-						if (dist > dgFloat32 (0.0f)) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							dgAssert (stack < DG_STACK_DEPTH);
-							stackPool[j] = node;
-							distance[j] = dist;
-							stack++;
-						}
-					}
-
-					if (me->m_right.IsLeaf()) {
-						dgInt32 index = dgInt32 (me->m_right.GetIndex());
-						dgInt32 vCount = me->m_right.GetCount();
-						if (vCount > 0) {
-							const dgInt32* const indices = &m_indices[index];
-							dgInt32 normalIndex = indices[vCount + 1];
-							dgVector faceNormal (&vertexArray[normalIndex].m_x);
-							dgFloat32 dist1 = obbAabbInfo.PolygonBoxDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x);
-							if (dist1 > dgFloat32 (0.0f)) {
-								dgAssert (vCount >= 3);
-								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, dist1) == t_StopSearh) {
-									return;
-								}
-							}
-						}
-
-					} else {
-						const dgNode* const node = me->m_right.GetNode(m_aabb);
-						dgFloat32 dist = node->BoxPenetration(obbAabbInfo, vertexArray);
-						if (dist > dgFloat32 (0.0f)) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							dgAssert (stack < DG_STACK_DEPTH);
-							stackPool[j] = node;
-							distance[j] = dist;
-							stack++;
-						}
-					}
-				}
-			}
-
-		} else {
-			dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), boxDistanceTravel);
-			dgFastRayTest obbRay (dgVector (dgFloat32 (0.0f)), obbAabbInfo.UnrotateVector(boxDistanceTravel));
-			dgInt32 stack = 1;
-			stackPool[0] = m_aabb;
-			distance [0] = m_aabb->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
-
-			while (stack) {
-				stack --;
-				const dgFloat32 dist = distance[stack];
-				const dgNode* const me = stackPool[stack];
-				if (dist < dgFloat32 (1.0f)) {
-
-					if (me->m_left.IsLeaf()) {
-						dgInt32 index = dgInt32 (me->m_left.GetIndex());
-						dgInt32 vCount = me->m_left.GetCount();
-						if (vCount > 0) {
-							const dgInt32* const indices = &m_indices[index];
-							dgInt32 normalIndex = indices[vCount + 1];
-							dgVector faceNormal (&vertexArray[normalIndex].m_x);
-							dgFloat32 hitDistance = obbAabbInfo.PolygonBoxRayDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x, ray);
-							if (hitDistance < dgFloat32 (1.0f)) {
-								dgAssert (vCount >= 3);
-								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, hitDistance) == t_StopSearh) {
-									return;
-								}
-							}
-						}
-
-					} else {
-						const dgNode* const node = me->m_left.GetNode(m_aabb);
-						dgFloat32 dist = node->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
-						if (dist < dgFloat32 (1.0f)) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							dgAssert (stack < DG_STACK_DEPTH);
-							stackPool[j] = node;
-							distance[j] = dist;
-							stack++;
-						}
-					}
-
-					if (me->m_right.IsLeaf()) {
-						dgInt32 index = dgInt32 (me->m_right.GetIndex());
-						dgInt32 vCount = me->m_right.GetCount();
-						if (vCount > 0) {
-							const dgInt32* const indices = &m_indices[index];
-							dgInt32 normalIndex = indices[vCount + 1];
-							dgVector faceNormal (&vertexArray[normalIndex].m_x);
-							dgFloat32 hitDistance = obbAabbInfo.PolygonBoxRayDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x, ray);
-							if (hitDistance < dgFloat32 (1.0f)) {
-								dgAssert (vCount >= 3);
-								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, hitDistance) == t_StopSearh) {
-									return;
-								}
-							}
-						}
-
-					} else {
-						const dgNode* const node = me->m_right.GetNode(m_aabb);
-						dgFloat32 dist = node->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
-						if (dist < dgFloat32 (1.0f)) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							dgAssert (stack < DG_STACK_DEPTH);
-							stackPool[j] = node;
-							distance[j] = dist;
-							stack ++;
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgStdafx.h"
+#include "dgHeap.h"
+#include "dgStack.h"
+#include "dgList.h"
+#include "dgMatrix.h"
+#include "dgThreadHive.h"
+#include "dgAABBPolygonSoup.h"
+#include "dgPolygonSoupBuilder.h"
+
+
+#define DG_STACK_DEPTH 512
+#define DG_COMPACT_NODE_MAX_COST	0x3fffffff
+
+// the boxes are binned along each axis by their centers to find the surface area heuristic split
+#define DG_BUILD_SAH_BINS			16
+
+// sub trees with more boxes than this are built by a forked job 
+#define DG_BUILD_SAH_FORK_SIZE		(1024 * 2)
+
+// ranges with more boxes than this are binned in parallel chunks
+#define DG_BUILD_SAH_CHUNK_SIZE		(1024 * 32)
+#define DG_BUILD_SAH_MAX_CHUNKS		8
+
+// nodes whose faces are processed by each job of the adjacency pass
+#define DG_ADJACENDY_NODE_BATCH		64
+
+// signature of the polygon soup images, the sections of an image start at cache line boundaries
+#define DG_POLYGON_SOUP_IMAGE_SIGNATURE	dgUnsigned32 (('I' << 24) | ('S' << 16) | ('G' << 8) | 'D')
+#define DG_POLYGON_SOUP_IMAGE_ALIGMENT	64
+
+
+DG_MSC_VECTOR_ALIGMENT
+class dgCompactNodeStackEntry
+{
+	public:
+	dgVector m_p0;
+	dgVector m_p1;
+	dgFloat32 m_dist;
+	dgInt32 m_node;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+// push a compact node keeping the stack sorted with the smallest distance on top
+static DG_INLINE dgInt32 dgPushCompactNode (dgCompactNodeStackEntry* const stackPool, dgInt32 stack, dgInt32 node, dgFloat32 dist, const dgVector& p0, const dgVector& p1)
+{
+	dgInt32 j = stack;
+	for ( ; j && (dist > stackPool[j - 1].m_dist); j --) {
+		stackPool[j] = stackPool[j - 1];
+	}
+	dgAssert (stack < DG_STACK_DEPTH);
+	stackPool[j].m_p0 = p0;
+	stackPool[j].m_p1 = p1;
+	stackPool[j].m_dist = dist;
+	stackPool[j].m_node = node;
+	return stack + 1;
+}
+
+// quantize a child bound conservatively, one extra step on each side absorbs the round off of the decoding
+static DG_INLINE dgUnsigned16 dgQuantizeCompactBound (dgFloat32 value, dgFloat32 origin, dgFloat32 scale, dgInt32 side)
+{
+	dgInt32 q = 0;
+	if (scale > dgFloat32 (0.0f)) {
+		dgFloat32 t = dgClamp ((value - origin) / scale, dgFloat32 (-1.0f), dgFloat32 (65536.0f));
+		q = side ? dgInt32 (dgCeil (t)) + 1 : dgInt32 (dgFloor (t)) - 1;
+		q = dgClamp (q, 0, 65535);
+	}
+	return dgUnsigned16 (q);
+}
+
+
+DG_MSC_VECTOR_ALIGMENT
+class dgAABBPolygonSoup::dgNodeBuilder: public dgAABBPolygonSoup::dgNode
+{
+	public:
+	dgNodeBuilder (const dgVector& p0, const dgVector& p1)
+		:dgNode()
+		,m_left (NULL)
+		,m_right (NULL)
+		,m_parent (NULL)
+		,m_indexBox0(0)
+		,m_indexBox1(0)
+		,m_enumeration(-1)
+		,m_faceIndex(0)
+		,m_indexCount(0)
+		,m_faceIndices(NULL)
+	{
+		SetBox (p0, p1);
+	}
+
+	dgNodeBuilder (const dgVector* const vertexArray, dgInt32 faceIndex, dgInt32 indexCount, const dgInt32* const indexArray)
+		:dgNode()
+		,m_left (NULL)
+		,m_right (NULL)
+		,m_parent (NULL)
+		,m_indexBox0(0)
+		,m_indexBox1(0)
+		,m_enumeration(-1)
+		,m_faceIndex(faceIndex)
+		,m_indexCount(indexCount)
+		,m_faceIndices(indexArray)
+	{
+		dgVector minP ( dgFloat32 (1.0e15f)); 
+		dgVector maxP (-dgFloat32 (1.0e15f)); 
+		for (dgInt32 i = 0; i < indexCount; i ++) {
+			dgInt32 index = indexArray[i];
+			const dgVector& p (vertexArray[index]);
+			minP = p.GetMin(minP); 
+			maxP = p.GetMax(maxP); 
+		}
+		minP -= dgVector (dgFloat32 (1.0e-3f));
+		maxP += dgVector (dgFloat32 (1.0e-3f));
+		minP = minP & dgVector::m_triplexMask;
+		maxP = maxP & dgVector::m_triplexMask;
+		SetBox (minP, maxP);
+	}
+
+	dgNodeBuilder (dgNodeBuilder* const left, dgNodeBuilder* const right)
+		:dgNode()
+		,m_left(left)
+		,m_right(right)
+		,m_parent(NULL)
+		,m_indexBox0(0)
+		,m_indexBox1(0)
+		,m_enumeration(-1)
+		,m_faceIndex(0)
+		,m_indexCount(0)
+		,m_faceIndices(NULL)
+	{
+		m_left->m_parent = this;
+		m_right->m_parent = this;
+
+		dgVector p0 (left->m_p0.GetMin(right->m_p0));
+		dgVector p1 (left->m_p1.GetMax(right->m_p1));
+		SetBox(p0, p1);
+	}
+
+	void SetBox (const dgVector& p0, const dgVector& p1)
+	{
+		m_p0 = p0;
+		m_p1 = p1;
+		m_size = m_p1 - m_p0;
+		m_origin = (m_p1 + m_p0).Scale4 (dgFloat32 (0.5f));
+		m_area = m_size.DotProduct4(m_size.ShiftTripleRight()).m_x;
+	}
+
+
+	dgVector m_p0;
+	dgVector m_p1;
+	dgVector m_size;
+	dgVector m_origin;
+	dgFloat32 m_area;
+	
+	dgNodeBuilder* m_left;
+	dgNodeBuilder* m_right;
+	dgNodeBuilder* m_parent;
+	dgInt32 m_indexBox0;
+	dgInt32 m_indexBox1;
+	dgInt32 m_enumeration;
+	dgInt32 m_faceIndex;
+	dgInt32 m_indexCount;
+	const dgInt32* m_faceIndices;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+
+DG_MSC_VECTOR_ALIGMENT
+class dgAABBPolygonSoup::dgBuildRange
+{
+	public:
+	dgVector m_center0;
+	dgVector m_center1;
+	dgNodeBuilder** m_boxArray;
+	dgNodeBuilder* m_nodePool;
+	dgNodeBuilder* m_node;
+	dgThreadHive* m_threadPool;
+	dgInt32 m_firstBox;
+	dgInt32 m_lastBox;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+// bounds and counts of the boxes binned by their centers along each axis
+DG_MSC_VECTOR_ALIGMENT
+class dgAABBPolygonSoup::dgSpliteInfo
+{
+	public:
+	DG_MSC_VECTOR_ALIGMENT
+	class dgBins
+	{
+		public:
+		void Init (dgNodeBuilder** const boxArray, dgInt32 boxCount, const dgVector& origin, const dgVector& scale)
+		{
+			m_origin = origin;
+			m_scale = scale;
+			m_boxArray = boxArray;
+			m_boxCount = boxCount;
+			for (dgInt32 i = 0; i < 3; i ++) {
+				for (dgInt32 j = 0; j < DG_BUILD_SAH_BINS; j ++) {
+					m_p0[i][j] = dgVector (dgFloat32 (1.0e15f));
+					m_p1[i][j] = dgVector (-dgFloat32 (1.0e15f));
+					m_center0[i][j] = dgVector (dgFloat32 (1.0e15f));
+					m_center1[i][j] = dgVector (-dgFloat32 (1.0e15f));
+					m_count[i][j] = 0;
+				}
+			}
+		}
+
+		DG_INLINE dgInt32 GetBin (const dgNodeBuilder* const box, dgInt32 axis) const
+		{
+			dgFloat32 x = (box->m_origin[axis] - m_origin[axis]) * m_scale[axis];
+			return dgClamp (dgInt32 (x), dgInt32 (0), dgInt32 (DG_BUILD_SAH_BINS - 1));
+		}
+
+		void AddBoxes ()
+		{
+			for (dgInt32 i = 0; i < m_boxCount; i ++) {
+				const dgNodeBuilder* const box = m_boxArray[i];
+				for (dgInt32 j = 0; j < 3; j ++) {
+					dgInt32 bin = GetBin (box, j);
+					m_p0[j][bin] = m_p0[j][bin].GetMin (box->m_p0);
+					m_p1[j][bin] = m_p1[j][bin].GetMax (box->m_p1);
+					m_center0[j][bin] = m_center0[j][bin].GetMin (box->m_origin);
+					m_center1[j][bin] = m_center1[j][bin].GetMax (box->m_origin);
+					m_count[j][bin] ++;
+				}
+			}
+		}
+
+		void Merge (const dgBins& bins)
+		{
+			for (dgInt32 i = 0; i < 3; i ++) {
+				for (dgInt32 j = 0; j < DG_BUILD_SAH_BINS; j ++) {
+					m_p0[i][j] = m_p0[i][j].GetMin (bins.m_p0[i][j]);
+					m_p1[i][j] = m_p1[i][j].GetMax (bins.m_p1[i][j]);
+					m_center0[i][j] = m_center0[i][j].GetMin (bins.m_center0[i][j]);
+					m_center1[i][j] = m_center1[i][j].GetMax (bins.m_center1[i][j]);
+					m_count[i][j] += bins.m_count[i][j];
+				}
+			}
+		}
+
+		static void AddBoxesKernel (void* const context, void* const unused, dgInt32 threadID)
+		{
+			dgBins* const bins = (dgBins*) context;
+			bins->AddBoxes();
+		}
+
+		dgVector m_origin;
+		dgVector m_scale;
+		dgVector m_p0[3][DG_BUILD_SAH_BINS];
+		dgVector m_p1[3][DG_BUILD_SAH_BINS];
+		dgVector m_center0[3][DG_BUILD_SAH_BINS];
+		dgVector m_center1[3][DG_BUILD_SAH_BINS];
+		dgInt32 m_count[3][DG_BUILD_SAH_BINS];
+		dgNodeBuilder** m_boxArray;
+		dgInt32 m_boxCount;
+	} DG_GCC_VECTOR_ALIGMENT;
+
+	// bin the boxes of the range, select the split with the lowest area weighted box count 
+	// and partition the range, the first m_axis boxes go to the left side
+	dgSpliteInfo (const dgBuildRange& range, dgInt32 threadID)
+	{
+		dgNodeBuilder** const boxArray = &range.m_boxArray[range.m_firstBox];
+		const dgInt32 boxCount = range.m_lastBox - range.m_firstBox + 1;
+
+		if (boxCount == 2) {
+			m_axis = 1;
+			m_p0 = boxArray[0]->m_p0.GetMin (boxArray[1]->m_p0);
+			m_p1 = boxArray[0]->m_p1.GetMax (boxArray[1]->m_p1);
+			m_leftCenter0 = range.m_center0;
+			m_leftCenter1 = range.m_center1;
+			m_rightCenter0 = range.m_center0;
+			m_rightCenter1 = range.m_center1;
+		} else {
+			const dgVector size (range.m_center1 - range.m_center0);
+			dgVector scale (dgFloat32 (0.0f));
+			for (dgInt32 i = 0; i < 3; i ++) {
+				if (size[i] > dgFloat32 (1.0e-6f)) {
+					scale[i] = dgFloat32 (DG_BUILD_SAH_BINS) * dgFloat32 (0.9999f) / size[i];
+				}
+			}
+
+			dgBins bins;
+			bins.Init (boxArray, boxCount, range.m_center0, scale);
+			if (range.m_threadPool && (boxCount > DG_BUILD_SAH_CHUNK_SIZE)) {
+				const dgInt32 chunkCount = dgMin (boxCount / DG_BUILD_SAH_CHUNK_SIZE, dgInt32 (DG_BUILD_SAH_MAX_CHUNKS));
+				dgStack<dgBins> chunkPool (chunkCount);
+				dgBins* const chunks = &chunkPool[0];
+				dgInt32 joinCounter = 0;
+				for (dgInt32 i = 0; i < chunkCount; i ++) {
+					const dgInt32 start = boxCount * i / chunkCount;
+					const dgInt32 end = boxCount * (i + 1) / chunkCount;
+					chunks[i].Init (&boxArray[start], end - start, range.m_center0, scale);
+					if (i) {
+						range.m_threadPool->ForkJob (threadID, &joinCounter, dgBins::AddBoxesKernel, &chunks[i], NULL);
+					}
+				}
+				chunks[0].AddBoxes();
+				range.m_threadPool->JoinJobs (threadID, &joinCounter);
+				for (dgInt32 i = 0; i < chunkCount; i ++) {
+					bins.Merge (chunks[i]);
+				}
+			} else {
+				bins.AddBoxes();
+			}
+
+			m_p0 = dgVector (dgFloat32 (1.0e15f));
+			m_p1 = dgVector (-dgFloat32 (1.0e15f));
+			for (dgInt32 i = 0; i < DG_BUILD_SAH_BINS; i ++) {
+				m_p0 = m_p0.GetMin (bins.m_p0[0][i]);
+				m_p1 = m_p1.GetMax (bins.m_p1[0][i]);
+			}
+
+			dgInt32 bestAxis = -1;
+			dgInt32 bestBin = 0;
+			dgFloat32 bestCost = dgFloat32 (1.0e30f);
+			for (dgInt32 i = 0; i < 3; i ++) {
+				dgFloat32 leftArea[DG_BUILD_SAH_BINS];
+				dgInt32 leftCount[DG_BUILD_SAH_BINS];
+				dgVector p0 (dgFloat32 (1.0e15f));
+				dgVector p1 (-dgFloat32 (1.0e15f));
+				dgInt32 count = 0;
+				for (dgInt32 j = 0; j < DG_BUILD_SAH_BINS - 1; j ++) {
+					p0 = p0.GetMin (bins.m_p0[i][j]);
+					p1 = p1.GetMax (bins.m_p1[i][j]);
+					count += bins.m_count[i][j];
+					leftArea[j] = count ? CalculateArea (p0, p1) : dgFloat32 (0.0f);
+					leftCount[j] = count;
+				}
+
+				p0 = dgVector (dgFloat32 (1.0e15f));
+				p1 = dgVector (-dgFloat32 (1.0e15f));
+				count = 0;
+				for (dgInt32 j = DG_BUILD_SAH_BINS - 1; j > 0; j --) {
+					p0 = p0.GetMin (bins.m_p0[i][j]);
+					p1 = p1.GetMax (bins.m_p1[i][j]);
+					count += bins.m_count[i][j];
+					if (count && leftCount[j - 1]) {
+						dgFloat32 cost = leftArea[j - 1] * dgFloat32 (leftCount[j - 1]) + CalculateArea (p0, p1) * dgFloat32 (count);
+						if (cost < bestCost) {
+							bestCost = cost;
+							bestAxis = i;
+							bestBin = j - 1;
+						}
+					}
+				}
+			}
+
+			if (bestAxis >= 0) {
+				dgInt32 i0 = 0;
+				dgInt32 i1 = boxCount - 1;
+				while (i0 <= i1) {
+					if (bins.GetBin (boxArray[i0], bestAxis) <= bestBin) {
+						i0 ++;
+					} else {
+						dgSwap (boxArray[i0], boxArray[i1]);
+						i1 --;
+					}
+				}
+				m_axis = i0;
+
+				m_leftCenter0 = dgVector (dgFloat32 (1.0e15f));
+				m_leftCenter1 = dgVector (-dgFloat32 (1.0e15f));
+				m_rightCenter0 = dgVector (dgFloat32 (1.0e15f));
+				m_rightCenter1 = dgVector (-dgFloat32 (1.0e15f));
+				for (dgInt32 i = 0; i < DG_BUILD_SAH_BINS; i ++) {
+					if (i <= bestBin) {
+						m_leftCenter0 = m_leftCenter0.GetMin (bins.m_center0[bestAxis][i]);
+						m_leftCenter1 = m_leftCenter1.GetMax (bins.m_center1[bestAxis][i]);
+					} else {
+						m_rightCenter0 = m_rightCenter0.GetMin (bins.m_center0[bestAxis][i]);
+						m_rightCenter1 = m_rightCenter1.GetMax (bins.m_center1[bestAxis][i]);
+					}
+				}
+			} else {
+				// all the centers fall in the same bin, split the range in half
+				m_axis = boxCount / 2;
+				m_leftCenter0 = range.m_center0;
+				m_leftCenter1 = range.m_center1;
+				m_rightCenter0 = range.m_center0;
+				m_rightCenter1 = range.m_center1;
+			}
+			dgAssert (m_axis > 0);
+			dgAssert (m_axis < boxCount);
+		}
+
+		dgAssert (m_p1.m_x - m_p0.m_x >= dgFloat32 (0.0f));
+		dgAssert (m_p1.m_y - m_p0.m_y >= dgFloat32 (0.0f));
+		dgAssert (m_p1.m_z - m_p0.m_z >= dgFloat32 (0.0f));
+	}
+
+	static dgFloat32 CalculateArea (const dgVector& p0, const dgVector& p1)
+	{
+		dgVector side0 (p1 - p0);
+		dgVector side1 (side0.m_y, side0.m_z, side0.m_x, dgFloat32 (0.0f));
+		return side0.DotProduct4(side1).m_x;
+	}
+
+	dgVector m_p0;
+	dgVector m_p1;
+	dgVector m_leftCenter0;
+	dgVector m_leftCenter1;
+	dgVector m_rightCenter0;
+	dgVector m_rightCenter1;
+	dgInt32 m_axis;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+
+// header of a polygon soup image, the vertex, index and node arrays follow it at the recorded offsets. 
+// the nodes only refer to faces, vertices and other nodes by index, so the image does not depend on the address where it is loaded.
+class dgAABBPolygonSoup::dgImageHeader
+{
+	public:
+	void Init (const dgAABBPolygonSoup& soup)
+	{
+		memset (this, 0, sizeof (dgImageHeader));
+		m_signature = DG_POLYGON_SOUP_IMAGE_SIGNATURE;
+		m_revision = m_currentRevision;
+		m_triplexSize = sizeof (dgTriplex);
+		m_nodeSize = sizeof (dgNode);
+		m_compactNodeSize = sizeof (dgCompactNode);
+		m_vertexCount = soup.m_vertexCount;
+		m_indexCount = soup.m_indexCount;
+		m_nodesCount = soup.m_aabb ? soup.m_nodesCount : 0;
+		m_compactNodesCount = soup.m_compactNodes ? soup.m_compactNodesCount : 0;
+		if (soup.m_compactNodes) {
+			m_compactBox[0] = soup.m_compactBox[0];
+			m_compactBox[1] = soup.m_compactBox[1];
+		}
+
+		m_vertexOffset = Align (sizeof (dgImageHeader));
+		m_indexOffset = Align (m_vertexOffset + m_vertexCount * m_triplexSize);
+		m_nodesOffset = Align (m_indexOffset + m_indexCount * dgInt32 (sizeof (dgInt32)));
+		m_imageSize = Align (m_nodesOffset + m_nodesCount * m_nodeSize + m_compactNodesCount * m_compactNodeSize);
+	}
+
+	bool IsValid (dgInt32 sizeInBytes) const
+	{
+		if ((m_signature != DG_POLYGON_SOUP_IMAGE_SIGNATURE) || (m_revision <= m_prePolygonSoupImageRevision) || (m_revision > m_currentRevision)) {
+			return false;
+		}
+		if ((m_triplexSize != sizeof (dgTriplex)) || (m_nodeSize != sizeof (dgNode)) || (m_compactNodeSize != sizeof (dgCompactNode))) {
+			return false;
+		}
+		if ((m_vertexCount < 0) || (m_indexCount < 0) || (m_nodesCount < 0) || (m_compactNodesCount < 0)) {
+			return false;
+		}
+		if (m_vertexCount && ((m_nodesCount ? 1 : 0) == (m_compactNodesCount ? 1 : 0))) {
+			return false;
+		}
+		// the arrays are read in place, so each one must start on an aligned address like the image itself
+		if ((m_vertexOffset | m_indexOffset | m_nodesOffset) & (DG_POLYGON_SOUP_IMAGE_ALIGMENT - 1)) {
+			return false;
+		}
+
+		// the sections must be in order and inside the image, the image must fit in the memory passed by the application
+		dgInt64 vertexEnd = dgInt64 (m_vertexOffset) + dgInt64 (m_vertexCount) * m_triplexSize;
+		dgInt64 indexEnd = dgInt64 (m_indexOffset) + dgInt64 (m_indexCount) * dgInt64 (sizeof (dgInt32));
+		dgInt64 nodesEnd = dgInt64 (m_nodesOffset) + dgInt64 (m_nodesCount) * m_nodeSize + dgInt64 (m_compactNodesCount) * m_compactNodeSize;
+		return (m_vertexOffset >= dgInt32 (sizeof (dgImageHeader))) && (m_indexOffset >= vertexEnd) && (m_nodesOffset >= indexEnd) && 
+			   (m_imageSize >= nodesEnd) && (m_imageSize <= sizeInBytes);
+	}
+
+	static dgInt32 Align (dgInt32 size)
+	{
+		return (size + DG_POLYGON_SOUP_IMAGE_ALIGMENT - 1) & -DG_POLYGON_SOUP_IMAGE_ALIGMENT;
+	}
+
+	// pad the image with zeros up to the start of the section and write it
+	void WriteSection (dgSerialize callback, void* const userData, dgInt32& position, dgInt32 offset, const void* const data, dgInt32 size) const
+	{
+		dgInt8 padding[DG_POLYGON_SOUP_IMAGE_ALIGMENT];
+		dgAssert ((offset >= position) && ((offset - position) < DG_POLYGON_SOUP_IMAGE_ALIGMENT));
+		if (offset > position) {
+			memset (padding, 0, sizeof (padding));
+			callback (userData, padding, size_t (offset - position));
+		}
+		if (size) {
+			callback (userData, data, size_t (size));
+		}
+		position = offset + size;
+	}
+
+	dgUnsigned32 m_signature;
+	dgInt32 m_revision;
+	dgInt32 m_imageSize;
+	dgInt32 m_triplexSize;
+	dgInt32 m_nodeSize;
+	dgInt32 m_compactNodeSize;
+	dgInt32 m_vertexCount;
+	dgInt32 m_indexCount;
+	dgInt32 m_nodesCount;
+	dgInt32 m_compactNodesCount;
+	dgInt32 m_vertexOffset;
+	dgInt32 m_indexOffset;
+	dgInt32 m_nodesOffset;
+	dgTriplex m_compactBox[2];
+};
+
+
+dgAABBPolygonSoup::dgAABBPolygonSoup ()
+	:dgPolygonSoupDatabase()
+	,m_nodesCount(0)
+	,m_indexCount(0)
+	,m_aabb(NULL)
+	,m_indices(NULL)
+	,m_compactNodesCount(0)
+	,m_compactNodes(NULL)
+	,m_mappedImage(NULL)
+{
+}
+
+dgAABBPolygonSoup::~dgAABBPolygonSoup ()
+{
+	ReleaseImage ();
+	if (m_aabb) {
+		dgFreeStack (m_aabb);
+	}
+	if (m_compactNodes) {
+		dgFreeStack (m_compactNodes);
+	}
+	if (m_indices) {
+		dgFreeStack (m_indices);
+	}
+}
+
+
+dgFloat32 dgAABBPolygonSoup::CalculateFaceMaxSize (const dgVector* const vertex, dgInt32 indexCount, const dgInt32* const indexArray) const
+{
+	dgFloat32 maxSize = dgFloat32 (0.0f);
+	dgInt32 index = indexArray[indexCount - 1];
+	dgVector p0 (vertex[index]);
+	for (dgInt32 i = 0; i < indexCount; i ++) {
+		dgInt32 index = indexArray[i];
+		dgVector p1 (vertex[index]);
+
+		dgVector dir (p1 - p0);
+		dir = dir.Scale3 (dgRsqrt (dir % dir));
+
+		dgFloat32 maxVal = dgFloat32 (-1.0e10f);
+		dgFloat32 minVal = dgFloat32 ( 1.0e10f);
+		for (dgInt32 j = 0; j < indexCount; j ++) {
+			dgInt32 index = indexArray[j];
+			dgVector q (vertex[index]);
+			dgFloat32 val = dir % q;
+			minVal = dgMin(minVal, val);
+			maxVal = dgMax(maxVal, val);
+		}
+
+		dgFloat32 size = maxVal - minVal;
+		maxSize = dgMax(maxSize, size);
+		p0 = p1;
+	}
+
+	return dgFloor (maxSize + dgFloat32 (1.0f));
+}
+
+
+
+
+void dgAABBPolygonSoup::GetAABB (dgVector& p0, dgVector& p1) const
+{
+	if (m_aabb || m_compactNodes) { 
+		GetNodeAABB (GetRootNode(), p0, p1);
+	} else {
+		p0 = dgVector (dgFloat32 (0.0f));
+		p1 = dgVector (dgFloat32 (0.0f));
+	}
+}
+
+
+
+void dgAABBPolygonSoup::CalculateAdjacendy (dgThreadHive* const threadPool)
+{
+	dgInt32 atomicIndex = 0;
+	if (threadPool) {
+		const dgInt32 threadCount = threadPool->GetThreadCount();
+		for (dgInt32 i = 0; i < threadCount; i ++) {
+			threadPool->QueueJob (CalculateAdjacendyKernel, &atomicIndex, this);
+		}
+		threadPool->SynchronizationBarrier();
+	} else {
+		CalculateAdjacendyKernel (&atomicIndex, this, 0);
+	}
+}
+
+// a face only writes its own edge normals, so the faces of each batch of nodes are processed independently
+void dgAABBPolygonSoup::CalculateAdjacendyKernel (void* const context, void* const soupContext, dgInt32 threadID)
+{
+	dgInt32* const atomicIndex = (dgInt32*) context;
+	dgAABBPolygonSoup* const me = (dgAABBPolygonSoup*) soupContext;
+
+	const dgInt32 nodesCount = me->m_nodesCount;
+	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, DG_ADJACENDY_NODE_BATCH); i < nodesCount; i = dgAtomicExchangeAndAdd(atomicIndex, DG_ADJACENDY_NODE_BATCH)) {
+		const dgInt32 count = dgMin (nodesCount - i, dgInt32 (DG_ADJACENDY_NODE_BATCH));
+		for (dgInt32 j = 0; j < count; j ++) {
+			const dgNode* const node = &me->m_aabb[i + j];
+			if (node->m_left.IsLeaf()) {
+				me->CalculateFaceAdjacendy (node->m_left);
+			}
+			if (node->m_right.IsLeaf()) {
+				me->CalculateFaceAdjacendy (node->m_right);
+			}
+		}
+	}
+}
+
+void dgAABBPolygonSoup::CalculateFaceAdjacendy (const dgNode::dgLeafNodePtr& leaf)
+{
+	dgInt32 vCount = leaf.GetCount();
+	if (vCount > 0) {
+		dgInt32 index = dgInt32 (leaf.GetIndex());
+		dgInt32* const face = &m_indices[index];
+		CalculateAllFaceEdgeNormals (this, m_localVertex, sizeof (dgTriplex), face, vCount, dgFloat32 (0.0f));
+		for (dgInt32 j = 0; j < vCount; j ++) {
+			if (face[vCount + 2 + j] == -1) {
+				face[vCount + 2 + j] = face[vCount + 1];
+			}
+		}
+	}
+}
+
+
+dgIntersectStatus dgAABBPolygonSoup::CalculateAllFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance)
+{
+	dgInt32 stride = dgInt32 (strideInBytes / sizeof (dgFloat32));
+
+	AdjacentdFaces adjacentFaces;
+	adjacentFaces.m_count = indexCount;
+	adjacentFaces.m_index = (dgInt32*) indexArray;
+
+	dgVector n (&polygon[indexArray[indexCount + 1] * stride]);
+	dgVector p (&polygon[indexArray[0] * stride]);
+	adjacentFaces.m_normal = dgPlane (n, - (n % p));
+
+	dgAssert (indexCount < dgInt32 (sizeof (adjacentFaces.m_edgeMap) / sizeof (adjacentFaces.m_edgeMap[0])));
+
+	dgInt32 edgeIndex = indexCount - 1;
+	dgInt32 i0 = indexArray[indexCount - 1];
+	dgVector p0 ( dgFloat32 (1.0e15f),  dgFloat32 (1.0e15f),  dgFloat32 (1.0e15f), dgFloat32 (0.0f)); 
+	dgVector p1 (-dgFloat32 (1.0e15f), -dgFloat32 (1.0e15f), -dgFloat32 (1.0e15f), dgFloat32 (0.0f)); 
+	for (dgInt32 i = 0; i < indexCount; i ++) {
+		dgInt32 i1 = indexArray[i];
+		dgInt32 index = i1 * stride;
+		dgVector p (&polygon[index]);
+//		p0.m_x = dgMin (p.m_x, p0.m_x); 
+//		p0.m_y = dgMin (p.m_y, p0.m_y); 
+//		p0.m_z = dgMin (p.m_z, p0.m_z); 
+//		p1.m_x = dgMax (p.m_x, p1.m_x); 
+//		p1.m_y = dgMax (p.m_y, p1.m_y); 
+//		p1.m_z = dgMax (p.m_z, p1.m_z); 
+		p0 = p0.GetMin(p);
+		p1 = p1.GetMax(p);
+		adjacentFaces.m_edgeMap[edgeIndex] = (dgInt64 (i1) << 32) + i0;
+		edgeIndex = i;
+		i0 = i1;
+	}
+
+	dgFloat32 padding = dgFloat32 (1.0f/16.0f);
+	p0.m_x -= padding;
+	p0.m_y -= padding;
+	p0.m_z -= padding;
+	p1.m_x += padding;
+	p1.m_y += padding;
+	p1.m_z += padding;
+
+	dgAABBPolygonSoup* const me = (dgAABBPolygonSoup*) context;
+	dgFastAABBInfo box (p0, p1);
+	me->ForAllSectors (box, dgVector (dgFloat32 (0.0f)), dgFloat32 (1.0f), CalculateDisjointedFaceEdgeNormals, &adjacentFaces);
+	return t_ContinueSearh;
+}
+
+
+dgIntersectStatus dgAABBPolygonSoup::CalculateDisjointedFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance)
+{
+	#define DG_WELDING_TOL (1.0e-2f)
+	#define DG_WELDING_TOL2 (DG_WELDING_TOL * DG_WELDING_TOL)
+
+	AdjacentdFaces& adjacentFaces = *((AdjacentdFaces*)context);
+
+	if (adjacentFaces.m_index != indexArray) {	
+		dgInt32 adjacentCount = adjacentFaces.m_count;
+		dgInt32 stride = dgInt32 (strideInBytes / sizeof (dgFloat32));
+
+		dgInt32 j0 = adjacentCount - 1;
+		dgInt32 indexJ0 = adjacentFaces.m_index[adjacentCount - 1];
+		for (dgInt32 j = 0; j < adjacentCount; j ++) {
+			dgInt32 indexJ1 = adjacentFaces.m_index[j];
+			dgBigVector q0 (&polygon[indexJ1 * stride]);
+			dgBigVector q1 (&polygon[indexJ0 * stride]);
+			dgBigVector q1q0 (q1 - q0);
+			dgFloat64 q1q0Mag2 = q1q0 % q1q0;
+
+			dgInt32 indexI0 = indexArray[indexCount - 1];
+			for (dgInt32 i = 0; i < indexCount; i ++) {
+				dgInt32 indexI1 = indexArray[i];
+				dgBigVector p0 (&polygon[indexI0 * stride]);
+				dgBigVector p1 (&polygon[indexI1 * stride]);
+				dgBigVector p1p0 (p1 - p0);
+				dgFloat64 dot = p1p0 % q1q0;
+				if (dot > 0.0f) {
+					dgFloat64 q1p0Mag2 = p1p0 % p1p0;
+					if ((dot * dot) >= (q1p0Mag2 * q1q0Mag2 * dgFloat64(0.99995f))) {
+						dgFloat64 x0 = q0 % q1q0;
+						dgFloat64 x1 = q1 % q1q0;
+						dgFloat64 y0 = p0 % q1q0;
+						dgFloat64 y1 = p1 % q1q0;
+						dgAssert (x1 > x0);
+						dgAssert (y1 > y0);
+						if (!((y0 >= x1) || (y1 <= x0))) {
+							dgFloat64 t = ((p0 - q0) % q1q0) / q1q0Mag2;
+							dgBigVector q (q0 + q1q0.Scale3(t));
+							dgBigVector dist (p0 - q);
+							dgFloat64 err2 = dist % dist;
+							if (err2 < DG_WELDING_TOL2) {
+								dgFloat32 maxDist = dgFloat32 (0.0f);
+								for (dgInt32 k = 0; k < indexCount; k ++) {
+									dgVector r (&polygon[indexArray[k] * stride]);
+									dgFloat32 dist = adjacentFaces.m_normal.Evalue(r);
+									if (dgAbsf (dist) > dgAbsf (maxDist)) {
+										maxDist = dist;
+									}
+								}
+
+								if (adjacentFaces.m_index[j0 + adjacentCount + 2] == -1) {
+									if (maxDist < -dgFloat32 (1.0e-3f)) {
+										adjacentFaces.m_index[j0 + adjacentCount + 2] = indexArray[indexCount + 1];
+									} else {
+										adjacentFaces.m_index[j0 + adjacentCount + 2] = adjacentFaces.m_index[adjacentCount + 1];
+									}
+								} else {
+									if (maxDist < -dgFloat32 (1.0e-3f)) {
+										dgBigVector n0 (adjacentFaces.m_normal[0], adjacentFaces.m_normal[1], adjacentFaces.m_normal[2], dgFloat64(0.0f));
+										dgBigVector n1 (&polygon[adjacentFaces.m_index[j0 + adjacentCount + 2] * stride]);
+										dgBigVector n2 (&polygon[indexArray[indexCount + 1] * stride]);
+
+										dgBigVector tilt0 (n0 * n1); 
+										dgBigVector tilt1 (n0 * n2); 
+										dgFloat64 dist0 (q1q0 % tilt0);
+										dgFloat64 dist1 (q1q0 % tilt1);
+										if (dist0 < dist1) {
+											adjacentFaces.m_index[j0 + adjacentCount + 2] = indexArray[indexCount + 1];
+										}
+									} else {
+										adjacentFaces.m_index[j0 + adjacentCount + 2] = adjacentFaces.m_index[adjacentCount + 1];
+									}
+								}
+								break;
+							}
+						}
+					}
+				}
+				indexI0 = indexI1;
+			}
+			j0 = j;
+			indexJ0 = indexJ1;
+		}
+	}
+	return t_ContinueSearh;
+}
+
+
+
+void dgAABBPolygonSoup::BuildTopDown (dgBuildRange& range, dgInt32 threadID) const
+{
+	dgAssert (range.m_firstBox >= 0);
+	dgAssert (range.m_lastBox >= range.m_firstBox);
+
+	if (range.m_lastBox == range.m_firstBox) {
+		range.m_node = range.m_boxArray[range.m_firstBox];
+	} else {
+		dgSpliteInfo info (range, threadID);
+
+		// a range of n boxes owns n - 1 nodes of the pool, the parent takes the one between the two sub ranges
+		dgInt32 splitBox = range.m_firstBox + info.m_axis;
+		dgNodeBuilder* const parent = new (&range.m_nodePool[splitBox - 1]) dgNodeBuilder (info.m_p0, info.m_p1);
+
+		dgBuildRange left (range);
+		left.m_lastBox = splitBox - 1;
+		left.m_center0 = info.m_leftCenter0;
+		left.m_center1 = info.m_leftCenter1;
+
+		dgBuildRange right (range);
+		right.m_firstBox = splitBox;
+		right.m_center0 = info.m_rightCenter0;
+		right.m_center1 = info.m_rightCenter1;
+
+		if (range.m_threadPool && ((range.m_lastBox - range.m_firstBox) > DG_BUILD_SAH_FORK_SIZE)) {
+			dgInt32 joinCounter = 0;
+			range.m_threadPool->ForkJob (threadID, &joinCounter, BuildTopDownKernel, &right, (void*)this);
+			BuildTopDown (left, threadID);
+			range.m_threadPool->JoinJobs (threadID, &joinCounter);
+		} else {
+			BuildTopDown (right, threadID);
+			BuildTopDown (left, threadID);
+		}
+
+		parent->m_right = right.m_node;
+		parent->m_right->m_parent = parent;
+		parent->m_left = left.m_node;
+		parent->m_left->m_parent = parent;
+		range.m_node = parent;
+	}
+}
+
+void dgAABBPolygonSoup::BuildTopDownKernel (void* const context, void* const soupContext, dgInt32 threadID)
+{
+	dgBuildRange* const range = (dgBuildRange*) context;
+	const dgAABBPolygonSoup* const me = (dgAABBPolygonSoup*) soupContext;
+	me->BuildTopDown (*range, threadID);
+}
+
+
+
+
+
+void dgAABBPolygonSoup::Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild, dgThreadHive* const threadPool)
+{
+	if (builder.m_faceCount == 0) {
+		return;
+	}
+	dgAssert (builder.m_faceCount >= 1);
+
+	// rebuilding a mapped soup leaves the image to the application, an owned soup frees the arrays of the previous build 
+	ReleaseImage ();
+	if (m_aabb) {
+		dgFreeStack (m_aabb);
+		m_aabb = NULL;
+	}
+	if (m_compactNodes) {
+		dgFreeStack (m_compactNodes);
+		m_compactNodes = NULL;
+	}
+	m_compactNodesCount = 0;
+	if (m_indices) {
+		dgFreeStack (m_indices);
+		m_indices = NULL;
+	}
+	if (m_localVertex) {
+		dgFreeStack (m_localVertex);
+		m_localVertex = NULL;
+	}
+	m_strideInBytes = sizeof (dgTriplex);
+	m_nodesCount = ((builder.m_faceCount - 1) < 1) ? 1 : builder.m_faceCount - 1;
+	m_aabb = (dgNode*) dgMallocStack (sizeof (dgNode) * m_nodesCount);
+	m_indexCount = builder.m_indexCount * 2 + builder.m_faceCount;
+	if (builder.m_faceCount == 1) {
+		m_indexCount *= 2;
+	}
+	m_indices = (dgInt32*) dgMallocStack (sizeof (dgInt32) * m_indexCount);
+	dgStack<dgVector> tmpVertexArrayCont(builder.m_vertexCount + builder.m_normalCount + builder.m_faceCount * 2 + 4);
+
+	dgVector* const tmpVertexArray = &tmpVertexArrayCont[0];
+	for (dgInt32 i = 0; i < builder.m_vertexCount; i ++) {
+		tmpVertexArray[i] = builder.m_vertexPoints[i];
+	}
+
+	for (dgInt32 i = 0; i < builder.m_normalCount; i ++) {
+		tmpVertexArray[i + builder.m_vertexCount] = builder.m_normalPoints[i];
+	}
+
+	const dgInt32* const indices = &builder.m_vertexIndex[0];
+	dgStack<dgNodeBuilder> constructor (builder.m_faceCount * 2 + 16); 
+
+	dgInt32 polygonIndex = 0;
+	dgInt32 allocatorIndex = 0;
+	if (builder.m_faceCount == 1) {
+		dgInt32 indexCount = builder.m_faceVertexCount[0] - 1;
+		new (&constructor[allocatorIndex]) dgNodeBuilder (&tmpVertexArray[0], 0, indexCount, &indices[0]);
+		allocatorIndex ++;
+	}
+	for (dgInt32 i = 0; i < builder.m_faceCount; i ++) {
+		dgInt32 indexCount = builder.m_faceVertexCount[i] - 1;
+		new (&constructor[allocatorIndex]) dgNodeBuilder (&tmpVertexArray[0], i, indexCount, &indices[polygonIndex]);
+		allocatorIndex ++;
+		polygonIndex += (indexCount + 1);
+	}
+
+	dgStack<dgNodeBuilder*> boxArray (allocatorIndex);
+	dgVector center0 (dgFloat32 (1.0e15f));
+	dgVector center1 (-dgFloat32 (1.0e15f));
+	for (dgInt32 i = 0; i < allocatorIndex; i ++) {
+		boxArray[i] = &constructor[i];
+		center0 = center0.GetMin (constructor[i].m_origin);
+		center1 = center1.GetMax (constructor[i].m_origin);
+	}
+
+	dgBuildRange range;
+	range.m_center0 = center0;
+	range.m_center1 = center1;
+	range.m_boxArray = &boxArray[0];
+	range.m_nodePool = &constructor[allocatorIndex];
+	range.m_node = NULL;
+	range.m_threadPool = threadPool;
+	range.m_firstBox = 0;
+	range.m_lastBox = allocatorIndex - 1;
+	if (threadPool) {
+		threadPool->QueueJob (BuildTopDownKernel, &range, this);
+		threadPool->SynchronizationBarrier();
+	} else {
+		BuildTopDown (range, 0);
+	}
+	dgNodeBuilder* root = range.m_node;
+
+	// the binned surface area split already produces a better tree than the local rotations 
+	// of the old median split build, so the tree is emitted as it comes out of the builder
+	dgAssert (root);
+	dgAssert (!root->m_left || root->m_right);
+
+	dgList<dgNodeBuilder*> list (builder.m_allocator);
+
+	list.Append(root);
+	dgInt32 nodeIndex = 0;
+	while (list.GetCount())  {
+		dgNodeBuilder* const node = list.GetFirst()->GetInfo();
+		list.Remove(list.GetFirst());
+
+		if (node->m_left) {
+			node->m_enumeration = nodeIndex;
+			nodeIndex ++;
+			dgAssert (node->m_right);
+			list.Append(node->m_left);
+			list.Append(node->m_right);
+		}
+	}
+	dgAssert(!list.GetCount());
+
+	dgInt32 aabbBase = builder.m_vertexCount + builder.m_normalCount;
+
+
+	dgVector* const aabbPoints = &tmpVertexArray[aabbBase];
+
+
+	dgInt32 vertexIndex = 0;
+	dgInt32 aabbNodeIndex = 0;
+	list.Append(root);
+	dgInt32 indexMap = 0;
+	while (list.GetCount())  {
+
+		dgNodeBuilder* const node = list.GetFirst()->GetInfo();
+		list.Remove(list.GetFirst());
+
+		if (node->m_enumeration >= 0) {
+			dgAssert (node->m_left);
+			dgAssert (node->m_right);
+			dgNode& aabbNode = m_aabb[aabbNodeIndex];
+			aabbNodeIndex ++;
+			dgAssert (aabbNodeIndex <= m_nodesCount);
+
+			if (node->m_parent) {
+				if (node->m_parent->m_left == node) {
+					m_aabb[node->m_parent->m_enumeration].m_left = dgNode::dgLeafNodePtr (dgUnsigned32 (&m_aabb[node->m_enumeration] - m_aabb));
+				} else {
+					dgAssert (node->m_parent->m_right == node);
+					m_aabb[node->m_parent->m_enumeration].m_right = dgNode::dgLeafNodePtr (dgUnsigned32 (&m_aabb[node->m_enumeration] - m_aabb));
+				}
+			}
+
+			aabbPoints[vertexIndex + 0] = node->m_p0;
+			aabbPoints[vertexIndex + 1] = node->m_p1;
+
+			aabbNode.m_indexBox0 = aabbBase + vertexIndex;
+			aabbNode.m_indexBox1 = aabbBase + vertexIndex + 1;
+
+			vertexIndex += 2;
+
+		} else {
+			dgAssert (!node->m_left);
+			dgAssert (!node->m_right);
+
+			if (node->m_parent) {
+				if (node->m_parent->m_left == node) {
+					m_aabb[node->m_parent->m_enumeration].m_left = dgNode::dgLeafNodePtr (node->m_indexCount, indexMap);
+				} else {
+					dgAssert (node->m_parent->m_right == node);
+					m_aabb[node->m_parent->m_enumeration].m_right = dgNode::dgLeafNodePtr (node->m_indexCount, indexMap);
+				}
+			}
+
+			// index format i0, i1, i2, ... , id, normal, e0Normal, e1Normal, e2Normal, ..., faceSize
+			for (dgInt32 j = 0; j < node->m_indexCount; j ++) {
+				m_indices[indexMap + j] = node->m_faceIndices[j];
+				m_indices[indexMap + j + node->m_indexCount + 2] = -1;
+			}
+
+			// face attribute
+			m_indices[indexMap + node->m_indexCount] = node->m_faceIndices[node->m_indexCount];
+			// face normal
+			m_indices[indexMap + node->m_indexCount + 1] = builder.m_vertexCount + builder.m_normalIndex[node->m_faceIndex];
+			// face size
+			m_indices[indexMap + node->m_indexCount * 2 + 2] = dgInt32 (CalculateFaceMaxSize (&tmpVertexArray[0], node->m_indexCount, node->m_faceIndices));
+
+			indexMap += node->m_indexCount * 2 + 3;
+		}
+
+		if (node->m_left) {
+			dgAssert (node->m_right);
+			list.Append(node->m_left);
+			list.Append(node->m_right);
+		}
+	}
+
+	dgStack<dgInt32> indexArray (vertexIndex);
+	dgInt32 aabbPointCount = dgVertexListToIndexList (&aabbPoints[0].m_x, sizeof (dgVector), sizeof (dgTriplex), 0, vertexIndex, &indexArray[0], dgFloat32 (1.0e-6f));
+
+	m_vertexCount = aabbBase + aabbPointCount;
+	m_localVertex = (dgFloat32*) dgMallocStack (sizeof (dgTriplex) * m_vertexCount);
+
+	dgTriplex* const dstPoints = (dgTriplex*)m_localVertex;
+	for (dgInt32 i = 0; i < m_vertexCount; i ++) {
+		dstPoints[i].m_x = tmpVertexArray[i].m_x;
+		dstPoints[i].m_y = tmpVertexArray[i].m_y;
+		dstPoints[i].m_z = tmpVertexArray[i].m_z;
+	}
+
+	for (dgInt32 i = 0; i < m_nodesCount; i ++) {
+		dgNode& box = m_aabb[i];
+
+		dgInt32 j = box.m_indexBox0 - aabbBase;
+		box.m_indexBox0 = indexArray[j] + aabbBase;
+
+		j = box.m_indexBox1 - aabbBase;
+		box.m_indexBox1 = indexArray[j] + aabbBase;
+	}
+
+	if (builder.m_faceCount == 1) {
+		m_aabb[0].m_right = dgNode::dgLeafNodePtr (0, 0);
+	}
+//	CalculateAdjacendy();
+}
+
+
+void dgAABBPolygonSoup::GetCompactChildBox (const dgNode::dgLeafNodePtr& child, dgVector& p0, dgVector& p1) const
+{
+	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+	if (child.IsLeaf()) {
+		dgInt32 vCount = child.GetCount();
+		if (vCount) {
+			const dgInt32* const indices = &m_indices[child.GetIndex()];
+			p0 = dgVector ( dgFloat32 (1.0e15f));
+			p1 = dgVector (-dgFloat32 (1.0e15f));
+			for (dgInt32 i = 0; i < vCount; i ++) {
+				const dgTriplex& q = vertexArray[indices[i]];
+				dgVector p (q.m_x, q.m_y, q.m_z, dgFloat32 (0.0f));
+				p0 = p0.GetMin(p);
+				p1 = p1.GetMax(p);
+			}
+			// same padding as the face boxes of the tree builder
+			p0 = (p0 - dgVector (dgFloat32 (1.0e-3f))) & dgVector::m_triplexMask;
+			p1 = (p1 + dgVector (dgFloat32 (1.0e-3f))) & dgVector::m_triplexMask;
+		} else {
+			p0 = dgVector (dgFloat32 (0.0f));
+			p1 = dgVector (dgFloat32 (0.0f));
+		}
+	} else {
+		const dgNode* const node = child.GetNode(m_aabb);
+		const dgTriplex& q0 = vertexArray[node->m_indexBox0];
+		const dgTriplex& q1 = vertexArray[node->m_indexBox1];
+		p0 = dgVector (q0.m_x, q0.m_y, q0.m_z, dgFloat32 (0.0f));
+		p1 = dgVector (q1.m_x, q1.m_y, q1.m_z, dgFloat32 (0.0f));
+	}
+}
+
+dgInt32 dgAABBPolygonSoup::GetCompactSlotsCost (const dgNode::dgLeafNodePtr& child, const dgInt32* const nodeCost, dgInt32 slots) const
+{
+	if (child.IsLeaf()) {
+		return (slots == 1) ? 0 : DG_COMPACT_NODE_MAX_COST;
+	}
+	return nodeCost[child.m_node * 4 + slots - 1];
+}
+
+dgInt32 dgAABBPolygonSoup::GetCompactSlotsSplit (const dgNode* const node, const dgInt32* const nodeCost, dgInt32 slots) const
+{
+	dgInt32 split = 1;
+	dgInt32 minCost = DG_COMPACT_NODE_MAX_COST;
+	for (dgInt32 i = 1; i < slots; i ++) {
+		dgInt32 cost = GetCompactSlotsCost (node->m_left, nodeCost, i) + GetCompactSlotsCost (node->m_right, nodeCost, slots - i);
+		if (cost < minCost) {
+			split = i;
+			minCost = cost;
+		}
+	}
+	return split;
+}
+
+void dgAABBPolygonSoup::CollectCompactChildren (const dgNode* const node, const dgInt32* const nodeCost, dgInt32 slots, dgNode::dgLeafNodePtr* const children, dgInt32& count) const
+{
+	dgInt32 split = GetCompactSlotsSplit (node, nodeCost, slots);
+	if (split == 1) {
+		children[count] = node->m_left;
+		count ++;
+	} else {
+		CollectCompactChildren (node->m_left.GetNode(m_aabb), nodeCost, split, children, count);
+	}
+	if ((slots - split) == 1) {
+		children[count] = node->m_right;
+		count ++;
+	} else {
+		CollectCompactChildren (node->m_right.GetNode(m_aabb), nodeCost, slots - split, children, count);
+	}
+}
+
+dgInt32 dgAABBPolygonSoup::BuildCompactNode (const dgNode* const node, const dgInt32* const nodeCost, const dgVector& p0, const dgVector& p1, dgInt32& nodeCount)
+{
+	// collapse the binary sub tree in the number of children that needs the fewest compact nodes below, the widest on ties
+	const dgInt32* const cost = &nodeCost[(node - m_aabb) * 4];
+	dgInt32 slots = 4;
+	for (dgInt32 i = 3; i >= 2; i --) {
+		if (cost[i - 1] < cost[slots - 1]) {
+			slots = i;
+		}
+	}
+
+	dgInt32 count = 0;
+	dgVector childP0[4];
+	dgVector childP1[4];
+	dgNode::dgLeafNodePtr children[4] = {node->m_left, node->m_right, node->m_left, node->m_right};
+	CollectCompactChildren (node, nodeCost, slots, children, count);
+	dgAssert (count == slots);
+	for (dgInt32 i = 0; i < count; i ++) {
+		GetCompactChildBox (children[i], childP0[i], childP1[i]);
+	}
+
+	dgInt32 nodeIndex = nodeCount;
+	nodeCount ++;
+	dgAssert (nodeCount <= m_nodesCount);
+	dgCompactNode& compactNode = m_compactNodes[nodeIndex];
+
+	const dgVector scale (dgCompactNode::GetScale (p0, p1));
+	for (dgInt32 i = 0; i < 4; i ++) {
+		if (i < count) {
+			compactNode.m_minX[i] = dgQuantizeCompactBound (childP0[i].m_x, p0.m_x, scale.m_x, 0);
+			compactNode.m_minY[i] = dgQuantizeCompactBound (childP0[i].m_y, p0.m_y, scale.m_y, 0);
+			compactNode.m_minZ[i] = dgQuantizeCompactBound (childP0[i].m_z, p0.m_z, scale.m_z, 0);
+			compactNode.m_maxX[i] = dgQuantizeCompactBound (childP1[i].m_x, p0.m_x, scale.m_x, 1);
+			compactNode.m_maxY[i] = dgQuantizeCompactBound (childP1[i].m_y, p0.m_y, scale.m_y, 1);
+			compactNode.m_maxZ[i] = dgQuantizeCompactBound (childP1[i].m_z, p0.m_z, scale.m_z, 1);
+			compactNode.m_child[i] = children[i];
+		} else {
+			compactNode.m_minX[i] = 0;
+			compactNode.m_minY[i] = 0;
+			compactNode.m_minZ[i] = 0;
+			compactNode.m_maxX[i] = 0;
+			compactNode.m_maxY[i] = 0;
+			compactNode.m_maxZ[i] = 0;
+			compactNode.m_child[i] = dgNode::dgLeafNodePtr (0, 0);
+		}
+	}
+
+	// children follow their parent, the sub trees are quantized in the decoded box of the child, as the traversal sees it
+	for (dgInt32 i = 0; i < count; i ++) {
+		if (!children[i].IsLeaf()) {
+			dgVector q0;
+			dgVector q1;
+			compactNode.GetChildBox (i, p0, scale, q0, q1);
+			dgAssert ((childP0[i] >= q0).GetSignMask() & (childP1[i] <= q1).GetSignMask() & 0x07);
+			dgInt32 childIndex = BuildCompactNode (children[i].GetNode(m_aabb), nodeCost, q0, q1, nodeCount);
+			compactNode.m_child[i] = dgNode::dgLeafNodePtr (dgUnsigned32 (childIndex));
+		}
+	}
+	return nodeIndex;
+}
+
+void dgAABBPolygonSoup::BuildCompactTree ()
+{
+	// a mapped soup is read only, the image must be compacted before it is saved
+	if (!m_aabb || m_mappedImage) {
+		return;
+	}
+
+	dgVector p0;
+	dgVector p1;
+	GetNodeAABB (m_aabb, p0, p1);
+	p0 = p0 & dgVector::m_triplexMask;
+	p1 = p1 & dgVector::m_triplexMask;
+	m_compactBox[0].m_x = p0.m_x;
+	m_compactBox[0].m_y = p0.m_y;
+	m_compactBox[0].m_z = p0.m_z;
+	m_compactBox[1].m_x = p1.m_x;
+	m_compactBox[1].m_y = p1.m_y;
+	m_compactBox[1].m_z = p1.m_z;
+
+	// the boxes of the binary nodes are the last vertices of the vertex array 
+	dgInt32 boxVertexBase = m_vertexCount;
+	for (dgInt32 i = 0; i < m_nodesCount; i ++) {
+		boxVertexBase = dgMin (boxVertexBase, m_aabb[i].m_indexBox0, m_aabb[i].m_indexBox1);
+	}
+
+	// fewest compact nodes needed under each binary node when it takes one to four children slots of its parent compact node.
+	// the binary nodes are enumerated breadth first, so the children are always resolved before their parent
+	dgStack<dgInt32> nodeCostPool (m_nodesCount * 4);
+	dgInt32* const nodeCost = &nodeCostPool[0];
+	for (dgInt32 i = m_nodesCount - 1; i >= 0; i --) {
+		const dgNode* const node = &m_aabb[i];
+		dgInt32* const cost = &nodeCost[i * 4];
+		cost[0] = DG_COMPACT_NODE_MAX_COST;
+		for (dgInt32 slots = 2; slots <= 4; slots ++) {
+			dgInt32 split = GetCompactSlotsSplit (node, nodeCost, slots);
+			cost[slots - 1] = GetCompactSlotsCost (node->m_left, nodeCost, split) + GetCompactSlotsCost (node->m_right, nodeCost, slots - split);
+			cost[0] = dgMin (cost[0], cost[slots - 1] + 1);
+		}
+	}
+
+	// each compact node replaces at least one binary node
+	dgInt32 nodeCount = 0;
+	m_compactNodes = (dgCompactNode*) dgMallocStack (sizeof (dgCompactNode) * m_nodesCount);
+	BuildCompactNode (m_aabb, nodeCost, p0, p1, nodeCount);
+
+	dgCompactNode* const compactNodes = (dgCompactNode*) dgMallocStack (sizeof (dgCompactNode) * nodeCount);
+	memcpy (compactNodes, m_compactNodes, sizeof (dgCompactNode) * nodeCount);
+	dgFreeStack (m_compactNodes);
+	m_compactNodes = compactNodes;
+	m_compactNodesCount = nodeCount;
+
+	dgFreeStack (m_aabb);
+	m_aabb = NULL;
+	m_nodesCount = 0;
+
+	if (boxVertexBase < m_vertexCount) {
+		dgFloat32* const localVertex = (dgFloat32*) dgMallocStack (sizeof (dgTriplex) * boxVertexBase);
+		memcpy (localVertex, m_localVertex, sizeof (dgTriplex) * boxVertexBase);
+		dgFreeStack (m_localVertex);
+		m_localVertex = localVertex;
+		m_vertexCount = boxVertexBase;
+	}
+}
+
+
+void dgAABBPolygonSoup::Serialize (dgSerialize callback, void* const userData) const
+{
+	callback (userData, &m_vertexCount, sizeof (dgInt32));
+	callback (userData, &m_indexCount, sizeof (dgInt32));
+	callback (userData, &m_nodesCount, sizeof (dgInt32));
+	callback (userData, &m_compactNodesCount, sizeof (dgInt32));
+	if (m_aabb) {
+		callback (userData,  m_localVertex, sizeof (dgTriplex) * m_vertexCount);
+		callback (userData,  m_indices, sizeof (dgInt32) * m_indexCount);
+		callback (userData, m_aabb, sizeof (dgNode) * m_nodesCount);
+	} else if (m_compactNodes) {
+		callback (userData,  m_localVertex, sizeof (dgTriplex) * m_vertexCount);
+		callback (userData,  m_indices, sizeof (dgInt32) * m_indexCount);
+		callback (userData, m_compactBox, sizeof (m_compactBox));
+		callback (userData, m_compactNodes, sizeof (dgCompactNode) * m_compactNodesCount);
+	}
+}
+
+void dgAABBPolygonSoup::Deserialize (dgDeserialize callback, void* const userData, dgInt32 revisionNumber)
+{
+	m_strideInBytes = sizeof (dgTriplex);
+	callback (userData, &m_vertexCount, sizeof (dgInt32));
+	callback (userData, &m_indexCount, sizeof (dgInt32));
+	callback (userData, &m_nodesCount, sizeof (dgInt32));
+	callback (userData, &m_compactNodesCount, sizeof (dgInt32));
+	if (revisionNumber <= m_prePolygonSoupCompactRevision) {
+		// older revisions wrote the node count twice
+		m_compactNodesCount = 0;
+	}
+
+	m_localVertex = NULL;
+	m_indices = NULL;
+	m_aabb = NULL;
+	m_compactNodes = NULL;
+	if (m_vertexCount) {
+		m_localVertex = (dgFloat32*) dgMallocStack (sizeof (dgTriplex) * m_vertexCount);
+		m_indices = (dgInt32*) dgMallocStack (sizeof (dgInt32) * m_indexCount);
+		callback (userData, m_localVertex, sizeof (dgTriplex) * m_vertexCount);
+		callback (userData, m_indices, sizeof (dgInt32) * m_indexCount);
+
+		if (m_compactNodesCount) {
+			m_compactNodes = (dgCompactNode*) dgMallocStack (sizeof (dgCompactNode) * m_compactNodesCount);
+			callback (userData, m_compactBox, sizeof (m_compactBox));
+			callback (userData, m_compactNodes, sizeof (dgCompactNode) * m_compactNodesCount);
+		} else {
+			m_aabb = (dgNode*) dgMallocStack (sizeof (dgNode) * m_nodesCount);
+			callback (userData, m_aabb, sizeof (dgNode) * m_nodesCount);
+		}
+	}
+}
+
+
+bool dgAABBPolygonSoup::IsValidImage (const void* const image, dgInt32 sizeInBytes)
+{
+	if (!image || (sizeInBytes < dgInt32 (sizeof (dgImageHeader))) || (((size_t) image) & (sizeof (dgVector) - 1))) {
+		return false;
+	}
+	const dgImageHeader* const header = (const dgImageHeader*) image;
+	return header->IsValid (sizeInBytes);
+}
+
+void dgAABBPolygonSoup::SerializeImage (dgSerialize callback, void* const userData) const
+{
+	dgImageHeader header;
+	header.Init (*this);
+
+	callback (userData, &header, sizeof (dgImageHeader));
+	dgInt32 position = sizeof (dgImageHeader);
+	header.WriteSection (callback, userData, position, header.m_vertexOffset, m_localVertex, header.m_vertexCount * header.m_triplexSize);
+	header.WriteSection (callback, userData, position, header.m_indexOffset, m_indices, header.m_indexCount * dgInt32 (sizeof (dgInt32)));
+	header.WriteSection (callback, userData, position, header.m_nodesOffset, m_aabb ? (void*) m_aabb : (void*) m_compactNodes, header.m_nodesCount * header.m_nodeSize + header.m_compactNodesCount * header.m_compactNodeSize);
+	header.WriteSection (callback, userData, position, header.m_imageSize, NULL, 0);
+	dgAssert (position == header.m_imageSize);
+}
+
+void dgAABBPolygonSoup::CreateFromImage (const void* const image)
+{
+	dgAssert (!m_mappedImage);
+	dgAssert (!m_localVertex && !m_indices && !m_aabb && !m_compactNodes);
+
+	const dgImageHeader* const header = (const dgImageHeader*) image;
+	dgAssert (header->IsValid (header->m_imageSize));
+
+	// the arrays are used in place, the image must stay mapped and unchanged for the life of the soup
+	dgInt8* const base = (dgInt8*) image;
+	m_mappedImage = image;
+	m_strideInBytes = sizeof (dgTriplex);
+	m_vertexCount = header->m_vertexCount;
+	m_indexCount = header->m_indexCount;
+	m_nodesCount = header->m_nodesCount;
+	m_compactNodesCount = header->m_compactNodesCount;
+	m_compactBox[0] = header->m_compactBox[0];
+	m_compactBox[1] = header->m_compactBox[1];
+	if (m_vertexCount) {
+		m_localVertex = (dgFloat32*) &base[header->m_vertexOffset];
+		m_indices = (dgInt32*) &base[header->m_indexOffset];
+		if (m_compactNodesCount) {
+			m_compactNodes = (dgCompactNode*) &base[header->m_nodesOffset];
+		} else {
+			m_aabb = (dgNode*) &base[header->m_nodesOffset];
+		}
+	}
+}
+
+void dgAABBPolygonSoup::ReleaseImage ()
+{
+	// the arrays of a mapped soup belong to the application image, they are dropped but not freed 
+	if (m_mappedImage) {
+		m_mappedImage = NULL;
+		m_localVertex = NULL;
+		m_indices = NULL;
+		m_aabb = NULL;
+		m_compactNodes = NULL;
+		m_vertexCount = 0;
+		m_indexCount = 0;
+		m_nodesCount = 0;
+		m_compactNodesCount = 0;
+	}
+}
+
+
+dgVector dgAABBPolygonSoup::ForAllSectorsSupportVectex (const dgVector& dir) const
+{
+	if (m_compactNodes) {
+		return ForAllSectorsSupportVectexCompact (dir);
+	}
+
+	dgVector supportVertex (dgFloat32 (0.0f));
+	if (m_aabb) {
+		dgFloat32 aabbProjection[DG_STACK_DEPTH];
+		const dgNode *stackPool[DG_STACK_DEPTH];
+
+		dgInt32 stack = 1;
+		stackPool[0] = m_aabb;
+		aabbProjection[0] = dgFloat32 (1.0e10f);
+		const dgTriplex* const boxArray = (dgTriplex*)m_localVertex;
+		
+
+		dgFloat32 maxProj = dgFloat32 (-1.0e20f); 
+		dgInt32 ix = (dir[0] > dgFloat32 (0.0f)) ? 1 : 0;
+		dgInt32 iy = (dir[1] > dgFloat32 (0.0f)) ? 1 : 0;
+		dgInt32 iz = (dir[2] > dgFloat32 (0.0f)) ? 1 : 0;
+
+		while (stack) {
+			dgFloat32 boxSupportValue;
+
+			stack--;
+			boxSupportValue = aabbProjection[stack];
+			if (boxSupportValue > maxProj) {
+				dgFloat32 backSupportDist = dgFloat32 (0.0f);
+				dgFloat32 frontSupportDist = dgFloat32 (0.0f);
+				const dgNode* const me = stackPool[stack];
+				if (me->m_left.IsLeaf()) {
+					backSupportDist = dgFloat32 (-1.0e20f);
+					dgInt32 index = dgInt32 (me->m_left.GetIndex());
+					dgInt32 vCount = me->m_left.GetCount();
+					dgVector vertex (dgFloat32 (0.0f));
+					for (dgInt32 j = 0; j < vCount; j ++) {
+						dgInt32 i0 = m_indices[index + j] * dgInt32 (sizeof (dgTriplex) / sizeof (dgFloat32));
+						dgVector p (&boxArray[i0].m_x);
+						dgFloat32 dist = p % dir;
+						if (dist > backSupportDist) {
+							backSupportDist = dist;
+							vertex = p;
+						}
+					}
+
+					if (backSupportDist > maxProj) {
+						maxProj = backSupportDist;
+						supportVertex = vertex; 
+					}
+
+				} else {
+					dgVector box[2];
+					const dgNode* const node = me->m_left.GetNode(m_aabb);
+					box[0].m_x = boxArray[node->m_indexBox0].m_x;
+					box[0].m_y = boxArray[node->m_indexBox0].m_y;
+					box[0].m_z = boxArray[node->m_indexBox0].m_z;
+					box[1].m_x = boxArray[node->m_indexBox1].m_x;
+					box[1].m_y = boxArray[node->m_indexBox1].m_y;
+					box[1].m_z = boxArray[node->m_indexBox1].m_z;
+
+					dgVector supportPoint (box[ix].m_x, box[iy].m_y, box[iz].m_z, dgFloat32 (0.0));
+					backSupportDist = supportPoint % dir;
+				}
+
+				if (me->m_right.IsLeaf()) {
+					frontSupportDist = dgFloat32 (-1.0e20f);
+					dgInt32 index = dgInt32 (me->m_right.GetIndex());
+					dgInt32 vCount = me->m_right.GetCount();
+					dgVector vertex (dgFloat32 (0.0f));
+					for (dgInt32 j = 0; j < vCount; j ++) {
+						dgInt32 i0 = m_indices[index + j] * dgInt32 (sizeof (dgTriplex) / sizeof (dgFloat32));
+						dgVector p (&boxArray[i0].m_x);
+						dgFloat32 dist = p % dir;
+						if (dist > frontSupportDist) {
+							frontSupportDist = dist;
+							vertex = p;
+						}
+					}
+					if (frontSupportDist > maxProj) {
+						maxProj = frontSupportDist;
+						supportVertex = vertex; 
+					}
+
+				} else {
+					dgVector box[2];
+					const dgNode* const node = me->m_right.GetNode(m_aabb);
+					box[0].m_x = boxArray[node->m_indexBox0].m_x;
+					box[0].m_y = boxArray[node->m_indexBox0].m_y;
+					box[0].m_z = boxArray[node->m_indexBox0].m_z;
+					box[1].m_x = boxArray[node->m_indexBox1].m_x;
+					box[1].m_y = boxArray[node->m_indexBox1].m_y;
+					box[1].m_z = boxArray[node->m_indexBox1].m_z;
+
+					dgVector supportPoint (box[ix].m_x, box[iy].m_y, box[iz].m_z, dgFloat32 (0.0f));
+					frontSupportDist = supportPoint % dir;
+				}
+
+				if (frontSupportDist >= backSupportDist) {
+					if (!me->m_left.IsLeaf()) {
+						aabbProjection[stack] = backSupportDist;
+						stackPool[stack] = me->m_left.GetNode(m_aabb);
+						stack++;
+					}
+
+					if (!me->m_right.IsLeaf()) {
+						aabbProjection[stack] = frontSupportDist;
+						stackPool[stack] = me->m_right.GetNode(m_aabb);
+						stack++;
+					}
+
+				} else {
+
+					if (!me->m_right.IsLeaf()) {
+						aabbProjection[stack] = frontSupportDist;
+						stackPool[stack] = me->m_right.GetNode(m_aabb);
+						stack++;
+					}
+
+					if (!me->m_left.IsLeaf()) {
+						aabbProjection[stack] = backSupportDist;
+						stackPool[stack] = me->m_left.GetNode(m_aabb);
+						stack++;
+					}
+				}
+			}
+		}
+	}
+	return supportVertex;
+}
+
+
+void dgAABBPolygonSoup::ForAllSectorsRayHit (const dgFastRayTest& raySrc, dgFloat32 maxParam, dgRayIntersectCallback callback, void* const context) const
+{
+	if (m_compactNodes) {
+		ForAllSectorsRayHitCompact (raySrc, maxParam, callback, context);
+		return;
+	}
+
+	const dgNode *stackPool[DG_STACK_DEPTH];
+	dgFloat32 distance[DG_STACK_DEPTH];
+	dgFastRayTest ray (raySrc);
+
+	dgInt32 stack = 1;
+	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+
+	stackPool[0] = m_aabb;
+	distance[0] = m_aabb->RayDistance(ray, vertexArray);
+	while (stack) {
+		stack --;
+		dgFloat32 dist = distance[stack];
+		if (dist > maxParam) {
+			break;
+		} else {
+			const dgNode *const me = stackPool[stack];
+			if (me->m_left.IsLeaf()) {
+				dgInt32 vCount = me->m_left.GetCount();
+				if (vCount > 0) {
+					dgInt32 index = dgInt32 (me->m_left.GetIndex());
+					dgFloat32 param = callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), &m_indices[index], vCount);
+					dgAssert (param >= dgFloat32 (0.0f));
+					if (param < maxParam) {
+						maxParam = param;
+						if (maxParam == dgFloat32 (0.0f)) {
+							break;
+						}
+					}
+				}
+
+			} else {
+				const dgNode* const node = me->m_left.GetNode(m_aabb);
+				dgFloat32 dist = node->RayDistance(ray, vertexArray);
+				if (dist < maxParam) {
+					dgInt32 j = stack;
+					for ( ; j && (dist > distance[j - 1]); j --) {
+						stackPool[j] = stackPool[j - 1];
+						distance[j] = distance[j - 1];
+					}
+					dgAssert (stack < DG_STACK_DEPTH);
+					stackPool[j] = node;
+					distance[j] = dist;
+					stack++;
+				}
+			}
+
+			if (me->m_right.IsLeaf()) {
+				dgInt32 vCount = me->m_right.GetCount();
+				if (vCount > 0) {
+					dgInt32 index = dgInt32 (me->m_right.GetIndex());
+					dgFloat32 param = callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), &m_indices[index], vCount);
+					dgAssert (param >= dgFloat32 (0.0f));
+					if (param < maxParam) {
+						maxParam = param;
+						if (maxParam == dgFloat32 (0.0f)) {
+							break;
+						}
+					}
+				}
+
+			} else {
+				const dgNode* const node = me->m_right.GetNode(m_aabb);
+				dgFloat32 dist = node->RayDistance(ray, vertexArray);
+				if (dist < maxParam) {
+					dgInt32 j = stack;
+					for ( ; j && (dist > distance[j - 1]); j --) {
+						stackPool[j] = stackPool[j - 1];
+						distance[j] = distance[j - 1];
+					}
+					dgAssert (stack < DG_STACK_DEPTH);
+					stackPool[j] = node;
+					distance[j] = dist;
+					stack++;
+				}
+			}
+		}
+	}
+}
+
+
+void dgAABBPolygonSoup::ForAllSectors (const dgFastAABBInfo& obbAabbInfo, const dgVector& boxDistanceTravel, dgFloat32 m_maxT, dgAABBIntersectCallback callback, void* const context) const
+{
+
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][0]) - obbAabbInfo.m_absDir[0][0]) < dgFloat32 (1.0e-4f));
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[1][1]) - obbAabbInfo.m_absDir[1][1]) < dgFloat32 (1.0e-4f));
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[2][2]) - obbAabbInfo.m_absDir[2][2]) < dgFloat32 (1.0e-4f));
+
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][1]) - obbAabbInfo.m_absDir[1][0]) < dgFloat32 (1.0e-4f));
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[0][2]) - obbAabbInfo.m_absDir[2][0]) < dgFloat32 (1.0e-4f));
+	dgAssert (dgAbsf(dgAbsf(obbAabbInfo[1][2]) - obbAabbInfo.m_absDir[2][1]) < dgFloat32 (1.0e-4f));
+
+	if (m_compactNodes) {
+		ForAllSectorsCompact (obbAabbInfo, boxDistanceTravel, m_maxT, callback, context);
+	} else if (m_aabb) {
+		dgFloat32 distance[DG_STACK_DEPTH];
+		const dgNode* stackPool[DG_STACK_DEPTH];
+
+		const dgInt32 stride = sizeof (dgTriplex) / sizeof (dgFloat32);
+		const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+
+		if ((boxDistanceTravel % boxDistanceTravel) < dgFloat32 (1.0e-8f)) {
+
+			dgInt32 stack = 1;
+			stackPool[0] = m_aabb;
+			distance[0] = m_aabb->BoxPenetration(obbAabbInfo, vertexArray);
+			while (stack) {
+				stack --;
+				dgFloat32 dist = distance[stack];
+				if (dist > dgFloat32 (0.0f)) {
+					const dgNode* const me = stackPool[stack];
+					if (me->m_left.IsLeaf()) {
+						dgInt32 index = dgInt32 (me->m_left.GetIndex());
+						dgInt32 vCount = me->m_left.GetCount();
+						if (vCount > 0) {
+							const dgInt32* const indices = &m_indices[index];
+							dgInt32 normalIndex = indices[vCount + 1];
+							dgVector faceNormal (&vertexArray[normalIndex].m_x);
+							dgFloat32 dist1 = obbAabbInfo.PolygonBoxDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x);
+							if (dist1 > dgFloat32 (0.0f)) {
+								dgAssert (vCount >= 3);
+								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, dist1) == t_StopSearh) {
+									return;
+								}
+							}
+						}
+
+					} else {
+						const dgNode* const node = me->m_left.GetNode(m_aabb);
+						dgFloat32 dist = node->BoxPenetration(obbAabbInfo, vertexArray);
+						if (dist > dgFloat32 (0.0f)) {
+							dgInt32 j = stack;
+							for ( ; j && (dist > distance[j - 1]); j --) {
+								stackPool[j] = stackPool[j - 1];
+								distance[j] = distance[j - 1];
+							}
+							dgAssert (stack < DG_STACK_DEPTH);
+							stackPool[j] = node;
+							distance[j] = dist;
+							stack++;
+						}
+					}
+
+					if (me->m_right.IsLeaf()) {
+						dgInt32 index = dgInt32 (me->m_right.GetIndex());
+						dgInt32 vCount = me->m_right.GetCount();
+						if (vCount > 0) {
+							const dgInt32* const indices = &m_indices[index];
+							dgInt32 normalIndex = indices[vCount + 1];
+							dgVector faceNormal (&vertexArray[normalIndex].m_x);
+							dgFloat32 dist1 = obbAabbInfo.PolygonBoxDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x);
+							if (dist1 > dgFloat32 (0.0f)) {
+								dgAssert (vCount >= 3);
+								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, dist1) == t_StopSearh) {
+									return;
+								}
+							}
+						}
+
+					} else {
+						const dgNode* const node = me->m_right.GetNode(m_aabb);
+						dgFloat32 dist = node->BoxPenetration(obbAabbInfo, vertexArray);
+						if (dist > dgFloat32 (0.0f)) {
+							dgInt32 j = stack;
+							for ( ; j && (dist > distance[j - 1]); j --) {
+								stackPool[j] = stackPool[j - 1];
+								distance[j] = distance[j - 1];
+							}
+							dgAssert (stack < DG_STACK_DEPTH);
+							stackPool[j] = node;
+							distance[j] = dist;
+							stack++;
+						}
+					}
+				}
+			}
+
+		} else {
+			dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), boxDistanceTravel);
+			dgFastRayTest obbRay (dgVector (dgFloat32 (0.0f)), obbAabbInfo.UnrotateVector(boxDistanceTravel));
+			dgInt32 stack = 1;
+			stackPool[0] = m_aabb;
+			distance [0] = m_aabb->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
+
+			while (stack) {
+				stack --;
+				const dgFloat32 dist = distance[stack];
+				const dgNode* const me = stackPool[stack];
+				if (dist < dgFloat32 (1.0f)) {
+
+					if (me->m_left.IsLeaf()) {
+						dgInt32 index = dgInt32 (me->m_left.GetIndex());
+						dgInt32 vCount = me->m_left.GetCount();
+						if (vCount > 0) {
+							const dgInt32* const indices = &m_indices[index];
+							dgInt32 normalIndex = indices[vCount + 1];
+							dgVector faceNormal (&vertexArray[normalIndex].m_x);
+							dgFloat32 hitDistance = obbAabbInfo.PolygonBoxRayDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x, ray);
+							if (hitDistance < dgFloat32 (1.0f)) {
+								dgAssert (vCount >= 3);
+								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, hitDistance) == t_StopSearh) {
+									return;
+								}
+							}
+						}
+
+					} else {
+						const dgNode* const node = me->m_left.GetNode(m_aabb);
+						dgFloat32 dist = node->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
+						if (dist < dgFloat32 (1.0f)) {
+							dgInt32 j = stack;
+							for ( ; j && (dist > distance[j - 1]); j --) {
+								stackPool[j] = stackPool[j - 1];
+								distance[j] = distance[j - 1];
+							}
+							dgAssert (stack < DG_STACK_DEPTH);
+							stackPool[j] = node;
+							distance[j] = dist;
+							stack++;
+						}
+					}
+
+					if (me->m_right.IsLeaf()) {
+						dgInt32 index = dgInt32 (me->m_right.GetIndex());
+						dgInt32 vCount = me->m_right.GetCount();
+						if (vCount > 0) {
+							const dgInt32* const indices = &m_indices[index];
+							dgInt32 normalIndex = indices[vCount + 1];
+							dgVector faceNormal (&vertexArray[normalIndex].m_x);
+							dgFloat32 hitDistance = obbAabbInfo.PolygonBoxRayDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x, ray);
+							if (hitDistance < dgFloat32 (1.0f)) {
+								dgAssert (vCount >= 3);
+								if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, hitDistance) == t_StopSearh) {
+									return;
+								}
+							}
+						}
+
+					} else {
+						const dgNode* const node = me->m_right.GetNode(m_aabb);
+						dgFloat32 dist = node->BoxIntersect (ray, obbRay, obbAabbInfo, vertexArray);
+						if (dist < dgFloat32 (1.0f)) {
+							dgInt32 j = stack;
+							for ( ; j && (dist > distance[j - 1]); j --) {
+								stackPool[j] = stackPool[j - 1];
+								distance[j] = distance[j - 1];
+							}
+							dgAssert (stack < DG_STACK_DEPTH);
+							stackPool[j] = node;
+							distance[j] = dist;
+							stack ++;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+
+dgVector dgAABBPolygonSoup::ForAllSectorsSupportVectexCompact (const dgVector& dir) const
+{
+	dgCompactNodeStackEntry stackPool[DG_STACK_DEPTH];
+	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+	const dgVector positive (dir > dgVector (dgFloat32 (0.0f)));
+
+	// the stack is sorted by the negated projection, so that the most extreme box is visited first
+	dgVector rootP0;
+	dgVector rootP1;
+	GetNodeAABB (m_compactNodes, rootP0, rootP1);
+	dgInt32 stack = dgPushCompactNode (stackPool, 0, 0, dgFloat32 (-1.0e10f), rootP0, rootP1);
+
+	dgFloat32 maxProj = dgFloat32 (-1.0e20f); 
+	dgVector supportVertex (dgFloat32 (0.0f));
+	while (stack) {
+		stack --;
+		const dgCompactNodeStackEntry entry (stackPool[stack]);
+		if (-entry.m_dist > maxProj) {
+			const dgCompactNode* const me = &m_compactNodes[entry.m_node];
+			const dgVector scale (dgCompactNode::GetScale (entry.m_p0, entry.m_p1));
+			for (dgInt32 i = 0; i < 4; i ++) {
+				const dgNode::dgLeafNodePtr& child = me->m_child[i];
+				if (child.IsLeaf()) {
+					dgInt32 index = dgInt32 (child.GetIndex());
+					dgInt32 vCount = child.GetCount();
+					for (dgInt32 j = 0; j < vCount; j ++) {
+						const dgTriplex& q = vertexArray[m_indices[index + j]];
+						dgVector p (q.m_x, q.m_y, q.m_z, dgFloat32 (0.0f));
+						dgFloat32 dist = p % dir;
+						if (dist > maxProj) {
+							maxProj = dist;
+							supportVertex = p;
+						}
+					}
+				} else {
+					dgVector p0;
+					dgVector p1;
+					me->GetChildBox (i, entry.m_p0, scale, p0, p1);
+					dgVector supportPoint ((p1 & positive) | p0.AndNot(positive));
+					dgFloat32 dist = supportPoint % dir;
+					if (dist > maxProj) {
+						stack = dgPushCompactNode (stackPool, stack, child.m_node, -dist, p0, p1);
+					}
+				}
+			}
+		}
+	}
+	return supportVertex;
+}
+
+
+void dgAABBPolygonSoup::ForAllSectorsRayHitCompact (const dgFastRayTest& raySrc, dgFloat32 maxParam, dgRayIntersectCallback callback, void* const context) const
+{
+	dgCompactNodeStackEntry stackPool[DG_STACK_DEPTH];
+	dgFastRayTest ray (raySrc);
+	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+
+	dgVector rootP0;
+	dgVector rootP1;
+	GetNodeAABB (m_compactNodes, rootP0, rootP1);
+	dgInt32 stack = dgPushCompactNode (stackPool, 0, 0, ray.BoxIntersect(rootP0, rootP1), rootP0, rootP1);
+	while (stack) {
+		stack --;
+		const dgCompactNodeStackEntry entry (stackPool[stack]);
+		if (entry.m_dist > maxParam) {
+			break;
+		}
+
+		// the leaf boxes are quantized too, so faces are also culled by their box before calling back
+		const dgCompactNode* const me = &m_compactNodes[entry.m_node];
+		const dgVector scale (dgCompactNode::GetScale (entry.m_p0, entry.m_p1));
+		for (dgInt32 i = 0; i < 4; i ++) {
+			const dgNode::dgLeafNodePtr& child = me->m_child[i];
+			if (!child.IsLeaf() || child.GetCount()) {
+				dgVector p0;
+				dgVector p1;
+				me->GetChildBox (i, entry.m_p0, scale, p0, p1);
+				dgFloat32 dist = ray.BoxIntersect(p0, p1);
+				if (dist < maxParam) {
+					if (child.IsLeaf()) {
+						dgInt32 index = dgInt32 (child.GetIndex());
+						dgFloat32 param = callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), &m_indices[index], child.GetCount());
+						dgAssert (param >= dgFloat32 (0.0f));
+						if (param < maxParam) {
+							maxParam = param;
+							if (maxParam == dgFloat32 (0.0f)) {
+								return;
+							}
+						}
+					} else {
+						stack = dgPushCompactNode (stackPool, stack, child.m_node, dist, p0, p1);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+void dgAABBPolygonSoup::ForAllSectorsCompact (const dgFastAABBInfo& obbAabbInfo, const dgVector& boxDistanceTravel, dgFloat32 m_maxT, dgAABBIntersectCallback callback, void* const context) const
+{
+	dgCompactNodeStackEntry stackPool[DG_STACK_DEPTH];
+	const dgInt32 stride = sizeof (dgTriplex) / sizeof (dgFloat32);
+	const dgTriplex* const vertexArray = (dgTriplex*) m_localVertex;
+
+	dgVector rootP0;
+	dgVector rootP1;
+	GetNodeAABB (m_compactNodes, rootP0, rootP1);
+
+	if ((boxDistanceTravel % boxDistanceTravel) < dgFloat32 (1.0e-8f)) {
+		dgInt32 stack = dgPushCompactNode (stackPool, 0, 0, dgNode::BoxPenetration (obbAabbInfo, rootP0, rootP1), rootP0, rootP1);
+		while (stack) {
+			stack --;
+			const dgCompactNodeStackEntry entry (stackPool[stack]);
+			if (entry.m_dist > dgFloat32 (0.0f)) {
+				const dgCompactNode* const me = &m_compactNodes[entry.m_node];
+				const dgVector scale (dgCompactNode::GetScale (entry.m_p0, entry.m_p1));
+				for (dgInt32 i = 0; i < 4; i ++) {
+					const dgNode::dgLeafNodePtr& child = me->m_child[i];
+					if (!child.IsLeaf() || child.GetCount()) {
+						dgVector p0;
+						dgVector p1;
+						me->GetChildBox (i, entry.m_p0, scale, p0, p1);
+						dgFloat32 dist = dgNode::BoxPenetration (obbAabbInfo, p0, p1);
+						if (dist > dgFloat32 (0.0f)) {
+							if (child.IsLeaf()) {
+								dgInt32 vCount = child.GetCount();
+								const dgInt32* const indices = &m_indices[child.GetIndex()];
+								dgInt32 normalIndex = indices[vCount + 1];
+								dgVector faceNormal (&vertexArray[normalIndex].m_x);
+								dgFloat32 dist1 = obbAabbInfo.PolygonBoxDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x);
+								if (dist1 > dgFloat32 (0.0f)) {
+									dgAssert (vCount >= 3);
+									if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, dist1) == t_StopSearh) {
+										return;
+									}
+								}
+							} else {
+								stack = dgPushCompactNode (stackPool, stack, child.m_node, dist, p0, p1);
+							}
+						}
+					}
+				}
+			}
+		}
+
+	} else {
+		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), boxDistanceTravel);
+		dgFastRayTest obbRay (dgVector (dgFloat32 (0.0f)), obbAabbInfo.UnrotateVector(boxDistanceTravel));
+		dgInt32 stack = dgPushCompactNode (stackPool, 0, 0, dgNode::BoxIntersect (ray, obbRay, obbAabbInfo, rootP0, rootP1), rootP0, rootP1);
+		while (stack) {
+			stack --;
+			const dgCompactNodeStackEntry entry (stackPool[stack]);
+			if (entry.m_dist < dgFloat32 (1.0f)) {
+				const dgCompactNode* const me = &m_compactNodes[entry.m_node];
+				const dgVector scale (dgCompactNode::GetScale (entry.m_p0, entry.m_p1));
+				for (dgInt32 i = 0; i < 4; i ++) {
+					const dgNode::dgLeafNodePtr& child = me->m_child[i];
+					if (!child.IsLeaf() || child.GetCount()) {
+						dgVector p0;
+						dgVector p1;
+						me->GetChildBox (i, entry.m_p0, scale, p0, p1);
+						dgFloat32 dist = dgNode::BoxIntersect (ray, obbRay, obbAabbInfo, p0, p1);
+						if (dist < dgFloat32 (1.0f)) {
+							if (child.IsLeaf()) {
+								dgInt32 vCount = child.GetCount();
+								const dgInt32* const indices = &m_indices[child.GetIndex()];
+								dgInt32 normalIndex = indices[vCount + 1];
+								dgVector faceNormal (&vertexArray[normalIndex].m_x);
+								dgFloat32 hitDistance = obbAabbInfo.PolygonBoxRayDistance (faceNormal, vCount, indices, stride, &vertexArray[0].m_x, ray);
+								if (hitDistance < dgFloat32 (1.0f)) {
+									dgAssert (vCount >= 3);
+									if (callback(context, &vertexArray[0].m_x, sizeof (dgTriplex), indices, vCount, hitDistance) == t_StopSearh) {
+										return;
+									}
+								}
+							} else {
+								stack = dgPushCompactNode (stackPool, stack, child.m_node, dist, p0, p1);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -1,472 +1,746 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgStdafx.h"
-#include "dgList.h"
-#include "dgDebug.h"
-#include "dgMemory.h"
-
-
-#ifdef _DEBUG
-dgInt32 m_threadSanityCheck = 0;
-#define DG_MEMORY_THREAD_SANITY_CHECK_LOCK()		\
-	dgAssert (!m_threadSanityCheck);				\
-	dgAtomicExchangeAndAdd(&m_threadSanityCheck, 1);
-	#define DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK()	  dgAtomicExchangeAndAdd(&m_threadSanityCheck, -1);	
-#else 
-	#define DG_MEMORY_THREAD_SANITY_CHECK_LOCK()
-	#define DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK()
-#endif
-
-class dgGlobalAllocator: public dgMemoryAllocator, public dgList<dgMemoryAllocator*>
-{
-	public:
-	dgGlobalAllocator ()
-		:dgMemoryAllocator (__malloc__, __free__), dgList<dgMemoryAllocator*> (NULL)
-	{
-		SetAllocator (this);
-	}
-
-	~dgGlobalAllocator ()
-	{
-		dgAssert (GetCount() == 0);
-	}
-
-	static void* dgApi __malloc__ (dgUnsigned32 size) 
-	{
-		return malloc (size);
-	}
-
-	static void dgApi __free__ (void* const ptr, dgUnsigned32 size)
-	{
-		free (ptr);
-	}
-
-	void operator delete (void* const ptr)
-	{
-		dgAssert (0);
-		//::delete (ptr);
-		free (ptr);
-	}
-
-
-	dgInt32 GetMemoryUsed () const
-	{
-		dgInt32 mem = m_memoryUsed;
-		for (dgList<dgMemoryAllocator*>::dgListNode* node = GetFirst(); node; node = node->GetNext()) {
-			mem += node->GetInfo()->GetMemoryUsed();
-		}
-		return mem;
-	}
-
-	static dgGlobalAllocator m_globalAllocator;
-};
-
-
-
-dgGlobalAllocator dgGlobalAllocator::m_globalAllocator;
-
-
-
-dgMemoryAllocator::dgMemoryAllocator ()
-{
-	m_memoryUsed = 0;
-	m_emumerator = 0;
-	SetAllocatorsCallback (dgGlobalAllocator::m_globalAllocator.m_malloc, dgGlobalAllocator::m_globalAllocator.m_free);
-	memset (m_memoryDirectory, 0, sizeof (m_memoryDirectory));
-	dgGlobalAllocator::m_globalAllocator.Append(this);
-}
-
-dgMemoryAllocator::dgMemoryAllocator (dgMemAlloc memAlloc, dgMemFree memFree)
-{
-	m_memoryUsed = 0;
-	m_emumerator = 0;
-	SetAllocatorsCallback (memAlloc, memFree);
-	memset (m_memoryDirectory, 0, sizeof (m_memoryDirectory));
-}
-
-
-dgMemoryAllocator::~dgMemoryAllocator  ()
-{
-	dgGlobalAllocator::m_globalAllocator.Remove(this);
-	dgAssert (m_memoryUsed == 0);
-}
-
-
-void *dgMemoryAllocator::operator new (size_t size) 
-{ 
-	return dgMallocStack(size);
-}
-
-void dgMemoryAllocator::operator delete (void* const ptr) 
-{ 
-	dgFreeStack(ptr); 
-}
-
-
-dgInt32 dgMemoryAllocator::GetMemoryUsed() const
-{
-	return m_memoryUsed;
-}
-
-void dgMemoryAllocator::SetAllocatorsCallback (dgMemAlloc memAlloc, dgMemFree memFree)
-{
-	m_free = memFree;
-	m_malloc = memAlloc;
-}
-
-
-
-void *dgMemoryAllocator::MallocLow (dgInt32 workingSize, dgInt32 alignment)
-{
-	dgAssert (alignment >= DG_MEMORY_GRANULARITY);
-	dgAssert (((-alignment) & (alignment - 1)) == 0);
-	dgInt32 size = workingSize + alignment * 2;
-	void* const ptr = m_malloc(dgUnsigned32 (size));
-	dgAssert (ptr);
-	dgUnsigned64 val = dgUnsigned64 (PointerToInt(ptr));
-	val = (val & dgUnsigned64(-alignment)) + alignment * 2;
-	void* const retPtr = IntToPointer (val);
-
-	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
-	info->SaveInfo(this, ptr, size, m_emumerator, workingSize);
-
-	dgAtomicExchangeAndAdd (&m_memoryUsed, size);
-	return retPtr;
-}
-
-void dgMemoryAllocator::FreeLow (void* const retPtr)
-{
-	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
-	dgAssert (info->m_allocator == this);
-
-	dgAtomicExchangeAndAdd (&m_memoryUsed, -info->m_size);
-
-#ifdef _DEBUG
-	memset (retPtr, 0, info->m_workingSize);
-#endif
-
-	m_free (info->m_ptr, dgUnsigned32 (info->m_size));
-}
-
-// alloca memory on pool that are quantized to DG_MEMORY_GRANULARITY
-// if memory size is larger than DG_MEMORY_BIN_ENTRIES then the memory is not placed into a pool
-void *dgMemoryAllocator::Malloc (dgInt32 memsize)
-{
-	dgAssert (dgInt32 (sizeof (dgMemoryCacheEntry) + sizeof (dgInt32) + sizeof(dgInt32)) <= DG_MEMORY_GRANULARITY);
-
-	dgInt32 size = memsize + DG_MEMORY_GRANULARITY - 1;
-	size &= (-DG_MEMORY_GRANULARITY);
-
-	dgInt32 paddedSize = size + DG_MEMORY_GRANULARITY; 
-	dgInt32 entry = paddedSize >> DG_MEMORY_GRANULARITY_BITS;	
-
-	void* ptr;
-	if (entry >= DG_MEMORY_BIN_ENTRIES) {
-		ptr = MallocLow (size);
-	} else {
-		if (!m_memoryDirectory[entry].m_cache) {
-			dgMemoryBin* const bin = (dgMemoryBin*) MallocLow (sizeof (dgMemoryBin));
-
-			dgInt32 count = dgInt32 (sizeof (bin->m_pool) / paddedSize);
-			bin->m_info.m_count = 0;
-			bin->m_info.m_totalCount = count;
-			bin->m_info.m_stepInBites = paddedSize;
-			bin->m_info.m_next = m_memoryDirectory[entry].m_first;
-			bin->m_info.m_prev = NULL;
-			if (bin->m_info.m_next) {
-				bin->m_info.m_next->m_info.m_prev = bin;
-			}
-
-			m_memoryDirectory[entry].m_first = bin;
-
-			dgInt8* charPtr = reinterpret_cast<dgInt8*>(bin->m_pool);
-			m_memoryDirectory[entry].m_cache = (dgMemoryCacheEntry*)charPtr;
-
-			for (dgInt32 i = 0; i < count; i ++) {
-				dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) charPtr;
-				cashe->m_next = (dgMemoryCacheEntry*) (charPtr + paddedSize);
-				cashe->m_prev = (dgMemoryCacheEntry*) (charPtr - paddedSize);
-				dgMemoryInfo* const info = ((dgMemoryInfo*) (charPtr + DG_MEMORY_GRANULARITY)) - 1;						
-				info->SaveInfo(this, bin, entry, m_emumerator, memsize);
-				charPtr += paddedSize;
-			}
-			dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (charPtr - paddedSize);
-			cashe->m_next = NULL;
-			m_memoryDirectory[entry].m_cache->m_prev = NULL;
-		}
-
-
-		dgAssert (m_memoryDirectory[entry].m_cache);
-
-		dgMemoryCacheEntry* const cashe = m_memoryDirectory[entry].m_cache;
-		m_memoryDirectory[entry].m_cache = cashe->m_next;
-		if (cashe->m_next) {
-			cashe->m_next->m_prev = NULL;
-		}
-
-		ptr = ((dgInt8*)cashe) + DG_MEMORY_GRANULARITY;
-
-		dgMemoryInfo* info;
-		info = ((dgMemoryInfo*) (ptr)) - 1;
-		dgAssert (info->m_allocator == this);
-
-		dgMemoryBin* const bin = (dgMemoryBin*) info->m_ptr;
-		bin->m_info.m_count ++;
-
-		#ifdef __TRACK_MEMORY_LEAKS__
-		m_leaklTracker.InsertBlock (dgInt32 (memsize), ptr);
-		#endif
-
-	}
-	return ptr;
-}
-
-// alloca memory on pool that are quantized to DG_MEMORY_GRANULARITY
-// if memory size is larger than DG_MEMORY_BIN_ENTRIES then the memory is not placed into a pool
-void dgMemoryAllocator::Free (void* const retPtr)
-{
-	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
-	dgAssert (info->m_allocator == this);
-
-	dgInt32 entry = info->m_size;
-
-	if (entry >= DG_MEMORY_BIN_ENTRIES) {
-		FreeLow (retPtr);
-	} else {
-		#ifdef __TRACK_MEMORY_LEAKS__
-		m_leaklTracker.RemoveBlock (retPtr);
-		#endif
-
-		dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (((char*)retPtr) - DG_MEMORY_GRANULARITY) ;
-
-		dgMemoryCacheEntry* const tmpCashe = m_memoryDirectory[entry].m_cache;
-		if (tmpCashe) {
-			dgAssert (!tmpCashe->m_prev);
-			tmpCashe->m_prev = cashe;
-		}
-		cashe->m_next = tmpCashe;
-		cashe->m_prev = NULL;
-
-		m_memoryDirectory[entry].m_cache = cashe;
-
-		dgMemoryBin* const bin = (dgMemoryBin *) info->m_ptr;
-
-		dgAssert (bin);
-#ifdef _DEBUG
-		dgAssert ((bin->m_info.m_stepInBites - DG_MEMORY_GRANULARITY) > 0);
-		memset (retPtr, 0, bin->m_info.m_stepInBites - DG_MEMORY_GRANULARITY);
-#endif
-
-		bin->m_info.m_count --;
-		if (bin->m_info.m_count == 0) {
-
-			dgInt32 count = bin->m_info.m_totalCount;
-			dgInt32 sizeInBytes = bin->m_info.m_stepInBites;
-			char* charPtr = bin->m_pool;
-			for (dgInt32 i = 0; i < count; i ++) {
-				dgMemoryCacheEntry* const tmpCashe = (dgMemoryCacheEntry*)charPtr;
-				charPtr += sizeInBytes;
-
-				if (tmpCashe == m_memoryDirectory[entry].m_cache) {
-					m_memoryDirectory[entry].m_cache = tmpCashe->m_next;
-				}
-
-				if (tmpCashe->m_prev) {
-					tmpCashe->m_prev->m_next = tmpCashe->m_next;
-				}
-
-				if (tmpCashe->m_next) {
-					tmpCashe->m_next->m_prev = tmpCashe->m_prev;
-				}
-			}
-
-			if (m_memoryDirectory[entry].m_first == bin) {
-				m_memoryDirectory[entry].m_first = bin->m_info.m_next;
-			}
-
-			if (bin->m_info.m_next) {
-				bin->m_info.m_next->m_info.m_prev = bin->m_info.m_prev;
-			}
-			if (bin->m_info.m_prev) {
-				bin->m_info.m_prev->m_info.m_next = bin->m_info.m_next;
-			}
-
-			FreeLow (bin);
-		}
-	}
-}
-
-
-
-	// this is a simple memory leak tracker, it uses an flat array of two megabyte indexed by a hatch code
-#ifdef __TRACK_MEMORY_LEAKS__
-
-dgMemoryAllocator::dgMemoryLeaksTracker::dgMemoryLeaksTracker()
-{
-	m_density = 0;
-	m_totalAllocatedBytes = 0; 
-	m_totalAllocatedCalls = 0; 
-	m_leakAllocationCounter = 0;
-
-	memset (m_pool, 0, sizeof (m_pool));
-}
-
-dgMemoryAllocator::dgMemoryLeaksTracker::~dgMemoryLeaksTracker ()
-{
-	if (m_totalAllocatedBytes) {
-		for (dgInt32 i = 0; i < DG_TRACK_MEMORY_LEAKS_ENTRIES; i ++) {
-			if (m_pool[i].m_ptr) {
-				dgTrace (("MemoryLeak: (0x%08x), size (%d)  allocationNumber (%d)\n", m_pool[i].m_ptr, m_pool[i].m_size, m_pool[i].m_allocationNumber));
-			}
-		}
-	}
-}
-
-void dgMemoryAllocator::dgMemoryLeaksTracker::InsertBlock (dgInt32 size, void* const ptr)
-{
-	dgUnsigned32 key = dgHash (&ptr, sizeof (void*));
-	dgUnsigned32 index = key % DG_TRACK_MEMORY_LEAKS_ENTRIES;
-
-	dgInt32 i = 0;
-	for (; m_pool[index].m_ptr && (i < DG_TRACK_MEMORY_LEAKS_ENTRIES); i ++) {
-		index = ((index + 1) < DG_TRACK_MEMORY_LEAKS_ENTRIES) ? index + 1 : 0;
-	}
-
-	dgAssert (i < 8);
-	dgAssert (i < DG_TRACK_MEMORY_LEAKS_ENTRIES);
-
-	m_density ++;
-	m_pool[index].m_size = size;
-	m_pool[index].m_ptr = ptr;
-	m_pool[index].m_allocationNumber = m_leakAllocationCounter;
-
-//	dgAssert (m_leakAllocationCounter != 129);
-
-	m_leakAllocationCounter ++;
-	m_totalAllocatedBytes += size; 
-	m_totalAllocatedCalls ++;
-}
-
-void dgMemoryAllocator::dgMemoryLeaksTracker::RemoveBlock (void* const ptr)
-{
-	dgUnsigned32 key = dgHash (&ptr, sizeof (void*));
-	dgUnsigned32 index = key % DG_TRACK_MEMORY_LEAKS_ENTRIES;
-
-	dgInt32 i = 0;
-	for (; i < DG_TRACK_MEMORY_LEAKS_ENTRIES; i ++) {
-		if (m_pool[index].m_ptr == ptr) {
-			m_density --;
-			m_totalAllocatedCalls--;
-			m_totalAllocatedBytes -= m_pool[index].m_size; 
-			dgAssert (m_totalAllocatedBytes >= 0);
-			m_pool[index].m_size = 0;
-			m_pool[index].m_ptr = NULL;
-			break;
-		}
-		index = ((index + 1) < DG_TRACK_MEMORY_LEAKS_ENTRIES) ? index + 1 : 0;
-	}
-
-	dgAssert (i < DG_TRACK_MEMORY_LEAKS_ENTRIES);
-}
-#endif
-
-
-
-// Set the pointer of memory allocation functions
-void dgSetGlobalAllocators (dgMemAlloc malloc, dgMemFree free)
-{
-	dgGlobalAllocator::m_globalAllocator.SetAllocatorsCallback (malloc, free);
-}
-
-dgInt32 dgGetMemoryUsed ()
-{
-	return dgGlobalAllocator::m_globalAllocator.GetMemoryUsed();
-}
-
-// this can be used by function that allocates large memory pools memory locally on the stack
-// this by pases the pool allocation because this should only be used for very large memory blocks.
-// this was using virtual memory on windows but 
-// but because of many complaint I changed it to use malloc and free
-void* dgApi dgMallocStack (size_t size)
-{
-	DG_MEMORY_THREAD_SANITY_CHECK_LOCK();
-	void * const ptr = dgGlobalAllocator::m_globalAllocator.MallocLow (dgInt32 (size));
-	DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK();
-	return ptr;
-}
-
-void* dgApi dgMallocAligned (size_t size, dgInt32 align)
-{
-	DG_MEMORY_THREAD_SANITY_CHECK_LOCK();
-	void * const ptr = dgGlobalAllocator::m_globalAllocator.MallocLow (dgInt32 (size), align);
-	DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK();
-	return ptr;
-	
-}
-
-// this can be used by function that allocates large memory pools memory locally on the stack
-// this by pases the pool allocation because this should only be used for very large memory blocks.
-// this was using virtual memory on windows but 
-// but because of many complaint I changed it to use malloc and free
-void  dgApi dgFreeStack (void* const ptr)
-{
-	DG_MEMORY_THREAD_SANITY_CHECK_LOCK();
-	dgGlobalAllocator::m_globalAllocator.FreeLow (ptr);
-	DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK();
-}
-
-
-// general memory allocation for all data in the library
-void* dgApi dgMalloc (size_t size, dgMemoryAllocator* const allocator) 
-{
-	void* ptr = NULL;
-	dgAssert (allocator);
-
-	DG_MEMORY_THREAD_SANITY_CHECK_LOCK();
-	if (size) {
-		ptr = allocator->Malloc (dgInt32 (size));
-	}
-
-	DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK();
-	return ptr;
-
-	
-}
-
-
-// general deletion allocation for all data in the library
-void dgApi dgFree (void* const ptr)
-{
-	if (ptr) {
-		DG_MEMORY_THREAD_SANITY_CHECK_LOCK();
-		dgMemoryAllocator::dgMemoryInfo* info;
-		info = ((dgMemoryAllocator::dgMemoryInfo*) ptr) - 1; 
-		dgAssert (info->m_allocator);
-		info->m_allocator->Free (ptr);
-		DG_MEMORY_THREAD_SANITY_CHECK_UNLOCK();
-	}
-}
-
-
-
-
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgStdafx.h"
+#include "dgList.h"
+#include "dgDebug.h"
+#include "dgMemory.h"
+
+
+// the stack allocations are also made by the worker threads of the parallel builders, 
+// so the global allocator is locked around them
+static dgInt32 dgStackAllocatorLock = 0;
+#define DG_MEMORY_STACK_LOCK()	dgSpinLock (&dgStackAllocatorLock, true);
+#define DG_MEMORY_STACK_UNLOCK()	dgSpinUnlock (&dgStackAllocatorLock);
+
+class dgGlobalAllocator: public dgMemoryAllocator, public dgList<dgMemoryAllocator*>
+{
+	public:
+	dgGlobalAllocator ()
+		:dgMemoryAllocator (__malloc__, __free__), dgList<dgMemoryAllocator*> (NULL)
+	{
+		SetAllocator (this);
+	}
+
+	~dgGlobalAllocator ()
+	{
+		dgAssert (GetCount() == 0);
+	}
+
+	static void* dgApi __malloc__ (dgUnsigned32 size) 
+	{
+		return malloc (size);
+	}
+
+	static void dgApi __free__ (void* const ptr, dgUnsigned32 size)
+	{
+		free (ptr);
+	}
+
+	void operator delete (void* const ptr)
+	{
+		dgAssert (0);
+		//::delete (ptr);
+		free (ptr);
+	}
+
+
+	dgInt32 GetMemoryUsed () const
+	{
+		dgInt32 mem = m_memoryUsed;
+		for (dgList<dgMemoryAllocator*>::dgListNode* node = GetFirst(); node; node = node->GetNext()) {
+			mem += node->GetInfo()->GetMemoryUsed();
+		}
+		return mem;
+	}
+
+	static dgGlobalAllocator m_globalAllocator;
+};
+
+
+
+dgGlobalAllocator dgGlobalAllocator::m_globalAllocator;
+
+// the magazine of the worker thread running on this core, if any
+static DG_THREAD_LOCAL dgMemoryAllocator::dgThreadCache* dgCurrentThreadCache = NULL;
+
+
+// the shared bins are only locked when some worker thread can access them concurrently
+class dgMemoryAllocator::dgSharedBinsLock
+{
+	public:
+	DG_INLINE dgSharedBinsLock (dgMemoryAllocator* const allocator, dgInt32 entry)
+		:m_lock(allocator->m_threadCacheCount ? &allocator->m_lock : NULL)
+	{
+		if (m_lock) {
+			if (dgInterlockedExchange(m_lock, 1)) {
+				dgSpinLock (m_lock, false);
+				allocator->m_counters[entry].m_lockContentions ++;
+			}
+		}
+		allocator->m_counters[entry].m_sharedBinsAccesses ++;
+	}
+
+	DG_INLINE ~dgSharedBinsLock ()
+	{
+		if (m_lock) {
+			dgSpinUnlock (m_lock);
+		}
+	}
+
+	dgInt32* m_lock;
+};
+
+
+
+dgMemoryAllocator::dgMemoryAllocator ()
+{
+	m_memoryUsed = 0;
+	m_emumerator = 0;
+	m_lock = 0;
+	m_threadCacheCount = 0;
+	m_threadCaches = NULL;
+	SetAllocatorsCallback (dgGlobalAllocator::m_globalAllocator.m_malloc, dgGlobalAllocator::m_globalAllocator.m_free);
+	memset (m_memoryDirectory, 0, sizeof (m_memoryDirectory));
+	memset (m_counters, 0, sizeof (m_counters));
+	dgGlobalAllocator::m_globalAllocator.Append(this);
+}
+
+dgMemoryAllocator::dgMemoryAllocator (dgMemAlloc memAlloc, dgMemFree memFree)
+{
+	m_memoryUsed = 0;
+	m_emumerator = 0;
+	m_lock = 0;
+	m_threadCacheCount = 0;
+	m_threadCaches = NULL;
+	SetAllocatorsCallback (memAlloc, memFree);
+	memset (m_memoryDirectory, 0, sizeof (m_memoryDirectory));
+	memset (m_counters, 0, sizeof (m_counters));
+}
+
+
+dgMemoryAllocator::~dgMemoryAllocator  ()
+{
+	dgGlobalAllocator::m_globalAllocator.Remove(this);
+	dgAssert (!m_threadCaches);
+	dgAssert (m_memoryUsed == 0);
+}
+
+
+void *dgMemoryAllocator::operator new (size_t size) 
+{ 
+	return dgMallocStack(size);
+}
+
+void dgMemoryAllocator::operator delete (void* const ptr) 
+{ 
+	dgFreeStack(ptr); 
+}
+
+
+dgInt32 dgMemoryAllocator::GetMemoryUsed() const
+{
+	return m_memoryUsed;
+}
+
+// fill the counters of up to maxCount size classes and return the number of size classes, 
+// the thread magazine counters are read without locking so they are only a snapshot
+dgInt32 dgMemoryAllocator::GetMemoryUsed(dgMemorySizeClassInfo* const sizeClasses, dgInt32 maxCount) const
+{
+	dgInt32 count = 0;
+	if (sizeClasses) {
+		dgSharedBinsLock lock (const_cast<dgMemoryAllocator*>(this), 0);
+		for (dgInt32 entry = 2; (entry < DG_MEMORY_BIN_ENTRIES) && (count < maxCount); entry ++) {
+			dgMemorySizeClassInfo& info = sizeClasses[count];
+			info.m_blockSize = (entry << DG_MEMORY_GRANULARITY_BITS) - DG_MEMORY_GRANULARITY;
+			info.m_blocksInUse = 0;
+			info.m_blocksInThreadCaches = 0;
+			info.m_allocations = m_counters[entry].m_allocations;
+			info.m_threadCacheHits = m_counters[entry].m_threadCacheHits;
+			info.m_sharedBinsAccesses = m_counters[entry].m_sharedBinsAccesses;
+			info.m_lockContentions = m_counters[entry].m_lockContentions;
+			for (dgMemoryBin* bin = m_memoryDirectory[entry].m_first; bin; bin = bin->m_info.m_next) {
+				info.m_blocksInUse += bin->m_info.m_count;
+			}
+			for (dgThreadCache* cache = m_threadCaches; cache; cache = cache->m_next) {
+				const dgThreadCache::dgMagazine& magazine = cache->m_magazines[entry];
+				info.m_blocksInThreadCaches += magazine.m_count;
+				info.m_allocations += magazine.m_allocations;
+				info.m_threadCacheHits += magazine.m_hits;
+			}
+			info.m_blocksInUse -= info.m_blocksInThreadCaches;
+			count ++;
+		}
+	} else {
+		count = DG_MEMORY_BIN_ENTRIES - 2;
+	}
+	return count;
+}
+
+void dgMemoryAllocator::SetAllocatorsCallback (dgMemAlloc memAlloc, dgMemFree memFree)
+{
+	m_free = memFree;
+	m_malloc = memAlloc;
+}
+
+
+
+void *dgMemoryAllocator::MallocLow (dgInt32 workingSize, dgInt32 alignment)
+{
+	dgAssert (alignment >= DG_MEMORY_GRANULARITY);
+	dgAssert (((-alignment) & (alignment - 1)) == 0);
+	dgInt32 size = workingSize + alignment * 2;
+	void* const ptr = m_malloc(dgUnsigned32 (size));
+	dgAssert (ptr);
+	dgUnsigned64 val = dgUnsigned64 (PointerToInt(ptr));
+	val = (val & dgUnsigned64(-alignment)) + alignment * 2;
+	void* const retPtr = IntToPointer (val);
+
+	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
+	info->SaveInfo(this, ptr, size, m_emumerator, workingSize);
+
+	dgAtomicExchangeAndAdd (&m_memoryUsed, size);
+	return retPtr;
+}
+
+void dgMemoryAllocator::FreeLow (void* const retPtr)
+{
+	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
+	dgAssert (info->m_allocator == this);
+
+	dgAtomicExchangeAndAdd (&m_memoryUsed, -info->m_size);
+
+#ifdef _DEBUG
+	memset (retPtr, 0, info->m_workingSize);
+#endif
+
+	m_free (info->m_ptr, dgUnsigned32 (info->m_size));
+}
+
+// alloca memory on pool that are quantized to DG_MEMORY_GRANULARITY
+// if memory size is larger than DG_MEMORY_BIN_ENTRIES then the memory is not placed into a pool
+void *dgMemoryAllocator::Malloc (dgInt32 memsize)
+{
+	dgAssert (dgInt32 (sizeof (dgMemoryCacheEntry) + sizeof (dgInt32) + sizeof(dgInt32)) <= DG_MEMORY_GRANULARITY);
+
+	dgInt32 size = memsize + DG_MEMORY_GRANULARITY - 1;
+	size &= (-DG_MEMORY_GRANULARITY);
+
+	dgInt32 paddedSize = size + DG_MEMORY_GRANULARITY; 
+	dgInt32 entry = paddedSize >> DG_MEMORY_GRANULARITY_BITS;	
+
+	void* ptr;
+	if (entry >= DG_MEMORY_BIN_ENTRIES) {
+		dgSharedBinsLock lock (this, DG_MEMORY_BIN_ENTRIES);
+		ptr = MallocLow (size);
+	} else {
+#ifndef __TRACK_MEMORY_LEAKS__
+		dgThreadCache* const cache = dgCurrentThreadCache;
+		if (cache && (cache->m_allocator == this)) {
+			ptr = cache->Malloc (entry, memsize);
+		} else 
+#endif
+		{
+			dgSharedBinsLock lock (this, entry);
+			m_counters[entry].m_allocations ++;
+			ptr = MallocBin (entry, memsize);
+		}
+	}
+	return ptr;
+}
+
+// alloca memory on pool that are quantized to DG_MEMORY_GRANULARITY
+// if memory size is larger than DG_MEMORY_BIN_ENTRIES then the memory is not placed into a pool
+void dgMemoryAllocator::Free (void* const retPtr)
+{
+	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
+	dgAssert (info->m_allocator == this);
+
+	dgInt32 entry = info->m_size;
+
+	if (entry >= DG_MEMORY_BIN_ENTRIES) {
+		dgSharedBinsLock lock (this, DG_MEMORY_BIN_ENTRIES);
+		FreeLow (retPtr);
+	} else {
+#ifndef __TRACK_MEMORY_LEAKS__
+		dgThreadCache* const cache = dgCurrentThreadCache;
+		if (cache && (cache->m_allocator == this)) {
+			cache->Free (entry, retPtr);
+		} else 
+#endif
+		{
+			dgSharedBinsLock lock (this, entry);
+			FreeBin (retPtr);
+		}
+	}
+}
+
+// take one block from the shared bins, the caller must own the shared bins lock
+void *dgMemoryAllocator::MallocBin (dgInt32 entry, dgInt32 memsize)
+{
+	dgInt32 paddedSize = entry << DG_MEMORY_GRANULARITY_BITS;
+	if (!m_memoryDirectory[entry].m_cache) {
+		dgMemoryBin* const bin = (dgMemoryBin*) MallocLow (sizeof (dgMemoryBin));
+
+		dgInt32 count = dgInt32 (sizeof (bin->m_pool) / paddedSize);
+		bin->m_info.m_count = 0;
+		bin->m_info.m_totalCount = count;
+		bin->m_info.m_stepInBites = paddedSize;
+		bin->m_info.m_next = m_memoryDirectory[entry].m_first;
+		bin->m_info.m_prev = NULL;
+		if (bin->m_info.m_next) {
+			bin->m_info.m_next->m_info.m_prev = bin;
+		}
+
+		m_memoryDirectory[entry].m_first = bin;
+
+		dgInt8* charPtr = reinterpret_cast<dgInt8*>(bin->m_pool);
+		m_memoryDirectory[entry].m_cache = (dgMemoryCacheEntry*)charPtr;
+
+		for (dgInt32 i = 0; i < count; i ++) {
+			dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) charPtr;
+			cashe->m_next = (dgMemoryCacheEntry*) (charPtr + paddedSize);
+			cashe->m_prev = (dgMemoryCacheEntry*) (charPtr - paddedSize);
+			dgMemoryInfo* const info = ((dgMemoryInfo*) (charPtr + DG_MEMORY_GRANULARITY)) - 1;						
+			info->SaveInfo(this, bin, entry, m_emumerator, memsize);
+			charPtr += paddedSize;
+		}
+		dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (charPtr - paddedSize);
+		cashe->m_next = NULL;
+		m_memoryDirectory[entry].m_cache->m_prev = NULL;
+	}
+
+
+	dgAssert (m_memoryDirectory[entry].m_cache);
+
+	dgMemoryCacheEntry* const cashe = m_memoryDirectory[entry].m_cache;
+	m_memoryDirectory[entry].m_cache = cashe->m_next;
+	if (cashe->m_next) {
+		cashe->m_next->m_prev = NULL;
+	}
+
+	void* const ptr = ((dgInt8*)cashe) + DG_MEMORY_GRANULARITY;
+
+	dgMemoryInfo* info;
+	info = ((dgMemoryInfo*) (ptr)) - 1;
+	dgAssert (info->m_allocator == this);
+
+	dgMemoryBin* const bin = (dgMemoryBin*) info->m_ptr;
+	bin->m_info.m_count ++;
+
+	#ifdef __TRACK_MEMORY_LEAKS__
+	m_leaklTracker.InsertBlock (dgInt32 (memsize), ptr);
+	#endif
+	return ptr;
+}
+
+// return one block to the shared bins, the caller must own the shared bins lock
+void dgMemoryAllocator::FreeBin (void* const retPtr)
+{
+	dgMemoryInfo* const info = ((dgMemoryInfo*) (retPtr)) - 1;
+	dgAssert (info->m_allocator == this);
+	dgInt32 entry = info->m_size;
+	dgAssert (entry < DG_MEMORY_BIN_ENTRIES);
+
+	#ifdef __TRACK_MEMORY_LEAKS__
+	m_leaklTracker.RemoveBlock (retPtr);
+	#endif
+
+	dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (((char*)retPtr) - DG_MEMORY_GRANULARITY) ;
+
+	dgMemoryCacheEntry* const tmpCashe = m_memoryDirectory[entry].m_cache;
+	if (tmpCashe) {
+		dgAssert (!tmpCashe->m_prev);
+		tmpCashe->m_prev = cashe;
+	}
+	cashe->m_next = tmpCashe;
+	cashe->m_prev = NULL;
+
+	m_memoryDirectory[entry].m_cache = cashe;
+
+	dgMemoryBin* const bin = (dgMemoryBin *) info->m_ptr;
+
+	dgAssert (bin);
+#ifdef _DEBUG
+	dgAssert ((bin->m_info.m_stepInBites - DG_MEMORY_GRANULARITY) > 0);
+	memset (retPtr, 0, bin->m_info.m_stepInBites - DG_MEMORY_GRANULARITY);
+#endif
+
+	bin->m_info.m_count --;
+	if (bin->m_info.m_count == 0) {
+
+		dgInt32 count = bin->m_info.m_totalCount;
+		dgInt32 sizeInBytes = bin->m_info.m_stepInBites;
+		char* charPtr = bin->m_pool;
+		for (dgInt32 i = 0; i < count; i ++) {
+			dgMemoryCacheEntry* const tmpCashe = (dgMemoryCacheEntry*)charPtr;
+			charPtr += sizeInBytes;
+
+			if (tmpCashe == m_memoryDirectory[entry].m_cache) {
+				m_memoryDirectory[entry].m_cache = tmpCashe->m_next;
+			}
+
+			if (tmpCashe->m_prev) {
+				tmpCashe->m_prev->m_next = tmpCashe->m_next;
+			}
+
+			if (tmpCashe->m_next) {
+				tmpCashe->m_next->m_prev = tmpCashe->m_prev;
+			}
+		}
+
+		if (m_memoryDirectory[entry].m_first == bin) {
+			m_memoryDirectory[entry].m_first = bin->m_info.m_next;
+		}
+
+		if (bin->m_info.m_next) {
+			bin->m_info.m_next->m_info.m_prev = bin->m_info.m_prev;
+		}
+		if (bin->m_info.m_prev) {
+			bin->m_info.m_prev->m_info.m_next = bin->m_info.m_next;
+		}
+
+		FreeLow (bin);
+	}
+}
+
+
+dgMemoryAllocator::dgThreadCache::dgThreadCache (dgMemoryAllocator* const allocator)
+	:m_allocator(allocator)
+	,m_next(NULL)
+	,m_prev(NULL)
+{
+	memset (m_magazines, 0, sizeof (m_magazines));
+	for (dgInt32 entry = 0; entry < DG_MEMORY_BIN_ENTRIES; entry ++) {
+		dgInt32 paddedSize = dgMax (entry << DG_MEMORY_GRANULARITY_BITS, DG_MEMORY_GRANULARITY);
+		m_magazines[entry].m_capacity = dgMax (DG_MEMORY_THREAD_CACHE_BYTES / paddedSize, 4);
+	}
+
+	dgAssert (!dgCurrentThreadCache);
+	dgCurrentThreadCache = this;
+
+	dgSpinLock (&m_allocator->m_lock, false);
+	m_next = m_allocator->m_threadCaches;
+	if (m_next) {
+		m_next->m_prev = this;
+	}
+	m_allocator->m_threadCaches = this;
+	m_allocator->m_threadCacheCount ++;
+	dgSpinUnlock (&m_allocator->m_lock);
+}
+
+dgMemoryAllocator::dgThreadCache::~dgThreadCache ()
+{
+	dgSpinLock (&m_allocator->m_lock, false);
+	for (dgInt32 entry = 0; entry < DG_MEMORY_BIN_ENTRIES; entry ++) {
+		dgMagazine& magazine = m_magazines[entry];
+		m_allocator->m_counters[entry].m_allocations += magazine.m_allocations;
+		m_allocator->m_counters[entry].m_threadCacheHits += magazine.m_hits;
+		while (magazine.m_first) {
+			dgMemoryCacheEntry* const cashe = magazine.m_first;
+			magazine.m_first = cashe->m_next;
+			m_allocator->FreeBin (((dgInt8*)cashe) + DG_MEMORY_GRANULARITY);
+		}
+		magazine.m_count = 0;
+	}
+
+	if (m_allocator->m_threadCaches == this) {
+		m_allocator->m_threadCaches = m_next;
+	}
+	if (m_next) {
+		m_next->m_prev = m_prev;
+	}
+	if (m_prev) {
+		m_prev->m_next = m_next;
+	}
+	m_allocator->m_threadCacheCount --;
+	dgSpinUnlock (&m_allocator->m_lock);
+
+	dgCurrentThreadCache = NULL;
+}
+
+void* dgMemoryAllocator::dgThreadCache::Malloc (dgInt32 entry, dgInt32 memsize)
+{
+	dgMagazine& magazine = m_magazines[entry];
+	magazine.m_allocations ++;
+	if (magazine.m_first) {
+		magazine.m_hits ++;
+	} else {
+		// refill half the magazine with one trip to the shared bins
+		dgSharedBinsLock lock (m_allocator, entry);
+		for (dgInt32 i = magazine.m_capacity / 2; i; i --) {
+			dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (((dgInt8*)m_allocator->MallocBin (entry, memsize)) - DG_MEMORY_GRANULARITY);
+			cashe->m_next = magazine.m_first;
+			magazine.m_first = cashe;
+			magazine.m_count ++;
+		}
+	}
+
+	dgMemoryCacheEntry* const cashe = magazine.m_first;
+	magazine.m_first = cashe->m_next;
+	magazine.m_count --;
+	return ((dgInt8*)cashe) + DG_MEMORY_GRANULARITY;
+}
+
+void dgMemoryAllocator::dgThreadCache::Free (dgInt32 entry, void* const retPtr)
+{
+	dgMagazine& magazine = m_magazines[entry];
+
+#ifdef _DEBUG
+	memset (retPtr, 0, (entry << DG_MEMORY_GRANULARITY_BITS) - DG_MEMORY_GRANULARITY);
+#endif
+
+	dgMemoryCacheEntry* const cashe = (dgMemoryCacheEntry*) (((dgInt8*)retPtr) - DG_MEMORY_GRANULARITY);
+	cashe->m_next = magazine.m_first;
+	magazine.m_first = cashe;
+	magazine.m_count ++;
+	if (magazine.m_count > magazine.m_capacity) {
+		Drain (entry, magazine.m_capacity / 2);
+	}
+}
+
+// return a batch of blocks to the shared bins with a single lock
+void dgMemoryAllocator::dgThreadCache::Drain (dgInt32 entry, dgInt32 count)
+{
+	dgMagazine& magazine = m_magazines[entry];
+	dgSharedBinsLock lock (m_allocator, entry);
+	for (dgInt32 i = 0; (i < count) && magazine.m_first; i ++) {
+		dgMemoryCacheEntry* const cashe = magazine.m_first;
+		magazine.m_first = cashe->m_next;
+		magazine.m_count --;
+		m_allocator->FreeBin (((dgInt8*)cashe) + DG_MEMORY_GRANULARITY);
+	}
+}
+
+
+
+dgFrameArena::dgFrameArena (dgMemoryAllocator* const allocator, dgInt32 sizeInBytes)
+	:m_buffer(NULL)
+	,m_allocator(allocator)
+	,m_overflow(NULL)
+	,m_capacity(0)
+	,m_used(0)
+	,m_highWaterMark(0)
+	,m_lock(0)
+{
+	memset (m_threadBlocks, 0, sizeof (m_threadBlocks));
+	Reserve (sizeInBytes);
+}
+
+dgFrameArena::~dgFrameArena ()
+{
+	Reset ();
+	if (m_buffer) {
+		m_allocator->FreeLow (m_buffer);
+	}
+}
+
+// make sure the buffer can hold at least sizeInBytes, this can only be called while the arena is empty
+void dgFrameArena::Reserve (dgInt32 sizeInBytes)
+{
+	dgAssert (!m_used);
+	dgAssert (!m_overflow);
+	sizeInBytes = (sizeInBytes + DG_FRAME_ARENA_THREAD_BLOCK - 1) & -DG_FRAME_ARENA_THREAD_BLOCK;
+	if (sizeInBytes > m_capacity) {
+		if (m_buffer) {
+			m_allocator->FreeLow (m_buffer);
+		}
+		m_capacity = sizeInBytes;
+		m_buffer = (dgUnsigned8*) m_allocator->MallocLow (m_capacity, DG_FRAME_ARENA_ALIGNMENT);
+	}
+}
+
+// recycle all the memory allocated since the last reset, no thread can be using the arena  
+void dgFrameArena::Reset ()
+{
+	m_highWaterMark = dgMax (m_highWaterMark, m_used);
+	while (m_overflow) {
+		dgOverflowBlock* const block = m_overflow;
+		m_overflow = block->m_next;
+		m_allocator->FreeLow (block);
+	}
+
+	m_used = 0;
+	memset (m_threadBlocks, 0, sizeof (m_threadBlocks));
+	Reserve (m_highWaterMark);
+}
+
+// the buffer is full, serve the block from the allocator and keep it until the next reset
+void* dgFrameArena::AllocOverflow (dgInt32 sizeInBytes)
+{
+	dgSpinLock (&m_lock, false);
+	dgOverflowBlock* const block = (dgOverflowBlock*) m_allocator->MallocLow (sizeInBytes + DG_FRAME_ARENA_ALIGNMENT, DG_FRAME_ARENA_ALIGNMENT);
+	block->m_next = m_overflow;
+	m_overflow = block;
+	dgSpinUnlock (&m_lock);
+	return ((dgUnsigned8*) block) + DG_FRAME_ARENA_ALIGNMENT;
+}
+
+
+
+	// this is a simple memory leak tracker, it uses an flat array of two megabyte indexed by a hatch code
+#ifdef __TRACK_MEMORY_LEAKS__
+
+dgMemoryAllocator::dgMemoryLeaksTracker::dgMemoryLeaksTracker()
+{
+	m_density = 0;
+	m_totalAllocatedBytes = 0; 
+	m_totalAllocatedCalls = 0; 
+	m_leakAllocationCounter = 0;
+
+	memset (m_pool, 0, sizeof (m_pool));
+}
+
+dgMemoryAllocator::dgMemoryLeaksTracker::~dgMemoryLeaksTracker ()
+{
+	if (m_totalAllocatedBytes) {
+		for (dgInt32 i = 0; i < DG_TRACK_MEMORY_LEAKS_ENTRIES; i ++) {
+			if (m_pool[i].m_ptr) {
+				dgTrace (("MemoryLeak: (0x%08x), size (%d)  allocationNumber (%d)\n", m_pool[i].m_ptr, m_pool[i].m_size, m_pool[i].m_allocationNumber));
+			}
+		}
+	}
+}
+
+void dgMemoryAllocator::dgMemoryLeaksTracker::InsertBlock (dgInt32 size, void* const ptr)
+{
+	dgUnsigned32 key = dgHash (&ptr, sizeof (void*));
+	dgUnsigned32 index = key % DG_TRACK_MEMORY_LEAKS_ENTRIES;
+
+	dgInt32 i = 0;
+	for (; m_pool[index].m_ptr && (i < DG_TRACK_MEMORY_LEAKS_ENTRIES); i ++) {
+		index = ((index + 1) < DG_TRACK_MEMORY_LEAKS_ENTRIES) ? index + 1 : 0;
+	}
+
+	dgAssert (i < 8);
+	dgAssert (i < DG_TRACK_MEMORY_LEAKS_ENTRIES);
+
+	m_density ++;
+	m_pool[index].m_size = size;
+	m_pool[index].m_ptr = ptr;
+	m_pool[index].m_allocationNumber = m_leakAllocationCounter;
+
+//	dgAssert (m_leakAllocationCounter != 129);
+
+	m_leakAllocationCounter ++;
+	m_totalAllocatedBytes += size; 
+	m_totalAllocatedCalls ++;
+}
+
+void dgMemoryAllocator::dgMemoryLeaksTracker::RemoveBlock (void* const ptr)
+{
+	dgUnsigned32 key = dgHash (&ptr, sizeof (void*));
+	dgUnsigned32 index = key % DG_TRACK_MEMORY_LEAKS_ENTRIES;
+
+	dgInt32 i = 0;
+	for (; i < DG_TRACK_MEMORY_LEAKS_ENTRIES; i ++) {
+		if (m_pool[index].m_ptr == ptr) {
+			m_density --;
+			m_totalAllocatedCalls--;
+			m_totalAllocatedBytes -= m_pool[index].m_size; 
+			dgAssert (m_totalAllocatedBytes >= 0);
+			m_pool[index].m_size = 0;
+			m_pool[index].m_ptr = NULL;
+			break;
+		}
+		index = ((index + 1) < DG_TRACK_MEMORY_LEAKS_ENTRIES) ? index + 1 : 0;
+	}
+
+	dgAssert (i < DG_TRACK_MEMORY_LEAKS_ENTRIES);
+}
+#endif
+
+
+
+// Set the pointer of memory allocation functions
+void dgSetGlobalAllocators (dgMemAlloc malloc, dgMemFree free)
+{
+	dgGlobalAllocator::m_globalAllocator.SetAllocatorsCallback (malloc, free);
+}
+
+dgInt32 dgGetMemoryUsed ()
+{
+	return dgGlobalAllocator::m_globalAllocator.GetMemoryUsed();
+}
+
+// this can be used by function that allocates large memory pools memory locally on the stack
+// this by pases the pool allocation because this should only be used for very large memory blocks.
+// this was using virtual memory on windows but 
+// but because of many complaint I changed it to use malloc and free
+void* dgApi dgMallocStack (size_t size)
+{
+	DG_MEMORY_STACK_LOCK();
+	void * const ptr = dgGlobalAllocator::m_globalAllocator.MallocLow (dgInt32 (size));
+	DG_MEMORY_STACK_UNLOCK();
+	return ptr;
+}
+
+void* dgApi dgMallocAligned (size_t size, dgInt32 align)
+{
+	DG_MEMORY_STACK_LOCK();
+	void * const ptr = dgGlobalAllocator::m_globalAllocator.MallocLow (dgInt32 (size), align);
+	DG_MEMORY_STACK_UNLOCK();
+	return ptr;
+	
+}
+
+// this can be used by function that allocates large memory pools memory locally on the stack
+// this by pases the pool allocation because this should only be used for very large memory blocks.
+// this was using virtual memory on windows but 
+// but because of many complaint I changed it to use malloc and free
+void  dgApi dgFreeStack (void* const ptr)
+{
+	DG_MEMORY_STACK_LOCK();
+	dgGlobalAllocator::m_globalAllocator.FreeLow (ptr);
+	DG_MEMORY_STACK_UNLOCK();
+}
+
+
+// general memory allocation for all data in the library
+void* dgApi dgMalloc (size_t size, dgMemoryAllocator* const allocator) 
+{
+	void* ptr = NULL;
+	dgAssert (allocator);
+
+	if (size) {
+		ptr = allocator->Malloc (dgInt32 (size));
+	}
+	return ptr;
+
+	
+}
+
+
+// general deletion allocation for all data in the library
+void dgApi dgFree (void* const ptr)
+{
+	if (ptr) {
+		dgMemoryAllocator::dgMemoryInfo* info;
+		info = ((dgMemoryAllocator::dgMemoryInfo*) ptr) - 1; 
+		dgAssert (info->m_allocator);
+		info->m_allocator->Free (ptr);
+	}
+}
+
+
+
+
+
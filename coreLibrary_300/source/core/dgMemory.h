@@ -1,201 +1,349 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#ifndef __dgMemory__
-#define __dgMemory__
-
-#include "dgStdafx.h"
-
-#ifdef _DEBUG
-//#define __TRACK_MEMORY_LEAKS__
-#endif
-
-class dgMemoryAllocator;
-
-void* dgApi dgMalloc (size_t size, dgMemoryAllocator* const allocator);
-void  dgApi dgFree (void* const ptr);
-
-
-void* dgApi dgMallocStack (size_t size);
-void* dgApi dgMallocAligned (size_t size, dgInt32 alignmentInBytes);
-void  dgApi dgFreeStack (void* const ptr);
-
-typedef void* (dgApi *dgMemAlloc) (dgUnsigned32 size);
-typedef void (dgApi *dgMemFree) (void* const ptr, dgUnsigned32 size);
-
-
-//void dgSetMemoryDrivers (dgMemAlloc alloc, dgMemFree free);
-void dgSetGlobalAllocators (dgMemAlloc alloc, dgMemFree free);
-dgInt32 dgGetMemoryUsed ();
-
-
-#define DG_CLASS_ALLOCATOR_NEW(allocator)			inline void *operator new (size_t size, dgMemoryAllocator* const allocator) { return dgMalloc(size, allocator);}
-#define DG_CLASS_ALLOCATOR_NEW_ARRAY(allocator)		inline void *operator new[] (size_t size, dgMemoryAllocator* const allocator) { return dgMalloc(size, allocator);}
-#define DG_CLASS_ALLOCATOR_DELETE(allocator)		inline void operator delete (void* const ptr, dgMemoryAllocator* const allocator) { dgFree(ptr); }
-#define DG_CLASS_ALLOCATOR_DELETE_ARRAY(allocator)	inline void operator delete[] (void* const ptr, dgMemoryAllocator* const allocator) { dgFree(ptr); }
-#define DG_CLASS_ALLOCATOR_NEW_DUMMY				inline void *operator new (size_t size) { dgAssert (0); return dgMalloc(size, NULL);}
-#define DG_CLASS_ALLOCATOR_NEW_ARRAY_DUMMY			inline void *operator new[] (size_t size) { dgAssert (0); return dgMalloc(size, NULL);}
-#define DG_CLASS_ALLOCATOR_DELETE_DUMMY				inline void operator delete (void* const ptr) { dgFree(ptr); }
-#define DG_CLASS_ALLOCATOR_DELETE_ARRAY_DUMMY		inline void operator delete[] (void* const ptr) { dgFree(ptr); }
-
-
-#define DG_CLASS_ALLOCATOR(allocator)				\
-	DG_CLASS_ALLOCATOR_DELETE(allocator)			\
-	DG_CLASS_ALLOCATOR_DELETE_ARRAY(allocator)		\
-	DG_CLASS_ALLOCATOR_NEW(allocator)				\
-	DG_CLASS_ALLOCATOR_NEW_ARRAY(allocator)			\
-	DG_CLASS_ALLOCATOR_NEW_DUMMY					\
-	DG_CLASS_ALLOCATOR_NEW_ARRAY_DUMMY				\
-	DG_CLASS_ALLOCATOR_DELETE_DUMMY					\
-	DG_CLASS_ALLOCATOR_DELETE_ARRAY_DUMMY
-
-
-
-
-class dgMemoryAllocator
-{
-
-	#if (defined (_WIN_64_VER) || defined (_MINGW_64_VER) || defined (_POSIX_VER_64) || defined (_MACOSX_VER))
-		#define DG_MEMORY_GRANULARITY_BITS		6	
-	#else
-		#define DG_MEMORY_GRANULARITY_BITS		5	
-	#endif
-	#define DG_MEMORY_GRANULARITY				(1 << DG_MEMORY_GRANULARITY_BITS)	
-	#define DG_MEMORY_SIZE						(1024 - 64)
-	#define DG_MEMORY_BIN_SIZE					(1024 * 16)
-	#define DG_MEMORY_BIN_ENTRIES				(DG_MEMORY_SIZE / DG_MEMORY_GRANULARITY)
-
-	public: 
-
-	class dgMemoryBin
-	{
-		public: 
-		class dgMemoryBinInfo
-		{
-			public: 
-			dgInt32 m_count;
-			dgInt32 m_totalCount;
-			dgInt32 m_stepInBites;
-			dgMemoryBin* m_next;
-			dgMemoryBin* m_prev;
-		};
-
-		char m_pool[DG_MEMORY_BIN_SIZE - sizeof (dgMemoryBinInfo) - DG_MEMORY_GRANULARITY * 2];
-		dgMemoryBinInfo m_info;
-	};
-
-
-	class dgMemoryCacheEntry
-	{
-		public: 
-		dgMemoryCacheEntry* m_next;
-		dgMemoryCacheEntry* m_prev;
-	};
-
-	class dgMemoryInfo
-	{
-		public:
-		void *m_ptr;
-		dgMemoryAllocator* m_allocator;
-		dgInt32 m_size;
-		dgInt32 m_enum;
-#ifdef _DEBUG
-		dgInt32 m_workingSize;
-#endif
-
-		DG_INLINE void SaveInfo(dgMemoryAllocator* const allocator, void* const ptr, dgInt32 size, dgInt32& enumerator, dgInt32 workingSize = 0)
-		{
-			m_ptr = ptr;
-			m_size = size;
-			m_enum = enumerator;
-			enumerator ++;
-			m_allocator = allocator;
-#ifdef _DEBUG
-			m_workingSize = workingSize;
-#endif
-		}
-	};
-
-	class dgMemDirectory
-	{	
-		public: 
-		dgMemoryBin* m_first;
-		dgMemoryCacheEntry* m_cache;
-	};
-
-
-	// this is a simple memory leak tracker, it uses an flat array of two megabyte indexed by a hatch code
-#ifdef __TRACK_MEMORY_LEAKS__
-	class dgMemoryLeaksTracker
-	{
-		#define DG_TRACK_MEMORY_LEAKS_ENTRIES (1024 * 1024 * 4)
-		class Pool
-		{	
-			public: 
-			void* m_ptr;
-			dgInt32 m_size;
-			dgInt32 m_allocationNumber;
-		};
-
-		public:
-		dgMemoryLeaksTracker();
-		~dgMemoryLeaksTracker ();
-		void RemoveBlock (void* const ptr);
-		void InsertBlock (dgInt32 size, void* const ptr);
-
-		dgInt32 m_density;
-		dgInt32 m_totalAllocatedBytes; 
-		dgInt32 m_totalAllocatedCalls; 
-		dgInt32 m_leakAllocationCounter;
-		Pool m_pool[DG_TRACK_MEMORY_LEAKS_ENTRIES];
-
-	};
-#endif
-
-	dgMemoryAllocator ();
-	~dgMemoryAllocator ();
-	void *operator new (size_t size);
-	void operator delete (void* const ptr);
-	dgInt32 GetMemoryUsed() const;
-	void SetAllocatorsCallback (dgMemAlloc memAlloc, dgMemFree memFree);
-	void *MallocLow (dgInt32 size, dgInt32 alignment = DG_MEMORY_GRANULARITY);
-	void FreeLow (void* const retPtr);
-	void *Malloc (dgInt32 memsize);
-	void Free (void* const retPtr);
-
-
-	protected:
-	dgMemoryAllocator (dgMemAlloc memAlloc, dgMemFree memFree);
-
-	dgInt32 m_emumerator;
-	dgInt32 m_memoryUsed;
-	dgMemFree m_free;
-	dgMemAlloc m_malloc;
-	dgMemDirectory m_memoryDirectory[DG_MEMORY_BIN_ENTRIES + 1]; 
-
-#ifdef __TRACK_MEMORY_LEAKS__
-	dgMemoryLeaksTracker m_leaklTracker;
-#endif
-};
-
-
-#endif
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __dgMemory__
+#define __dgMemory__
+
+#include "dgStdafx.h"
+
+#ifdef _DEBUG
+//#define __TRACK_MEMORY_LEAKS__
+#endif
+
+class dgMemoryAllocator;
+
+void* dgApi dgMalloc (size_t size, dgMemoryAllocator* const allocator);
+void  dgApi dgFree (void* const ptr);
+
+
+void* dgApi dgMallocStack (size_t size);
+void* dgApi dgMallocAligned (size_t size, dgInt32 alignmentInBytes);
+void  dgApi dgFreeStack (void* const ptr);
+
+typedef void* (dgApi *dgMemAlloc) (dgUnsigned32 size);
+typedef void (dgApi *dgMemFree) (void* const ptr, dgUnsigned32 size);
+
+
+//void dgSetMemoryDrivers (dgMemAlloc alloc, dgMemFree free);
+void dgSetGlobalAllocators (dgMemAlloc alloc, dgMemFree free);
+dgInt32 dgGetMemoryUsed ();
+
+
+#define DG_CLASS_ALLOCATOR_NEW(allocator)			inline void *operator new (size_t size, dgMemoryAllocator* const allocator) { return dgMalloc(size, allocator);}
+#define DG_CLASS_ALLOCATOR_NEW_ARRAY(allocator)		inline void *operator new[] (size_t size, dgMemoryAllocator* const allocator) { return dgMalloc(size, allocator);}
+#define DG_CLASS_ALLOCATOR_DELETE(allocator)		inline void operator delete (void* const ptr, dgMemoryAllocator* const allocator) { dgFree(ptr); }
+#define DG_CLASS_ALLOCATOR_DELETE_ARRAY(allocator)	inline void operator delete[] (void* const ptr, dgMemoryAllocator* const allocator) { dgFree(ptr); }
+#define DG_CLASS_ALLOCATOR_NEW_DUMMY				inline void *operator new (size_t size) { dgAssert (0); return dgMalloc(size, NULL);}
+#define DG_CLASS_ALLOCATOR_NEW_ARRAY_DUMMY			inline void *operator new[] (size_t size) { dgAssert (0); return dgMalloc(size, NULL);}
+#define DG_CLASS_ALLOCATOR_DELETE_DUMMY				inline void operator delete (void* const ptr) { dgFree(ptr); }
+#define DG_CLASS_ALLOCATOR_DELETE_ARRAY_DUMMY		inline void operator delete[] (void* const ptr) { dgFree(ptr); }
+
+
+#define DG_CLASS_ALLOCATOR(allocator)				\
+	DG_CLASS_ALLOCATOR_DELETE(allocator)			\
+	DG_CLASS_ALLOCATOR_DELETE_ARRAY(allocator)		\
+	DG_CLASS_ALLOCATOR_NEW(allocator)				\
+	DG_CLASS_ALLOCATOR_NEW_ARRAY(allocator)			\
+	DG_CLASS_ALLOCATOR_NEW_DUMMY					\
+	DG_CLASS_ALLOCATOR_NEW_ARRAY_DUMMY				\
+	DG_CLASS_ALLOCATOR_DELETE_DUMMY					\
+	DG_CLASS_ALLOCATOR_DELETE_ARRAY_DUMMY
+
+
+
+
+class dgMemoryAllocator
+{
+
+	#if (defined (_WIN_64_VER) || defined (_MINGW_64_VER) || defined (_POSIX_VER_64) || defined (_MACOSX_VER))
+		#define DG_MEMORY_GRANULARITY_BITS		6	
+	#else
+		#define DG_MEMORY_GRANULARITY_BITS		5	
+	#endif
+	#define DG_MEMORY_GRANULARITY				(1 << DG_MEMORY_GRANULARITY_BITS)	
+	#define DG_MEMORY_SIZE						(1024 - 64)
+	#define DG_MEMORY_BIN_SIZE					(1024 * 16)
+	#define DG_MEMORY_BIN_ENTRIES				(DG_MEMORY_SIZE / DG_MEMORY_GRANULARITY)
+	#define DG_MEMORY_THREAD_CACHE_BYTES		(1024 * 8)
+
+	public: 
+
+	class dgMemoryBin
+	{
+		public: 
+		class dgMemoryBinInfo
+		{
+			public: 
+			dgInt32 m_count;
+			dgInt32 m_totalCount;
+			dgInt32 m_stepInBites;
+			dgMemoryBin* m_next;
+			dgMemoryBin* m_prev;
+		};
+
+		char m_pool[DG_MEMORY_BIN_SIZE - sizeof (dgMemoryBinInfo) - DG_MEMORY_GRANULARITY * 2];
+		dgMemoryBinInfo m_info;
+	};
+
+
+	class dgMemoryCacheEntry
+	{
+		public: 
+		dgMemoryCacheEntry* m_next;
+		dgMemoryCacheEntry* m_prev;
+	};
+
+	class dgMemoryInfo
+	{
+		public:
+		void *m_ptr;
+		dgMemoryAllocator* m_allocator;
+		dgInt32 m_size;
+		dgInt32 m_enum;
+#ifdef _DEBUG
+		dgInt32 m_workingSize;
+#endif
+
+		DG_INLINE void SaveInfo(dgMemoryAllocator* const allocator, void* const ptr, dgInt32 size, dgInt32& enumerator, dgInt32 workingSize = 0)
+		{
+			m_ptr = ptr;
+			m_size = size;
+			m_enum = enumerator;
+			enumerator ++;
+			m_allocator = allocator;
+#ifdef _DEBUG
+			m_workingSize = workingSize;
+#endif
+		}
+	};
+
+	class dgMemDirectory
+	{	
+		public: 
+		dgMemoryBin* m_first;
+		dgMemoryCacheEntry* m_cache;
+	};
+
+	// counters for one bin entry, blocks of the same size class share a bin entry  
+	class dgMemorySizeClassInfo
+	{
+		public:
+		dgInt32 m_blockSize;
+		dgInt32 m_blocksInUse;
+		dgInt32 m_blocksInThreadCaches;
+		dgInt32 m_allocations;
+		dgInt32 m_threadCacheHits;
+		dgInt32 m_sharedBinsAccesses;
+		dgInt32 m_lockContentions;
+	};
+
+	// each worker thread keeps a small magazine of free blocks per size class in front of the shared bins,
+	// allocations and frees from that thread do not lock, the magazine is refilled and drained in batches.
+	// blocks freed by a thread other than the one that allocated them simply go to the freeing thread magazine.
+	class dgThreadCache
+	{
+		public:
+		dgThreadCache (dgMemoryAllocator* const allocator);
+		~dgThreadCache ();
+
+		private:
+		class dgMagazine
+		{
+			public:
+			dgMemoryCacheEntry* m_first;
+			dgInt32 m_count;
+			dgInt32 m_capacity;
+			dgInt32 m_allocations;
+			dgInt32 m_hits;
+		};
+
+		void* Malloc (dgInt32 entry, dgInt32 memsize);
+		void Free (dgInt32 entry, void* const retPtr);
+		void Drain (dgInt32 entry, dgInt32 count);
+
+		dgMemoryAllocator* m_allocator;
+		dgThreadCache* m_next;
+		dgThreadCache* m_prev;
+		dgMagazine m_magazines[DG_MEMORY_BIN_ENTRIES];
+
+		friend class dgMemoryAllocator;
+	};
+
+
+	// this is a simple memory leak tracker, it uses an flat array of two megabyte indexed by a hatch code
+#ifdef __TRACK_MEMORY_LEAKS__
+	class dgMemoryLeaksTracker
+	{
+		#define DG_TRACK_MEMORY_LEAKS_ENTRIES (1024 * 1024 * 4)
+		class Pool
+		{	
+			public: 
+			void* m_ptr;
+			dgInt32 m_size;
+			dgInt32 m_allocationNumber;
+		};
+
+		public:
+		dgMemoryLeaksTracker();
+		~dgMemoryLeaksTracker ();
+		void RemoveBlock (void* const ptr);
+		void InsertBlock (dgInt32 size, void* const ptr);
+
+		dgInt32 m_density;
+		dgInt32 m_totalAllocatedBytes; 
+		dgInt32 m_totalAllocatedCalls; 
+		dgInt32 m_leakAllocationCounter;
+		Pool m_pool[DG_TRACK_MEMORY_LEAKS_ENTRIES];
+
+	};
+#endif
+
+	dgMemoryAllocator ();
+	~dgMemoryAllocator ();
+	void *operator new (size_t size);
+	void operator delete (void* const ptr);
+	dgInt32 GetMemoryUsed() const;
+	dgInt32 GetMemoryUsed(dgMemorySizeClassInfo* const sizeClasses, dgInt32 maxCount) const;
+	void SetAllocatorsCallback (dgMemAlloc memAlloc, dgMemFree memFree);
+	void *MallocLow (dgInt32 size, dgInt32 alignment = DG_MEMORY_GRANULARITY);
+	void FreeLow (void* const retPtr);
+	void *Malloc (dgInt32 memsize);
+	void Free (void* const retPtr);
+
+
+	protected:
+	class dgSharedBinsLock;
+
+	class dgSharedCounters
+	{
+		public:
+		dgInt32 m_allocations;
+		dgInt32 m_threadCacheHits;
+		dgInt32 m_sharedBinsAccesses;
+		dgInt32 m_lockContentions;
+	};
+
+	dgMemoryAllocator (dgMemAlloc memAlloc, dgMemFree memFree);
+	void *MallocBin (dgInt32 entry, dgInt32 memsize);
+	void FreeBin (void* const retPtr);
+
+	dgInt32 m_emumerator;
+	dgInt32 m_memoryUsed;
+	dgInt32 m_lock;
+	dgInt32 m_threadCacheCount;
+	dgMemFree m_free;
+	dgMemAlloc m_malloc;
+	dgThreadCache* m_threadCaches;
+	dgMemDirectory m_memoryDirectory[DG_MEMORY_BIN_ENTRIES + 1]; 
+	dgSharedCounters m_counters[DG_MEMORY_BIN_ENTRIES + 1];
+
+#ifdef __TRACK_MEMORY_LEAKS__
+	dgMemoryLeaksTracker m_leaklTracker;
+#endif
+};
+
+
+// bump allocator for transient data that only lives for the duration of one world step.
+// all the memory is recycled at once by Reset, blocks that did not fit are taken from the allocator 
+// and the buffer grows to the high water mark on the next reset, so a steady simulation does not touch the heap.
+// worker threads carve their own blocks out of the arena and allocate from them without atomics.
+class dgFrameArena
+{
+	#define DG_FRAME_ARENA_ALIGNMENT		64
+	#define DG_FRAME_ARENA_THREAD_BLOCK		(1024 * 16)
+
+	public:
+	dgFrameArena (dgMemoryAllocator* const allocator, dgInt32 sizeInBytes);
+	~dgFrameArena ();
+
+	void Reset ();
+	void Reserve (dgInt32 sizeInBytes);
+
+	void* Alloc (dgInt32 sizeInBytes);
+	void* Alloc (dgInt32 sizeInBytes, dgInt32 threadIndex);
+
+	dgInt32 GetCapacity () const;
+	dgInt32 GetHighWaterMark () const;
+
+	private:
+	class dgOverflowBlock
+	{
+		public:
+		dgOverflowBlock* m_next;
+	};
+
+	class dgThreadBlock
+	{
+		public:
+		dgUnsigned8* m_ptr;
+		dgInt32 m_size;
+	};
+
+	void* AllocOverflow (dgInt32 sizeInBytes);
+
+	dgUnsigned8* m_buffer;
+	dgMemoryAllocator* m_allocator;
+	dgOverflowBlock* m_overflow;
+	dgInt32 m_capacity;
+	dgInt32 m_used;
+	dgInt32 m_highWaterMark;
+	dgInt32 m_lock;
+	dgThreadBlock m_threadBlocks[DG_MAX_THREADS_HIVE_COUNT];
+};
+
+DG_INLINE void* dgFrameArena::Alloc (dgInt32 sizeInBytes)
+{
+	sizeInBytes = (sizeInBytes + DG_FRAME_ARENA_ALIGNMENT - 1) & -DG_FRAME_ARENA_ALIGNMENT;
+	dgInt32 offset = dgAtomicExchangeAndAdd (&m_used, sizeInBytes);
+	if ((offset + sizeInBytes) <= m_capacity) {
+		return &m_buffer[offset];
+	}
+	return AllocOverflow (sizeInBytes);
+}
+
+DG_INLINE void* dgFrameArena::Alloc (dgInt32 sizeInBytes, dgInt32 threadIndex)
+{
+	dgAssert (threadIndex < DG_MAX_THREADS_HIVE_COUNT);
+	dgThreadBlock& block = m_threadBlocks[threadIndex];
+	sizeInBytes = (sizeInBytes + DG_FRAME_ARENA_ALIGNMENT - 1) & -DG_FRAME_ARENA_ALIGNMENT;
+	if (sizeInBytes > block.m_size) {
+		block.m_size = dgMax (sizeInBytes, DG_FRAME_ARENA_THREAD_BLOCK);
+		block.m_ptr = (dgUnsigned8*) Alloc (block.m_size);
+	}
+	void* const ptr = block.m_ptr;
+	block.m_ptr += sizeInBytes;
+	block.m_size -= sizeInBytes;
+	return ptr;
+}
+
+DG_INLINE dgInt32 dgFrameArena::GetCapacity () const
+{
+	return m_capacity;
+}
+
+DG_INLINE dgInt32 dgFrameArena::GetHighWaterMark () const
+{
+	return dgMax (m_highWaterMark, m_used);
+}
+
+
+#endif
+
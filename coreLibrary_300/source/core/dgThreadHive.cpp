@@ -1,243 +1,397 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgStdafx.h"
-#include "dgTypes.h"
-#include "dgMemory.h"
-#include "dgThreadHive.h"
-
-
-
-
-dgThreadHive::dgThreadBee::dgThreadBee()
-	:dgThread()
-	,m_isBusy(0)
-	,m_ticks (0)
-	,m_myMutex()
-	,m_hive(NULL)
-	,m_allocator(NULL)
-	,m_getPerformanceCount(NULL)
-{
-}
-
-dgThreadHive::dgThreadBee::~dgThreadBee()
-{
-	while (IsBusy());
-
-	dgInterlockedExchange(&m_terminate, 1);
-	m_myMutex.Release();
-	Close();
-}
-
-void dgThreadHive::dgThreadBee::SetUp(dgMemoryAllocator* const allocator, const char* const name, dgInt32 id, dgThreadHive* const hive)
-{
-	m_allocator = allocator;
-	m_hive = hive;
-	Init (name, id);
-
-	int priority = GetPriority();
-	SetPriority(priority + 1);
-}
-
-bool dgThreadHive::dgThreadBee::IsBusy() const
-{
-	return m_isBusy ? true : false;
-}
-
-void dgThreadHive::dgThreadBee::SetPerfomanceCounter(OnGetPerformanceCountCallback callback)
-{
-	m_getPerformanceCount = callback;
-}
-
-
-void dgThreadHive::dgThreadBee::Execute (dgInt32 threadId)
-{
-	m_hive->OnBeginWorkerThread (threadId);
-
-	while (!m_terminate) {
-		dgInterlockedExchange(&m_isBusy, 0);
-		SuspendExecution(m_myMutex);
-		dgInterlockedExchange(&m_isBusy, 1);
-		if (!m_terminate) {
-			RunNextJobInQueue(threadId);
-			m_hive->m_myMutex[threadId].Release();
-		}
-	}
-
-	dgInterlockedExchange(&m_isBusy, 0);
-
-	m_hive->OnEndWorkerThread (threadId);
-}
-
-
-void dgThreadHive::dgThreadBee::RunNextJobInQueue(dgInt32 threadId)
-{
-	dgUnsigned32 ticks = m_getPerformanceCount();
-
-	bool isEmpty = false;
-	do {
-		dgThreadJob job;
-		dgAssert (threadId == m_id);
-		m_hive->m_jobsCriticalSection.Lock(false);
-		isEmpty = m_hive->m_jobsPool.IsEmpty();
-		if (!isEmpty) {
-			job = m_hive->m_jobsPool.GetHead();
-			m_hive->m_jobsPool.Pop();
-		}
-		m_hive->m_jobsCriticalSection.Unlock();
-
-		if (!isEmpty) {
-			job.m_callback (job.m_context0, job.m_context1, m_id);
-		}
-	} while (!isEmpty);
-
-	
-	m_ticks += (m_getPerformanceCount() - ticks);
-}
-
-
-dgThreadHive::dgThreadHive(dgMemoryAllocator* const allocator)
-	:m_beesCount(0)
-	,m_currentIdleBee(0)
-	,m_workerBees(NULL)
-	,m_myMasterThread(NULL)
-	,m_allocator(allocator)
-	,m_jobsCriticalSection()
-	,m_globalCriticalSection()
-    ,m_jobsPool(allocator)
-{
-}
-
-dgThreadHive::~dgThreadHive()
-{
-	DestroyThreads();
-}
-
-void dgThreadHive::SetMatertThread (dgThread* const mastertThread)
-{
-	m_myMasterThread = mastertThread;
-}
-
-void dgThreadHive::DestroyThreads()
-{
-	if (m_beesCount) {
-		delete[] m_workerBees;
-		m_workerBees = NULL;
-		m_beesCount = 0;
-	}
-}
-
-
-void dgThreadHive::SetPerfomanceCounter(OnGetPerformanceCountCallback callback)
-{
-	for (dgInt32 i = 0; i < m_beesCount; i ++) {
-		m_workerBees[i].SetPerfomanceCounter(callback);
-	}
-}
-
-
-dgUnsigned32 dgThreadHive::GetPerfomanceTicks (dgUnsigned32 threadIndex) const
-{
-	return (m_beesCount && (threadIndex < dgUnsigned32(m_beesCount))) ? m_workerBees[threadIndex].m_ticks : 0;
-}
-
-
-
-
-dgInt32 dgThreadHive::GetThreadCount() const
-{
-	return m_beesCount ? m_beesCount : 1;
-}
-
-void dgThreadHive::ClearTimers()
-{
-	for (dgInt32 i = 0; i < m_beesCount; i ++) {
-		m_workerBees[i].m_ticks = 0;
-	}
-}
-
-dgInt32 dgThreadHive::GetMaxThreadCount() const
-{
-	return DG_MAX_THREADS_HIVE_COUNT;
-}
-
-
-void dgThreadHive::SetThreadsCount (dgInt32 threads)
-{
-	DestroyThreads();
-
-	m_beesCount = dgMin (threads, DG_MAX_THREADS_HIVE_COUNT);
-	if (m_beesCount == 1) {
-		m_beesCount = 0;
-	}
-
-	if (m_beesCount) {
-		m_workerBees = new (m_allocator) dgThreadBee[dgUnsigned32 (m_beesCount)];
-
-		for (dgInt32 i = 0; i < m_beesCount; i ++) {
-			char name[256];
-			sprintf (name, "dgThreadBee%d", i);
-			m_workerBees[i].SetUp(m_allocator, name, i, this);
-		}
-	}
-}
-
-
-void dgThreadHive::QueueJob (dgWorkerThreadTaskCallback callback, void* const context0, void* const context1)
-{
-	if (!m_beesCount) {
-		callback (context0, context1, 0);
-	} else {
-		#ifdef DG_USE_THREAD_EMULATION
-			callback (context0, context1, 0);
-		#else 
-			dgThreadJob job (context0, context1, callback);
-			m_jobsPool.Push(job);
-			if (m_jobsPool.IsFull()) {
-				SynchronizationBarrier ();
-			}
-		#endif
-	}
-}
-
-
-void dgThreadHive::OnBeginWorkerThread (dgInt32 threadId)
-{
-}
-
-void dgThreadHive::OnEndWorkerThread (dgInt32 threadId)
-{
-}
-
-
-void dgThreadHive::SynchronizationBarrier ()
-{
-	if (m_beesCount) {
-		for (dgInt32 i = 0; i < m_beesCount; i ++) {
-			m_workerBees[i].m_myMutex.Release();
-		}
-
-		m_myMasterThread->SuspendExecution(m_beesCount, m_myMutex);
-		dgAssert (m_jobsPool.IsEmpty());
-	}
-}
-
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgStdafx.h"
+#include "dgTypes.h"
+#include "dgMemory.h"
+#include "dgThreadHive.h"
+
+
+
+
+dgThreadHive::dgThreadBee::dgThreadBee()
+	:dgThread()
+	,m_isBusy(0)
+	,m_isSleeping(0)
+	,m_jobsGeneration(0)
+	,m_ticks (0)
+	,m_myMutex()
+	,m_hive(NULL)
+	,m_allocator(NULL)
+	,m_getPerformanceCount(NULL)
+	,m_jobsQueue(NULL)
+{
+}
+
+dgThreadHive::dgThreadBee::~dgThreadBee()
+{
+	while (IsBusy());
+
+	dgInterlockedExchange(&m_terminate, 1);
+	WakeUp();
+	Close();
+
+	if (m_jobsQueue) {
+		delete m_jobsQueue;
+	}
+}
+
+void dgThreadHive::dgThreadBee::SetUp(dgMemoryAllocator* const allocator, const char* const name, dgInt32 id, dgThreadHive* const hive)
+{
+	m_allocator = allocator;
+	m_hive = hive;
+	m_jobsGeneration = hive->m_jobsGeneration;
+	m_jobsQueue = new (allocator) dgWorkStealingQueue<dgThreadJob, DG_THREAD_BEE_JOB_SIZE>(allocator);
+	Init (name, id);
+
+	int priority = GetPriority();
+	SetPriority(priority + 1);
+}
+
+bool dgThreadHive::dgThreadBee::IsBusy() const
+{
+	return m_isBusy ? true : false;
+}
+
+void dgThreadHive::dgThreadBee::SetPerfomanceCounter(OnGetPerformanceCountCallback callback)
+{
+	m_getPerformanceCount = callback;
+}
+
+
+void dgThreadHive::dgThreadBee::Execute (dgInt32 threadId)
+{
+	// worker threads allocate from their own magazines, without locking the allocator
+	dgMemoryAllocator::dgThreadCache memoryCache (m_allocator);
+
+	m_hive->OnBeginWorkerThread (threadId);
+
+	while (!m_terminate) {
+		WaitForJobs();
+		if (!m_terminate) {
+			dgInterlockedExchange(&m_isBusy, 1);
+			RunNextJobInQueue(threadId);
+			dgInterlockedExchange(&m_isBusy, 0);
+		}
+	}
+
+	dgInterlockedExchange(&m_isBusy, 0);
+
+	m_hive->OnEndWorkerThread (threadId);
+}
+
+void dgThreadHive::dgThreadBee::WakeUp ()
+{
+	// only the thread that clears the flag releases the semaphore
+	if (dgInterlockedExchange(&m_isSleeping, 0)) {
+		m_myMutex.Release();
+	}
+}
+
+void dgThreadHive::dgThreadBee::WaitForJobs ()
+{
+	// spin for a while, this is usually enough to catch the next batch of jobs
+	const volatile dgInt32* const generation = &m_hive->m_jobsGeneration;
+	for (dgInt32 i = 0; (i < DG_THREAD_HIVE_SPIN_COUNT) && !m_terminate; i ++) {
+		if (*generation != m_jobsGeneration) {
+			m_jobsGeneration = *generation;
+			return;
+		}
+		SpinWait (i);
+	}
+
+	// go to sleep, the master thread wakes us up when a new batch is published
+	dgInterlockedExchange(&m_isSleeping, 1);
+	if ((*generation == m_jobsGeneration) && !m_terminate) {
+		SuspendExecution(m_myMutex);
+	} else if (!dgInterlockedExchange(&m_isSleeping, 0)) {
+		// somebody else already cleared the flag, consume the release
+		SuspendExecution(m_myMutex);
+	}
+	m_jobsGeneration = *generation;
+}
+
+void dgThreadHive::dgThreadBee::RunNextJobInQueue(dgInt32 threadId)
+{
+	dgAssert (threadId == m_id);
+	dgInt32 idleLoops = 0;
+	const volatile dgInt32* const pendingJobs = &m_hive->m_pendingJobs;
+	while (*pendingJobs > 0) {
+		dgThreadJob job;
+		if (m_hive->GetNextJob (m_id, job)) {
+			// only the time spent running jobs is counted, so the ticks show how busy each thread was 
+			dgUnsigned32 ticks = m_getPerformanceCount();
+			m_hive->ExecuteJob (job, m_id);
+			m_ticks += (m_getPerformanceCount() - ticks);
+			idleLoops = 0;
+		} else {
+			SpinWait (idleLoops);
+			idleLoops ++;
+		}
+	}
+}
+
+
+dgThreadHive::dgThreadHive(dgMemoryAllocator* const allocator)
+	:m_beesCount(0)
+	,m_currentIdleBee(0)
+	,m_pendingJobs(0)
+	,m_jobsGeneration(0)
+	,m_masterIsSleeping(0)
+	,m_workerBees(NULL)
+	,m_myMasterThread(NULL)
+	,m_allocator(allocator)
+	,m_globalCriticalSection()
+	,m_myMutex()
+	,m_jobsPool(allocator)
+	,m_sharedJobs(allocator)
+{
+}
+
+dgThreadHive::~dgThreadHive()
+{
+	DestroyThreads();
+}
+
+void dgThreadHive::SetMatertThread (dgThread* const mastertThread)
+{
+	m_myMasterThread = mastertThread;
+}
+
+void dgThreadHive::DestroyThreads()
+{
+	if (m_beesCount) {
+		delete[] m_workerBees;
+		m_workerBees = NULL;
+		m_beesCount = 0;
+	}
+}
+
+
+void dgThreadHive::SetPerfomanceCounter(OnGetPerformanceCountCallback callback)
+{
+	for (dgInt32 i = 0; i < m_beesCount; i ++) {
+		m_workerBees[i].SetPerfomanceCounter(callback);
+	}
+}
+
+
+dgUnsigned32 dgThreadHive::GetPerfomanceTicks (dgUnsigned32 threadIndex) const
+{
+	return (m_beesCount && (threadIndex < dgUnsigned32(m_beesCount))) ? m_workerBees[threadIndex].m_ticks : 0;
+}
+
+
+
+
+dgInt32 dgThreadHive::GetThreadCount() const
+{
+	return m_beesCount ? m_beesCount : 1;
+}
+
+void dgThreadHive::ClearTimers()
+{
+	for (dgInt32 i = 0; i < m_beesCount; i ++) {
+		m_workerBees[i].m_ticks = 0;
+	}
+}
+
+dgInt32 dgThreadHive::GetMaxThreadCount() const
+{
+	return DG_MAX_THREADS_HIVE_COUNT;
+}
+
+
+void dgThreadHive::SetThreadsCount (dgInt32 threads)
+{
+	DestroyThreads();
+
+	m_beesCount = dgMin (threads, DG_MAX_THREADS_HIVE_COUNT);
+	if (m_beesCount == 1) {
+		m_beesCount = 0;
+	}
+
+	if (m_beesCount) {
+		m_workerBees = new (m_allocator) dgThreadBee[dgUnsigned32 (m_beesCount)];
+
+		for (dgInt32 i = 0; i < m_beesCount; i ++) {
+			char name[256];
+			sprintf (name, "dgThreadBee%d", i);
+			m_workerBees[i].SetUp(m_allocator, name, i, this);
+		}
+	}
+}
+
+
+void dgThreadHive::QueueJob (dgWorkerThreadTaskCallback callback, void* const context0, void* const context1)
+{
+	if (!m_beesCount) {
+		callback (context0, context1, 0);
+	} else {
+		#ifdef DG_USE_THREAD_EMULATION
+			callback (context0, context1, 0);
+		#else 
+			// jobs are staged here and only published to the workers at the synchronization barrier
+			dgThreadJob job (context0, context1, callback);
+			m_jobsPool.Push(job);
+			if (m_jobsPool.IsFull()) {
+				SynchronizationBarrier ();
+			}
+		#endif
+	}
+}
+
+void dgThreadHive::ForkJob (dgInt32 threadId, dgInt32* const joinCounter, dgWorkerThreadTaskCallback callback, void* const context0, void* const context1)
+{
+	#ifdef DG_USE_THREAD_EMULATION
+		callback (context0, context1, threadId);
+	#else 
+		if (!m_beesCount) {
+			callback (context0, context1, threadId);
+		} else {
+			dgAssert (threadId < m_beesCount);
+			dgThreadJob job (context0, context1, callback, joinCounter);
+			dgAtomicExchangeAndAdd(joinCounter, 1);
+			dgAtomicExchangeAndAdd(&m_pendingJobs, 1);
+			if (!m_workerBees[threadId].m_jobsQueue->Push(job)) {
+				// local queue is full, just run it here
+				ExecuteJob (job, threadId);
+			}
+		}
+	#endif
+}
+
+void dgThreadHive::JoinJobs (dgInt32 threadId, dgInt32* const joinCounter)
+{
+	#ifndef DG_USE_THREAD_EMULATION
+		if (m_beesCount) {
+			dgInt32 idleLoops = 0;
+			const volatile dgInt32* const count = joinCounter;
+			while (*count > 0) {
+				dgThreadJob job;
+				if (GetNextJob (threadId, job)) {
+					ExecuteJob (job, threadId);
+					idleLoops = 0;
+				} else {
+					SpinWait (idleLoops);
+					idleLoops ++;
+				}
+			}
+		}
+	#endif
+}
+
+void dgThreadHive::SpinWait (dgInt32 iteration)
+{
+	// do not starve the threads doing the work when there are more threads than cores
+	if (iteration < DG_THREAD_HIVE_PAUSE_COUNT) {
+		dgThreadPause();
+	} else {
+		dgThreadYield();
+	}
+}
+
+bool dgThreadHive::GetNextJob (dgInt32 threadId, dgThreadJob& job)
+{
+	// local jobs first, then the shared queue and then steal from the other workers
+	if (m_workerBees[threadId].m_jobsQueue->Pop(job)) {
+		return true;
+	}
+
+	if (m_sharedJobs.Steal(job)) {
+		return true;
+	}
+
+	for (dgInt32 i = 1; i < m_beesCount; i ++) {
+		dgInt32 index = threadId + i;
+		index -= (index >= m_beesCount) ? m_beesCount : 0;
+		if (m_workerBees[index].m_jobsQueue->Steal(job)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void dgThreadHive::ExecuteJob (const dgThreadJob& job, dgInt32 threadId)
+{
+	job.m_callback (job.m_context0, job.m_context1, threadId);
+	if (job.m_joinCounter) {
+		dgAtomicExchangeAndAdd(job.m_joinCounter, -1);
+	}
+
+	if (dgAtomicExchangeAndAdd(&m_pendingJobs, -1) == 1) {
+		// this was the last job, wake up the master thread if it is sleeping on the barrier
+		if (dgInterlockedExchange(&m_masterIsSleeping, 0)) {
+			m_myMutex.Release();
+		}
+	}
+}
+
+void dgThreadHive::OnBeginWorkerThread (dgInt32 threadId)
+{
+}
+
+void dgThreadHive::OnEndWorkerThread (dgInt32 threadId)
+{
+}
+
+
+void dgThreadHive::SynchronizationBarrier ()
+{
+	if (m_beesCount && !m_jobsPool.IsEmpty()) {
+		// a job that does not fit in the shared queue stays staged and goes out with the next round
+		dgInt32 count = 0;
+		while (!m_jobsPool.IsEmpty() && m_sharedJobs.Push(m_jobsPool.GetHead())) {
+			m_jobsPool.Pop();
+			count ++;
+		}
+		dgAssert (count);
+
+		// publish the batch and wake up any sleeping worker
+		dgAtomicExchangeAndAdd(&m_pendingJobs, count);
+		dgAtomicExchangeAndAdd(&m_jobsGeneration, 1);
+		for (dgInt32 i = 0; i < m_beesCount; i ++) {
+			m_workerBees[i].WakeUp();
+		}
+
+		// spin for a while before going to sleep
+		const volatile dgInt32* const pendingJobs = &m_pendingJobs;
+		for (dgInt32 i = 0; (i < DG_THREAD_HIVE_SPIN_COUNT) && *pendingJobs; i ++) {
+			SpinWait (i);
+		}
+
+		if (*pendingJobs) {
+			dgInterlockedExchange(&m_masterIsSleeping, 1);
+			if (*pendingJobs) {
+				m_myMasterThread->SuspendExecution(m_myMutex);
+			} else if (!dgInterlockedExchange(&m_masterIsSleeping, 0)) {
+				// the last worker already cleared the flag, consume the release
+				m_myMasterThread->SuspendExecution(m_myMutex);
+			}
+		}
+		dgAssert (m_sharedJobs.IsEmpty());
+		dgAssert (!m_pendingJobs);
+
+		if (!m_jobsPool.IsEmpty()) {
+			SynchronizationBarrier ();
+		}
+	}
+}
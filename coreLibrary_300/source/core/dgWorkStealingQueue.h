@@ -0,0 +1,144 @@
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __dgWorkStealingQueue__
+#define __dgWorkStealingQueue__
+
+#include "dgStdafx.h"
+
+// fixed size Chase-Lev double ended queue.
+// the owner thread pushes and pops from the bottom end, any other thread can steal from the top end without locks.
+// the indices grow monotonically and are compared by difference, so they are allowed to wrap around.
+template<class T, dgInt32 sizeInPowerOfTwo>
+class dgWorkStealingQueue
+{
+	public:
+	DG_CLASS_ALLOCATOR(allocator)
+
+	dgWorkStealingQueue (dgMemoryAllocator* const allocator);
+	~dgWorkStealingQueue ();
+
+	bool IsEmpty() const;
+	dgInt32 GetCount() const;
+
+	// owner side
+	bool Push (const T& object);
+	bool Pop (T& object);
+
+	// thief side
+	bool Steal (T& object);
+
+	private:
+	static dgInt32 Add (dgInt32 index, dgInt32 value);
+
+	T* m_pool;
+	dgMemoryAllocator* m_allocator;
+	volatile dgInt32 m_top;
+	volatile dgInt32 m_bottom;
+};
+
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+dgWorkStealingQueue<T, sizeInPowerOfTwo>::dgWorkStealingQueue (dgMemoryAllocator* const allocator)
+	:m_allocator(allocator)
+	,m_top(0)
+	,m_bottom(0)
+{
+	dgAssert (((sizeInPowerOfTwo -1) & (-sizeInPowerOfTwo)) == 0);
+	m_pool = (T*) m_allocator->MallocLow(sizeInPowerOfTwo * sizeof (T));
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+dgWorkStealingQueue<T, sizeInPowerOfTwo>::~dgWorkStealingQueue ()
+{
+	m_allocator->FreeLow(m_pool); 
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+dgInt32 dgWorkStealingQueue<T, sizeInPowerOfTwo>::Add (dgInt32 index, dgInt32 value)
+{
+	return dgInt32 (dgUnsigned32 (index) + dgUnsigned32 (value));
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+dgInt32 dgWorkStealingQueue<T, sizeInPowerOfTwo>::GetCount() const
+{
+	dgInt32 count = dgInt32 (dgUnsigned32 (m_bottom) - dgUnsigned32 (m_top));
+	return (count > 0) ? count : 0;
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+bool dgWorkStealingQueue<T, sizeInPowerOfTwo>::IsEmpty() const
+{
+	return GetCount() == 0;
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+bool dgWorkStealingQueue<T, sizeInPowerOfTwo>::Push (const T& object)
+{
+	dgInt32 bottom = m_bottom;
+	if (dgInt32 (dgUnsigned32 (bottom) - dgUnsigned32 (m_top)) >= (sizeInPowerOfTwo - 1)) {
+		return false;
+	}
+	m_pool[bottom & (sizeInPowerOfTwo - 1)] = object;
+	// the exchange publishes the new entry to the thieves
+	dgInterlockedExchange((dgInt32*)&m_bottom, Add (bottom, 1));
+	return true;
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+bool dgWorkStealingQueue<T, sizeInPowerOfTwo>::Pop (T& object)
+{
+	// fetch and add is a full fence, the bottom must be visible before reading the top
+	dgInt32 bottom = Add (dgAtomicExchangeAndAdd((dgInt32*)&m_bottom, -1), -1);
+	dgInt32 top = m_top;
+	dgInt32 count = dgInt32 (dgUnsigned32 (bottom) - dgUnsigned32 (top));
+	if (count < 0) {
+		dgInterlockedExchange((dgInt32*)&m_bottom, top);
+		return false;
+	}
+
+	object = m_pool[bottom & (sizeInPowerOfTwo - 1)];
+	if (count > 0) {
+		return true;
+	}
+
+	// last entry, race with the thieves for it
+	bool state = dgAtomicCompareAndSwap ((dgInt32*)&m_top, top, Add (top, 1));
+	dgInterlockedExchange((dgInt32*)&m_bottom, Add (top, 1));
+	return state;
+}
+
+template<class T, dgInt32 sizeInPowerOfTwo>
+bool dgWorkStealingQueue<T, sizeInPowerOfTwo>::Steal (T& object)
+{
+	dgInt32 top = m_top;
+	dgInt32 bottom = m_bottom;
+	if (dgInt32 (dgUnsigned32 (bottom) - dgUnsigned32 (top)) <= 0) {
+		return false;
+	}
+	object = m_pool[top & (sizeInPowerOfTwo - 1)];
+	return dgAtomicCompareAndSwap ((dgInt32*)&m_top, top, Add (top, 1));
+}
+
+
+#endif
+
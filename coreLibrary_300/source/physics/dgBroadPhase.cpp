@@ -1,1875 +1,2532 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgPhysicsStdafx.h"
-#include "dgBody.h"
-#include "dgWorld.h"
-#include "dgContact.h"
-#include "dgBroadPhase.h"
-#include "dgDynamicBody.h"
-#include "dgCollisionConvex.h"
-#include "dgCollisionInstance.h"
-#include "dgDeformableContact.h"
-#include "dgWorldDynamicUpdate.h"
-#include "dgCollisionDeformableMesh.h"
-
-#define DG_CONVEX_CAST_POOLSIZE			32
-#define DG_BROADPHASE_MAX_STACK_DEPTH	256
-#define DG_BROADPHASE_AABB_SCALE		dgFloat32 (8.0f)
-#define DG_BROADPHASE_AABB_INV_SCALE	(dgFloat32 (1.0f) / DG_BROADPHASE_AABB_SCALE)
-
-dgVector dgBroadPhase::m_conservativeRotAngle (45.0f * 3.14159f / 180.0f);
-dgVector dgBroadPhase::m_obbTolerance (dgFloat32 (1.0e-5f), dgFloat32 (1.0e-5f), dgFloat32 (1.0e-5f), dgFloat32 (0.0f));
-
-
-DG_MSC_VECTOR_ALIGMENT
-class dgBroadPhase::dgNode
-{
-	public: 
-	DG_CLASS_ALLOCATOR(allocator)
-	
-	dgNode (dgBody* const body)
-		:m_minBox (body->m_minAABB)
-		,m_maxBox (body->m_maxAABB)
-		,m_body(body)
-		,m_left(NULL)
-		,m_right(NULL)
-		,m_parent(NULL)
-		,m_fitnessNode(NULL) 
-	{
-		SetAABB(body->m_minAABB, body->m_maxAABB);
-		m_body->m_collisionCell = this;
-	}
-
-	dgNode (dgNode* const sibling, dgNode* const myNode)
-		:m_body(NULL)
-		,m_left(sibling)
-		,m_right(myNode)
-		,m_parent(sibling->m_parent)
-		,m_fitnessNode(NULL)  
-	{
-		if (m_parent) {
-			if (m_parent->m_left == sibling) {
-				m_parent->m_left = this;
-			} else {
-				dgAssert (m_parent->m_right == sibling);
-				m_parent->m_right = this;
-			}
-		}
-		sibling->m_parent = this;
-		myNode->m_parent = this;
-
-		dgNode* const left = m_left;
-		dgNode* const right = m_right;
-
-		m_minBox = left->m_minBox.GetMin(right->m_minBox);
-		m_maxBox = left->m_maxBox.GetMax(right->m_maxBox);
-		dgVector side0 (m_maxBox - m_minBox);
-		m_surfaceArea = side0.DotProduct4(side0.ShiftTripleRight()).m_x;
-	}
-
-	dgNode (dgNode* const parent, const dgVector& minBox, const dgVector& maxBox)
-		:m_minBox (minBox)
-		,m_maxBox(maxBox)
-		,m_body(NULL)
-		,m_left(NULL)
-		,m_right(NULL)
-		,m_parent(parent)
-		,m_fitnessNode(NULL) 
-	{
-	}
-
-
-	~dgNode ()
-	{
-		if (m_body) {
-			dgAssert (!m_left);
-			dgAssert (!m_right);
-			dgAssert (m_body->m_collisionCell == this);
-			m_body->m_collisionCell = NULL;
-		} else {
-			if (m_left) {
-				delete m_left;
-			}
-			if (m_right) {
-				delete m_right;
-			}
-		}
-	}
-
-	void SetAABB (const dgVector& minBox, const dgVector& maxBox)
-	{
-		dgAssert (minBox.m_x <= maxBox.m_x);
-		dgAssert (minBox.m_y <= maxBox.m_y);
-		dgAssert (minBox.m_z <= maxBox.m_z);
-
-		dgVector p0 (minBox.CompProduct4(m_broadPhaseScale));
-		dgVector p1 (maxBox.CompProduct4(m_broadPhaseScale) + dgVector::m_one);
-
-		m_minBox = p0.Floor().CompProduct4(m_broadInvPhaseScale);
-		m_maxBox = p1.Floor().CompProduct4(m_broadInvPhaseScale);
-
-		dgAssert (m_minBox.m_w == dgFloat32 (0.0f));
-		dgAssert (m_maxBox.m_w == dgFloat32 (0.0f));
-
-		dgVector side0 (m_maxBox - m_minBox);
-		m_surfaceArea = side0.DotProduct4(side0.ShiftTripleRight()).m_x;
-	}
-
-
-	dgVector m_minBox;
-	dgVector m_maxBox;
-	dgFloat32 m_surfaceArea;
-	dgBody* m_body;	
-	dgNode* m_left;
-	dgNode* m_right;
-	dgNode* m_parent;
-	dgList<dgNode*>::dgListNode* m_fitnessNode;
-	static dgVector m_broadPhaseScale;
-	static dgVector m_broadInvPhaseScale;
-
-	friend class dgBody;
-	friend class dgBroadPhase;
-//	friend class dgBroadphaseSyncDescriptor;
-	friend class dgFitnessList;
-} DG_GCC_VECTOR_ALIGMENT;
-
-dgVector dgBroadPhase::dgNode::m_broadPhaseScale (DG_BROADPHASE_AABB_SCALE, DG_BROADPHASE_AABB_SCALE, DG_BROADPHASE_AABB_SCALE, dgFloat32 (0.0f));
-dgVector dgBroadPhase::dgNode::m_broadInvPhaseScale (DG_BROADPHASE_AABB_INV_SCALE, DG_BROADPHASE_AABB_INV_SCALE, DG_BROADPHASE_AABB_INV_SCALE, dgFloat32 (0.0f));
-
-class dgBroadphaseSyncDescriptor
-{
-	public:
-	dgBroadphaseSyncDescriptor (dgFloat32 timestep, dgBodyMasterList::dgListNode* const firstNode)
-		:m_newBodiesNodes(NULL)
-		,m_collindPairBodyNode (firstNode)
-		,m_forceAndTorqueBodyNode (firstNode)
-		,m_timestep (timestep) 
-		,m_pairsAtomicCounter(0)
-	{
-	}
-
-	dgList<dgBody*>::dgListNode* m_newBodiesNodes;
-	dgBodyMasterList::dgListNode* m_collindPairBodyNode;
-	dgBodyMasterList::dgListNode* m_forceAndTorqueBodyNode;
-	dgFloat32 m_timestep;
-	dgInt32 m_pairsAtomicCounter;
-
-	//dgThread::dgCriticalSection* m_lock;
-	//dgInt32 m_pairsCount;
-	//dgInt32 m_pairsAtomicCounter;
-	//dgInt32 m_jointsAtomicCounter;
-	//dgFloat32 m_timestep;
-	//dgBodyMasterList::dgListNode* m_collindPairBodyNode;
-	//dgBodyMasterList::dgListNode* m_forceAndTorqueBodyNode;
-	//dgList<dgBody*>::dgListNode* m_newBodiesNodes;
-	//dgBroadPhase::dgNode* m_pairs[1024 * 4];	
-};
-
-class dgBroadPhase::dgSpliteInfo
-{
-	public:
-	dgSpliteInfo (dgNode** const boxArray, dgInt32 boxCount)
-	{
-		dgVector minP ( dgFloat32 (1.0e15f)); 
-		dgVector maxP (-dgFloat32 (1.0e15f)); 
-
-		if (boxCount == 2) {
-			m_axis = 1;
-			for (dgInt32 i = 0; i < boxCount; i ++) {
-				dgNode* const node = boxArray[i];
-				dgAssert (node->m_body);
-				minP = minP.GetMin (node->m_minBox); 
-				maxP = maxP.GetMax (node->m_maxBox); 
-			}
-		} else {
-			dgVector median (dgFloat32 (0.0f));
-			dgVector varian (dgFloat32 (0.0f));
-			for (dgInt32 i = 0; i < boxCount; i ++) {
-				dgNode* const node = boxArray[i];
-				dgAssert (node->m_body);
-				minP = minP.GetMin (node->m_minBox); 
-				maxP = maxP.GetMax (node->m_maxBox); 
-				dgVector p ((node->m_minBox + node->m_maxBox).CompProduct4(dgVector::m_half));
-				median += p;
-				varian += p.CompProduct4(p);
-			}
-
-			varian = varian.Scale4 (dgFloat32 (boxCount)) - median.CompProduct4(median);
-
-			dgInt32 index = 0;
-			dgFloat32 maxVarian = dgFloat32 (-1.0e10f);
-			for (dgInt32 i = 0; i < 3; i ++) {
-				if (varian[i] > maxVarian) {
-					index = i;
-					maxVarian = varian[i];
-				}
-			}
-
-			dgVector center = median.Scale4 (dgFloat32 (1.0f) / dgFloat32 (boxCount));
-
-			dgFloat32 test = center[index];
-
-			dgInt32 i0 = 0;
-			dgInt32 i1 = boxCount - 1;
-			do {    
-				for (; i0 <= i1; i0 ++) {
-					dgNode* const node = boxArray[i0];
-					dgFloat32 val = (node->m_minBox[index] + node->m_maxBox[index]) * dgFloat32 (0.5f);
-					if (val > test) {
-						break;
-					}
-				}
-
-				for (; i1 >= i0; i1 --) {
-					dgNode* const node = boxArray[i1];
-					dgFloat32 val = (node->m_minBox[index] + node->m_maxBox[index]) * dgFloat32 (0.5f);
-					if (val < test) {
-						break;
-					}
-				}
-
-				if (i0 < i1)	{
-					dgSwap(boxArray[i0], boxArray[i1]);
-					i0++; 
-					i1--;
-				}
-
-			} while (i0 <= i1);
-
-			if (i0 > 0){
-				i0 --;
-			}
-			if ((i0 + 1) >= boxCount) {
-				i0 = boxCount - 2;
-			}
-			m_axis = i0 + 1;
-		}
-
-		dgAssert (maxP.m_x - minP.m_x >= dgFloat32 (0.0f));
-		dgAssert (maxP.m_y - minP.m_y >= dgFloat32 (0.0f));
-		dgAssert (maxP.m_z - minP.m_z >= dgFloat32 (0.0f));
-		m_p0 = minP;
-		m_p1 = maxP;
-	}
-
-	dgInt32 m_axis;
-	dgVector m_p0;
-	dgVector m_p1;
-};
-
-
-dgBroadPhase::dgBroadPhase(dgWorld* const world)
-	:m_world(world)
-	,m_rootNode (NULL)
-	,m_treeEntropy(dgFloat32 (0.0f))
-	,m_lru(0)
-	,m_fitness(world->GetAllocator())
-	,m_generatedBodies(world->GetAllocator())
-	,m_contacJointLock()
-	,m_criticalSectionLock()
-	,m_recursiveChunks(false)
-{
-}
-
-dgBroadPhase::~dgBroadPhase()
-{
-	if (m_rootNode) {
-		delete m_rootNode;
-	}
-}
-
-
-dgBroadPhase::dgFitnessList::dgFitnessList (dgMemoryAllocator* const allocator)
-	:dgList <dgNode*>(allocator)
-{
-}
-
-dgFloat64 dgBroadPhase::dgFitnessList::TotalCost () const
-{
-	dgFloat64 cost = dgFloat32 (0.0f);
-	for (dgListNode* node = GetFirst(); node; node = node->GetNext()) {
-		dgNode* const box = node->GetInfo();
-		cost += box->m_surfaceArea;
-	}
-	return cost;
-}
-
-dgFloat64 dgBroadPhase::CalculateEntropy ()
-{
-	dgFloat64 cost0 = m_fitness.TotalCost ();
-	dgFloat64 cost1 = cost0;
-	do {
-		cost0 = cost1;
-		for (dgFitnessList::dgListNode* node = m_fitness.GetFirst(); node; node = node->GetNext()) {
-			ImproveNodeFitness (node->GetInfo());
-		}
-		cost1 = m_fitness.TotalCost ();
-	} while (cost1 < (dgFloat32 (0.99f)) * cost0);
-	return cost1;
-}
-
-
-
-void dgBroadPhase::InvalidateCache ()
-{
-	ResetEntropy ();
-	ImproveFitness();
-}
-
-void dgBroadPhase::GetWorldSize (dgVector& p0, dgVector& p1) const
-{
-	dgAssert (0);
-}
-
-
-void dgBroadPhase::ForEachBodyInAABB (const dgVector& minBox, const dgVector& maxBox, OnBodiesInAABB callback, void* const userData) const
-{
-	if (m_rootNode) {
-		const dgNode* stackPool[DG_BROADPHASE_MAX_STACK_DEPTH];
-		dgInt32 stack = 1;
-		stackPool[0] = m_rootNode;
-
-		dgBody* const sentinel = m_world->GetSentinelBody();
-		while (stack) {
-			stack --;
-			const dgNode* const rootNode = stackPool[stack];
-			if (dgOverlapTest (rootNode->m_minBox, rootNode->m_maxBox, minBox, maxBox)) {
-
-				if (rootNode->m_body) {
-					dgAssert (!rootNode->m_left);
-					dgAssert (!rootNode->m_right);
-					dgBody* const body = rootNode->m_body;
-					if (dgOverlapTest (body->m_minAABB, body->m_maxAABB, minBox, maxBox)) {
-						if (body != sentinel) {
-							if (!callback (body, userData)) {
-								break;
-							}
-						}
-					}
-				} else {
-					stackPool[stack] = rootNode->m_left;
-					stack ++;
-					dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (stackPool[0])));
-
-					stackPool[stack] = rootNode->m_right;
-					stack ++;
-					dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (stackPool[0])));
-				}
-			}
-		}
-	}
-}
-
-
-
-DG_INLINE dgFloat32 dgBroadPhase::CalculateSurfaceArea (const dgNode* const node0, const dgNode* const node1, dgVector& minBox, dgVector& maxBox) const
-{
-	minBox = node0->m_minBox.GetMin(node1->m_minBox);
-	maxBox = node0->m_maxBox.GetMax(node1->m_maxBox);
-	dgVector side0 (maxBox - minBox);
-	return side0.DotProduct4(side0.ShiftTripleRight()).GetScalar();
-}
-
-dgBroadPhase::dgNode* dgBroadPhase::InsertNode (dgNode* const node)
-{
-	dgVector p0;
-	dgVector p1;
-
-	dgNode* sibling = m_rootNode;
-	dgFloat32 surfaceArea = CalculateSurfaceArea (node, sibling, p0, p1);
-	while(sibling->m_left && sibling->m_right) {
-		if (surfaceArea > sibling->m_surfaceArea) {
-			break;
-		} 
-
-		sibling->m_minBox = p0;
-		sibling->m_maxBox = p1;
-		sibling->m_surfaceArea = surfaceArea;
-
-		dgVector leftP0;
-		dgVector leftP1;		
-		dgFloat32 leftSurfaceArea = CalculateSurfaceArea (node, sibling->m_left, leftP0, leftP1);
-
-		dgVector rightP0;
-		dgVector rightP1;		
-		dgFloat32 rightSurfaceArea = CalculateSurfaceArea (node, sibling->m_right, rightP0, rightP1);
-
-		if (leftSurfaceArea < rightSurfaceArea) {
-			sibling = sibling->m_left;
-			p0 = leftP0;
-			p1 = leftP1;
-			surfaceArea = leftSurfaceArea;
-		} else {
-			sibling = sibling->m_right;
-			p0 = rightP0;
-			p1 = rightP1;
-			surfaceArea = rightSurfaceArea;
-		}
-	} 
-
-	dgNode* const parent = new (m_world->GetAllocator()) dgNode (sibling, node);
-	parent->m_fitnessNode = m_fitness.Append (parent);
-
-	return parent;
-}
-
-void dgBroadPhase::Add (dgBody* const body)
-{
-	// create a new leaf node;
-	dgNode* const newNode = new (m_world->GetAllocator()) dgNode (body);
-
-	if (!m_rootNode) {
-		m_rootNode = newNode;
-	} else {
-		dgNode* const node = InsertNode(newNode);
-
-		if (!node->m_parent) {
-			m_rootNode = node;
-		}
-	}
-}
-
-
-void dgBroadPhase::Remove (dgBody* const body)
-{
-	dgNode* const node = body->m_collisionCell;
-
-	dgAssert (!node->m_fitnessNode);
-
-	if (node->m_parent) {
-		dgNode* const grandParent = node->m_parent->m_parent;
-		if (grandParent) {
-			if (grandParent->m_left == node->m_parent) {
-				if (node->m_parent->m_right == node) {
-					grandParent->m_left = node->m_parent->m_left;
-					node->m_parent->m_left->m_parent = grandParent;
-					node->m_parent->m_left = NULL;
-					node->m_parent->m_parent = NULL;
-				} else {
-					grandParent->m_left = node->m_parent->m_right;
-					node->m_parent->m_right->m_parent = grandParent;
-					node->m_parent->m_right = NULL;
-					node->m_parent->m_parent = NULL;
-				}
-			} else {
-				if (node->m_parent->m_right == node) {
-					grandParent->m_right = node->m_parent->m_left;
-					node->m_parent->m_left->m_parent = grandParent;
-					node->m_parent->m_left = NULL;
-					node->m_parent->m_parent = NULL;
-				} else {
-					grandParent->m_right = node->m_parent->m_right;
-					node->m_parent->m_right->m_parent = grandParent;
-					node->m_parent->m_right = NULL;
-					node->m_parent->m_parent = NULL;
-				}
-			}
-		} else {
-			if (node->m_parent->m_right == node) {
-				m_rootNode = node->m_parent->m_left;
-				m_rootNode->m_parent = NULL;
-				node->m_parent->m_left = NULL;
-			} else {
-				m_rootNode = node->m_parent->m_right;
-				m_rootNode->m_parent = NULL;
-				node->m_parent->m_right = NULL;
-			}
-		}
-
-		dgAssert (node->m_parent->m_fitnessNode);
-		m_fitness.Remove(node->m_parent->m_fitnessNode);
-		delete node->m_parent;
-	} else {
-		delete node;
-		m_rootNode = NULL;
-	}
-}
-
-
-void dgBroadPhase::RotateLeft (dgNode* const node)
-{
-	dgVector cost1P0;
-	dgVector cost1P1;		
-	dgFloat32 cost1 = CalculateSurfaceArea (node->m_left, node->m_parent->m_left, cost1P0, cost1P1);
-
-	dgVector cost2P0;
-	dgVector cost2P1;		
-	dgFloat32 cost2 = CalculateSurfaceArea (node->m_right, node->m_parent->m_left, cost2P0, cost2P1);
-
-	dgFloat32 cost0 = node->m_surfaceArea;
-	if ((cost1 <= cost0) && (cost1 <= cost2)) {
-
-		dgNode* const parent = node->m_parent;
-		node->m_minBox = parent->m_minBox;
-		node->m_maxBox = parent->m_maxBox;
-		node->m_surfaceArea = parent->m_surfaceArea; 
-		if (parent->m_parent) {
-			if (parent->m_parent->m_left == parent) {
-				parent->m_parent->m_left = node;
-			} else {
-				dgAssert (parent->m_parent->m_right == parent);
-				parent->m_parent->m_right = node;
-			}
-		} else {
-			m_rootNode = node;
-		}
-		node->m_parent = parent->m_parent;
-		parent->m_parent = node;
-		node->m_left->m_parent = parent;
-		parent->m_right = node->m_left;
-		node->m_left = parent;
-
-		parent->m_minBox = cost1P0;
-		parent->m_maxBox = cost1P1;		
-		parent->m_surfaceArea = cost1;
-
-	} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
-		dgNode* const parent = node->m_parent;
-		node->m_minBox = parent->m_minBox;
-		node->m_maxBox = parent->m_maxBox;
-		node->m_surfaceArea = parent->m_surfaceArea; 
-		if (parent->m_parent) {
-			if (parent->m_parent->m_left == parent) {
-				parent->m_parent->m_left = node;
-			} else {
-				dgAssert (parent->m_parent->m_right == parent);
-				parent->m_parent->m_right = node;
-			}
-		} else {
-			m_rootNode = node;
-		}
-		node->m_parent = parent->m_parent;
-		parent->m_parent = node;
-		node->m_right->m_parent = parent;
-		parent->m_right = node->m_right;
-		node->m_right = parent;
-
-		parent->m_minBox = cost2P0;
-		parent->m_maxBox = cost2P1;		
-		parent->m_surfaceArea = cost2;
-	}
-}
-
-void dgBroadPhase::RotateRight (dgNode* const node)
-{
-	dgVector cost1P0;
-	dgVector cost1P1;		
-	dgFloat32 cost1 = CalculateSurfaceArea (node->m_right, node->m_parent->m_right, cost1P0, cost1P1);
-
-	dgVector cost2P0;
-	dgVector cost2P1;		
-	dgFloat32 cost2 = CalculateSurfaceArea (node->m_left, node->m_parent->m_right, cost2P0, cost2P1);
-
-	dgFloat32 cost0 = node->m_surfaceArea;
-	if ((cost1 <= cost0) && (cost1 <= cost2)) {
-		dgNode* const parent = node->m_parent;
-		node->m_minBox = parent->m_minBox;
-		node->m_maxBox = parent->m_maxBox;
-		node->m_surfaceArea = parent->m_surfaceArea; 
-		if (parent->m_parent) {
-			if (parent->m_parent->m_left == parent) {
-				parent->m_parent->m_left = node;
-			} else {
-				dgAssert (parent->m_parent->m_right == parent);
-				parent->m_parent->m_right = node;
-			}
-		} else {
-			m_rootNode = node;
-		}
-		node->m_parent = parent->m_parent;
-		parent->m_parent = node;
-		node->m_right->m_parent = parent;
-		parent->m_left = node->m_right;
-		node->m_right = parent;
-		parent->m_minBox = cost1P0;
-		parent->m_maxBox = cost1P1;		
-		parent->m_surfaceArea = cost1;
-
-	} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
-		dgNode* const parent = node->m_parent;
-		node->m_minBox = parent->m_minBox;
-		node->m_maxBox = parent->m_maxBox;
-		node->m_surfaceArea = parent->m_surfaceArea; 
-
-		if (parent->m_parent) {
-			if (parent->m_parent->m_left == parent) {
-				parent->m_parent->m_left = node;
-			} else {
-				dgAssert (parent->m_parent->m_right == parent);
-				parent->m_parent->m_right = node;
-			}
-		} else {
-			m_rootNode = node;
-		}
-		node->m_parent = parent->m_parent;
-		parent->m_parent = node;
-		node->m_left->m_parent = parent;
-		parent->m_left = node->m_left;
-		node->m_left = parent;
-
-		parent->m_minBox = cost2P0;
-		parent->m_maxBox = cost2P1;		
-		parent->m_surfaceArea = cost2;
-	}
-}
-
-
-void dgBroadPhase::ImproveNodeFitness (dgNode* const node)
-{
-	dgAssert (node->m_left);
-	dgAssert (node->m_right);
-
-	if (node->m_parent)	{
-		if (node->m_parent->m_left == node) {
-			RotateRight (node);
-		} else {
-			RotateLeft (node);
-		}
-	}
-	dgAssert (!m_rootNode->m_parent);
-}
-
-
-dgBroadPhase::dgNode* dgBroadPhase::BuildTopDown (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode)
-{
-	dgAssert (firstBox >= 0);
-	dgAssert (lastBox >= 0);
-
-	if (lastBox == firstBox) {
-		return leafArray[firstBox];
-	} else {
-		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1);
-
-		dgNode* const parent = (*nextNode)->GetInfo();
-		parent->m_parent = NULL;
-		*nextNode = (*nextNode)->GetNext();
-
-		parent->SetAABB (info.m_p0, info.m_p1);
-
-		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + info.m_axis - 1, nextNode);
-		parent->m_left->m_parent = parent;
-
-		parent->m_right = BuildTopDown (leafArray, firstBox + info.m_axis, lastBox, nextNode);
-		parent->m_right->m_parent = parent;
-		return parent;
-	}
-}
-
-
-dgInt32 dgBroadPhase::CompareNodes (const dgNode* const nodeA, const dgNode* const nodeB, void* )
-{
-	dgFloat32 areaA = nodeA->m_surfaceArea;
-	dgFloat32 areaB = nodeB->m_surfaceArea;
-	if (areaA < areaB) {
-		return -1;
-	}
-	if (areaA > areaB) {
-		return 1;
-	}
-
-	return 0;
-}
-
-
-dgBroadPhase::dgNode* dgBroadPhase::BuildTopDownBig (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode)
-{
-	if (lastBox == firstBox) {
-		return BuildTopDown (leafArray, firstBox, lastBox, nextNode);
-	}
-
-	dgInt32 midPoint = -1;
-	const dgFloat32 scale = dgFloat32 (10.0f);
-	const dgFloat32 scale2 = dgFloat32 (3.0f) * scale * scale;
-	const dgInt32 count = lastBox - firstBox;
-	for (dgInt32 i = 0; i < count; i ++) {
-		const dgNode* const node0 = leafArray[firstBox + i];
-		const dgNode* const node1 = leafArray[firstBox + i + 1];
-		if (node1->m_surfaceArea > (scale2 * node0->m_surfaceArea)) {
-			midPoint = i;
-			break;
-		}
-	}
-
-	if (midPoint == -1) {
-		return BuildTopDown (leafArray, firstBox, lastBox, nextNode);
-	} else {
-		dgNode* const parent = (*nextNode)->GetInfo();
-
-		parent->m_parent = NULL;
-		*nextNode = (*nextNode)->GetNext();
-
-		dgVector minP ( dgFloat32 (1.0e15f)); 
-		dgVector maxP (-dgFloat32 (1.0e15f)); 
-		for (dgInt32 i = 0; i <= count; i ++) {
-			const dgNode* const node = leafArray[firstBox + i];
-			dgAssert (node->m_body);
-			minP = minP.GetMin (node->m_minBox); 
-			maxP = maxP.GetMax (node->m_maxBox); 
-		}
-
-		parent->SetAABB (minP, maxP);
-		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + midPoint, nextNode);
-		parent->m_left->m_parent = parent;
-
-		parent->m_right = BuildTopDownBig (leafArray, firstBox + midPoint + 1, lastBox, nextNode);
-		parent->m_right->m_parent = parent;
-		return parent;
-	}
-}
-
-void dgBroadPhase::ResetEntropy ()
-{
-	m_treeEntropy = dgFloat32 (0.0f);
-}
-
-void dgBroadPhase::ImproveFitness()
-{
-	dgFloat64 entropy = CalculateEntropy();
-	if ((entropy > m_treeEntropy * dgFloat32 (2.0f)) || (entropy < m_treeEntropy * dgFloat32 (0.5f))) {
-		if (m_fitness.GetFirst()) {
-			dgWorld* const world = m_world;
-			dgInt32 count = m_fitness.GetCount() * 2 + 12;
-			world->m_pairMemoryBuffer.ExpandCapacityIfNeessesary (count, sizeof (dgNode*));
-
-			dgInt32 leafNodesCount = 0;
-			dgNode** const leafArray = (dgNode**)&world->m_pairMemoryBuffer[0];
-			for (dgFitnessList::dgListNode* nodePtr = m_fitness.GetFirst(); nodePtr; nodePtr = nodePtr->GetNext()) {
-				dgNode* const node = nodePtr->GetInfo();
-				dgNode* const leftNode = node->m_left;
-				if (leftNode->m_body) {
-					node->SetAABB(leftNode->m_body->m_minAABB, leftNode->m_body->m_maxAABB);
-					leafArray[leafNodesCount] = leftNode;
-					leafNodesCount ++;
-				}
-				dgNode* const rightNode = node->m_right;
-				if (rightNode->m_body) {
-					rightNode->SetAABB (rightNode->m_body->m_minAABB, rightNode->m_body->m_maxAABB);
-					leafArray[leafNodesCount] = rightNode;
-					leafNodesCount ++;
-				}
-			}
-
-			dgFitnessList::dgListNode* nodePtr = m_fitness.GetFirst();
-
-			dgSortIndirect (leafArray, leafNodesCount, CompareNodes); 
-			m_rootNode = BuildTopDownBig (leafArray, 0, leafNodesCount - 1, &nodePtr);
-			m_treeEntropy = CalculateEntropy();
-		} else {
-			m_treeEntropy = entropy;
-		}
-	}
-}
-
-void dgBroadPhase::AddPair (dgBody* const body0, dgBody* const body1, const dgVector& timestep2, dgInt32 threadID)
-{
-	dgAssert ((body0->GetInvMass().m_w != dgFloat32 (0.0f)) || (body1->GetInvMass().m_w != dgFloat32 (0.0f)) || (body0->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)) || (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)));
-
-	// add all pairs 
-	const dgBodyMaterialList* const materialList = m_world;  
-	dgCollidingPairCollector* const contactPairs = m_world;
-
-	bool isCollidable = true;
-	dgContact* contact = NULL;
-	if ((body0->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)) || (body0->GetInvMass().m_w != dgFloat32 (0.0f))) {
-		dgThreadHiveScopeLock lock (m_world, &m_contacJointLock, false);
-		for (dgBodyMasterListRow::dgListNode* link = body0->m_masterNode->GetInfo().GetFirst(); link; link = link->GetNext()) {
-			dgConstraint* const constraint = link->GetInfo().m_joint;
-			if (constraint->GetId() != dgConstraint::m_contactConstraint) {
-				break;
-			}
-			if (link->GetInfo().m_bodyNode == body1) {
-				contact = (dgContact*)constraint;
-				isCollidable = true;
-				break;
-			}
-		}
-
-		for (dgBodyMasterListRow::dgListNode* link = body0->m_masterNode->GetInfo().GetLast(); link; link = link->GetPrev()) {
-			dgConstraint* const constraint = link->GetInfo().m_joint;
-			if (constraint->GetId() == dgConstraint::m_contactConstraint) {
-				break;
-			}
-			if (link->GetInfo().m_bodyNode == body1) {
-				isCollidable = constraint->IsCollidable();
-				break;
-			}
-		}
-	} else {
-		dgThreadHiveScopeLock lock (m_world, &m_contacJointLock, false);
-		dgAssert ((body1->GetInvMass().m_w != dgFloat32 (0.0f)) || (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)));
-		for (dgBodyMasterListRow::dgListNode* link = body1->m_masterNode->GetInfo().GetFirst(); link; link = link->GetNext()) {
-			dgConstraint* const constraint = link->GetInfo().m_joint;
-			if (constraint->GetId() != dgConstraint::m_contactConstraint) {
-				break;
-			}
-			if (link->GetInfo().m_bodyNode == body0) {
-				contact = (dgContact*)constraint;
-				isCollidable = true;
-				break;
-			}
-		}
-
-		for (dgBodyMasterListRow::dgListNode* link = body1->m_masterNode->GetInfo().GetLast(); link; link = link->GetPrev()) {
-			dgConstraint* const constraint = link->GetInfo().m_joint;
-			if (constraint->GetId() == dgConstraint::m_contactConstraint) {
-				break;
-			}
-			if (link->GetInfo().m_bodyNode == body0) {
-				isCollidable = constraint->IsCollidable();
-				break;
-			}
-		}
-	}
-
-	if (isCollidable) {
-		bool newContact = false;
-		if (!contact) {
-			dgUnsigned32 group0_ID = dgUnsigned32 (body0->m_bodyGroupId);
-			dgUnsigned32 group1_ID = dgUnsigned32 (body1->m_bodyGroupId);
-			if (group1_ID < group0_ID) {
-				dgSwap (group0_ID, group1_ID);
-			}
-
-			dgUnsigned32 key = (group1_ID << 16) + group0_ID;
-			const dgContactMaterial* const material = &materialList->Find (key)->GetInfo();
-
-			if (material->m_flags & dgContactMaterial::m_collisionEnable) {
-				newContact = true;
-				dgThreadHiveScopeLock lock (m_world, &m_contacJointLock, false);
-				if (body0->IsRTTIType (dgBody::m_deformableBodyRTTI) || body1->IsRTTIType (dgBody::m_deformableBodyRTTI)) {
-					contact = new (m_world->m_allocator) dgDeformableContact (m_world, material);
-				} else {
-					contact = new (m_world->m_allocator) dgContact (m_world, material);
-				}
-				contact->AppendToActiveList();
-				m_world->AttachConstraint (contact, body0, body1);
-			}
-		}
-
-		if (newContact) {
-			contact->m_contactActive = 0;
-			contact->m_broadphaseLru = m_lru;
-			contact->m_timeOfImpact = dgFloat32 (1.0e10f);
-			contactPairs->AddPair(contact, threadID);
-		} else if (contact) {
-			dgAssert (contact);
-			bool kinematicBodyEquilibrium = (((body0->IsRTTIType(dgBody::m_kinematicBodyRTTI) ? true : false) & body0->IsCollidable()) | ((body1->IsRTTIType(dgBody::m_kinematicBodyRTTI) ? true : false) & body1->IsCollidable())) ? false : true;
-			if (!(body0->m_equilibrium & body1->m_equilibrium & kinematicBodyEquilibrium & (contact->m_closestDistance > (DG_CACHE_DIST_TOL * dgFloat32 (4.0f))))) {
-				contact->m_contactActive = 0;
-				contact->m_broadphaseLru = m_lru;
-				contact->m_timeOfImpact = dgFloat32 (1.0e10f);
-				contactPairs->AddPair(contact, threadID);
-			}
-		}
-	}
-}
-
-
-void dgBroadPhase::ApplyForceAndtorque (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
-{
-	dgFloat32 timestep = descriptor->m_timestep; 
-
-	dgBodyMasterList::dgListNode* node = NULL;
-	{
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_forceAndTorqueBodyNode;
-		if (node) {
-			descriptor->m_forceAndTorqueBodyNode = node->GetNext();
-		}
-	}
-
-	while (node) {
-		dgBody* const body = node->GetInfo().GetBody();
-
-		if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
-			dgDynamicBody* const dymamicBody = (dgDynamicBody*) body;
-
-			dymamicBody->ApplyExtenalForces (timestep, threadID);
-			if (!dymamicBody->IsInEquilibrium ()) {
-				dymamicBody->m_sleeping = false;
-				dymamicBody->m_equilibrium = false;
-				// update collision matrix only
-				dymamicBody->UpdateCollisionMatrix (timestep, threadID);
-			}
-			if (dymamicBody->GetInvMass().m_w == dgFloat32(0.0f) || body->m_collision->IsType(dgCollision::dgCollisionMesh_RTTI)) {
-				dymamicBody->m_sleeping = true;	
-				dymamicBody->m_autoSleep = true;
-				dymamicBody->m_equilibrium = true;
-			}
-			
-			dymamicBody->m_prevExternalForce = dymamicBody->m_accel;
-			dymamicBody->m_prevExternalTorque = dymamicBody->m_alpha;
-		} else {
-			dgAssert (body->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI));
-
-			if (body->IsRTTIType(dgBody::m_deformableBodyRTTI)) {
-				body->ApplyExtenalForces (timestep, threadID);
-			}
-
-			// kinematic bodies are always sleeping (skip collision with kinematic bodies)
-			if (body->IsCollidable()) {
-				body->m_sleeping = false;	
-				body->m_autoSleep = false;
-			} else {
-				body->m_sleeping = true;	
-				body->m_autoSleep = true;
-			}
-			body->m_equilibrium = true;
-
-			// update collision matrix by calling the transform callback for all kinematic bodies
-			body->UpdateMatrix (timestep, threadID);
-		}
-
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_forceAndTorqueBodyNode;
-		if (node) {
-			descriptor->m_forceAndTorqueBodyNode = node->GetNext();
-		}
-	}
-}
-
-
-void dgBroadPhase::KinematicBodyActivation (dgContact* const contatJoint) const
-{
-	dgBody* const body0 = contatJoint->GetBody0();
-	dgBody* const body1 = contatJoint->GetBody1();
-	if (body0->IsCollidable() | body1->IsCollidable()) {
-		if (body0->IsRTTIType(dgBody::m_kinematicBodyRTTI)) {
-			if (body1->IsRTTIType(dgBody::m_dynamicBodyRTTI) && (body1->GetInvMass().m_w > dgFloat32 (0.0f))) {
-				if (body1->m_equilibrium) {
-					dgVector relVeloc (body0->m_veloc - body1->m_veloc);
-					dgVector relOmega (body0->m_omega - body1->m_omega);
-					dgVector mask2 ((relVeloc.DotProduct4(relVeloc) < dgDynamicBody::m_equilibriumError2) & (relOmega.DotProduct4(relOmega) < dgDynamicBody::m_equilibriumError2));
-
-					dgThreadHiveScopeLock lock (m_world, &body1->m_criticalSectionLock, false);
-					body1->m_sleeping = false;
-					body1->m_equilibrium = mask2.GetSignMask() ? true : false;
-				}
-			}
-		} else if (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI)) {
-			if (body0->IsRTTIType(dgBody::m_dynamicBodyRTTI) && (body0->GetInvMass().m_w > dgFloat32 (0.0f))) {
-				if (body0->m_equilibrium) {
-					dgVector relVeloc (body0->m_veloc - body1->m_veloc);
-					dgVector relOmega (body0->m_omega - body1->m_omega);
-					dgVector mask2 ((relVeloc.DotProduct4(relVeloc) < dgDynamicBody::m_equilibriumError2) & (relOmega.DotProduct4(relOmega) < dgDynamicBody::m_equilibriumError2));
-
-					dgThreadHiveScopeLock lock (m_world, &body0->m_criticalSectionLock, false);
-					body0->m_sleeping = false;
-					body0->m_equilibrium = mask2.GetSignMask() ? true : false;
-				}
-			}
-		}
-	}
-}
-
-void dgBroadPhase::CalculatePairContacts (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
-{
-	dgContactPoint contacts[DG_MAX_CONTATCS];
-	
-	dgFloat32 timestep = descriptor->m_timestep;
-	dgCollidingPairCollector* const pairCollector = m_world;
-	const dgInt32 count = pairCollector->m_count;
-	dgCollidingPairCollector::dgPair* const pairs = (dgCollidingPairCollector::dgPair*) &m_world->m_pairMemoryBuffer[0];
-
-	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_pairsAtomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_pairsAtomicCounter, 1)) {
-		dgCollidingPairCollector::dgPair* const pair = &pairs[i];
-		pair->m_cacheIsValid = false;
-		pair->m_contactBuffer = contacts;
-		m_world->CalculateContacts (pair, timestep, threadID, false, false);
-
-		if (pair->m_contactCount) {
-			dgAssert (pair->m_contactCount <= (DG_CONSTRAINT_MAX_ROWS / 3));
-			if (pair->m_isDeformable) {
-				m_world->ProcessDeformableContacts (pair, timestep, threadID);
-			} else {
-				m_world->ProcessContacts (pair, timestep, threadID);
-				KinematicBodyActivation (pair->m_contact);
-			}
-		} else {
-			if (pair->m_cacheIsValid) {
-				//m_world->ProcessCachedContacts (pair->m_contact, timestep, threadID);
-				KinematicBodyActivation (pair->m_contact);
-			} else {
-				pair->m_contact->m_maxDOF = 0;
-			}
-		}
-	}
-}
-
-//#pragma optimize( "", off )
-void dgBroadPhase::UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex)
-{
-	if (m_rootNode) {
-		dgNode* const node = body->m_collisionCell;
-		dgAssert (!node->m_left);
-		dgAssert (!node->m_right);
-
-		if (!dgBoxInclusionTest (body->m_minAABB, body->m_maxAABB, node->m_minBox, node->m_maxBox)) {
-
-			node->SetAABB(body->m_minAABB, body->m_maxAABB);
-			dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-			for (dgNode* parent = node->m_parent; parent; parent = parent->m_parent) {
-				dgVector minBox;
-				dgVector maxBox;
-				dgFloat32 area = CalculateSurfaceArea (parent->m_left, parent->m_right, minBox, maxBox);
-				if (dgBoxInclusionTest (minBox, maxBox, parent->m_minBox, parent->m_maxBox)) {
-					break;
-				}
-				parent->m_minBox = minBox;
-				parent->m_maxBox = maxBox;
-				parent->m_surfaceArea = area;
-			}
-		}
-	}
-}
-
-
-void dgBroadPhase::ForceAndToqueKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgBroadPhase* const broadPhase = world->GetBroadPhase();
-
-	if (!threadID) {
-		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
-		broadPhase->ApplyForceAndtorque (descriptor, threadID);
-		world->m_perfomanceCounters[m_forceCallbackTicks] = world->m_getPerformanceCount() - ticks0;
-	} else {
-		broadPhase->ApplyForceAndtorque (descriptor, threadID);
-	}
-}
-
-void dgBroadPhase::CollidingPairsKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgBroadPhase* const broadPhase = world->GetBroadPhase();
-
-	if (!threadID) {
-		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
-		broadPhase->FindCollidingPairs (descriptor, threadID);
-		world->m_perfomanceCounters[m_broadPhaceTicks] = world->m_getPerformanceCount() - ticks0;
-	} else {
-		broadPhase->FindCollidingPairs (descriptor, threadID);
-	}
-}
-
-void dgBroadPhase::UpdateContactsKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgBroadPhase* const broadPhase = world->GetBroadPhase();
-
-	if (!threadID) {
-		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
-		broadPhase->CalculatePairContacts (descriptor, threadID);
-		world->m_perfomanceCounters[m_narrowPhaseTicks] = world->m_getPerformanceCount() - ticks0;
-	} else {
-		broadPhase->CalculatePairContacts (descriptor, threadID);
-	}
-}
-
-
-void dgBroadPhase::AddGeneratedBodiesContactsKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgBroadPhase* const broadPhase = world->GetBroadPhase();
-
-	if (!threadID) {
-		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
-		broadPhase->FindGeneratedBodiesCollidingPairs (descriptor, threadID);
-		world->m_perfomanceCounters[m_broadPhaceTicks] += (world->m_getPerformanceCount() - ticks0);
-	} else {
-		broadPhase->FindGeneratedBodiesCollidingPairs (descriptor, threadID);
-	}
-}
-
-
-bool dgBroadPhase::TestOverlaping (const dgBody* const body0, const dgBody* const body1) const
-{
-	bool mass0 = (body0->m_invMass.m_w != dgFloat32 (0.0f)); 
-	bool mass1 = (body1->m_invMass.m_w != dgFloat32 (0.0f)); 
-	bool isDynamic0 = body0->IsRTTIType (dgBody::m_dynamicBodyRTTI) != 0;
-	bool isDynamic1 = body1->IsRTTIType (dgBody::m_dynamicBodyRTTI) != 0;
-	bool isKinematic0 = body0->IsRTTIType (dgBody::m_kinematicBodyRTTI) != 0;
-	bool isKinematic1 = body1->IsRTTIType (dgBody::m_kinematicBodyRTTI) != 0;
-
-	bool tier0 = ((-dgOverlapTest (body0->m_minAABB, body0->m_maxAABB, body1->m_minAABB, body1->m_maxAABB)) >> 4) != 0;
-	bool tier1 = !(body1->m_collision->IsType (dgCollision::dgCollisionNull_RTTI) | body0->m_collision->IsType (dgCollision::dgCollisionNull_RTTI));
-	bool tier2 = !(body0->m_sleeping & body1->m_sleeping);
-	bool tier3 = isDynamic0 & mass0; 
-	bool tier4 = isDynamic1 & mass1; 
-	bool tier5 = isKinematic0 & mass1; 
-	bool tier6 = isKinematic1 & mass0; 
-	//bool tier7 = body0->m_collision->GetCollisionMode() & body1->m_collision->GetCollisionMode(); 
-	bool tier7 = true;
-	bool ret = tier0 & tier1 & tier2 & tier7 & (tier3 | tier4 | tier5 | tier6);
-
-	if (ret) {
-		const dgCollisionInstance* const instance0 = body0->GetCollision();
-		const dgCollisionInstance* const instance1 = body1->GetCollision();
-
-		if (body0->m_continueCollisionMode | body1->m_continueCollisionMode) {
-			dgVector box0_p0;
-			dgVector box0_p1;
-			dgVector box1_p0;
-			dgVector box1_p1;
-			
-			instance0->CalcAABB(instance0->GetGlobalMatrix(), box0_p0, box0_p1);
-			instance1->CalcAABB(instance1->GetGlobalMatrix(), box1_p0, box1_p1);
-
-			dgVector boxp0 (box0_p0 - box1_p1);
-			dgVector boxp1 (box0_p1 - box1_p0);
-
-			dgVector velRelative (body1->GetVelocity() - body0->GetVelocity());
-			dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velRelative);
-			dgFloat32 distance = ray.BoxIntersect(boxp0, boxp1);
-			ret = (distance < dgFloat32 (1.0f));
-
-		} else {
-#if 1
-			dgVector size0;
-			dgVector size1;
-			dgVector origin0;
-			dgVector origin1;
-
-			instance0->CalcObb (origin0, size0);
-			instance1->CalcObb (origin1, size1);
-			dgMatrix matrix (instance1->GetGlobalMatrix() * instance0->GetGlobalMatrix().Inverse());
-
-//matrix = dgPitchMatrix(30.0 * 3.141592f / 180.0f) * dgYawMatrix(30.0 * 3.141592f / 180.0f);
-//matrix.m_posit = dgVector (0.0f, 0.5f, 0.0f, 1.0f);
-
-			dgMatrix matrixAbs;
-			matrixAbs[0] = matrix[0].Abs() + m_obbTolerance;
-			matrixAbs[1] = matrix[1].Abs() + m_obbTolerance;
-			matrixAbs[2] = matrix[2].Abs() + m_obbTolerance;
-
-			dgVector q0 (origin1 - size1);
-			dgVector q1 (origin1 + size1);
-			dgVector size (matrixAbs.UnrotateVector(size0));
-			dgVector origin (matrix.UntransformVector(origin0));
-			dgVector p0 (origin - size);
-			dgVector p1 (origin + size);
-			dgVector box0 (p0 - q1);
-			dgVector box1 (p1 - q0);
-			dgVector test (box0.CompProduct4((box1)));
-			ret = (test.GetSignMask() & 0x07) == 0x07;
-			if (ret) {
-				dgVector p0 (origin0 - size0);
-				dgVector p1 (origin0 + size0);
-				dgVector size (matrixAbs.RotateVector(size1));
-				origin1 = matrix.TransformVector(origin1);
-				dgVector q0 (origin1 - size);
-				dgVector q1 (origin1 + size);
-				dgVector box0 (p0 - q1);
-				dgVector box1 (p1 - q0);
-				dgVector test (box0.CompProduct4((box1)));
-				ret = (test.GetSignMask() & 0x07) == 0x07;
-
-/*
-				for (dgInt32 i = 0; (i < 3) && ret; i ++) {
-					dgVector dir(dgFloat32 (0.0f));
-					dir[i] = dgFloat32 (1.0f);
-					for (dgInt32 j = 0; (j < 3) && ret; j ++) {
-						dgVector crossDir (dir * matrix[j]);
-						//							if (crossDir.DotProduct4(crossDir).m_x > dgFloat32 (1.0e-7f)) 
-						{
-							dgVector sizeCross0 (size0.DotProduct4(crossDir.Abs() + m_obbTolerance));
-							dgVector originCross0 (origin0.DotProduct4(crossDir));
-							dgVector pCross0 (originCross0 - sizeCross0);
-							dgVector pCross1 (originCross0 + sizeCross0);
-
-							dgVector originCross1 (origin1.DotProduct4(crossDir));
-							dgVector crossCrossSupport1 (matrix[0].DotProduct4(crossDir).m_x, matrix[1].DotProduct4(crossDir).m_x, matrix[2].DotProduct4(crossDir).m_x, dgFloat32 (0.0f));
-							dgVector sizeCross1 (size1.DotProduct4(crossCrossSupport1.Abs() + m_obbTolerance));
-							dgVector qCross0 (originCross1 - sizeCross1);
-							dgVector qCross1 (originCross1 + sizeCross1);
-
-							dgVector boxCross0 (pCross0 - qCross1);
-							dgVector boxCross1 (pCross1 - qCross0);
-							dgVector testCross (boxCross0.CompProduct4((boxCross1)));
-							ret = (testCross.GetSignMask() & 0x01) == 0x01;
-						}
-					}
-				}
-*/
-				if (ret) {
-					dgMatrix matrixTransposed (matrix.Transpose());
-		
-					dgVector origin0_y (origin0.BroadcastY());
-					dgVector origin0_z (origin0.BroadcastZ());
-					dgVector size0_y (size0.BroadcastY());
-					dgVector size0_z (size0.BroadcastZ());
-
-					dgVector origin1_y (origin1.BroadcastY());
-					dgVector origin1_z (origin1.BroadcastZ());
-					dgVector size1_x (size1.BroadcastX());
-					dgVector size1_y (size1.BroadcastY());
-					dgVector size1_z (size1.BroadcastZ());
-					dgVector crossDir0_y (matrixTransposed[1]);
-					dgVector crossDir0_z (matrixTransposed[2]);
-
-					dgMatrix crossDir1Matrix (matrixTransposed[1].CompProduct4(matrix[0].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[0].BroadcastY()), 
-											  matrixTransposed[1].CompProduct4(matrix[1].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[1].BroadcastY()), 
-											  matrixTransposed[1].CompProduct4(matrix[2].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[2].BroadcastY()), 
-											  dgVector::m_wOne); 
-
-					dgVector originCross0 (origin0_z.CompProduct4(crossDir0_y) - origin0_y.CompProduct4(crossDir0_z));
-					dgVector sizeCross0 (size0_z.CompProduct4(crossDir0_y.Abs() + m_obbTolerance) + size0_y.CompProduct4(crossDir0_z.Abs() + m_obbTolerance));
-					dgVector originCross1 (origin1_z.CompProduct4(crossDir0_y) - origin1_y.CompProduct4(crossDir0_z));
-					dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
-
-					dgVector pCross0 (originCross0 - sizeCross0);
-					dgVector pCross1 (originCross0 + sizeCross0);
-					dgVector qCross0 (originCross1 - sizeCross1);
-					dgVector qCross1 (originCross1 + sizeCross1);
-					dgVector boxCross0 (pCross0 - qCross1);
-					dgVector boxCross1 (pCross1 - qCross0);
-					dgVector testCross (boxCross0.CompProduct4((boxCross1)));
-					ret = (testCross.GetSignMask() & 0x07) == 0x07;
-					if (ret) {
-						dgVector size0_x (size0.BroadcastX());
-						dgVector origin0_x (origin0.BroadcastX());
-						dgVector origin1_x (origin1.BroadcastX());
-						dgVector crossDir0_x (matrixTransposed[0]);
-
-						dgMatrix crossDir1Matrix (matrixTransposed[2].CompProduct4(matrix[0].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[0].BroadcastZ()), 
-												  matrixTransposed[2].CompProduct4(matrix[1].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[1].BroadcastZ()), 
-												  matrixTransposed[2].CompProduct4(matrix[2].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[2].BroadcastZ()), 
-												  dgVector::m_wOne); 
-						dgVector originCross0 (origin0_x.CompProduct4(crossDir0_z) - origin0_z.CompProduct4(crossDir0_x));
-						dgVector sizeCross0 (size0_x.CompProduct4(crossDir0_z.Abs() + m_obbTolerance) + size0_z.CompProduct4(crossDir0_x.Abs() + m_obbTolerance));
-						dgVector originCross1 (origin1_x.CompProduct4(crossDir0_z) - origin1_z.CompProduct4(crossDir0_x));
-						dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
-
-						dgVector pCross0 (originCross0 - sizeCross0);
-						dgVector pCross1 (originCross0 + sizeCross0);
-						dgVector qCross0 (originCross1 - sizeCross1);
-						dgVector qCross1 (originCross1 + sizeCross1);
-						dgVector boxCross0 (pCross0 - qCross1);
-						dgVector boxCross1 (pCross1 - qCross0);
-						dgVector testCross (boxCross0.CompProduct4((boxCross1)));
-						ret = (testCross.GetSignMask() & 0x07) == 0x07;
-						if (ret) {
-							dgMatrix crossDir1Matrix (matrixTransposed[0].CompProduct4(matrix[0].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[0].BroadcastX()), 
-													  matrixTransposed[0].CompProduct4(matrix[1].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[1].BroadcastX()), 
-													  matrixTransposed[0].CompProduct4(matrix[2].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[2].BroadcastX()), 
-													  dgVector::m_wOne); 
-
-							dgVector originCross0 (origin0_y.CompProduct4(crossDir0_x) - origin0_x.CompProduct4(crossDir0_y));
-							dgVector sizeCross0 (size0_y.CompProduct4(crossDir0_x.Abs() + m_obbTolerance) + size0_x.CompProduct4(crossDir0_y.Abs() + m_obbTolerance));
-							dgVector originCross1 (origin1_y.CompProduct4(crossDir0_x) - origin1_x.CompProduct4(crossDir0_y));
-							dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
-
-							dgVector pCross0 (originCross0 - sizeCross0);
-							dgVector pCross1 (originCross0 + sizeCross0);
-							dgVector qCross0 (originCross1 - sizeCross1);
-							dgVector qCross1 (originCross1 + sizeCross1);
-							dgVector boxCross0 (pCross0 - qCross1);
-							dgVector boxCross1 (pCross1 - qCross0);
-							dgVector testCross (boxCross0.CompProduct4((boxCross1)));
-							ret = (testCross.GetSignMask() & 0x07) == 0x07;
-						}
-					}
-				}
-			}
-#else
-			dgVector size0;
-			dgVector size1;
-			dgVector origin0;
-			dgVector origin1;
-			instance0->CalcObb (origin0, size0);
-			instance1->CalcObb (origin1, size1);
-			const dgMatrix& matrix0 = instance0->GetGlobalMatrix();
-			const dgMatrix& matrix1 = instance1->GetGlobalMatrix();
-			origin0 = matrix0.TransformVector(origin0);
-			origin1 = matrix1.TransformVector(origin1);
-			const dgVector base (origin1 - origin0);
-			dgVector dir0 (dgFloat32 (1.0f), dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f)); 
-			for (dgInt32 i = 0; i < 4; i ++) {
-				dgVector negDir (dir0.CompProduct4(dgVector::m_negOne));
-				dgVector tmpDir (matrix1.UnrotateVector(matrix0.RotateVector(dir0)));
-
-				dgVector mask0 (negDir < dgVector (dgFloat32 (0.0f)));
-				dgVector mask1 (tmpDir < dgVector (dgFloat32 (0.0f)));
-
-				dgVector q0(size0.AndNot(mask0) - (size0 & mask0));
-				dgVector p0(matrix0.UnrotateVector(matrix1.RotateVector (size1.AndNot(mask1) - (size1 & mask1)) + base));
-				
-				dgVector q0p0 (q0 - p0);
-				dgVector dot (q0p0.DotProduct4 (dir0));
-				ret = (dot.GetSignMask() & 0x01) == 0x01;
-				if (!ret) { 
-					break;
-				}
-				dgAssert ((q0p0 % q0p0) > dgFloat32 (0.0f));
-				q0p0 = q0p0.CompProduct4 (q0p0.InvMagSqrt());
-				dot = q0p0.DotProduct4 (dir0);
-				dir0 -= q0p0.CompProduct4 (dot.CompProduct4 (dgVector::m_two)); 
-				dgAssert (dgAbsf(dir0 % dir0 - dgFloat32 (1.0f)) < dgFloat32 (1.0e-3f));
-			}
-#endif
-		}
-	}
-	return ret;
-}
-
-void dgBroadPhase::SubmitPairs (dgNode* const bodyNode, dgNode* const node, const dgVector& timeStepBound, dgInt32 threadID)
-{
-	dgNode* pool[DG_BROADPHASE_MAX_STACK_DEPTH];
-	pool[0] = node;
-	dgInt32 stack = 1;
-
-	dgBody* const body0 = bodyNode->m_body;
-	dgAssert (!body0->m_collision->IsType (dgCollision::dgCollisionNull_RTTI));
-	
-	while (stack) {
-		stack --;
-		dgNode* const rootNode = pool[stack];
-		if (dgOverlapTest (rootNode->m_minBox, rootNode->m_maxBox, body0->m_minAABB, body0->m_maxAABB)) {
-			if (!rootNode->m_left) {
-				dgAssert (!rootNode->m_right);
-				dgBody* const body1 = rootNode->m_body;
-				if (TestOverlaping (body0, body1)) {
-					AddPair (body0, body1, timeStepBound, threadID);
-				}
-
-			} else {
-				pool[stack] = rootNode->m_left;
-				stack ++;
-				dgAssert (stack < dgInt32 (sizeof (pool) / sizeof (pool[0])));
-
-				pool[stack] = rootNode->m_right;
-				stack ++;
-				dgAssert (stack < dgInt32 (sizeof (pool) / sizeof (pool[0])));
-			}
-		}
-	}
-}
-
-
-void dgBroadPhase::FindCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
-{
-	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
-	dgBodyMasterList::dgListNode* node = NULL;
-	{
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_collindPairBodyNode;
-		if (node) {
-			descriptor->m_collindPairBodyNode = node->GetNext();
-		}
-	}
-	
-	while (node) {
-		dgBody* const body = node->GetInfo().GetBody();
-		if (body->m_collisionCell) {
-			if (!body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
-				dgNode* const bodyNode = body->m_collisionCell;
-				for (dgNode* ptr = bodyNode; ptr->m_parent; ptr = ptr->m_parent) {
-					dgNode* const sibling = ptr->m_parent->m_right;
-					if (sibling != ptr) {
-						SubmitPairs (bodyNode, sibling, timestep2, threadID);
-					}
-				}
-			}
-		}
-
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_collindPairBodyNode;
-		if (node) {
-			descriptor->m_collindPairBodyNode = node->GetNext();
-		}
-	}
-}
-
-void dgBroadPhase::FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
-{
-	dgAssert (0);
-
-	dgList<dgBody*>::dgListNode* node = NULL;
-	{
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_newBodiesNodes;
-		if (node) {
-			descriptor->m_newBodiesNodes = node->GetNext();
-		}
-	}
-
-	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
-	while(node) {
-		dgBody* const body = node->GetInfo();
-		if (body->m_collisionCell) {
-			if (!body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
-				dgNode* const bodyNode = body->m_collisionCell;
-				for (dgNode* ptr = bodyNode; ptr->m_parent; ptr = ptr->m_parent) {
-					dgNode* const sibling = ptr->m_parent->m_right;
-					if (sibling != ptr) {
-						SubmitPairs (bodyNode, sibling, timestep2, threadID);
-					} else {
-						dgNode* const sibling = ptr->m_parent->m_left;
-						dgAssert (sibling);
-						dgAssert (sibling != ptr);
-						SubmitPairs (bodyNode, sibling, timestep2, threadID);
-					}
-				}
-			}
-		}
-
-		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
-		node = descriptor->m_newBodiesNodes;
-		if (node) {
-			descriptor->m_newBodiesNodes = node->GetNext();
-		}
-	}
-}
-
-
-void dgBroadPhase::UpdateContactsBroadPhaseEnd ()
-{
-	// delete all non used contacts
-	dgInt32 count = 0;
-	dgUnsigned32 lru = m_lru;
-
-	dgActiveContacts* const contactList = m_world;
-	dgContact** const deadContacs = (dgContact**) &m_world->m_pairMemoryBuffer[0];
-
-	for (dgActiveContacts::dgListNode* contactNode = contactList->GetFirst(); contactNode; contactNode = contactNode->GetNext()) {
-		dgContact* const contact = contactNode->GetInfo();
-		if (contact->m_broadphaseLru != lru) {
-			const dgBody* const body0 = contact->m_body0;
-			const dgBody* const body1 = contact->m_body1;
-			if (! ((body0->m_sleeping | body0->m_equilibrium) & (body1->m_sleeping | body1->m_equilibrium)) ) {
-				if (contact->m_contactActive) {
-					contact->m_contactActive = false;
-				} else {
-					deadContacs[count] = contact;
-					count ++;
-				}
-			} else if ((lru -  contact->m_broadphaseLru) > 200) {
-				dgVector minBox (body0->m_minAABB - body1->m_maxAABB);
-				dgVector maxBox (body0->m_maxAABB - body1->m_minAABB);
-				dgVector mask ((minBox.CompProduct4(maxBox)) > dgVector (dgFloat32 (0.0f)));
-				dgVector dist ((maxBox.Abs()).GetMin (minBox.Abs()) & mask);
-				dist = dist.GetMax(dist.ShiftTripleRight());
-				dist = dist.GetMax(dist.ShiftTripleRight());
-				if (dist.GetScalar() < dgFloat32(2.0f)) {
-					contact->m_broadphaseLru = lru - 1;
-				} else {
-					if (contact->m_contactActive) {
-						contact->m_contactActive = false;
-					} else {
-						deadContacs[count] = contact;
-						count ++;
-					}
-				}
-			}
-		}
-	}
-
-	for (dgInt32 i = 0; i < count; i ++) {
-		dgContact* const contact = deadContacs[i];
-		m_world->DestroyConstraint (contact);
-	}
-}
-
-
-void dgBroadPhase::RayCast (const dgVector& l0, const dgVector& l1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const
-{
-	if (filter && m_rootNode) {
-		dgVector segment (l1 - l0);
-		dgFloat32 dist2 = segment % segment;
-		if (dist2 > dgFloat32 (1.0e-8f)) {
-
-			dgFloat32 distance[DG_COMPOUND_STACK_DEPTH];
-			const dgNode* stackPool[DG_BROADPHASE_MAX_STACK_DEPTH];
-
-			dgFastRayTest ray (l0, l1);
-
-			dgInt32 stack = 1;
-			stackPool[0] = m_rootNode;
-			distance[0] = ray.BoxIntersect(m_rootNode->m_minBox, m_rootNode->m_maxBox);
-			
-			dgFloat32 maxParam = dgFloat32 (1.2f);
-
-			dgLineBox line;	
-			line.m_l0 = l0;
-			line.m_l1 = l1;
-
-			dgVector test (line.m_l0 <= line.m_l1);
-			line.m_boxL0 = (line.m_l0 & test) | line.m_l1.AndNot(test);
-			line.m_boxL1 = (line.m_l1 & test) | line.m_l0.AndNot(test);
-
-			const dgBody* const sentinel = m_world->GetSentinelBody();
-			while (stack) {
-				stack --;
-				dgFloat32 dist = distance[stack];
-				if (dist > maxParam) {
-					break;
-				} else {
-					const dgNode* const me = stackPool[stack];
-					dgAssert (me);
-					if (me->m_body) {
-						if (me->m_body != sentinel) {
-							dgAssert (!me->m_left);
-							dgAssert (!me->m_right);
-							dgFloat32 param = me->m_body->RayCast (line, filter, prefilter, userData, maxParam);
-							if (param < maxParam) {
-								maxParam = param;
-								if (maxParam < dgFloat32 (1.0e-8f)) {
-									break;
-								}
-							}
-						}
-					} else {
-						const dgNode* const left = me->m_left;
-						dgAssert (left);
-						dgFloat32 dist = ray.BoxIntersect(left->m_minBox, left->m_maxBox);
-						if (dist < maxParam) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							stackPool[j] = left;
-							distance[j] = dist;
-							stack++;
-							dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-						}
-
-						const dgNode* const right = me->m_right;
-						dgAssert (right);
-						dist = ray.BoxIntersect(right->m_minBox, right->m_maxBox);
-						if (dist < maxParam) {
-							dgInt32 j = stack;
-							for ( ; j && (dist > distance[j - 1]); j --) {
-								stackPool[j] = stackPool[j - 1];
-								distance[j] = distance[j - 1];
-							}
-							stackPool[j] = right;
-							distance[j] = dist;
-							stack++;
-							dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-
-
-void dgBroadPhase::ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const
-{
-	if (filter && m_rootNode && shape->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
-
-		dgVector boxP0;
-		dgVector boxP1;
-		shape->CalcAABB(shape->GetLocalMatrix() * matrix, boxP0, boxP1);
-
-		dgInt32 stack = 1;
-		dgFloat32 distance[DG_COMPOUND_STACK_DEPTH];
-		const dgNode* stackPool[DG_BROADPHASE_MAX_STACK_DEPTH];		
-
-		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
-		dgFloat32 maxParam = dgFloat32 (1.02f);
-		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
-		dgFloat32 quantizeStep = dgMax (dgFloat32 (1.0f) / velocA.DotProduct4(velocA).m_x, dgFloat32 (0.001f));
-
-
-		dgVector minBox (m_rootNode->m_minBox - boxP1);
-		dgVector maxBox (m_rootNode->m_maxBox - boxP0);
-		stackPool[0] = m_rootNode;
-		distance[0] = ray.BoxIntersect(minBox, maxBox);
-
-		const dgBody* const sentinel = m_world->GetSentinelBody();
-		while (stack) {
-			stack --;
-			dgFloat32 dist = distance[stack];
-			if (dist > maxParam) {
-				break;
-			} else {
-				const dgNode* const me = stackPool[stack];
-				dgAssert (me);
-				if (me->m_body) {
-					if (me->m_body != sentinel) {
-						dgAssert (!me->m_left);
-						dgAssert (!me->m_right);
-						dgBody* const body = me->m_body;
-						if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
-							dgFloat32 param = body->ConvexRayCast (ray, shape,boxP0, boxP1, matrix, velocA, filter, prefilter, userData, maxParam, threadId);
-							if (param < maxParam) {
-								param = dgMin (param + quantizeStep, dgFloat32 (1.0f));
-								maxParam = param;
-							}
-						}
-					}
-				} else {
-					const dgNode* const left = me->m_left;
-					dgAssert (left);
-					dgVector minBox (left->m_minBox - boxP1);
-					dgVector maxBox (left->m_maxBox - boxP0);
-					dgFloat32 dist = ray.BoxIntersect(minBox, maxBox);
-					if (dist < maxParam) {
-						dgInt32 j = stack;
-						for ( ; j && (dist > distance[j - 1]); j --) {
-							stackPool[j] = stackPool[j - 1];
-							distance[j] = distance[j - 1];
-						}
-						stackPool[j] = left;
-						distance[j] = dist;
-						stack++;
-						dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-					}
-
-					const dgNode* const right = me->m_right;
-					dgAssert (right);
-					minBox = right->m_minBox - boxP1;
-					maxBox = right->m_maxBox - boxP0;
-					dist = ray.BoxIntersect(minBox, maxBox);
-					if (dist < maxParam) {
-						dgInt32 j = stack;
-						for ( ; j && (dist > distance[j - 1]); j --) {
-							stackPool[j] = stackPool[j - 1];
-							distance[j] = distance[j - 1];
-						}
-						stackPool[j] = right;
-						distance[j] = dist;
-						stack++;
-						dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-					}
-				}
-			}
-		}
-	}
-}
-
-
-dgInt32 dgBroadPhase::ConvexCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, dgFloat32& timeToImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const
-{
-	dgInt32 totalCount = 0;
-	if (m_rootNode) {
-		dgVector boxP0;
-		dgVector boxP1;
-		dgAssert (matrix.TestOrthogonal());
-		shape->CalcAABB(matrix, boxP0, boxP1);
-
-		dgInt32 stack = 1;
-		dgTriplex points[DG_CONVEX_CAST_POOLSIZE];
-		dgTriplex normals[DG_CONVEX_CAST_POOLSIZE];
-		dgFloat32 penetration[DG_CONVEX_CAST_POOLSIZE];
-		dgInt64 attributeA[DG_CONVEX_CAST_POOLSIZE];
-		dgInt64 attributeB[DG_CONVEX_CAST_POOLSIZE];
-
-		dgFloat32 distance[DG_COMPOUND_STACK_DEPTH];
-		const dgNode* stackPool[DG_BROADPHASE_MAX_STACK_DEPTH];		
-		
-		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
-		dgVector velocB(dgFloat32(0.0f));
-
-		dgFloat32 time = dgFloat32 (1.0f);
-		dgFloat32 maxParam = dgFloat32 (1.2f);
-		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
-
-		dgVector minBox (m_rootNode->m_minBox - boxP1);
-		dgVector maxBox (m_rootNode->m_maxBox - boxP0);
-		stackPool[0] = m_rootNode;
-		distance[0] = ray.BoxIntersect(minBox, maxBox);
-
-		const dgBody* const sentinel = m_world->GetSentinelBody();
-		while (stack) {
-			stack --;
-
-			dgFloat32 dist = distance[stack];
-
-			if (dist > maxParam) {
-				break;
-			} else {
-				const dgNode* const me = stackPool[stack];
-				if (me->m_body) {
-					if (me->m_body != sentinel) {
-						dgAssert (!me->m_left);
-						dgAssert (!me->m_right);
-						dgBody* const body = me->m_body;
-						if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
-							dgInt32 count = m_world->CollideContinue(shape, matrix, velocA, velocB, body->m_collision, body->m_matrix, velocB, velocB, time, points, normals, penetration, attributeA, attributeB, DG_CONVEX_CAST_POOLSIZE, threadIndex);
-
-							if (count) {
-								if (time < maxParam) {
-									if ((time - maxParam) < dgFloat32(-1.0e-3f)) {
-										totalCount = 0;
-									}
-									maxParam = time;
-									if (count >= (maxContacts - totalCount)) {
-										count = maxContacts - totalCount;
-									}
-
-									for (dgInt32 i = 0; i < count; i++) {
-										info[totalCount].m_point[0] = points[i].m_x;
-										info[totalCount].m_point[1] = points[i].m_y;
-										info[totalCount].m_point[2] = points[i].m_z;
-                                        info[totalCount].m_point[3] = dgFloat32 (0.0f);
-										info[totalCount].m_normal[0] = normals[i].m_x;
-										info[totalCount].m_normal[1] = normals[i].m_y;
-										info[totalCount].m_normal[2] = normals[i].m_z;
-                                        info[totalCount].m_normal[3] = dgFloat32 (0.0f);
-										info[totalCount].m_penetration = penetration[i];
-										info[totalCount].m_contaID = attributeB[i];
-                                        info[totalCount].m_hitBody = body;
-										totalCount++;
-									}
-								}
-								if (maxParam < 1.0e-8f) {
-									break;
-								}
-							}
-						}
-					}
-
-				} else {
-					const dgNode* const left = me->m_left;
-					dgAssert (left);
-					dgVector minBox (left->m_minBox - boxP1);
-					dgVector maxBox (left->m_maxBox - boxP0);
-					dgFloat32 dist = ray.BoxIntersect(minBox, maxBox);
-					if (dist < maxParam) {
-						dgInt32 j = stack;
-						for ( ; j && (dist > distance[j - 1]); j --) {
-							stackPool[j] = stackPool[j - 1];
-							distance[j] = distance[j - 1];
-						}
-						stackPool[j] = left;
-						distance[j] = dist;
-						stack++;
-						dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-					}
-
-					const dgNode* const right = me->m_right;
-					dgAssert (right);
-					minBox = right->m_minBox - boxP1;
-					maxBox = right->m_maxBox - boxP0;
-					dist = ray.BoxIntersect(minBox, maxBox);
-					if (dist < maxParam) {
-						dgInt32 j = stack;
-						for ( ; j && (dist > distance[j - 1]); j --) {
-							stackPool[j] = stackPool[j - 1];
-							distance[j] = distance[j - 1];
-						}
-						stackPool[j] = right;
-						distance[j] = dist;
-						stack++;
-						dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (dgNode*)));
-					}
-				}
-			}
-		}
-
-		timeToImpact = maxParam;
-	}
-
-	return totalCount;
-}
-
-void dgBroadPhase::AddInternallyGeneratedBody(dgBody* const body)
-{
-	m_generatedBodies.Append(body);
-}
-
-dgUnsigned32 dgBroadPhase::GetLRU () const
-{
-    return m_lru;
-}
-
-
-void dgBroadPhase::UpdateContacts (dgFloat32 timestep)
-{
-	dgUnsigned32 ticks = m_world->m_getPerformanceCount();
-
-	dgCollidingPairCollector* const contactPairs = m_world;
-	contactPairs->Init();
-	m_lru = m_lru + 1;
-
-	m_recursiveChunks = true;
-	dgInt32 threadsCount = m_world->GetThreadCount();	
-
-	const dgBodyMasterList* const masterList = m_world;
-	dgBodyMasterList::dgListNode* const firstBodyNode = masterList->GetFirst()->GetNext();
-
-	dgBroadphaseSyncDescriptor syncPoints(timestep, firstBodyNode);
-
-	for (dgInt32 i = 0; i < threadsCount; i ++) {
-		m_world->QueueJob (ForceAndToqueKernel, &syncPoints, m_world);
-	}
-	m_world->SynchronizationBarrier();
-
-	// update pre-listeners after the force and true are applied
-	if (m_world->m_preListener.GetCount()) {
-		dgUnsigned32 ticks = m_world->m_getPerformanceCount();
-		for (dgWorld::dgListenerList::dgListNode* node = m_world->m_preListener.GetFirst(); node; node = node->GetNext()) {
-			dgWorld::dgListener& listener = node->GetInfo();
-			listener.m_onListenerUpdate (m_world, listener.m_userData, timestep);
-		}
-		m_world->m_perfomanceCounters[m_preUpdataListerTicks] = m_world->m_getPerformanceCount() - ticks;
-	}
-
-	ImproveFitness();
-
-	for (dgInt32 i = 0; i < threadsCount; i ++) {
-		m_world->QueueJob (CollidingPairsKernel, &syncPoints, m_world);
-	}
-	m_world->SynchronizationBarrier();
-
-	for (dgInt32 i = 0; i < threadsCount; i ++) {
-		m_world->QueueJob (UpdateContactsKernel, &syncPoints, m_world);
-	}
-	m_world->SynchronizationBarrier();
-
-	m_recursiveChunks = false;
-	if (m_generatedBodies.GetCount()) {
-		syncPoints.m_newBodiesNodes = m_generatedBodies.GetFirst();
-		for (dgInt32 i = 0; i < threadsCount; i ++) {
-			m_world->QueueJob (AddGeneratedBodiesContactsKernel, &syncPoints, m_world);
-		}
-		m_world->SynchronizationBarrier();
-
-		for (dgInt32 i = 0; i < threadsCount; i ++) {
-			m_world->QueueJob (UpdateContactsKernel, &syncPoints, m_world);
-		}
-		m_world->SynchronizationBarrier();
-
-		m_generatedBodies.RemoveAll();
-	}
-
-
-	UpdateContactsBroadPhaseEnd();
-
-	dgUnsigned32 endTicks = m_world->m_getPerformanceCount();
-	m_world->m_perfomanceCounters[m_collisionTicks] = endTicks - ticks - m_world->m_perfomanceCounters[m_forceCallbackTicks];
-
-	// update soft body dynamics phase 1
-    dgDeformableBodiesUpdate* const softBodyList = m_world;
-    softBodyList->ApplyExternaForces(timestep);
-
-	m_world->m_perfomanceCounters[m_softBodyTicks] = m_world->m_getPerformanceCount() - endTicks;
-}
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgPhysicsStdafx.h"
+#include "dgBody.h"
+#include "dgWorld.h"
+#include "dgContact.h"
+#include "dgBroadPhase.h"
+#include "dgDynamicBody.h"
+#include "dgCollisionConvex.h"
+#include "dgCollisionInstance.h"
+#include "dgDeformableContact.h"
+#include "dgWorldDynamicUpdate.h"
+#include "dgCollisionDeformableMesh.h"
+
+#define DG_CONVEX_CAST_POOLSIZE			32
+#define DG_BROADPHASE_MAX_STACK_DEPTH	256
+#define DG_BROADPHASE_RAY_STACK_DEPTH	(4 * DG_BROADPHASE_MAX_STACK_DEPTH)
+#define DG_BROADPHASE_AABB_SCALE		dgFloat32 (8.0f)
+#define DG_BROADPHASE_AABB_INV_SCALE	(dgFloat32 (1.0f) / DG_BROADPHASE_AABB_SCALE)
+#define DG_BROADPHASE_WIDE_NODE_ALIGN	64
+#define DG_BROADPHASE_WIDE_GRANULARITY	256
+
+dgVector dgBroadPhase::m_conservativeRotAngle (45.0f * 3.14159f / 180.0f);
+dgVector dgBroadPhase::m_obbTolerance (dgFloat32 (1.0e-5f), dgFloat32 (1.0e-5f), dgFloat32 (1.0e-5f), dgFloat32 (0.0f));
+
+
+dgBroadPhase::dgNode::dgNode (dgBody* const body)
+	:m_minBox (body->m_minAABB)
+	,m_maxBox (body->m_maxAABB)
+	,m_body(body)
+	,m_left(NULL)
+	,m_right(NULL)
+	,m_parent(NULL)
+	,m_fitnessNode(NULL) 
+	,m_wideNode(-1)
+	,m_wideSlot(-1)
+{
+	SetAABB(body->m_minAABB, body->m_maxAABB);
+	m_body->m_collisionCell = this;
+}
+
+dgBroadPhase::dgNode::dgNode (dgNode* const sibling, dgNode* const myNode)
+	:m_body(NULL)
+	,m_left(sibling)
+	,m_right(myNode)
+	,m_parent(sibling->m_parent)
+	,m_fitnessNode(NULL)  
+	,m_wideNode(-1)
+	,m_wideSlot(-1)
+{
+	if (m_parent) {
+		if (m_parent->m_left == sibling) {
+			m_parent->m_left = this;
+		} else {
+			dgAssert (m_parent->m_right == sibling);
+			m_parent->m_right = this;
+		}
+	}
+	sibling->m_parent = this;
+	myNode->m_parent = this;
+
+	dgNode* const left = m_left;
+	dgNode* const right = m_right;
+
+	m_minBox = left->m_minBox.GetMin(right->m_minBox);
+	m_maxBox = left->m_maxBox.GetMax(right->m_maxBox);
+	dgVector side0 (m_maxBox - m_minBox);
+	m_surfaceArea = side0.DotProduct4(side0.ShiftTripleRight()).m_x;
+}
+
+dgBroadPhase::dgNode::dgNode (dgNode* const parent, const dgVector& minBox, const dgVector& maxBox)
+	:m_minBox (minBox)
+	,m_maxBox(maxBox)
+	,m_body(NULL)
+	,m_left(NULL)
+	,m_right(NULL)
+	,m_parent(parent)
+	,m_fitnessNode(NULL) 
+	,m_wideNode(-1)
+	,m_wideSlot(-1)
+{
+}
+
+dgBroadPhase::dgNode::~dgNode ()
+{
+	if (m_body) {
+		dgAssert (!m_left);
+		dgAssert (!m_right);
+		dgAssert (m_body->m_collisionCell == this);
+		m_body->m_collisionCell = NULL;
+	} else {
+		if (m_left) {
+			delete m_left;
+		}
+		if (m_right) {
+			delete m_right;
+		}
+	}
+}
+
+dgVector dgBroadPhase::dgNode::m_broadPhaseScale (DG_BROADPHASE_AABB_SCALE, DG_BROADPHASE_AABB_SCALE, DG_BROADPHASE_AABB_SCALE, dgFloat32 (0.0f));
+dgVector dgBroadPhase::dgNode::m_broadInvPhaseScale (DG_BROADPHASE_AABB_INV_SCALE, DG_BROADPHASE_AABB_INV_SCALE, DG_BROADPHASE_AABB_INV_SCALE, dgFloat32 (0.0f));
+
+
+// the binary tree is collapsed two levels at the time into nodes of up to four children, 
+// the children boxes are stored as one vector per coordinate so that a single sequence of 
+// vector instructions tests all four children against a box or a ray.
+// a child index >= 0 is a wide node, a negative index is the leaf -(index + 1)
+DG_MSC_VECTOR_ALIGMENT
+class dgBroadPhase::dgWideNode
+{
+	public:
+	DG_INLINE void Init (dgInt32 parent, dgInt32 parentSlot)
+	{
+		// empty slots get a degenerated box far away, an inverted box would still pass the ray slab test
+		m_minX = dgVector (dgFloat32 (1.0e15f));
+		m_minY = m_minX;
+		m_minZ = m_minX;
+		m_maxX = m_minX;
+		m_maxY = m_minX;
+		m_maxZ = m_minX;
+		m_child[0] = 0;
+		m_child[1] = 0;
+		m_child[2] = 0;
+		m_child[3] = 0;
+		m_parent = parent;
+		m_parentSlot = parentSlot;
+	}
+
+	DG_INLINE void SetBox (dgInt32 slot, const dgVector& minBox, const dgVector& maxBox)
+	{
+		dgAssert (slot >= 0);
+		dgAssert (slot < 4);
+		m_minX[slot] = minBox.m_x;
+		m_minY[slot] = minBox.m_y;
+		m_minZ[slot] = minBox.m_z;
+		m_maxX[slot] = maxBox.m_x;
+		m_maxY[slot] = maxBox.m_y;
+		m_maxZ[slot] = maxBox.m_z;
+	}
+
+	DG_INLINE dgInt32 OverlapMask (const dgVector& minBox, const dgVector& maxBox) const
+	{
+		dgVector test ((m_minX < maxBox.BroadcastX()) & (m_maxX > minBox.BroadcastX()));
+		test = test & (m_minY < maxBox.BroadcastY()) & (m_maxY > minBox.BroadcastY());
+		test = test & (m_minZ < maxBox.BroadcastZ()) & (m_maxZ > minBox.BroadcastZ());
+		return test.GetSignMask();
+	}
+
+	// same as dgFastRayTest::BoxIntersect, on the Minkowski sum of each child with the box (boxP0, boxP1)
+	DG_INLINE dgVector RayDistance (const dgFastRayTest& ray, const dgVector& boxP0, const dgVector& boxP1) const
+	{
+		const dgVector px (ray.m_p0.BroadcastX());
+		const dgVector py (ray.m_p0.BroadcastY());
+		const dgVector pz (ray.m_p0.BroadcastZ());
+
+		const dgVector minX (m_minX - boxP1.BroadcastX());
+		const dgVector minY (m_minY - boxP1.BroadcastY());
+		const dgVector minZ (m_minZ - boxP1.BroadcastZ());
+		const dgVector maxX (m_maxX - boxP0.BroadcastX());
+		const dgVector maxY (m_maxY - boxP0.BroadcastY());
+		const dgVector maxZ (m_maxZ - boxP0.BroadcastZ());
+
+		dgVector outside (((px <= minX) | (px >= maxX)) & ray.m_isParallel.BroadcastX());
+		outside = outside | (((py <= minY) | (py >= maxY)) & ray.m_isParallel.BroadcastY());
+		outside = outside | (((pz <= minZ) | (pz >= maxZ)) & ray.m_isParallel.BroadcastZ());
+
+		const dgVector invX (ray.m_dpInv.BroadcastX());
+		const dgVector invY (ray.m_dpInv.BroadcastY());
+		const dgVector invZ (ray.m_dpInv.BroadcastZ());
+
+		dgVector tx0 ((minX - px).CompProduct4(invX));
+		dgVector tx1 ((maxX - px).CompProduct4(invX));
+		dgVector ty0 ((minY - py).CompProduct4(invY));
+		dgVector ty1 ((maxY - py).CompProduct4(invY));
+		dgVector tz0 ((minZ - pz).CompProduct4(invZ));
+		dgVector tz1 ((maxZ - pz).CompProduct4(invZ));
+
+		dgVector t0 (ray.m_minT.GetMax(tx0.GetMin(tx1)).GetMax(ty0.GetMin(ty1)).GetMax(tz0.GetMin(tz1)));
+		dgVector t1 (ray.m_maxT.GetMin(tx0.GetMax(tx1)).GetMin(ty0.GetMax(ty1)).GetMin(tz0.GetMax(tz1)));
+
+		dgVector mask ((t0 < t1).AndNot(outside));
+		dgVector maxDist (dgFloat32 (1.2f));
+		return (t0 & mask) | maxDist.AndNot(mask);
+	}
+
+	// same as above for one ray of a packet, the ray is already broadcast and carries its own maximum parameter
+	DG_INLINE dgVector RayDistance (const dgRayPacket::dgRay& ray) const
+	{
+		dgVector outside (((ray.m_p0x <= m_minX) | (ray.m_p0x >= m_maxX)) & ray.m_isParallelX);
+		outside = outside | (((ray.m_p0y <= m_minY) | (ray.m_p0y >= m_maxY)) & ray.m_isParallelY);
+		outside = outside | (((ray.m_p0z <= m_minZ) | (ray.m_p0z >= m_maxZ)) & ray.m_isParallelZ);
+
+		dgVector tx0 ((m_minX - ray.m_p0x).CompProduct4(ray.m_dpInvX));
+		dgVector tx1 ((m_maxX - ray.m_p0x).CompProduct4(ray.m_dpInvX));
+		dgVector ty0 ((m_minY - ray.m_p0y).CompProduct4(ray.m_dpInvY));
+		dgVector ty1 ((m_maxY - ray.m_p0y).CompProduct4(ray.m_dpInvY));
+		dgVector tz0 ((m_minZ - ray.m_p0z).CompProduct4(ray.m_dpInvZ));
+		dgVector tz1 ((m_maxZ - ray.m_p0z).CompProduct4(ray.m_dpInvZ));
+
+		dgVector t0 (dgVector (dgFloat32 (0.0f)).GetMax(tx0.GetMin(tx1)).GetMax(ty0.GetMin(ty1)).GetMax(tz0.GetMin(tz1)));
+		dgVector t1 (ray.m_maxT.GetMin(tx0.GetMax(tx1)).GetMin(ty0.GetMax(ty1)).GetMin(tz0.GetMax(tz1)));
+
+		dgVector mask ((t0 < t1).AndNot(outside));
+		dgVector maxDist (dgFloat32 (1.2f));
+		return (t0 & mask) | maxDist.AndNot(mask);
+	}
+
+	// push the children closer than maxParam keeping the stack sorted with the closest child on top
+	DG_INLINE dgInt32 PushChildren (const dgVector& dist, dgFloat32 maxParam, dgInt32* const stackPool, dgFloat32* const distance, dgInt32 stack) const
+	{
+		for (dgInt32 i = 0; i < 4; i ++) {
+			dgFloat32 childDist = dist[i];
+			if (childDist < maxParam) {
+				dgInt32 j = stack;
+				for ( ; j && (childDist > distance[j - 1]); j --) {
+					stackPool[j] = stackPool[j - 1];
+					distance[j] = distance[j - 1];
+				}
+				stackPool[j] = m_child[i];
+				distance[j] = childDist;
+				stack++;
+				dgAssert (stack < DG_BROADPHASE_RAY_STACK_DEPTH);
+			}
+		}
+		return stack;
+	}
+
+	dgVector m_minX;
+	dgVector m_minY;
+	dgVector m_minZ;
+	dgVector m_maxX;
+	dgVector m_maxY;
+	dgVector m_maxZ;
+	dgInt32 m_child[4];
+	dgInt32 m_parent;
+	dgInt32 m_parentSlot;
+} DG_GCC_VECTOR_ALIGMENT;
+
+class dgBroadPhase::dgSpliteInfo
+{
+	public:
+	dgSpliteInfo (dgNode** const boxArray, dgInt32 boxCount)
+	{
+		dgVector minP ( dgFloat32 (1.0e15f)); 
+		dgVector maxP (-dgFloat32 (1.0e15f)); 
+
+		if (boxCount == 2) {
+			m_axis = 1;
+			for (dgInt32 i = 0; i < boxCount; i ++) {
+				dgNode* const node = boxArray[i];
+				dgAssert (node->m_body);
+				minP = minP.GetMin (node->m_minBox); 
+				maxP = maxP.GetMax (node->m_maxBox); 
+			}
+		} else {
+			dgVector median (dgFloat32 (0.0f));
+			dgVector varian (dgFloat32 (0.0f));
+			for (dgInt32 i = 0; i < boxCount; i ++) {
+				dgNode* const node = boxArray[i];
+				dgAssert (node->m_body);
+				minP = minP.GetMin (node->m_minBox); 
+				maxP = maxP.GetMax (node->m_maxBox); 
+				dgVector p ((node->m_minBox + node->m_maxBox).CompProduct4(dgVector::m_half));
+				median += p;
+				varian += p.CompProduct4(p);
+			}
+
+			varian = varian.Scale4 (dgFloat32 (boxCount)) - median.CompProduct4(median);
+
+			dgInt32 index = 0;
+			dgFloat32 maxVarian = dgFloat32 (-1.0e10f);
+			for (dgInt32 i = 0; i < 3; i ++) {
+				if (varian[i] > maxVarian) {
+					index = i;
+					maxVarian = varian[i];
+				}
+			}
+
+			dgVector center = median.Scale4 (dgFloat32 (1.0f) / dgFloat32 (boxCount));
+
+			dgFloat32 test = center[index];
+
+			dgInt32 i0 = 0;
+			dgInt32 i1 = boxCount - 1;
+			do {    
+				for (; i0 <= i1; i0 ++) {
+					dgNode* const node = boxArray[i0];
+					dgFloat32 val = (node->m_minBox[index] + node->m_maxBox[index]) * dgFloat32 (0.5f);
+					if (val > test) {
+						break;
+					}
+				}
+
+				for (; i1 >= i0; i1 --) {
+					dgNode* const node = boxArray[i1];
+					dgFloat32 val = (node->m_minBox[index] + node->m_maxBox[index]) * dgFloat32 (0.5f);
+					if (val < test) {
+						break;
+					}
+				}
+
+				if (i0 < i1)	{
+					dgSwap(boxArray[i0], boxArray[i1]);
+					i0++; 
+					i1--;
+				}
+
+			} while (i0 <= i1);
+
+			if (i0 > 0){
+				i0 --;
+			}
+			if ((i0 + 1) >= boxCount) {
+				i0 = boxCount - 2;
+			}
+			m_axis = i0 + 1;
+		}
+
+		dgAssert (maxP.m_x - minP.m_x >= dgFloat32 (0.0f));
+		dgAssert (maxP.m_y - minP.m_y >= dgFloat32 (0.0f));
+		dgAssert (maxP.m_z - minP.m_z >= dgFloat32 (0.0f));
+		m_p0 = minP;
+		m_p1 = maxP;
+	}
+
+	dgInt32 m_axis;
+	dgVector m_p0;
+	dgVector m_p1;
+};
+
+
+dgBroadPhase::dgBroadPhase(dgWorld* const world)
+	:m_world(world)
+	,m_rootNode (NULL)
+	,m_treeEntropy(dgFloat32 (0.0f))
+	,m_lru(0)
+	,m_fitness(world->GetAllocator())
+	,m_generatedBodies(world->GetAllocator())
+	,m_pendingContacts(DG_PENDING_CONTACTS_SIZE, world->GetAllocator())
+	,m_pendingContactsCount(0)
+	,m_contactTasks(DG_CONTACT_TASK_MAX_COUNT, world->GetAllocator())
+	,m_contactTaskPoints(DG_CONTACT_TASK_MAX_COUNT * DG_MAX_CONTACT_MANIFOLD_POINTS, world->GetAllocator())
+	,m_splitPairs(DG_CONTACT_TASK_MAX_COUNT, world->GetAllocator())
+	,m_contactTasksCount(0)
+	,m_splitPairsCount(0)
+	,m_wideNodes(DG_BROADPHASE_WIDE_GRANULARITY, world->GetAllocator(), DG_BROADPHASE_WIDE_NODE_ALIGN)
+	,m_wideLeaves(DG_BROADPHASE_WIDE_GRANULARITY, world->GetAllocator())
+	,m_wideNodesCount(0)
+	,m_wideTreeDirty(1)
+	,m_contacJointLock()
+	,m_contactTasksLock()
+	,m_criticalSectionLock()
+	,m_wideTreeLock()
+	,m_recursiveChunks(false)
+{
+}
+
+dgBroadPhase::~dgBroadPhase()
+{
+	if (m_rootNode) {
+		delete m_rootNode;
+	}
+}
+
+dgBroadPhase::dgType dgBroadPhase::GetType () const
+{
+	return m_dynamicAABBTree;
+}
+
+void dgBroadPhase::PrepareCollidingPairs ()
+{
+	ImproveFitness();
+	ValidateWideTree();
+}
+
+
+dgBroadPhase::dgFitnessList::dgFitnessList (dgMemoryAllocator* const allocator)
+	:dgList <dgNode*>(allocator)
+{
+}
+
+dgFloat64 dgBroadPhase::dgFitnessList::TotalCost () const
+{
+	dgFloat64 cost = dgFloat32 (0.0f);
+	for (dgListNode* node = GetFirst(); node; node = node->GetNext()) {
+		dgNode* const box = node->GetInfo();
+		cost += box->m_surfaceArea;
+	}
+	return cost;
+}
+
+dgFloat64 dgBroadPhase::CalculateEntropy ()
+{
+	dgFloat64 cost0 = m_fitness.TotalCost ();
+	dgFloat64 cost1 = cost0;
+	do {
+		cost0 = cost1;
+		for (dgFitnessList::dgListNode* node = m_fitness.GetFirst(); node; node = node->GetNext()) {
+			ImproveNodeFitness (node->GetInfo());
+		}
+		cost1 = m_fitness.TotalCost ();
+	} while (cost1 < (dgFloat32 (0.99f)) * cost0);
+	return cost1;
+}
+
+
+
+void dgBroadPhase::InvalidateCache ()
+{
+	ResetEntropy ();
+	ImproveFitness();
+}
+
+void dgBroadPhase::GetWorldSize (dgVector& p0, dgVector& p1) const
+{
+	dgAssert (0);
+}
+
+
+void dgBroadPhase::ForEachBodyInAABB (const dgVector& minBox, const dgVector& maxBox, OnBodiesInAABB callback, void* const userData) const
+{
+	ValidateWideTree();
+	if (m_wideNodesCount) {
+		dgInt32 stackPool[DG_BROADPHASE_MAX_STACK_DEPTH];
+		dgInt32 stack = 1;
+		stackPool[0] = 0;
+
+		dgBody* const sentinel = m_world->GetSentinelBody();
+		while (stack) {
+			stack --;
+			const dgWideNode& node = m_wideNodes[stackPool[stack]];
+			dgInt32 mask = node.OverlapMask (minBox, maxBox);
+			for (dgInt32 i = 0; mask; i ++) {
+				if (mask & 1) {
+					dgInt32 child = node.m_child[i];
+					if (child < 0) {
+						dgBody* const body = m_wideLeaves[-child - 1];
+						if (dgOverlapTest (body->m_minAABB, body->m_maxAABB, minBox, maxBox)) {
+							if (body != sentinel) {
+								if (!callback (body, userData)) {
+									return;
+								}
+							}
+						}
+					} else {
+						stackPool[stack] = child;
+						stack ++;
+						dgAssert (stack < dgInt32 (sizeof (stackPool) / sizeof (stackPool[0])));
+					}
+				}
+				mask >>= 1;
+			}
+		}
+	}
+}
+
+
+void dgBroadPhase::ValidateWideTree () const
+{
+	// the wide tree is only a cache of the binary tree, queries from the application can find it out of date 
+	// after bodies are added or removed, the first one to get here rebuilds it 
+	if (m_wideTreeDirty) {
+		dgBroadPhase* const me = (dgBroadPhase*) this;
+		dgThreadHiveScopeLock lock (m_world, &me->m_wideTreeLock, false);
+		if (m_wideTreeDirty) {
+			me->BuildWideTree();
+		}
+	}
+}
+
+void dgBroadPhase::BuildWideTree ()
+{
+	m_wideNodesCount = 0;
+	if (m_rootNode) {
+		dgInt32 leafCount = 0;
+		m_rootNode->m_wideNode = -1;
+		m_rootNode->m_wideSlot = -1;
+		BuildWideNode (m_rootNode, -1, -1, leafCount);
+	}
+	m_wideTreeDirty = 0;
+}
+
+dgInt32 dgBroadPhase::BuildWideNode (dgNode* const node, dgInt32 parent, dgInt32 parentSlot, dgInt32& leafCount)
+{
+	dgInt32 count = 0;
+	dgNode* children[4];
+	if (node->m_body) {
+		// only happens when the root is a leaf 
+		children[0] = node;
+		count = 1;
+	} else {
+		dgNode* const sides[] = {node->m_left, node->m_right};
+		for (dgInt32 i = 0; i < 2; i ++) {
+			dgNode* const side = sides[i];
+			if (side->m_body) {
+				children[count] = side;
+				count ++;
+			} else {
+				side->m_wideNode = -1;
+				side->m_wideSlot = -1;
+				children[count] = side->m_left;
+				children[count + 1] = side->m_right;
+				count += 2;
+			}
+		}
+	}
+
+	dgInt32 index = m_wideNodesCount;
+	m_wideNodesCount ++;
+
+	dgWideNode& wideNode = m_wideNodes[index];
+	wideNode.Init (parent, parentSlot);
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgNode* const child = children[i];
+		child->m_wideNode = index;
+		child->m_wideSlot = i;
+		wideNode.SetBox (i, child->m_minBox, child->m_maxBox);
+		if (child->m_body) {
+			m_wideLeaves[leafCount] = child->m_body;
+			wideNode.m_child[i] = -(leafCount + 1);
+			leafCount ++;
+		}
+	}
+
+	// the array can grow while building the children, do not keep references across the recursion
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgNode* const child = children[i];
+		if (!child->m_body) {
+			dgInt32 childIndex = BuildWideNode (child, index, i, leafCount);
+			m_wideNodes[index].m_child[i] = childIndex;
+		}
+	}
+	return index;
+}
+
+DG_INLINE void dgBroadPhase::UpdateWideNodeBox (const dgNode* const node)
+{
+	if (!m_wideTreeDirty && (node->m_wideNode >= 0)) {
+		m_wideNodes[node->m_wideNode].SetBox (node->m_wideSlot, node->m_minBox, node->m_maxBox);
+	}
+}
+
+
+DG_INLINE dgFloat32 dgBroadPhase::CalculateSurfaceArea (const dgNode* const node0, const dgNode* const node1, dgVector& minBox, dgVector& maxBox) const
+{
+	minBox = node0->m_minBox.GetMin(node1->m_minBox);
+	maxBox = node0->m_maxBox.GetMax(node1->m_maxBox);
+	dgVector side0 (maxBox - minBox);
+	return side0.DotProduct4(side0.ShiftTripleRight()).GetScalar();
+}
+
+dgBroadPhase::dgNode* dgBroadPhase::InsertNode (dgNode* const node)
+{
+	dgVector p0;
+	dgVector p1;
+
+	dgNode* sibling = m_rootNode;
+	dgFloat32 surfaceArea = CalculateSurfaceArea (node, sibling, p0, p1);
+	while(sibling->m_left && sibling->m_right) {
+		if (surfaceArea > sibling->m_surfaceArea) {
+			break;
+		} 
+
+		sibling->m_minBox = p0;
+		sibling->m_maxBox = p1;
+		sibling->m_surfaceArea = surfaceArea;
+
+		dgVector leftP0;
+		dgVector leftP1;		
+		dgFloat32 leftSurfaceArea = CalculateSurfaceArea (node, sibling->m_left, leftP0, leftP1);
+
+		dgVector rightP0;
+		dgVector rightP1;		
+		dgFloat32 rightSurfaceArea = CalculateSurfaceArea (node, sibling->m_right, rightP0, rightP1);
+
+		if (leftSurfaceArea < rightSurfaceArea) {
+			sibling = sibling->m_left;
+			p0 = leftP0;
+			p1 = leftP1;
+			surfaceArea = leftSurfaceArea;
+		} else {
+			sibling = sibling->m_right;
+			p0 = rightP0;
+			p1 = rightP1;
+			surfaceArea = rightSurfaceArea;
+		}
+	} 
+
+	dgNode* const parent = new (m_world->GetAllocator()) dgNode (sibling, node);
+	parent->m_fitnessNode = m_fitness.Append (parent);
+
+	return parent;
+}
+
+void dgBroadPhase::Add (dgBody* const body)
+{
+	// create a new leaf node;
+	dgNode* const newNode = new (m_world->GetAllocator()) dgNode (body);
+
+	m_wideTreeDirty = 1;
+	if (!m_rootNode) {
+		m_rootNode = newNode;
+	} else {
+		dgNode* const node = InsertNode(newNode);
+
+		if (!node->m_parent) {
+			m_rootNode = node;
+		}
+	}
+}
+
+
+void dgBroadPhase::Remove (dgBody* const body)
+{
+	dgNode* const node = body->m_collisionCell;
+
+	dgAssert (!node->m_fitnessNode);
+	m_wideTreeDirty = 1;
+
+	if (node->m_parent) {
+		dgNode* const grandParent = node->m_parent->m_parent;
+		if (grandParent) {
+			if (grandParent->m_left == node->m_parent) {
+				if (node->m_parent->m_right == node) {
+					grandParent->m_left = node->m_parent->m_left;
+					node->m_parent->m_left->m_parent = grandParent;
+					node->m_parent->m_left = NULL;
+					node->m_parent->m_parent = NULL;
+				} else {
+					grandParent->m_left = node->m_parent->m_right;
+					node->m_parent->m_right->m_parent = grandParent;
+					node->m_parent->m_right = NULL;
+					node->m_parent->m_parent = NULL;
+				}
+			} else {
+				if (node->m_parent->m_right == node) {
+					grandParent->m_right = node->m_parent->m_left;
+					node->m_parent->m_left->m_parent = grandParent;
+					node->m_parent->m_left = NULL;
+					node->m_parent->m_parent = NULL;
+				} else {
+					grandParent->m_right = node->m_parent->m_right;
+					node->m_parent->m_right->m_parent = grandParent;
+					node->m_parent->m_right = NULL;
+					node->m_parent->m_parent = NULL;
+				}
+			}
+		} else {
+			if (node->m_parent->m_right == node) {
+				m_rootNode = node->m_parent->m_left;
+				m_rootNode->m_parent = NULL;
+				node->m_parent->m_left = NULL;
+			} else {
+				m_rootNode = node->m_parent->m_right;
+				m_rootNode->m_parent = NULL;
+				node->m_parent->m_right = NULL;
+			}
+		}
+
+		dgAssert (node->m_parent->m_fitnessNode);
+		m_fitness.Remove(node->m_parent->m_fitnessNode);
+		delete node->m_parent;
+	} else {
+		delete node;
+		m_rootNode = NULL;
+	}
+}
+
+
+void dgBroadPhase::RotateLeft (dgNode* const node)
+{
+	dgVector cost1P0;
+	dgVector cost1P1;		
+	dgFloat32 cost1 = CalculateSurfaceArea (node->m_left, node->m_parent->m_left, cost1P0, cost1P1);
+
+	dgVector cost2P0;
+	dgVector cost2P1;		
+	dgFloat32 cost2 = CalculateSurfaceArea (node->m_right, node->m_parent->m_left, cost2P0, cost2P1);
+
+	dgFloat32 cost0 = node->m_surfaceArea;
+	if ((cost1 <= cost0) && (cost1 <= cost2)) {
+		m_wideTreeDirty = 1;
+
+		dgNode* const parent = node->m_parent;
+		node->m_minBox = parent->m_minBox;
+		node->m_maxBox = parent->m_maxBox;
+		node->m_surfaceArea = parent->m_surfaceArea; 
+		if (parent->m_parent) {
+			if (parent->m_parent->m_left == parent) {
+				parent->m_parent->m_left = node;
+			} else {
+				dgAssert (parent->m_parent->m_right == parent);
+				parent->m_parent->m_right = node;
+			}
+		} else {
+			m_rootNode = node;
+		}
+		node->m_parent = parent->m_parent;
+		parent->m_parent = node;
+		node->m_left->m_parent = parent;
+		parent->m_right = node->m_left;
+		node->m_left = parent;
+
+		parent->m_minBox = cost1P0;
+		parent->m_maxBox = cost1P1;		
+		parent->m_surfaceArea = cost1;
+
+	} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
+		m_wideTreeDirty = 1;
+		dgNode* const parent = node->m_parent;
+		node->m_minBox = parent->m_minBox;
+		node->m_maxBox = parent->m_maxBox;
+		node->m_surfaceArea = parent->m_surfaceArea; 
+		if (parent->m_parent) {
+			if (parent->m_parent->m_left == parent) {
+				parent->m_parent->m_left = node;
+			} else {
+				dgAssert (parent->m_parent->m_right == parent);
+				parent->m_parent->m_right = node;
+			}
+		} else {
+			m_rootNode = node;
+		}
+		node->m_parent = parent->m_parent;
+		parent->m_parent = node;
+		node->m_right->m_parent = parent;
+		parent->m_right = node->m_right;
+		node->m_right = parent;
+
+		parent->m_minBox = cost2P0;
+		parent->m_maxBox = cost2P1;		
+		parent->m_surfaceArea = cost2;
+	}
+}
+
+void dgBroadPhase::RotateRight (dgNode* const node)
+{
+	dgVector cost1P0;
+	dgVector cost1P1;		
+	dgFloat32 cost1 = CalculateSurfaceArea (node->m_right, node->m_parent->m_right, cost1P0, cost1P1);
+
+	dgVector cost2P0;
+	dgVector cost2P1;		
+	dgFloat32 cost2 = CalculateSurfaceArea (node->m_left, node->m_parent->m_right, cost2P0, cost2P1);
+
+	dgFloat32 cost0 = node->m_surfaceArea;
+	if ((cost1 <= cost0) && (cost1 <= cost2)) {
+		m_wideTreeDirty = 1;
+		dgNode* const parent = node->m_parent;
+		node->m_minBox = parent->m_minBox;
+		node->m_maxBox = parent->m_maxBox;
+		node->m_surfaceArea = parent->m_surfaceArea; 
+		if (parent->m_parent) {
+			if (parent->m_parent->m_left == parent) {
+				parent->m_parent->m_left = node;
+			} else {
+				dgAssert (parent->m_parent->m_right == parent);
+				parent->m_parent->m_right = node;
+			}
+		} else {
+			m_rootNode = node;
+		}
+		node->m_parent = parent->m_parent;
+		parent->m_parent = node;
+		node->m_right->m_parent = parent;
+		parent->m_left = node->m_right;
+		node->m_right = parent;
+		parent->m_minBox = cost1P0;
+		parent->m_maxBox = cost1P1;		
+		parent->m_surfaceArea = cost1;
+
+	} else if ((cost2 <= cost0) && (cost2 <= cost1)) {
+		m_wideTreeDirty = 1;
+		dgNode* const parent = node->m_parent;
+		node->m_minBox = parent->m_minBox;
+		node->m_maxBox = parent->m_maxBox;
+		node->m_surfaceArea = parent->m_surfaceArea; 
+
+		if (parent->m_parent) {
+			if (parent->m_parent->m_left == parent) {
+				parent->m_parent->m_left = node;
+			} else {
+				dgAssert (parent->m_parent->m_right == parent);
+				parent->m_parent->m_right = node;
+			}
+		} else {
+			m_rootNode = node;
+		}
+		node->m_parent = parent->m_parent;
+		parent->m_parent = node;
+		node->m_left->m_parent = parent;
+		parent->m_left = node->m_left;
+		node->m_left = parent;
+
+		parent->m_minBox = cost2P0;
+		parent->m_maxBox = cost2P1;		
+		parent->m_surfaceArea = cost2;
+	}
+}
+
+
+void dgBroadPhase::ImproveNodeFitness (dgNode* const node)
+{
+	dgAssert (node->m_left);
+	dgAssert (node->m_right);
+
+	if (node->m_parent)	{
+		if (node->m_parent->m_left == node) {
+			RotateRight (node);
+		} else {
+			RotateLeft (node);
+		}
+	}
+	dgAssert (!m_rootNode->m_parent);
+}
+
+
+dgBroadPhase::dgNode* dgBroadPhase::BuildTopDown (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode)
+{
+	dgAssert (firstBox >= 0);
+	dgAssert (lastBox >= 0);
+
+	if (lastBox == firstBox) {
+		return leafArray[firstBox];
+	} else {
+		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1);
+
+		dgNode* const parent = (*nextNode)->GetInfo();
+		parent->m_parent = NULL;
+		*nextNode = (*nextNode)->GetNext();
+
+		parent->SetAABB (info.m_p0, info.m_p1);
+
+		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + info.m_axis - 1, nextNode);
+		parent->m_left->m_parent = parent;
+
+		parent->m_right = BuildTopDown (leafArray, firstBox + info.m_axis, lastBox, nextNode);
+		parent->m_right->m_parent = parent;
+		return parent;
+	}
+}
+
+
+dgInt32 dgBroadPhase::CompareNodes (const dgNode* const nodeA, const dgNode* const nodeB, void* )
+{
+	dgFloat32 areaA = nodeA->m_surfaceArea;
+	dgFloat32 areaB = nodeB->m_surfaceArea;
+	if (areaA < areaB) {
+		return -1;
+	}
+	if (areaA > areaB) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+dgBroadPhase::dgNode* dgBroadPhase::BuildTopDownBig (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode)
+{
+	if (lastBox == firstBox) {
+		return BuildTopDown (leafArray, firstBox, lastBox, nextNode);
+	}
+
+	dgInt32 midPoint = -1;
+	const dgFloat32 scale = dgFloat32 (10.0f);
+	const dgFloat32 scale2 = dgFloat32 (3.0f) * scale * scale;
+	const dgInt32 count = lastBox - firstBox;
+	for (dgInt32 i = 0; i < count; i ++) {
+		const dgNode* const node0 = leafArray[firstBox + i];
+		const dgNode* const node1 = leafArray[firstBox + i + 1];
+		if (node1->m_surfaceArea > (scale2 * node0->m_surfaceArea)) {
+			midPoint = i;
+			break;
+		}
+	}
+
+	if (midPoint == -1) {
+		return BuildTopDown (leafArray, firstBox, lastBox, nextNode);
+	} else {
+		dgNode* const parent = (*nextNode)->GetInfo();
+
+		parent->m_parent = NULL;
+		*nextNode = (*nextNode)->GetNext();
+
+		dgVector minP ( dgFloat32 (1.0e15f)); 
+		dgVector maxP (-dgFloat32 (1.0e15f)); 
+		for (dgInt32 i = 0; i <= count; i ++) {
+			const dgNode* const node = leafArray[firstBox + i];
+			dgAssert (node->m_body);
+			minP = minP.GetMin (node->m_minBox); 
+			maxP = maxP.GetMax (node->m_maxBox); 
+		}
+
+		parent->SetAABB (minP, maxP);
+		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + midPoint, nextNode);
+		parent->m_left->m_parent = parent;
+
+		parent->m_right = BuildTopDownBig (leafArray, firstBox + midPoint + 1, lastBox, nextNode);
+		parent->m_right->m_parent = parent;
+		return parent;
+	}
+}
+
+void dgBroadPhase::ResetEntropy ()
+{
+	m_treeEntropy = dgFloat32 (0.0f);
+}
+
+void dgBroadPhase::ImproveFitness()
+{
+	dgFloat64 entropy = CalculateEntropy();
+	if ((entropy > m_treeEntropy * dgFloat32 (2.0f)) || (entropy < m_treeEntropy * dgFloat32 (0.5f))) {
+		if (m_fitness.GetFirst()) {
+			dgWorld* const world = m_world;
+			dgInt32 count = m_fitness.GetCount() * 2 + 12;
+			world->m_pairMemoryBuffer.ExpandCapacityIfNeessesary (count, sizeof (dgNode*));
+
+			dgInt32 leafNodesCount = 0;
+			dgNode** const leafArray = (dgNode**)&world->m_pairMemoryBuffer[0];
+			for (dgFitnessList::dgListNode* nodePtr = m_fitness.GetFirst(); nodePtr; nodePtr = nodePtr->GetNext()) {
+				dgNode* const node = nodePtr->GetInfo();
+				dgNode* const leftNode = node->m_left;
+				if (leftNode->m_body) {
+					node->SetAABB(leftNode->m_body->m_minAABB, leftNode->m_body->m_maxAABB);
+					leafArray[leafNodesCount] = leftNode;
+					leafNodesCount ++;
+				}
+				dgNode* const rightNode = node->m_right;
+				if (rightNode->m_body) {
+					rightNode->SetAABB (rightNode->m_body->m_minAABB, rightNode->m_body->m_maxAABB);
+					leafArray[leafNodesCount] = rightNode;
+					leafNodesCount ++;
+				}
+			}
+
+			dgFitnessList::dgListNode* nodePtr = m_fitness.GetFirst();
+
+			dgSortIndirect (leafArray, leafNodesCount, CompareNodes); 
+			m_rootNode = BuildTopDownBig (leafArray, 0, leafNodesCount - 1, &nodePtr);
+			m_wideTreeDirty = 1;
+			m_treeEntropy = CalculateEntropy();
+		} else {
+			m_treeEntropy = entropy;
+		}
+	}
+}
+
+void dgBroadPhase::AddPair (dgBody* const body0, dgBody* const body1, const dgVector& timestep2, dgInt32 threadID)
+{
+	dgAssert ((body0->GetInvMass().m_w != dgFloat32 (0.0f)) || (body1->GetInvMass().m_w != dgFloat32 (0.0f)) || (body0->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)) || (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)));
+
+	// add all pairs 
+	const dgBodyMaterialList* const materialList = m_world;  
+	dgCollidingPairCollector* const contactPairs = m_world;
+
+	// new contacts are only attached after all threads are done finding pairs, 
+	// so the joint list of the bodies can be read here without locks
+	bool isCollidable = true;
+	dgContact* contact = NULL;
+	if ((body0->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)) || (body0->GetInvMass().m_w != dgFloat32 (0.0f))) {
+		for (dgBodyMasterListRow::dgListNode* link = body0->m_masterNode->GetInfo().GetFirst(); link; link = link->GetNext()) {
+			dgConstraint* const constraint = link->GetInfo().m_joint;
+			if (constraint->GetId() != dgConstraint::m_contactConstraint) {
+				break;
+			}
+			if (link->GetInfo().m_bodyNode == body1) {
+				contact = (dgContact*)constraint;
+				isCollidable = true;
+				break;
+			}
+		}
+
+		for (dgBodyMasterListRow::dgListNode* link = body0->m_masterNode->GetInfo().GetLast(); link; link = link->GetPrev()) {
+			dgConstraint* const constraint = link->GetInfo().m_joint;
+			if (constraint->GetId() == dgConstraint::m_contactConstraint) {
+				break;
+			}
+			if (link->GetInfo().m_bodyNode == body1) {
+				isCollidable = constraint->IsCollidable();
+				break;
+			}
+		}
+	} else {
+		dgAssert ((body1->GetInvMass().m_w != dgFloat32 (0.0f)) || (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI)));
+		for (dgBodyMasterListRow::dgListNode* link = body1->m_masterNode->GetInfo().GetFirst(); link; link = link->GetNext()) {
+			dgConstraint* const constraint = link->GetInfo().m_joint;
+			if (constraint->GetId() != dgConstraint::m_contactConstraint) {
+				break;
+			}
+			if (link->GetInfo().m_bodyNode == body0) {
+				contact = (dgContact*)constraint;
+				isCollidable = true;
+				break;
+			}
+		}
+
+		for (dgBodyMasterListRow::dgListNode* link = body1->m_masterNode->GetInfo().GetLast(); link; link = link->GetPrev()) {
+			dgConstraint* const constraint = link->GetInfo().m_joint;
+			if (constraint->GetId() == dgConstraint::m_contactConstraint) {
+				break;
+			}
+			if (link->GetInfo().m_bodyNode == body0) {
+				isCollidable = constraint->IsCollidable();
+				break;
+			}
+		}
+	}
+
+	if (isCollidable) {
+		if (!contact) {
+			const dgContactMaterial* const material = materialList->FindPairMaterial (dgUnsigned32 (body0->m_bodyGroupId), dgUnsigned32 (body1->m_bodyGroupId));
+
+			if (material->m_flags & dgContactMaterial::m_collisionEnable) {
+				// defer the contact creation, the lock only guards the append to the pending array
+				dgThreadHiveScopeLock lock (m_world, &m_contacJointLock, false);
+				dgPendingContact& pendingContact = m_pendingContacts[m_pendingContactsCount];
+				pendingContact.m_body0 = body0;
+				pendingContact.m_body1 = body1;
+				pendingContact.m_material = material;
+				m_pendingContactsCount ++;
+			}
+		} else {
+			bool kinematicBodyEquilibrium = (((body0->IsRTTIType(dgBody::m_kinematicBodyRTTI) ? true : false) & body0->IsCollidable()) | ((body1->IsRTTIType(dgBody::m_kinematicBodyRTTI) ? true : false) & body1->IsCollidable())) ? false : true;
+			if (!(body0->m_equilibrium & body1->m_equilibrium & kinematicBodyEquilibrium & (contact->m_closestDistance > (DG_CACHE_DIST_TOL * dgFloat32 (4.0f))))) {
+				contact->m_contactActive = 0;
+				contact->m_broadphaseLru = m_lru;
+				contact->m_timeOfImpact = dgFloat32 (1.0e10f);
+				contactPairs->AddPair(contact, threadID);
+			}
+		}
+	}
+}
+
+
+dgInt32 dgBroadPhase::ComparePendingContacts (const dgPendingContact* const contactA, const dgPendingContact* const contactB, void* notUsed)
+{
+	const dgInt32 idA0 = dgMin (contactA->m_body0->m_uniqueID, contactA->m_body1->m_uniqueID);
+	const dgInt32 idB0 = dgMin (contactB->m_body0->m_uniqueID, contactB->m_body1->m_uniqueID);
+	if (idA0 < idB0) {
+		return -1;
+	}
+	if (idA0 > idB0) {
+		return 1;
+	}
+
+	const dgInt32 idA1 = dgMax (contactA->m_body0->m_uniqueID, contactA->m_body1->m_uniqueID);
+	const dgInt32 idB1 = dgMax (contactB->m_body0->m_uniqueID, contactB->m_body1->m_uniqueID);
+	if (idA1 < idB1) {
+		return -1;
+	}
+	if (idA1 > idB1) {
+		return 1;
+	}
+
+	if (contactA->m_body0->m_uniqueID < contactB->m_body0->m_uniqueID) {
+		return -1;
+	}
+	if (contactA->m_body0->m_uniqueID > contactB->m_body0->m_uniqueID) {
+		return 1;
+	}
+	return 0;
+}
+
+
+bool dgBroadPhase::IsSamePendingContact (const dgPendingContact* const contactA, const dgPendingContact* const contactB)
+{
+	const dgInt32 idA0 = dgMin (contactA->m_body0->m_uniqueID, contactA->m_body1->m_uniqueID);
+	const dgInt32 idB0 = dgMin (contactB->m_body0->m_uniqueID, contactB->m_body1->m_uniqueID);
+	const dgInt32 idA1 = dgMax (contactA->m_body0->m_uniqueID, contactA->m_body1->m_uniqueID);
+	const dgInt32 idB1 = dgMax (contactB->m_body0->m_uniqueID, contactB->m_body1->m_uniqueID);
+	return (idA0 == idB0) && (idA1 == idB1);
+}
+
+
+void dgBroadPhase::AttachPendingContacts ()
+{
+	if (m_pendingContactsCount) {
+		dgCollidingPairCollector* const contactPairs = m_world;
+		dgPendingContact* const pendingContacts = &m_pendingContacts[0];
+
+		// sorting makes the creation order independent of which thread found the pair, 
+		// and it places pairs submitted more than once next to each other
+		dgSort (pendingContacts, m_pendingContactsCount, ComparePendingContacts);
+
+		for (dgInt32 i = 0; i < m_pendingContactsCount; i ++) {
+			const dgPendingContact& pendingContact = pendingContacts[i];
+			// (A, B) and (B, A) are the same pair, so only the unordered ids decide what is a duplicate
+			if (i && IsSamePendingContact (&pendingContacts[i - 1], &pendingContact)) {
+				continue;
+			}
+
+			dgBody* const body0 = pendingContact.m_body0;
+			dgBody* const body1 = pendingContact.m_body1;
+			dgContact* contact = NULL;
+			if (body0->IsRTTIType (dgBody::m_deformableBodyRTTI) || body1->IsRTTIType (dgBody::m_deformableBodyRTTI)) {
+				contact = new (m_world->m_allocator) dgDeformableContact (m_world, pendingContact.m_material);
+			} else {
+				contact = new (m_world->m_allocator) dgContact (m_world, pendingContact.m_material);
+			}
+			contact->AppendToActiveList();
+			m_world->AttachConstraint (contact, body0, body1);
+
+			contact->m_contactActive = 0;
+			contact->m_broadphaseLru = m_lru;
+			contact->m_timeOfImpact = dgFloat32 (1.0e10f);
+			contactPairs->AddPair(contact, 0);
+		}
+		m_pendingContactsCount = 0;
+	}
+}
+
+
+void dgBroadPhase::PrefetchHeightFieldTiles () const
+{
+	// page in the tiles of streaming height fields under the bodies that are about to collide with them
+	const dgCollidingPairCollector* const pairCollector = m_world;
+	const dgCollidingPairCollector::dgPair* const pairs = (dgCollidingPairCollector::dgPair*) &m_world->m_pairMemoryBuffer[0];
+	for (dgInt32 i = 0; i < pairCollector->m_count; i ++) {
+		const dgContact* const contact = pairs[i].m_contact;
+		const dgBody* const body0 = contact->GetBody0();
+		const dgBody* const body1 = contact->GetBody1();
+		for (dgInt32 j = 0; j < 2; j ++) {
+			const dgBody* const body = j ? body1 : body0;
+			const dgCollisionInstance* const instance = body->GetCollision();
+			if (instance->IsType (dgCollision::dgCollisionHeightField_RTTI)) {
+				const dgCollisionHeightField* const heightField = (dgCollisionHeightField*) instance->GetChildShape();
+				if (heightField->IsTiled()) {
+					const dgBody* const otherBody = j ? body0 : body1;
+					heightField->PrefetchTiles (instance, otherBody->m_minAABB, otherBody->m_maxAABB, m_lru);
+				}
+			}
+		}
+	}
+}
+
+void dgBroadPhase::ApplyForceAndtorque (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgFloat32 timestep = descriptor->m_timestep; 
+
+	dgBodyMasterList::dgListNode* node = NULL;
+	{
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_forceAndTorqueBodyNode;
+		if (node) {
+			descriptor->m_forceAndTorqueBodyNode = node->GetNext();
+		}
+	}
+
+	while (node) {
+		dgBody* const body = node->GetInfo().GetBody();
+
+		if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+			dgDynamicBody* const dymamicBody = (dgDynamicBody*) body;
+
+			dymamicBody->ApplyExtenalForces (timestep, threadID);
+			if (!dymamicBody->IsInEquilibrium ()) {
+				dymamicBody->m_sleeping = false;
+				dymamicBody->m_equilibrium = false;
+				// update collision matrix only
+				dymamicBody->UpdateCollisionMatrix (timestep, threadID);
+			}
+			if (dymamicBody->GetInvMass().m_w == dgFloat32(0.0f) || body->m_collision->IsType(dgCollision::dgCollisionMesh_RTTI)) {
+				dymamicBody->m_sleeping = true;	
+				dymamicBody->m_autoSleep = true;
+				dymamicBody->m_equilibrium = true;
+			}
+			
+			dymamicBody->m_prevExternalForce = dymamicBody->m_accel;
+			dymamicBody->m_prevExternalTorque = dymamicBody->m_alpha;
+		} else {
+			dgAssert (body->IsRTTIType(dgBody::m_kinematicBodyRTTI | dgBody::m_deformableBodyRTTI));
+
+			if (body->IsRTTIType(dgBody::m_deformableBodyRTTI)) {
+				body->ApplyExtenalForces (timestep, threadID);
+			}
+
+			// kinematic bodies are always sleeping (skip collision with kinematic bodies)
+			if (body->IsCollidable()) {
+				body->m_sleeping = false;	
+				body->m_autoSleep = false;
+			} else {
+				body->m_sleeping = true;	
+				body->m_autoSleep = true;
+			}
+			body->m_equilibrium = true;
+
+			// update collision matrix by calling the transform callback for all kinematic bodies
+			body->UpdateMatrix (timestep, threadID);
+		}
+
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_forceAndTorqueBodyNode;
+		if (node) {
+			descriptor->m_forceAndTorqueBodyNode = node->GetNext();
+		}
+	}
+}
+
+
+void dgBroadPhase::KinematicBodyActivation (dgContact* const contatJoint) const
+{
+	dgBody* const body0 = contatJoint->GetBody0();
+	dgBody* const body1 = contatJoint->GetBody1();
+	if (body0->IsCollidable() | body1->IsCollidable()) {
+		if (body0->IsRTTIType(dgBody::m_kinematicBodyRTTI)) {
+			if (body1->IsRTTIType(dgBody::m_dynamicBodyRTTI) && (body1->GetInvMass().m_w > dgFloat32 (0.0f))) {
+				if (body1->m_equilibrium) {
+					dgVector relVeloc (body0->m_veloc - body1->m_veloc);
+					dgVector relOmega (body0->m_omega - body1->m_omega);
+					dgVector mask2 ((relVeloc.DotProduct4(relVeloc) < dgDynamicBody::m_equilibriumError2) & (relOmega.DotProduct4(relOmega) < dgDynamicBody::m_equilibriumError2));
+
+					dgThreadHiveScopeLock lock (m_world, &body1->m_criticalSectionLock, false);
+					body1->m_sleeping = false;
+					body1->m_equilibrium = mask2.GetSignMask() ? true : false;
+				}
+			}
+		} else if (body1->IsRTTIType(dgBody::m_kinematicBodyRTTI)) {
+			if (body0->IsRTTIType(dgBody::m_dynamicBodyRTTI) && (body0->GetInvMass().m_w > dgFloat32 (0.0f))) {
+				if (body0->m_equilibrium) {
+					dgVector relVeloc (body0->m_veloc - body1->m_veloc);
+					dgVector relOmega (body0->m_omega - body1->m_omega);
+					dgVector mask2 ((relVeloc.DotProduct4(relVeloc) < dgDynamicBody::m_equilibriumError2) & (relOmega.DotProduct4(relOmega) < dgDynamicBody::m_equilibriumError2));
+
+					dgThreadHiveScopeLock lock (m_world, &body0->m_criticalSectionLock, false);
+					body0->m_sleeping = false;
+					body0->m_equilibrium = mask2.GetSignMask() ? true : false;
+				}
+			}
+		}
+	}
+}
+
+void dgBroadPhase::ProcessPairContacts (dgCollidingPairCollector::dgPair* const pair, dgFloat32 timestep, dgInt32 threadID)
+{
+	if (pair->m_contactCount) {
+		dgAssert (pair->m_contactCount <= (DG_CONSTRAINT_MAX_ROWS / 3));
+		if (pair->m_isDeformable) {
+			m_world->ProcessDeformableContacts (pair, timestep, threadID);
+		} else {
+			m_world->ProcessContacts (pair, timestep, threadID);
+			KinematicBodyActivation (pair->m_contact);
+		}
+	} else {
+		if (pair->m_cacheIsValid) {
+			//m_world->ProcessCachedContacts (pair->m_contact, timestep, threadID);
+			KinematicBodyActivation (pair->m_contact);
+		} else {
+			pair->m_contact->m_maxDOF = 0;
+		}
+	}
+}
+
+void dgBroadPhase::CalculatePairContacts (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgContactPoint contacts[DG_MAX_CONTATCS];
+	
+	dgFloat32 timestep = descriptor->m_timestep;
+	dgCollidingPairCollector* const pairCollector = m_world;
+	const dgInt32 count = pairCollector->m_count;
+	// a pair is split in at most two tasks per thread, more tasks only add merge overhead
+	const dgInt32 maxTasks = 2 * m_world->GetThreadCount();
+	const bool splitPairs = maxTasks >= DG_CONTACT_TASK_MIN_COUNT;
+	// the pair cost is only used for scheduling the pairs of the next step on more than one thread, 
+	// without a performance counter the cost is estimated from the contacts and faces the pair produced
+	const bool measureCost = m_world->GetThreadCount() > 1;
+	const bool hasCounter = m_world->m_getPerformanceCount != dgWorld::GetPerformanceCount;
+	dgCollidingPairCollector::dgPair* const pairs = (dgCollidingPairCollector::dgPair*) &m_world->m_pairMemoryBuffer[0];
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_pairsAtomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_pairsAtomicCounter, 1)) {
+		dgCollidingPairCollector::dgPair* const pair = &pairs[i];
+		dgContact* const contact = pair->m_contact;
+		dgUnsigned32 ticks = (measureCost && hasCounter) ? m_world->m_getPerformanceCount() : 0;
+
+		dgContactTaskBatch tasks (maxTasks);
+		pair->m_cacheIsValid = false;
+		pair->m_contactBuffer = contacts;
+		m_world->CalculateContacts (pair, timestep, threadID, false, false, splitPairs ? &tasks : NULL);
+		if (tasks.m_count) {
+			// large pairs are collided by all threads after the pass, and processed when their tasks are merged
+			AddContactTasks (pair, tasks);
+		} else {
+			ProcessPairContacts (pair, timestep, threadID);
+		}
+
+		if (measureCost) {
+			contact->m_pairCost = hasCounter ? (m_world->m_getPerformanceCount() - ticks) : dgUnsigned32 (1 + pair->m_contactCount + contact->m_collidingFaceCount);
+		}
+	}
+}
+
+dgInt32 dgBroadPhase::ComparePairsCost (const dgCollidingPairCollector::dgPair* const pairA, const dgCollidingPairCollector::dgPair* const pairB, void* notUsed)
+{
+	const dgUnsigned32 costA = pairA->m_contact->m_pairCost;
+	const dgUnsigned32 costB = pairB->m_contact->m_pairCost;
+	if (costA > costB) {
+		return -1;
+	}
+	if (costA < costB) {
+		return 1;
+	}
+	return 0;
+}
+
+// threads take the pairs in buffer order, so an expensive pair found late leaves all but one thread waiting at the barrier. 
+// the pairs that cost well above the average last step are moved to the front of the buffer, longest first
+void dgBroadPhase::SortPairsByCost (dgInt32 firstPair)
+{
+	dgCollidingPairCollector* const pairCollector = m_world;
+	const dgInt32 count = pairCollector->m_count - firstPair;
+	if (count > 1) {
+		dgCollidingPairCollector::dgPair* const pairs = &((dgCollidingPairCollector::dgPair*) &m_world->m_pairMemoryBuffer[0])[firstPair];
+
+		dgUnsigned64 totalCost = 0;
+		for (dgInt32 i = 0; i < count; i ++) {
+			totalCost += pairs[i].m_contact->m_pairCost;
+		}
+
+		const dgUnsigned64 threshold = DG_PAIR_COST_OUTLIER * totalCost / count;
+		dgInt32 expensiveCount = 0;
+		for (dgInt32 i = 0; i < count; i ++) {
+			if (pairs[i].m_contact->m_pairCost > threshold) {
+				dgSwap (pairs[expensiveCount], pairs[i]);
+				expensiveCount ++;
+			}
+		}
+
+		if (expensiveCount > 1) {
+			dgSort (pairs, expensiveCount, ComparePairsCost);
+		}
+	}
+}
+
+void dgBroadPhase::AddContactTasks (dgCollidingPairCollector::dgPair* const pair, const dgContactTaskBatch& tasks)
+{
+	dgThreadHiveScopeLock lock (m_world, &m_contactTasksLock, false);
+	m_splitPairs[m_splitPairsCount] = m_contactTasksCount;
+	m_splitPairsCount ++;
+	for (dgInt32 i = 0; i < tasks.m_count; i ++) {
+		dgContactTask& task = m_contactTasks[m_contactTasksCount];
+		task = tasks.m_tasks[i];
+		task.m_pair = pair;
+		m_contactTasksCount ++;
+	}
+}
+
+void dgBroadPhase::CalculateContactTasks (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgFloat32 timestep = descriptor->m_timestep;
+	const dgInt32 count = m_contactTasksCount;
+	dgContactTask* const tasks = &m_contactTasks[0];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_contactTasksAtomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_contactTasksAtomicCounter, 1)) {
+		m_world->CalculateContactTask (&tasks[i], timestep, threadID);
+	}
+}
+
+void dgBroadPhase::MergeContactTasks (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgContactPoint contacts[DG_MAX_CONTATCS];
+
+	dgFloat32 timestep = descriptor->m_timestep;
+	const dgInt32 count = m_splitPairsCount;
+	const dgInt32* const splitPairs = &m_splitPairs[0];
+	const dgContactTask* const tasks = &m_contactTasks[0];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_splitPairsAtomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_splitPairsAtomicCounter, 1)) {
+		// the tasks of a pair are contiguous, and the pairs were added in task order
+		const dgInt32 firstTask = splitPairs[i];
+		const dgInt32 lastTask = ((i + 1) < count) ? splitPairs[i + 1] : m_contactTasksCount;
+		dgCollidingPairCollector::dgPair* const pair = tasks[firstTask].m_pair;
+		pair->m_contactBuffer = contacts;
+		m_world->MergeContactTasks (pair, &tasks[firstTask], lastTask - firstTask);
+		ProcessPairContacts (pair, timestep, threadID);
+	}
+}
+
+//#pragma optimize( "", off )
+void dgBroadPhase::UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex)
+{
+	if (m_rootNode) {
+		dgNode* const node = body->m_collisionCell;
+		dgAssert (!node->m_left);
+		dgAssert (!node->m_right);
+
+		if (!dgBoxInclusionTest (body->m_minAABB, body->m_maxAABB, node->m_minBox, node->m_maxBox)) {
+
+			node->SetAABB(body->m_minAABB, body->m_maxAABB);
+			dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+			UpdateWideNodeBox (node);
+			for (dgNode* parent = node->m_parent; parent; parent = parent->m_parent) {
+				dgVector minBox;
+				dgVector maxBox;
+				dgFloat32 area = CalculateSurfaceArea (parent->m_left, parent->m_right, minBox, maxBox);
+				if (dgBoxInclusionTest (minBox, maxBox, parent->m_minBox, parent->m_maxBox)) {
+					break;
+				}
+				parent->m_minBox = minBox;
+				parent->m_maxBox = maxBox;
+				parent->m_surfaceArea = area;
+				UpdateWideNodeBox (parent);
+			}
+		}
+	}
+}
+
+
+void dgBroadPhase::ForceAndToqueKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->ApplyForceAndtorque (descriptor, threadID);
+		world->m_perfomanceCounters[m_forceCallbackTicks] = world->m_getPerformanceCount() - ticks0;
+	} else {
+		broadPhase->ApplyForceAndtorque (descriptor, threadID);
+	}
+}
+
+void dgBroadPhase::CollidingPairsKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->FindCollidingPairs (descriptor, threadID);
+		world->m_perfomanceCounters[m_broadPhaceTicks] = world->m_getPerformanceCount() - ticks0;
+	} else {
+		broadPhase->FindCollidingPairs (descriptor, threadID);
+	}
+}
+
+void dgBroadPhase::UpdateContactsKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->CalculatePairContacts (descriptor, threadID);
+		world->m_perfomanceCounters[m_narrowPhaseTicks] = world->m_getPerformanceCount() - ticks0;
+	} else {
+		broadPhase->CalculatePairContacts (descriptor, threadID);
+	}
+}
+
+
+void dgBroadPhase::ContactTasksKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->CalculateContactTasks (descriptor, threadID);
+		world->m_perfomanceCounters[m_narrowPhaseTicks] += world->m_getPerformanceCount() - ticks0;
+	} else {
+		broadPhase->CalculateContactTasks (descriptor, threadID);
+	}
+}
+
+void dgBroadPhase::MergeContactTasksKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->MergeContactTasks (descriptor, threadID);
+		world->m_perfomanceCounters[m_narrowPhaseTicks] += world->m_getPerformanceCount() - ticks0;
+	} else {
+		broadPhase->MergeContactTasks (descriptor, threadID);
+	}
+}
+
+
+void dgBroadPhase::AddGeneratedBodiesContactsKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	if (!threadID) {
+		dgUnsigned32 ticks0 = world->m_getPerformanceCount();
+		broadPhase->FindGeneratedBodiesCollidingPairs (descriptor, threadID);
+		world->m_perfomanceCounters[m_broadPhaceTicks] += (world->m_getPerformanceCount() - ticks0);
+	} else {
+		broadPhase->FindGeneratedBodiesCollidingPairs (descriptor, threadID);
+	}
+}
+
+
+bool dgBroadPhase::TestOverlaping (const dgBody* const body0, const dgBody* const body1) const
+{
+	bool mass0 = (body0->m_invMass.m_w != dgFloat32 (0.0f)); 
+	bool mass1 = (body1->m_invMass.m_w != dgFloat32 (0.0f)); 
+	bool isDynamic0 = body0->IsRTTIType (dgBody::m_dynamicBodyRTTI) != 0;
+	bool isDynamic1 = body1->IsRTTIType (dgBody::m_dynamicBodyRTTI) != 0;
+	bool isKinematic0 = body0->IsRTTIType (dgBody::m_kinematicBodyRTTI) != 0;
+	bool isKinematic1 = body1->IsRTTIType (dgBody::m_kinematicBodyRTTI) != 0;
+
+	bool tier0 = ((-dgOverlapTest (body0->m_minAABB, body0->m_maxAABB, body1->m_minAABB, body1->m_maxAABB)) >> 4) != 0;
+	bool tier1 = !(body1->m_collision->IsType (dgCollision::dgCollisionNull_RTTI) | body0->m_collision->IsType (dgCollision::dgCollisionNull_RTTI));
+	bool tier2 = !(body0->m_sleeping & body1->m_sleeping);
+	bool tier3 = isDynamic0 & mass0; 
+	bool tier4 = isDynamic1 & mass1; 
+	bool tier5 = isKinematic0 & mass1; 
+	bool tier6 = isKinematic1 & mass0; 
+	//bool tier7 = body0->m_collision->GetCollisionMode() & body1->m_collision->GetCollisionMode(); 
+	bool tier7 = true;
+	bool ret = tier0 & tier1 & tier2 & tier7 & (tier3 | tier4 | tier5 | tier6);
+
+	if (ret) {
+		const dgCollisionInstance* const instance0 = body0->GetCollision();
+		const dgCollisionInstance* const instance1 = body1->GetCollision();
+
+		if (body0->m_continueCollisionMode | body1->m_continueCollisionMode) {
+			dgVector box0_p0;
+			dgVector box0_p1;
+			dgVector box1_p0;
+			dgVector box1_p1;
+			
+			instance0->CalcAABB(instance0->GetGlobalMatrix(), box0_p0, box0_p1);
+			instance1->CalcAABB(instance1->GetGlobalMatrix(), box1_p0, box1_p1);
+
+			dgVector boxp0 (box0_p0 - box1_p1);
+			dgVector boxp1 (box0_p1 - box1_p0);
+
+			dgVector velRelative (body1->GetVelocity() - body0->GetVelocity());
+			dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velRelative);
+			dgFloat32 distance = ray.BoxIntersect(boxp0, boxp1);
+			ret = (distance < dgFloat32 (1.0f));
+
+		} else {
+#if 1
+			dgVector size0;
+			dgVector size1;
+			dgVector origin0;
+			dgVector origin1;
+
+			instance0->CalcObb (origin0, size0);
+			instance1->CalcObb (origin1, size1);
+			dgMatrix matrix (instance1->GetGlobalMatrix() * instance0->GetGlobalMatrix().Inverse());
+
+//matrix = dgPitchMatrix(30.0 * 3.141592f / 180.0f) * dgYawMatrix(30.0 * 3.141592f / 180.0f);
+//matrix.m_posit = dgVector (0.0f, 0.5f, 0.0f, 1.0f);
+
+			dgMatrix matrixAbs;
+			matrixAbs[0] = matrix[0].Abs() + m_obbTolerance;
+			matrixAbs[1] = matrix[1].Abs() + m_obbTolerance;
+			matrixAbs[2] = matrix[2].Abs() + m_obbTolerance;
+
+			dgVector q0 (origin1 - size1);
+			dgVector q1 (origin1 + size1);
+			dgVector size (matrixAbs.UnrotateVector(size0));
+			dgVector origin (matrix.UntransformVector(origin0));
+			dgVector p0 (origin - size);
+			dgVector p1 (origin + size);
+			dgVector box0 (p0 - q1);
+			dgVector box1 (p1 - q0);
+			dgVector test (box0.CompProduct4((box1)));
+			ret = (test.GetSignMask() & 0x07) == 0x07;
+			if (ret) {
+				dgVector p0 (origin0 - size0);
+				dgVector p1 (origin0 + size0);
+				dgVector size (matrixAbs.RotateVector(size1));
+				origin1 = matrix.TransformVector(origin1);
+				dgVector q0 (origin1 - size);
+				dgVector q1 (origin1 + size);
+				dgVector box0 (p0 - q1);
+				dgVector box1 (p1 - q0);
+				dgVector test (box0.CompProduct4((box1)));
+				ret = (test.GetSignMask() & 0x07) == 0x07;
+
+/*
+				for (dgInt32 i = 0; (i < 3) && ret; i ++) {
+					dgVector dir(dgFloat32 (0.0f));
+					dir[i] = dgFloat32 (1.0f);
+					for (dgInt32 j = 0; (j < 3) && ret; j ++) {
+						dgVector crossDir (dir * matrix[j]);
+						//							if (crossDir.DotProduct4(crossDir).m_x > dgFloat32 (1.0e-7f)) 
+						{
+							dgVector sizeCross0 (size0.DotProduct4(crossDir.Abs() + m_obbTolerance));
+							dgVector originCross0 (origin0.DotProduct4(crossDir));
+							dgVector pCross0 (originCross0 - sizeCross0);
+							dgVector pCross1 (originCross0 + sizeCross0);
+
+							dgVector originCross1 (origin1.DotProduct4(crossDir));
+							dgVector crossCrossSupport1 (matrix[0].DotProduct4(crossDir).m_x, matrix[1].DotProduct4(crossDir).m_x, matrix[2].DotProduct4(crossDir).m_x, dgFloat32 (0.0f));
+							dgVector sizeCross1 (size1.DotProduct4(crossCrossSupport1.Abs() + m_obbTolerance));
+							dgVector qCross0 (originCross1 - sizeCross1);
+							dgVector qCross1 (originCross1 + sizeCross1);
+
+							dgVector boxCross0 (pCross0 - qCross1);
+							dgVector boxCross1 (pCross1 - qCross0);
+							dgVector testCross (boxCross0.CompProduct4((boxCross1)));
+							ret = (testCross.GetSignMask() & 0x01) == 0x01;
+						}
+					}
+				}
+*/
+				if (ret) {
+					dgMatrix matrixTransposed (matrix.Transpose());
+		
+					dgVector origin0_y (origin0.BroadcastY());
+					dgVector origin0_z (origin0.BroadcastZ());
+					dgVector size0_y (size0.BroadcastY());
+					dgVector size0_z (size0.BroadcastZ());
+
+					dgVector origin1_y (origin1.BroadcastY());
+					dgVector origin1_z (origin1.BroadcastZ());
+					dgVector size1_x (size1.BroadcastX());
+					dgVector size1_y (size1.BroadcastY());
+					dgVector size1_z (size1.BroadcastZ());
+					dgVector crossDir0_y (matrixTransposed[1]);
+					dgVector crossDir0_z (matrixTransposed[2]);
+
+					dgMatrix crossDir1Matrix (matrixTransposed[1].CompProduct4(matrix[0].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[0].BroadcastY()), 
+											  matrixTransposed[1].CompProduct4(matrix[1].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[1].BroadcastY()), 
+											  matrixTransposed[1].CompProduct4(matrix[2].BroadcastZ()) - matrixTransposed[2].CompProduct4(matrix[2].BroadcastY()), 
+											  dgVector::m_wOne); 
+
+					dgVector originCross0 (origin0_z.CompProduct4(crossDir0_y) - origin0_y.CompProduct4(crossDir0_z));
+					dgVector sizeCross0 (size0_z.CompProduct4(crossDir0_y.Abs() + m_obbTolerance) + size0_y.CompProduct4(crossDir0_z.Abs() + m_obbTolerance));
+					dgVector originCross1 (origin1_z.CompProduct4(crossDir0_y) - origin1_y.CompProduct4(crossDir0_z));
+					dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
+
+					dgVector pCross0 (originCross0 - sizeCross0);
+					dgVector pCross1 (originCross0 + sizeCross0);
+					dgVector qCross0 (originCross1 - sizeCross1);
+					dgVector qCross1 (originCross1 + sizeCross1);
+					dgVector boxCross0 (pCross0 - qCross1);
+					dgVector boxCross1 (pCross1 - qCross0);
+					dgVector testCross (boxCross0.CompProduct4((boxCross1)));
+					ret = (testCross.GetSignMask() & 0x07) == 0x07;
+					if (ret) {
+						dgVector size0_x (size0.BroadcastX());
+						dgVector origin0_x (origin0.BroadcastX());
+						dgVector origin1_x (origin1.BroadcastX());
+						dgVector crossDir0_x (matrixTransposed[0]);
+
+						dgMatrix crossDir1Matrix (matrixTransposed[2].CompProduct4(matrix[0].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[0].BroadcastZ()), 
+												  matrixTransposed[2].CompProduct4(matrix[1].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[1].BroadcastZ()), 
+												  matrixTransposed[2].CompProduct4(matrix[2].BroadcastX()) - matrixTransposed[0].CompProduct4(matrix[2].BroadcastZ()), 
+												  dgVector::m_wOne); 
+						dgVector originCross0 (origin0_x.CompProduct4(crossDir0_z) - origin0_z.CompProduct4(crossDir0_x));
+						dgVector sizeCross0 (size0_x.CompProduct4(crossDir0_z.Abs() + m_obbTolerance) + size0_z.CompProduct4(crossDir0_x.Abs() + m_obbTolerance));
+						dgVector originCross1 (origin1_x.CompProduct4(crossDir0_z) - origin1_z.CompProduct4(crossDir0_x));
+						dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
+
+						dgVector pCross0 (originCross0 - sizeCross0);
+						dgVector pCross1 (originCross0 + sizeCross0);
+						dgVector qCross0 (originCross1 - sizeCross1);
+						dgVector qCross1 (originCross1 + sizeCross1);
+						dgVector boxCross0 (pCross0 - qCross1);
+						dgVector boxCross1 (pCross1 - qCross0);
+						dgVector testCross (boxCross0.CompProduct4((boxCross1)));
+						ret = (testCross.GetSignMask() & 0x07) == 0x07;
+						if (ret) {
+							dgMatrix crossDir1Matrix (matrixTransposed[0].CompProduct4(matrix[0].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[0].BroadcastX()), 
+													  matrixTransposed[0].CompProduct4(matrix[1].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[1].BroadcastX()), 
+													  matrixTransposed[0].CompProduct4(matrix[2].BroadcastY()) - matrixTransposed[1].CompProduct4(matrix[2].BroadcastX()), 
+													  dgVector::m_wOne); 
+
+							dgVector originCross0 (origin0_y.CompProduct4(crossDir0_x) - origin0_x.CompProduct4(crossDir0_y));
+							dgVector sizeCross0 (size0_y.CompProduct4(crossDir0_x.Abs() + m_obbTolerance) + size0_x.CompProduct4(crossDir0_y.Abs() + m_obbTolerance));
+							dgVector originCross1 (origin1_y.CompProduct4(crossDir0_x) - origin1_x.CompProduct4(crossDir0_y));
+							dgVector sizeCross1 (size1_x.CompProduct4(crossDir1Matrix[0].Abs() + m_obbTolerance) + size1_y.CompProduct4(crossDir1Matrix[1].Abs() + m_obbTolerance) + size1_z.CompProduct4(crossDir1Matrix[2].Abs() + m_obbTolerance));
+
+							dgVector pCross0 (originCross0 - sizeCross0);
+							dgVector pCross1 (originCross0 + sizeCross0);
+							dgVector qCross0 (originCross1 - sizeCross1);
+							dgVector qCross1 (originCross1 + sizeCross1);
+							dgVector boxCross0 (pCross0 - qCross1);
+							dgVector boxCross1 (pCross1 - qCross0);
+							dgVector testCross (boxCross0.CompProduct4((boxCross1)));
+							ret = (testCross.GetSignMask() & 0x07) == 0x07;
+						}
+					}
+				}
+			}
+#else
+			dgVector size0;
+			dgVector size1;
+			dgVector origin0;
+			dgVector origin1;
+			instance0->CalcObb (origin0, size0);
+			instance1->CalcObb (origin1, size1);
+			const dgMatrix& matrix0 = instance0->GetGlobalMatrix();
+			const dgMatrix& matrix1 = instance1->GetGlobalMatrix();
+			origin0 = matrix0.TransformVector(origin0);
+			origin1 = matrix1.TransformVector(origin1);
+			const dgVector base (origin1 - origin0);
+			dgVector dir0 (dgFloat32 (1.0f), dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f)); 
+			for (dgInt32 i = 0; i < 4; i ++) {
+				dgVector negDir (dir0.CompProduct4(dgVector::m_negOne));
+				dgVector tmpDir (matrix1.UnrotateVector(matrix0.RotateVector(dir0)));
+
+				dgVector mask0 (negDir < dgVector (dgFloat32 (0.0f)));
+				dgVector mask1 (tmpDir < dgVector (dgFloat32 (0.0f)));
+
+				dgVector q0(size0.AndNot(mask0) - (size0 & mask0));
+				dgVector p0(matrix0.UnrotateVector(matrix1.RotateVector (size1.AndNot(mask1) - (size1 & mask1)) + base));
+				
+				dgVector q0p0 (q0 - p0);
+				dgVector dot (q0p0.DotProduct4 (dir0));
+				ret = (dot.GetSignMask() & 0x01) == 0x01;
+				if (!ret) { 
+					break;
+				}
+				dgAssert ((q0p0 % q0p0) > dgFloat32 (0.0f));
+				q0p0 = q0p0.CompProduct4 (q0p0.InvMagSqrt());
+				dot = q0p0.DotProduct4 (dir0);
+				dir0 -= q0p0.CompProduct4 (dot.CompProduct4 (dgVector::m_two)); 
+				dgAssert (dgAbsf(dir0 % dir0 - dgFloat32 (1.0f)) < dgFloat32 (1.0e-3f));
+			}
+#endif
+		}
+	}
+	return ret;
+}
+
+void dgBroadPhase::SubmitPairs (dgBody* const body0, dgInt32 nodeIndex, dgInt32 slotMask, const dgVector& timeStepBound, dgInt32 threadID)
+{
+	dgInt32 pool[DG_BROADPHASE_MAX_STACK_DEPTH];
+	pool[0] = nodeIndex;
+	dgInt32 stack = 1;
+
+	dgAssert (!body0->m_collision->IsType (dgCollision::dgCollisionNull_RTTI));
+	
+	while (stack) {
+		stack --;
+		const dgWideNode& node = m_wideNodes[pool[stack]];
+		dgInt32 mask = node.OverlapMask (body0->m_minAABB, body0->m_maxAABB) & slotMask;
+		slotMask = 0x0f;
+		for (dgInt32 i = 0; mask; i ++) {
+			if (mask & 1) {
+				dgInt32 child = node.m_child[i];
+				if (child < 0) {
+					dgBody* const body1 = m_wideLeaves[-child - 1];
+					if (TestOverlaping (body0, body1)) {
+						AddPair (body0, body1, timeStepBound, threadID);
+					}
+				} else {
+					pool[stack] = child;
+					stack ++;
+					dgAssert (stack < dgInt32 (sizeof (pool) / sizeof (pool[0])));
+				}
+			}
+			mask >>= 1;
+		}
+	}
+}
+
+
+void dgBroadPhase::FindCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
+	dgBodyMasterList::dgListNode* node = NULL;
+	{
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_collindPairBodyNode;
+		if (node) {
+			descriptor->m_collindPairBodyNode = node->GetNext();
+		}
+	}
+	
+	dgAssert (!m_wideTreeDirty);
+	while (node) {
+		dgBody* const body = node->GetInfo().GetBody();
+		if (body->m_collisionCell) {
+			if (!body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
+				// each pair is reported once by testing only the children to the right of the path to the root
+				const dgNode* const bodyNode = body->m_collisionCell;
+				dgInt32 slot = bodyNode->m_wideSlot;
+				for (dgInt32 index = bodyNode->m_wideNode; index >= 0; index = m_wideNodes[index].m_parent) {
+					dgInt32 slotMask = 0x0f & ~((2 << slot) - 1);
+					if (slotMask) {
+						SubmitPairs (body, index, slotMask, timestep2, threadID);
+					}
+					slot = m_wideNodes[index].m_parentSlot;
+				}
+			}
+		}
+
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_collindPairBodyNode;
+		if (node) {
+			descriptor->m_collindPairBodyNode = node->GetNext();
+		}
+	}
+}
+
+void dgBroadPhase::FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgAssert (0);
+
+	dgList<dgBody*>::dgListNode* node = NULL;
+	{
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_newBodiesNodes;
+		if (node) {
+			descriptor->m_newBodiesNodes = node->GetNext();
+		}
+	}
+
+	dgAssert (!m_wideTreeDirty);
+	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
+	while(node) {
+		dgBody* const body = node->GetInfo();
+		if (body->m_collisionCell) {
+			if (!body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
+				const dgNode* const bodyNode = body->m_collisionCell;
+				dgInt32 slot = bodyNode->m_wideSlot;
+				for (dgInt32 index = bodyNode->m_wideNode; index >= 0; index = m_wideNodes[index].m_parent) {
+					SubmitPairs (body, index, 0x0f & ~(1 << slot), timestep2, threadID);
+					slot = m_wideNodes[index].m_parentSlot;
+				}
+			}
+		}
+
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_newBodiesNodes;
+		if (node) {
+			descriptor->m_newBodiesNodes = node->GetNext();
+		}
+	}
+}
+
+
+void dgBroadPhase::UpdateContactsBroadPhaseEnd ()
+{
+	// delete all non used contacts
+	dgInt32 count = 0;
+	dgUnsigned32 lru = m_lru;
+
+	dgActiveContacts* const contactList = m_world;
+	dgContact** const deadContacs = (dgContact**) &m_world->m_pairMemoryBuffer[0];
+
+	for (dgActiveContacts::dgListNode* contactNode = contactList->GetFirst(); contactNode; contactNode = contactNode->GetNext()) {
+		dgContact* const contact = contactNode->GetInfo();
+		if (contact->m_broadphaseLru != lru) {
+			const dgBody* const body0 = contact->m_body0;
+			const dgBody* const body1 = contact->m_body1;
+			if (! ((body0->m_sleeping | body0->m_equilibrium) & (body1->m_sleeping | body1->m_equilibrium)) ) {
+				if (contact->m_contactActive) {
+					contact->m_contactActive = false;
+				} else {
+					deadContacs[count] = contact;
+					count ++;
+				}
+			} else if ((lru -  contact->m_broadphaseLru) > 200) {
+				dgVector minBox (body0->m_minAABB - body1->m_maxAABB);
+				dgVector maxBox (body0->m_maxAABB - body1->m_minAABB);
+				dgVector mask ((minBox.CompProduct4(maxBox)) > dgVector (dgFloat32 (0.0f)));
+				dgVector dist ((maxBox.Abs()).GetMin (minBox.Abs()) & mask);
+				dist = dist.GetMax(dist.ShiftTripleRight());
+				dist = dist.GetMax(dist.ShiftTripleRight());
+				if (dist.GetScalar() < dgFloat32(2.0f)) {
+					contact->m_broadphaseLru = lru - 1;
+				} else {
+					if (contact->m_contactActive) {
+						contact->m_contactActive = false;
+					} else {
+						deadContacs[count] = contact;
+						count ++;
+					}
+				}
+			}
+		}
+	}
+
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgContact* const contact = deadContacs[i];
+		m_world->DestroyConstraint (contact);
+	}
+}
+
+
+void dgBroadPhase::RayCast (const dgVector& l0, const dgVector& l1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const
+{
+	ValidateWideTree();
+	if (filter && m_wideNodesCount) {
+		dgVector segment (l1 - l0);
+		dgFloat32 dist2 = segment % segment;
+		if (dist2 > dgFloat32 (1.0e-8f)) {
+
+			dgFloat32 distance[DG_BROADPHASE_RAY_STACK_DEPTH];
+			dgInt32 stackPool[DG_BROADPHASE_RAY_STACK_DEPTH];
+
+			dgFastRayTest ray (l0, l1);
+			const dgVector zero (dgFloat32 (0.0f));
+
+			dgInt32 stack = 1;
+			stackPool[0] = 0;
+			distance[0] = dgFloat32 (0.0f);
+			
+			dgFloat32 maxParam = dgFloat32 (1.2f);
+
+			dgLineBox line;	
+			line.m_l0 = l0;
+			line.m_l1 = l1;
+
+			dgVector test (line.m_l0 <= line.m_l1);
+			line.m_boxL0 = (line.m_l0 & test) | line.m_l1.AndNot(test);
+			line.m_boxL1 = (line.m_l1 & test) | line.m_l0.AndNot(test);
+
+			const dgBody* const sentinel = m_world->GetSentinelBody();
+			while (stack) {
+				stack --;
+				dgFloat32 dist = distance[stack];
+				if (dist > maxParam) {
+					break;
+				} else {
+					dgInt32 me = stackPool[stack];
+					if (me < 0) {
+						const dgBody* const body = m_wideLeaves[-me - 1];
+						if (body != sentinel) {
+							dgFloat32 param = body->RayCast (line, filter, prefilter, userData, maxParam);
+							if (param < maxParam) {
+								maxParam = param;
+								if (maxParam < dgFloat32 (1.0e-8f)) {
+									break;
+								}
+							}
+						}
+					} else {
+						const dgWideNode& node = m_wideNodes[me];
+						stack = node.PushChildren (node.RayDistance (ray, zero, zero), maxParam, stackPool, distance, stack);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+
+void dgBroadPhase::ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const
+{
+	ValidateWideTree();
+	if (filter && m_wideNodesCount && shape->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
+
+		dgVector boxP0;
+		dgVector boxP1;
+		shape->CalcAABB(shape->GetLocalMatrix() * matrix, boxP0, boxP1);
+
+		dgInt32 stack = 1;
+		dgFloat32 distance[DG_BROADPHASE_RAY_STACK_DEPTH];
+		dgInt32 stackPool[DG_BROADPHASE_RAY_STACK_DEPTH];		
+
+		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
+		dgFloat32 maxParam = dgFloat32 (1.02f);
+		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
+		dgFloat32 quantizeStep = dgMax (dgFloat32 (1.0f) / velocA.DotProduct4(velocA).m_x, dgFloat32 (0.001f));
+
+		stackPool[0] = 0;
+		distance[0] = dgFloat32 (0.0f);
+
+		const dgBody* const sentinel = m_world->GetSentinelBody();
+		while (stack) {
+			stack --;
+			dgFloat32 dist = distance[stack];
+			if (dist > maxParam) {
+				break;
+			} else {
+				dgInt32 me = stackPool[stack];
+				if (me < 0) {
+					dgBody* const body = m_wideLeaves[-me - 1];
+					if (body != sentinel) {
+						if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
+							dgFloat32 param = body->ConvexRayCast (ray, shape,boxP0, boxP1, matrix, velocA, filter, prefilter, userData, maxParam, threadId);
+							if (param < maxParam) {
+								param = dgMin (param + quantizeStep, dgFloat32 (1.0f));
+								maxParam = param;
+							}
+						}
+					}
+				} else {
+					const dgWideNode& node = m_wideNodes[me];
+					stack = node.PushChildren (node.RayDistance (ray, boxP0, boxP1), maxParam, stackPool, distance, stack);
+				}
+			}
+		}
+	}
+}
+
+
+dgInt32 dgBroadPhase::ConvexCastBody (dgBody* const body, dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& velocA, dgFloat32& time, dgFloat32& maxParam, dgConvexCastReturnInfo* const info, dgInt32 totalCount, dgInt32 maxContacts, dgInt32 threadIndex) const
+{
+	dgTriplex points[DG_CONVEX_CAST_POOLSIZE];
+	dgTriplex normals[DG_CONVEX_CAST_POOLSIZE];
+	dgFloat32 penetration[DG_CONVEX_CAST_POOLSIZE];
+	dgInt64 attributeA[DG_CONVEX_CAST_POOLSIZE];
+	dgInt64 attributeB[DG_CONVEX_CAST_POOLSIZE];
+
+	dgVector velocB(dgFloat32(0.0f));
+	dgInt32 count = m_world->CollideContinue(shape, matrix, velocA, velocB, body->m_collision, body->m_matrix, velocB, velocB, time, points, normals, penetration, attributeA, attributeB, DG_CONVEX_CAST_POOLSIZE, threadIndex);
+
+	if (count) {
+		if (time < maxParam) {
+			if ((time - maxParam) < dgFloat32(-1.0e-3f)) {
+				totalCount = 0;
+			}
+			maxParam = time;
+			if (count >= (maxContacts - totalCount)) {
+				count = maxContacts - totalCount;
+			}
+
+			for (dgInt32 i = 0; i < count; i++) {
+				info[totalCount].m_point[0] = points[i].m_x;
+				info[totalCount].m_point[1] = points[i].m_y;
+				info[totalCount].m_point[2] = points[i].m_z;
+                info[totalCount].m_point[3] = dgFloat32 (0.0f);
+				info[totalCount].m_normal[0] = normals[i].m_x;
+				info[totalCount].m_normal[1] = normals[i].m_y;
+				info[totalCount].m_normal[2] = normals[i].m_z;
+                info[totalCount].m_normal[3] = dgFloat32 (0.0f);
+				info[totalCount].m_penetration = penetration[i];
+				info[totalCount].m_contaID = attributeB[i];
+                info[totalCount].m_hitBody = body;
+				totalCount++;
+			}
+		}
+	}
+	return totalCount;
+}
+
+dgInt32 dgBroadPhase::ConvexCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, dgFloat32& timeToImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const
+{
+	dgInt32 totalCount = 0;
+	ValidateWideTree();
+	if (m_wideNodesCount) {
+		dgVector boxP0;
+		dgVector boxP1;
+		dgAssert (matrix.TestOrthogonal());
+		shape->CalcAABB(matrix, boxP0, boxP1);
+
+		dgInt32 stack = 1;
+		dgFloat32 distance[DG_BROADPHASE_RAY_STACK_DEPTH];
+		dgInt32 stackPool[DG_BROADPHASE_RAY_STACK_DEPTH];		
+		
+		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
+
+		dgFloat32 time = dgFloat32 (1.0f);
+		dgFloat32 maxParam = dgFloat32 (1.2f);
+		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
+
+		stackPool[0] = 0;
+		distance[0] = dgFloat32 (0.0f);
+
+		const dgBody* const sentinel = m_world->GetSentinelBody();
+		while (stack) {
+			stack --;
+
+			dgFloat32 dist = distance[stack];
+
+			if (dist > maxParam) {
+				break;
+			} else {
+				dgInt32 me = stackPool[stack];
+				if (me < 0) {
+					dgBody* const body = m_wideLeaves[-me - 1];
+					if (body != sentinel) {
+						if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
+							totalCount = ConvexCastBody (body, shape, matrix, velocA, time, maxParam, info, totalCount, maxContacts, threadIndex);
+							if (maxParam < 1.0e-8f) {
+								break;
+							}
+						}
+					}
+				} else {
+					const dgWideNode& node = m_wideNodes[me];
+					stack = node.PushChildren (node.RayDistance (ray, boxP0, boxP1), maxParam, stackPool, distance, stack);
+				}
+			}
+		}
+
+		timeToImpact = maxParam;
+	}
+
+	return totalCount;
+}
+
+
+class dgBroadphaseQueryDescriptor
+{
+	public:
+	dgBroadphaseQueryDescriptor (dgInt32 count, dgInt32 strideInBytes, OnRayPrecastAction prefilter, void* const userData)
+		:m_p0(NULL)
+		,m_p1(NULL)
+		,m_matrices(NULL)
+		,m_targets(NULL)
+		,m_shape(NULL)
+		,m_prefilter(prefilter)
+		,m_userData(userData)
+		,m_rayInfo(NULL)
+		,m_castInfo(NULL)
+		,m_timeToImpact(NULL)
+		,m_strideInBytes(strideInBytes)
+		,m_count(count)
+		,m_atomicIndex(0)
+	{
+	}
+
+	const dgFloat32* m_p0;
+	const dgFloat32* m_p1;
+	const dgFloat32* m_matrices;
+	const dgFloat32* m_targets;
+	dgCollisionInstance* m_shape;
+	OnRayPrecastAction m_prefilter;
+	void* m_userData;
+	dgRayCastReturnInfo* m_rayInfo;
+	dgConvexCastReturnInfo* m_castInfo;
+	dgFloat32* m_timeToImpact;
+	dgInt32 m_strideInBytes;
+	dgInt32 m_count;
+	dgInt32 m_atomicIndex;
+};
+
+
+dgBroadPhase::dgRayPacket::dgRayPacket (const dgFloat32* const p0, const dgFloat32* const p1, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgRayCastReturnInfo* const info)
+	:m_p0x (dgFloat32 (0.0f))
+	,m_p0y (dgFloat32 (0.0f))
+	,m_p0z (dgFloat32 (0.0f))
+	,m_maxT (dgFloat32 (-1.0f))
+{
+	dgAssert (count > 0);
+	dgAssert (count <= 4);
+
+	dgVector p1x (dgFloat32 (0.0f));
+	dgVector p1y (dgFloat32 (0.0f));
+	dgVector p1z (dgFloat32 (0.0f));
+	const dgInt32 stride = dgInt32 (strideInBytes / sizeof (dgFloat32));
+	for (dgInt32 i = 0; i < count; i ++) {
+		const dgVector l0 (p0[i * stride + 0], p0[i * stride + 1], p0[i * stride + 2], dgFloat32 (0.0f));
+		const dgVector l1 (p1[i * stride + 0], p1[i * stride + 1], p1[i * stride + 2], dgFloat32 (0.0f));
+
+		dgRayCastReturnInfo& hit = info[i];
+		memset (&hit, 0, sizeof (dgRayCastReturnInfo));
+		hit.m_param = dgFloat32 (1.0f);
+
+		dgRay& ray = m_rays[i];
+		ray.m_line.m_l0 = l0;
+		ray.m_line.m_l1 = l1;
+		dgVector test (l0 <= l1);
+		ray.m_line.m_boxL0 = (l0 & test) | l1.AndNot(test);
+		ray.m_line.m_boxL1 = (l1 & test) | l0.AndNot(test);
+		ray.m_prefilter = prefilter;
+		ray.m_userData = userData;
+		ray.m_info = &hit;
+		ray.m_maxParam = dgFloat32 (1.2f);
+
+		dgVector segment (l1 - l0);
+		if ((segment % segment) > dgFloat32 (1.0e-8f)) {
+			m_p0x[i] = l0.m_x;
+			m_p0y[i] = l0.m_y;
+			m_p0z[i] = l0.m_z;
+			p1x[i] = l1.m_x;
+			p1y[i] = l1.m_y;
+			p1z[i] = l1.m_z;
+			m_maxT[i] = dgFloat32 (1.0f);
+		}
+	}
+
+	// same as the dgFastRayTest constructor, one ray per lane
+	const dgVector dx (p1x - m_p0x);
+	const dgVector dy (p1y - m_p0y);
+	const dgVector dz (p1z - m_p0z);
+	const dgVector tol (dgFloat32 (1.0e-8f));
+	const dgVector parallelInv (dgFloat32 (1.0e-20f));
+	m_isParallelX = dx.Abs() < tol;
+	m_isParallelY = dy.Abs() < tol;
+	m_isParallelZ = dz.Abs() < tol;
+	m_dpInvX = ((parallelInv & m_isParallelX) | dx.AndNot(m_isParallelX)).Reciproc();
+	m_dpInvY = ((parallelInv & m_isParallelY) | dy.AndNot(m_isParallelY)).Reciproc();
+	m_dpInvZ = ((parallelInv & m_isParallelZ) | dz.AndNot(m_isParallelZ)).Reciproc();
+
+	for (dgInt32 i = 0; i < 4; i ++) {
+		dgRay& ray = m_rays[i];
+		ray.m_p0x = dgVector (m_p0x[i]);
+		ray.m_p0y = dgVector (m_p0y[i]);
+		ray.m_p0z = dgVector (m_p0z[i]);
+		ray.m_dpInvX = dgVector (m_dpInvX[i]);
+		ray.m_dpInvY = dgVector (m_dpInvY[i]);
+		ray.m_dpInvZ = dgVector (m_dpInvZ[i]);
+		ray.m_isParallelX = dgVector (dx[i]).Abs() < tol;
+		ray.m_isParallelY = dgVector (dy[i]).Abs() < tol;
+		ray.m_isParallelZ = dgVector (dz[i]).Abs() < tol;
+		ray.m_maxT = dgVector (m_maxT[i]);
+	}
+}
+
+void dgBroadPhase::dgRayPacket::CastBody (const dgBody* const body, dgInt32 rayMask)
+{
+	for (dgInt32 i = 0; rayMask; i ++) {
+		if (rayMask & 1) {
+			dgRay& ray = m_rays[i];
+			dgFloat32 param = body->RayCast (ray.m_line, Filter, ray.m_prefilter ? Prefilter : NULL, &ray, ray.m_maxParam);
+			if (param < ray.m_maxParam) {
+				ray.m_maxParam = param;
+				m_maxT[i] = (param < dgFloat32 (1.0e-8f)) ? dgFloat32 (-1.0f) : dgMin (param, dgFloat32 (1.0f));
+				ray.m_maxT = dgVector (m_maxT[i]);
+			}
+		}
+		rayMask >>= 1;
+	}
+}
+
+dgUnsigned32 dgApi dgBroadPhase::dgRayPacket::Prefilter (const dgBody* const body, const dgCollisionInstance* const collision, void* const userData)
+{
+	const dgRay* const ray = (dgRay*) userData;
+	return ray->m_prefilter (body, collision, ray->m_userData);
+}
+
+dgFloat32 dgApi dgBroadPhase::dgRayPacket::Filter (const dgBody* const body, const dgCollisionInstance* const collision, const dgVector& contact, const dgVector& normal, dgInt64 collisionID, void* const userData, dgFloat32 intersetParam)
+{
+	// the body only reports hits closer than the current one
+	const dgRay* const ray = (dgRay*) userData;
+	dgRayCastReturnInfo* const info = ray->m_info;
+	info->m_point[0] = contact.m_x;
+	info->m_point[1] = contact.m_y;
+	info->m_point[2] = contact.m_z;
+	info->m_point[3] = dgFloat32 (0.0f);
+	info->m_normal[0] = normal.m_x;
+	info->m_normal[1] = normal.m_y;
+	info->m_normal[2] = normal.m_z;
+	info->m_normal[3] = dgFloat32 (0.0f);
+	info->m_contaID = collisionID;
+	info->m_hitBody = body;
+	info->m_param = intersetParam;
+	return intersetParam;
+}
+
+void dgBroadPhase::RayCastPacket (dgRayPacket& packet) const
+{
+	if (m_wideNodesCount) {
+		dgVector rayDistance[DG_BROADPHASE_RAY_STACK_DEPTH];
+		dgFloat32 distance[DG_BROADPHASE_RAY_STACK_DEPTH];
+		dgInt32 stackPool[DG_BROADPHASE_RAY_STACK_DEPTH];
+
+		dgInt32 stack = 1;
+		stackPool[0] = 0;
+		distance[0] = dgFloat32 (0.0f);
+		rayDistance[0] = dgVector (dgFloat32 (0.0f));
+
+		const dgVector maxDist (dgFloat32 (1.2f));
+		const dgBody* const sentinel = m_world->GetSentinelBody();
+		while (stack) {
+			stack --;
+			// each entry keeps the distance of every ray to the node, the rays that 
+			// found a closer hit since the node was pushed do not visit it
+			dgInt32 rayMask = packet.GetActiveMask (rayDistance[stack]);
+			if (rayMask) {
+				dgInt32 me = stackPool[stack];
+				if (me < 0) {
+					const dgBody* const body = m_wideLeaves[-me - 1];
+					if (body != sentinel) {
+						packet.CastBody (body, rayMask);
+					}
+				} else {
+					// each ray tests the four children at once, the transpose gives the distance of all the rays to each child
+					const dgWideNode& node = m_wideNodes[me];
+					dgVector dist0 ((rayMask & 1) ? node.RayDistance (packet.GetRay(0)) : maxDist);
+					dgVector dist1 ((rayMask & 2) ? node.RayDistance (packet.GetRay(1)) : maxDist);
+					dgVector dist2 ((rayMask & 4) ? node.RayDistance (packet.GetRay(2)) : maxDist);
+					dgVector dist3 ((rayMask & 8) ? node.RayDistance (packet.GetRay(3)) : maxDist);
+					dgVector childDist (dist0.GetMin(dist1).GetMin(dist2).GetMin(dist3));
+
+					dgVector childRayDist[4];
+					dgVector::Transpose4x4 (childRayDist[0], childRayDist[1], childRayDist[2], childRayDist[3], dist0, dist1, dist2, dist3);
+
+					// keep the stack sorted with the child closest to any of the rays on top
+					for (dgInt32 i = 0; i < 4; i ++) {
+						if (packet.GetActiveMask (childRayDist[i])) {
+							dgFloat32 dist = childDist[i];
+							dgInt32 j = stack;
+							for ( ; j && (dist > distance[j - 1]); j --) {
+								stackPool[j] = stackPool[j - 1];
+								rayDistance[j] = rayDistance[j - 1];
+								distance[j] = distance[j - 1];
+							}
+							stackPool[j] = node.m_child[i];
+							rayDistance[j] = childRayDist[i];
+							distance[j] = dist;
+							stack ++;
+							dgAssert (stack < DG_BROADPHASE_RAY_STACK_DEPTH);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void dgBroadPhase::RayCastBatchKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseQueryDescriptor* const descriptor = (dgBroadphaseQueryDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	const dgInt32 count = descriptor->m_count;
+	const dgInt32 stride = dgInt32 (descriptor->m_strideInBytes / sizeof (dgFloat32));
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicIndex, 4); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicIndex, 4)) {
+		dgRayPacket packet (&descriptor->m_p0[i * stride], &descriptor->m_p1[i * stride], descriptor->m_strideInBytes, dgMin (count - i, 4), descriptor->m_prefilter, descriptor->m_userData, &descriptor->m_rayInfo[i]);
+		broadPhase->RayCastPacket (packet);
+	}
+}
+
+void dgBroadPhase::ConvexCastBatchKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgBroadphaseQueryDescriptor* const descriptor = (dgBroadphaseQueryDescriptor*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgBroadPhase* const broadPhase = world->GetBroadPhase();
+
+	const dgInt32 count = descriptor->m_count;
+	const dgInt32 stride = dgInt32 (descriptor->m_strideInBytes / sizeof (dgFloat32));
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicIndex, 1)) {
+		const dgMatrix matrix (&descriptor->m_matrices[i * 16]);
+		const dgFloat32* const target = &descriptor->m_targets[i * stride];
+		dgVector destination (target[0], target[1], target[2], dgFloat32 (0.0f));
+		dgFloat32 time = dgFloat32 (1.2f);
+		dgConvexCastReturnInfo& info = descriptor->m_castInfo[i];
+		if (!broadPhase->ConvexCast (descriptor->m_shape, matrix, destination, time, descriptor->m_prefilter, descriptor->m_userData, &info, 1, threadID)) {
+			memset (&info, 0, sizeof (dgConvexCastReturnInfo));
+		}
+		descriptor->m_timeToImpact[i] = time;
+	}
+}
+
+// cast the rays in packets of four distributed over the worker threads, 
+// the closest hit of each ray is written to its entry in info
+void dgBroadPhase::RayCastBatch (const dgFloat32* const p0, const dgFloat32* const p1, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgRayCastReturnInfo* const info) const
+{
+	dgAssert (!m_world->m_inUpdate);
+	if (count > 0) {
+		ValidateWideTree();
+
+		dgBroadphaseQueryDescriptor descriptor (count, strideInBytes, prefilter, userData);
+		descriptor.m_p0 = p0;
+		descriptor.m_p1 = p1;
+		descriptor.m_rayInfo = info;
+
+		dgInt32 threadsCount = m_world->GetThreadCount();
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (RayCastBatchKernel, &descriptor, m_world);
+		}
+		m_world->SynchronizationBarrier();
+	}
+}
+
+// the matrices are packed in arrays of 16 floats, the first contact of each cast is written 
+// to its entry in info and the time of impact to timeToImpact
+void dgBroadPhase::ConvexCastBatch (dgCollisionInstance* const shape, const dgFloat32* const matrices, const dgFloat32* const targets, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgFloat32* const timeToImpact, dgConvexCastReturnInfo* const info) const
+{
+	dgAssert (!m_world->m_inUpdate);
+	if (count > 0) {
+		ValidateWideTree();
+
+		dgBroadphaseQueryDescriptor descriptor (count, strideInBytes, prefilter, userData);
+		descriptor.m_matrices = matrices;
+		descriptor.m_targets = targets;
+		descriptor.m_shape = shape;
+		descriptor.m_castInfo = info;
+		descriptor.m_timeToImpact = timeToImpact;
+
+		dgInt32 threadsCount = m_world->GetThreadCount();
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (ConvexCastBatchKernel, &descriptor, m_world);
+		}
+		m_world->SynchronizationBarrier();
+	}
+}
+
+void dgBroadPhase::AddInternallyGeneratedBody(dgBody* const body)
+{
+	m_generatedBodies.Append(body);
+}
+
+dgUnsigned32 dgBroadPhase::GetLRU () const
+{
+    return m_lru;
+}
+
+
+// collide the tasks of the pairs split during the contact pass, and merge them before the pairs are processed
+void dgBroadPhase::UpdateContactTasks (dgBroadphaseSyncDescriptor* const descriptor)
+{
+	if (m_contactTasksCount) {
+		dgInt32 threadsCount = m_world->GetThreadCount();	
+
+		if (m_contactTaskPoints.GetElementsCapacity() < (m_contactTasksCount * DG_MAX_CONTACT_MANIFOLD_POINTS)) {
+			m_contactTaskPoints.Resize (m_contactTasksCount * DG_MAX_CONTACT_MANIFOLD_POINTS);
+		}
+		dgContactPoint* const contacts = &m_contactTaskPoints[0];
+		dgContactTask* const tasks = &m_contactTasks[0];
+		for (dgInt32 i = 0; i < m_contactTasksCount; i ++) {
+			tasks[i].m_contacts = &contacts[i * DG_MAX_CONTACT_MANIFOLD_POINTS];
+		}
+
+		descriptor->m_contactTasksAtomicCounter = 0;
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (ContactTasksKernel, descriptor, m_world);
+		}
+		m_world->SynchronizationBarrier();
+		descriptor->m_splitPairsAtomicCounter = 0;
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (MergeContactTasksKernel, descriptor, m_world);
+		}
+		m_world->SynchronizationBarrier();
+
+		m_contactTasksCount = 0;
+		m_splitPairsCount = 0;
+	}
+}
+
+void dgBroadPhase::UpdateContacts (dgFloat32 timestep)
+{
+	dgUnsigned32 ticks = m_world->m_getPerformanceCount();
+
+	dgCollidingPairCollector* const contactPairs = m_world;
+	contactPairs->Init();
+	m_lru = m_lru + 1;
+
+	m_recursiveChunks = true;
+	dgInt32 threadsCount = m_world->GetThreadCount();	
+
+	const dgBodyMasterList* const masterList = m_world;
+	dgBodyMasterList::dgListNode* const firstBodyNode = masterList->GetFirst()->GetNext();
+
+	dgBroadphaseSyncDescriptor syncPoints(timestep, firstBodyNode);
+
+	for (dgInt32 i = 0; i < threadsCount; i ++) {
+		m_world->QueueJob (ForceAndToqueKernel, &syncPoints, m_world);
+	}
+	m_world->SynchronizationBarrier();
+
+	// update pre-listeners after the force and true are applied
+	if (m_world->m_preListener.GetCount()) {
+		dgUnsigned32 ticks = m_world->m_getPerformanceCount();
+		for (dgWorld::dgListenerList::dgListNode* node = m_world->m_preListener.GetFirst(); node; node = node->GetNext()) {
+			dgWorld::dgListener& listener = node->GetInfo();
+			listener.m_onListenerUpdate (m_world, listener.m_userData, timestep);
+		}
+		m_world->m_perfomanceCounters[m_preUpdataListerTicks] = m_world->m_getPerformanceCount() - ticks;
+	}
+
+	PrepareCollidingPairs();
+
+	for (dgInt32 i = 0; i < threadsCount; i ++) {
+		m_world->QueueJob (CollidingPairsKernel, &syncPoints, m_world);
+	}
+	m_world->SynchronizationBarrier();
+	AttachPendingContacts ();
+	PrefetchHeightFieldTiles ();
+	// this is the last serial point before the narrow phase, once the tiles in use are marked every tiled field is trimmed to its budget, 
+	// including those that no pair touched this update, so tiles paged in by ray casts and other queries do not stay resident
+	dgCollisionHeightField::TrimTileCaches (m_world, m_lru);
+	if (threadsCount > 1) {
+		SortPairsByCost (0);
+	}
+
+	for (dgInt32 i = 0; i < threadsCount; i ++) {
+		m_world->QueueJob (UpdateContactsKernel, &syncPoints, m_world);
+	}
+	m_world->SynchronizationBarrier();
+	UpdateContactTasks (&syncPoints);
+
+	m_recursiveChunks = false;
+	if (m_generatedBodies.GetCount()) {
+		// the pairs of the first pass are already processed, the second pass only touches the pairs appended after them
+		const dgInt32 firstPair = contactPairs->m_count;
+		syncPoints.m_newBodiesNodes = m_generatedBodies.GetFirst();
+		PrepareCollidingPairs();
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (AddGeneratedBodiesContactsKernel, &syncPoints, m_world);
+		}
+		m_world->SynchronizationBarrier();
+		AttachPendingContacts ();
+		PrefetchHeightFieldTiles ();
+		if (threadsCount > 1) {
+			SortPairsByCost (firstPair);
+		}
+
+		syncPoints.m_pairsAtomicCounter = firstPair;
+		for (dgInt32 i = 0; i < threadsCount; i ++) {
+			m_world->QueueJob (UpdateContactsKernel, &syncPoints, m_world);
+		}
+		m_world->SynchronizationBarrier();
+		UpdateContactTasks (&syncPoints);
+
+		m_generatedBodies.RemoveAll();
+	}
+
+
+	UpdateContactsBroadPhaseEnd();
+
+	dgUnsigned32 endTicks = m_world->m_getPerformanceCount();
+	m_world->m_perfomanceCounters[m_collisionTicks] = endTicks - ticks - m_world->m_perfomanceCounters[m_forceCallbackTicks];
+
+	// update soft body dynamics phase 1
+    dgDeformableBodiesUpdate* const softBodyList = m_world;
+    softBodyList->ApplyExternaForces(timestep);
+
+	m_world->m_perfomanceCounters[m_softBodyTicks] = m_world->m_getPerformanceCount() - endTicks;
+}
@@ -1,154 +1,391 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#ifndef __AFX_BROADPHASE_H_
-#define __AFX_BROADPHASE_H_
-
-#include "dgPhysicsStdafx.h"
-
-
-class dgBody;
-class dgWorld;
-class dgContact;
-class dgCollision;
-class dgCollisionInstance;
-class dgBroadphaseSyncDescriptor;
-
-typedef dgInt32 (dgApi *OnBodiesInAABB) (dgBody* body, void* const userData);
-typedef dgUnsigned32 (dgApi *OnRayPrecastAction) (const dgBody* const body, const dgCollisionInstance* const collision, void* const userData);
-typedef dgFloat32 (dgApi *OnRayCastAction) (const dgBody* const body, const dgCollisionInstance* const collision, const dgVector& contact, const dgVector& normal, dgInt64 collisionID, void* const userData, dgFloat32 intersetParam);
-
-
-#define DG_CACHE_DIST_TOL			dgFloat32 (1.0e-3f)
-
-DG_MSC_VECTOR_ALIGMENT
-struct dgLineBox
-{
-	dgVector m_l0;
-	dgVector m_l1;
-	dgVector m_boxL0;
-	dgVector m_boxL1;
-} DG_GCC_VECTOR_ALIGMENT;
-
-
-class dgConvexCastReturnInfo
-{
-	public:
-	dgFloat32 m_point[4];					// collision point in global space
-	dgFloat32 m_normal[4];					// surface normal at collision point in global space
-	//dgFloat32 m_normalOnHitPoint[4];		// surface normal at the surface of the hit body, 
-											// is the same as the normal calculate by a raycast passing by the hit point in the direction of the cast
-	dgInt64  m_contaID;	                // collision ID at contact point
-	const dgBody* m_hitBody;				// body hit at contact point
-	dgFloat32 m_penetration;                // contact penetration at collision point
-};
-
-
-class dgBroadPhase
-{
-	public:
-	DG_CLASS_ALLOCATOR(allocator);
-
-	class dgNode;
-	class dgSpliteInfo;
-
-	dgBroadPhase(dgWorld* const world);
-	virtual ~dgBroadPhase();
-
-    dgUnsigned32 GetLRU () const;
-	void GetWorldSize (dgVector& p0, dgVector& p1) const;
-	void RayCast (const dgVector& p0, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const;
-	void ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrx, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const;
-
-	dgInt32 ConvexCast (dgCollisionInstance* const shape, const dgMatrix& p0, const dgVector& p1, dgFloat32& timetoImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const;
-	void ForEachBodyInAABB (const dgVector& q0, const dgVector& q1, OnBodiesInAABB callback, void* const userData) const;
-
-	void ResetEntropy ();
-
-	protected:
-	class dgFitnessList: public dgList <dgNode*>
-	{
-		public:
-		dgFitnessList (dgMemoryAllocator* const allocator);
-		dgFloat64 TotalCost () const;
-	};
-
-	void Add (dgBody* const body);
-	void Remove (dgBody* const body);
-	void InvalidateCache ();
-	void UpdateContacts (dgFloat32 timestep);
-	void AddInternallyGeneratedBody(dgBody* const body);
-	void UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex);
-
-	void ImproveFitness();
-	void RotateLeft (dgNode* const node);
-	void RotateRight (dgNode* const node);
-	void ImproveNodeFitness (dgNode* const node);
-	dgNode* InsertNode (dgNode* const node);
-	dgFloat32 CalculateSurfaceArea (const dgNode* const node0, const dgNode* const node1, dgVector& minBox, dgVector& maxBox) const;
-
-	void AddPair (dgBody* const body0, dgBody* const body1, const dgVector& timestep2, dgInt32 threadID);
-
-	static void ForceAndToqueKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
-	static void CollidingPairsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
-	static void UpdateContactsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
-//	static void UpdateSoftBodyForcesKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
-	static void AddGeneratedBodiesContactsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
-	static dgInt32 CompareNodes (const dgNode* const nodeA, const dgNode* const nodeB, void* notUsed);
-	
-	void UpdateContactsBroadPhaseEnd ();
-	void ApplyForceAndtorque (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
-	void ApplyDeformableForceAndtorque (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
-	void CalculatePairContacts (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
-//	void UpdateSoftBodyForcesKernel (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
-	
-	dgNode* BuildTopDown (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode);
-	dgNode* BuildTopDownBig (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode);
-
-	void FindCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
-	void SubmitPairs (dgNode* const body, dgNode* const node, const dgVector& timeStepBound, dgInt32 threadID);
-
-	void FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
-
-	void KinematicBodyActivation (dgContact* const contatJoint) const;
-
-	bool TestOverlaping (const dgBody* const body0, const dgBody* const body1) const;
-	dgFloat64 CalculateEntropy ();
-			  
-
-	dgWorld* m_world;
-	dgNode* m_rootNode;
-	dgFloat64 m_treeEntropy;
-	dgUnsigned32 m_lru;
-	dgFitnessList m_fitness;
-	dgList<dgBody*> m_generatedBodies;
-	dgThread::dgCriticalSection m_contacJointLock;
-	dgThread::dgCriticalSection m_criticalSectionLock;
-	bool m_recursiveChunks;
-
-	static dgVector m_obbTolerance;
-	static dgVector m_conservativeRotAngle;
-	friend class dgBody;
-	friend class dgWorld;
-	friend class dgWorldDynamicUpdate;
-	friend class dgCollisionCompoundFractured;
-};
-#endif
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __AFX_BROADPHASE_H_
+#define __AFX_BROADPHASE_H_
+
+#include "dgPhysicsStdafx.h"
+#include "dgBodyMasterList.h"
+#include "dgContact.h"
+
+
+class dgBody;
+class dgWorld;
+class dgContact;
+class dgCollision;
+class dgContactMaterial;
+class dgCollisionInstance;
+
+typedef dgInt32 (dgApi *OnBodiesInAABB) (dgBody* body, void* const userData);
+typedef dgUnsigned32 (dgApi *OnRayPrecastAction) (const dgBody* const body, const dgCollisionInstance* const collision, void* const userData);
+typedef dgFloat32 (dgApi *OnRayCastAction) (const dgBody* const body, const dgCollisionInstance* const collision, const dgVector& contact, const dgVector& normal, dgInt64 collisionID, void* const userData, dgFloat32 intersetParam);
+
+
+#define DG_CACHE_DIST_TOL			dgFloat32 (1.0e-3f)
+#define DG_PENDING_CONTACTS_SIZE	256
+#define DG_PAIR_COST_OUTLIER		4
+
+DG_MSC_VECTOR_ALIGMENT
+struct dgLineBox
+{
+	dgVector m_l0;
+	dgVector m_l1;
+	dgVector m_boxL0;
+	dgVector m_boxL1;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+class dgConvexCastReturnInfo
+{
+	public:
+	dgFloat32 m_point[4];					// collision point in global space
+	dgFloat32 m_normal[4];					// surface normal at collision point in global space
+	//dgFloat32 m_normalOnHitPoint[4];		// surface normal at the surface of the hit body, 
+											// is the same as the normal calculate by a raycast passing by the hit point in the direction of the cast
+	dgInt64  m_contaID;	                // collision ID at contact point
+	const dgBody* m_hitBody;				// body hit at contact point
+	dgFloat32 m_penetration;                // contact penetration at collision point
+};
+
+class dgRayCastReturnInfo
+{
+	public:
+	dgFloat32 m_point[4];					// intersection point in global space
+	dgFloat32 m_normal[4];					// surface normal at the intersection point in global space
+	dgInt64  m_contaID;						// collision ID at the intersection point
+	const dgBody* m_hitBody;				// closest body hit by the ray, NULL when the ray did not hit anything
+	dgFloat32 m_param;						// intersection parameter along the ray, 1.0 when the ray did not hit anything
+};
+
+
+class dgBroadphaseSyncDescriptor
+{
+	public:
+	dgBroadphaseSyncDescriptor (dgFloat32 timestep, dgBodyMasterList::dgListNode* const firstNode)
+		:m_newBodiesNodes(NULL)
+		,m_collindPairBodyNode (firstNode)
+		,m_forceAndTorqueBodyNode (firstNode)
+		,m_timestep (timestep) 
+		,m_pairsAtomicCounter(0)
+		,m_proxiesAtomicCounter(0)
+		,m_contactTasksAtomicCounter(0)
+		,m_splitPairsAtomicCounter(0)
+	{
+	}
+
+	dgList<dgBody*>::dgListNode* m_newBodiesNodes;
+	dgBodyMasterList::dgListNode* m_collindPairBodyNode;
+	dgBodyMasterList::dgListNode* m_forceAndTorqueBodyNode;
+	dgFloat32 m_timestep;
+	dgInt32 m_pairsAtomicCounter;
+	dgInt32 m_proxiesAtomicCounter;
+	dgInt32 m_contactTasksAtomicCounter;
+	dgInt32 m_splitPairsAtomicCounter;
+};
+
+
+// the dynamic aabb tree is the default broadphase, the virtual functions are the 
+// interface that alternative broadphases implement over the same contact management
+class dgBroadPhase
+{
+	public:
+	DG_CLASS_ALLOCATOR(allocator);
+
+	class dgNode;
+	class dgWideNode;
+	class dgSpliteInfo;
+
+	enum dgType
+	{
+		m_dynamicAABBTree = 0,
+		m_sweepAndPrune,
+	};
+
+	dgBroadPhase(dgWorld* const world);
+	virtual ~dgBroadPhase();
+
+	virtual dgType GetType () const;
+
+    dgUnsigned32 GetLRU () const;
+	void GetWorldSize (dgVector& p0, dgVector& p1) const;
+	virtual void RayCast (const dgVector& p0, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const;
+	virtual void ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrx, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const;
+
+	virtual dgInt32 ConvexCast (dgCollisionInstance* const shape, const dgMatrix& p0, const dgVector& p1, dgFloat32& timetoImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const;
+	virtual void ForEachBodyInAABB (const dgVector& q0, const dgVector& q1, OnBodiesInAABB callback, void* const userData) const;
+
+	void RayCastBatch (const dgFloat32* const p0, const dgFloat32* const p1, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgRayCastReturnInfo* const info) const;
+	void ConvexCastBatch (dgCollisionInstance* const shape, const dgFloat32* const matrices, const dgFloat32* const targets, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgFloat32* const timeToImpact, dgConvexCastReturnInfo* const info) const;
+
+	void ResetEntropy ();
+
+	protected:
+	class dgFitnessList: public dgList <dgNode*>
+	{
+		public:
+		dgFitnessList (dgMemoryAllocator* const allocator);
+		dgFloat64 TotalCost () const;
+	};
+
+	class dgRayPacket;
+
+	class dgPendingContact
+	{
+		public:
+		dgBody* m_body0;
+		dgBody* m_body1;
+		const dgContactMaterial* m_material;
+	};
+
+	virtual void Add (dgBody* const body);
+	virtual void Remove (dgBody* const body);
+	virtual void InvalidateCache ();
+	virtual void UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex);
+	virtual void PrepareCollidingPairs ();
+	virtual void FindCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	virtual void FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	virtual void RayCastPacket (dgRayPacket& packet) const;
+
+	void UpdateContacts (dgFloat32 timestep);
+	void AddInternallyGeneratedBody(dgBody* const body);
+
+	void ImproveFitness();
+	void RotateLeft (dgNode* const node);
+	void RotateRight (dgNode* const node);
+	void ImproveNodeFitness (dgNode* const node);
+	dgNode* InsertNode (dgNode* const node);
+	dgFloat32 CalculateSurfaceArea (const dgNode* const node0, const dgNode* const node1, dgVector& minBox, dgVector& maxBox) const;
+
+	void AddPair (dgBody* const body0, dgBody* const body1, const dgVector& timestep2, dgInt32 threadID);
+	void AttachPendingContacts ();
+	void PrefetchHeightFieldTiles () const;
+	static dgInt32 ComparePendingContacts (const dgPendingContact* const contactA, const dgPendingContact* const contactB, void* notUsed);
+	static bool IsSamePendingContact (const dgPendingContact* const contactA, const dgPendingContact* const contactB);
+	static dgInt32 ComparePairsCost (const dgCollidingPairCollector::dgPair* const pairA, const dgCollidingPairCollector::dgPair* const pairB, void* notUsed);
+	void SortPairsByCost (dgInt32 firstPair);
+
+	static void ForceAndToqueKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void CollidingPairsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void UpdateContactsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void ContactTasksKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void MergeContactTasksKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+//	static void UpdateSoftBodyForcesKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void AddGeneratedBodiesContactsKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void RayCastBatchKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void ConvexCastBatchKernel (void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static dgInt32 CompareNodes (const dgNode* const nodeA, const dgNode* const nodeB, void* notUsed);
+	
+	void UpdateContactsBroadPhaseEnd ();
+	void ApplyForceAndtorque (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	void ApplyDeformableForceAndtorque (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	void CalculatePairContacts (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
+	void ProcessPairContacts (dgCollidingPairCollector::dgPair* const pair, dgFloat32 timestep, dgInt32 threadID);
+	void AddContactTasks (dgCollidingPairCollector::dgPair* const pair, const dgContactTaskBatch& tasks);
+	void CalculateContactTasks (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
+	void MergeContactTasks (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
+	void UpdateContactTasks (dgBroadphaseSyncDescriptor* const descriptor);
+//	void UpdateSoftBodyForcesKernel (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
+	
+	dgNode* BuildTopDown (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode);
+	dgNode* BuildTopDownBig (dgNode** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgFitnessList::dgListNode** const nextNode);
+
+	void ValidateWideTree () const;
+	void BuildWideTree ();
+	dgInt32 BuildWideNode (dgNode* const node, dgInt32 parent, dgInt32 parentSlot, dgInt32& leafCount);
+	void UpdateWideNodeBox (const dgNode* const node);
+
+	void SubmitPairs (dgBody* const body0, dgInt32 nodeIndex, dgInt32 slotMask, const dgVector& timeStepBound, dgInt32 threadID);
+
+	void KinematicBodyActivation (dgContact* const contatJoint) const;
+
+	bool TestOverlaping (const dgBody* const body0, const dgBody* const body1) const;
+	dgInt32 ConvexCastBody (dgBody* const body, dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& velocA, dgFloat32& time, dgFloat32& maxParam, dgConvexCastReturnInfo* const info, dgInt32 totalCount, dgInt32 maxContacts, dgInt32 threadIndex) const;
+	dgFloat64 CalculateEntropy ();
+			  
+
+	dgWorld* m_world;
+	dgNode* m_rootNode;
+	dgFloat64 m_treeEntropy;
+	dgUnsigned32 m_lru;
+	dgFitnessList m_fitness;
+	dgList<dgBody*> m_generatedBodies;
+	dgArray<dgPendingContact> m_pendingContacts;
+	dgInt32 m_pendingContactsCount;
+	dgArray<dgContactTask> m_contactTasks;
+	dgArray<dgContactPoint> m_contactTaskPoints;
+	dgArray<dgInt32> m_splitPairs;
+	dgInt32 m_contactTasksCount;
+	dgInt32 m_splitPairsCount;
+	dgArray<dgWideNode> m_wideNodes;
+	dgArray<dgBody*> m_wideLeaves;
+	dgInt32 m_wideNodesCount;
+	dgInt32 m_wideTreeDirty;
+	dgThread::dgCriticalSection m_contacJointLock;
+	dgThread::dgCriticalSection m_contactTasksLock;
+	dgThread::dgCriticalSection m_criticalSectionLock;
+	dgThread::dgCriticalSection m_wideTreeLock;
+	bool m_recursiveChunks;
+
+	static dgVector m_obbTolerance;
+	static dgVector m_conservativeRotAngle;
+	friend class dgBody;
+	friend class dgWorld;
+	friend class dgWorldDynamicUpdate;
+	friend class dgCollisionCompoundFractured;
+};
+
+
+DG_MSC_VECTOR_ALIGMENT
+class dgBroadPhase::dgNode
+{
+	public: 
+	DG_CLASS_ALLOCATOR(allocator)
+	
+	dgNode (dgBody* const body);
+	dgNode (dgNode* const sibling, dgNode* const myNode);
+	dgNode (dgNode* const parent, const dgVector& minBox, const dgVector& maxBox);
+	~dgNode ();
+
+	DG_INLINE void SetAABB (const dgVector& minBox, const dgVector& maxBox)
+	{
+		dgAssert (minBox.m_x <= maxBox.m_x);
+		dgAssert (minBox.m_y <= maxBox.m_y);
+		dgAssert (minBox.m_z <= maxBox.m_z);
+
+		dgVector p0 (minBox.CompProduct4(m_broadPhaseScale));
+		dgVector p1 (maxBox.CompProduct4(m_broadPhaseScale) + dgVector::m_one);
+
+		m_minBox = p0.Floor().CompProduct4(m_broadInvPhaseScale);
+		m_maxBox = p1.Floor().CompProduct4(m_broadInvPhaseScale);
+
+		dgAssert (m_minBox.m_w == dgFloat32 (0.0f));
+		dgAssert (m_maxBox.m_w == dgFloat32 (0.0f));
+
+		dgVector side0 (m_maxBox - m_minBox);
+		m_surfaceArea = side0.DotProduct4(side0.ShiftTripleRight()).m_x;
+	}
+
+	dgVector m_minBox;
+	dgVector m_maxBox;
+	dgFloat32 m_surfaceArea;
+	dgBody* m_body;	
+	dgNode* m_left;
+	dgNode* m_right;
+	dgNode* m_parent;
+	dgList<dgNode*>::dgListNode* m_fitnessNode;
+	dgInt32 m_wideNode;
+	dgInt32 m_wideSlot;
+	static dgVector m_broadPhaseScale;
+	static dgVector m_broadInvPhaseScale;
+
+	friend class dgBody;
+	friend class dgBroadPhase;
+	friend class dgFitnessList;
+} DG_GCC_VECTOR_ALIGMENT;
+
+
+// up to four rays cast together, the rays of a packet share a single traversal of the broadphase.
+// each ray keeps its coordinates broadcast for testing it against the four children of a wide node, 
+// and the packet keeps them as one vector per coordinate for testing a single box against all the rays.
+// each ray keeps the closest hit in its return info, rays that do not exist or already hit at the origin
+// have a negative maximum parameter and never pass a box test
+DG_MSC_VECTOR_ALIGMENT
+class dgBroadPhase::dgRayPacket
+{
+	public:
+	DG_MSC_VECTOR_ALIGMENT
+	class dgRay
+	{
+		public:
+		dgVector m_p0x;
+		dgVector m_p0y;
+		dgVector m_p0z;
+		dgVector m_dpInvX;
+		dgVector m_dpInvY;
+		dgVector m_dpInvZ;
+		dgVector m_isParallelX;
+		dgVector m_isParallelY;
+		dgVector m_isParallelZ;
+		dgVector m_maxT;
+		dgLineBox m_line;
+		OnRayPrecastAction m_prefilter;
+		void* m_userData;
+		dgRayCastReturnInfo* m_info;
+		dgFloat32 m_maxParam;
+	} DG_GCC_VECTOR_ALIGMENT;
+
+	dgRayPacket (const dgFloat32* const p0, const dgFloat32* const p1, dgInt32 strideInBytes, dgInt32 count, OnRayPrecastAction prefilter, void* const userData, dgRayCastReturnInfo* const info);
+
+	DG_INLINE dgInt32 GetActiveMask (const dgVector& rayDist) const
+	{
+		return (rayDist < m_maxT).GetSignMask();
+	}
+
+	DG_INLINE const dgRay& GetRay (dgInt32 index) const
+	{
+		return m_rays[index];
+	}
+
+	DG_INLINE dgInt32 BoxTest (const dgVector& minBox, const dgVector& maxBox) const
+	{
+		const dgVector minX (minBox.BroadcastX());
+		const dgVector minY (minBox.BroadcastY());
+		const dgVector minZ (minBox.BroadcastZ());
+		const dgVector maxX (maxBox.BroadcastX());
+		const dgVector maxY (maxBox.BroadcastY());
+		const dgVector maxZ (maxBox.BroadcastZ());
+
+		dgVector outside (((m_p0x <= minX) | (m_p0x >= maxX)) & m_isParallelX);
+		outside = outside | (((m_p0y <= minY) | (m_p0y >= maxY)) & m_isParallelY);
+		outside = outside | (((m_p0z <= minZ) | (m_p0z >= maxZ)) & m_isParallelZ);
+
+		dgVector tx0 ((minX - m_p0x).CompProduct4(m_dpInvX));
+		dgVector tx1 ((maxX - m_p0x).CompProduct4(m_dpInvX));
+		dgVector ty0 ((minY - m_p0y).CompProduct4(m_dpInvY));
+		dgVector ty1 ((maxY - m_p0y).CompProduct4(m_dpInvY));
+		dgVector tz0 ((minZ - m_p0z).CompProduct4(m_dpInvZ));
+		dgVector tz1 ((maxZ - m_p0z).CompProduct4(m_dpInvZ));
+
+		dgVector t0 (dgVector (dgFloat32 (0.0f)).GetMax(tx0.GetMin(tx1)).GetMax(ty0.GetMin(ty1)).GetMax(tz0.GetMin(tz1)));
+		dgVector t1 (m_maxT.GetMin(tx0.GetMax(tx1)).GetMin(ty0.GetMax(ty1)).GetMin(tz0.GetMax(tz1)));
+		return (t0 < t1).AndNot(outside).GetSignMask();
+	}
+
+	void CastBody (const dgBody* const body, dgInt32 rayMask);
+
+	private:
+	static dgUnsigned32 dgApi Prefilter (const dgBody* const body, const dgCollisionInstance* const collision, void* const userData);
+	static dgFloat32 dgApi Filter (const dgBody* const body, const dgCollisionInstance* const collision, const dgVector& contact, const dgVector& normal, dgInt64 collisionID, void* const userData, dgFloat32 intersetParam);
+
+	dgVector m_p0x;
+	dgVector m_p0y;
+	dgVector m_p0z;
+	dgVector m_dpInvX;
+	dgVector m_dpInvY;
+	dgVector m_dpInvZ;
+	dgVector m_isParallelX;
+	dgVector m_isParallelY;
+	dgVector m_isParallelZ;
+	dgVector m_maxT;
+	dgRay m_rays[4];
+} DG_GCC_VECTOR_ALIGMENT;
+
+#endif
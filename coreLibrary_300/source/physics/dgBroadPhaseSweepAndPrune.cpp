@@ -0,0 +1,388 @@
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgPhysicsStdafx.h"
+#include "dgBody.h"
+#include "dgWorld.h"
+#include "dgCollisionInstance.h"
+#include "dgBroadPhaseSweepAndPrune.h"
+
+#define DG_SWEEP_AND_PRUNE_GRANULARITY		1024
+#define DG_SWEEP_AND_PRUNE_CHUNK_SIZE		64
+
+
+dgBroadPhaseSweepAndPrune::dgBroadPhaseSweepAndPrune(dgWorld* const world)
+	:dgBroadPhase(world)
+	,m_proxies(DG_SWEEP_AND_PRUNE_GRANULARITY, world->GetAllocator())
+	,m_proxiesCount(0)
+	,m_deadProxiesCount(0)
+	,m_newProxiesCount(0)
+	,m_sortAxis(0)
+{
+}
+
+dgBroadPhaseSweepAndPrune::~dgBroadPhaseSweepAndPrune()
+{
+	for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+		delete m_proxies[i];
+	}
+}
+
+dgBroadPhase::dgType dgBroadPhaseSweepAndPrune::GetType () const
+{
+	return m_sweepAndPrune;
+}
+
+void dgBroadPhaseSweepAndPrune::Add (dgBody* const body)
+{
+	dgNode* const proxy = new (m_world->GetAllocator()) dgNode (body);
+	m_proxies[m_proxiesCount] = proxy;
+	m_proxiesCount ++;
+	m_newProxiesCount ++;
+}
+
+void dgBroadPhaseSweepAndPrune::Remove (dgBody* const body)
+{
+	// the proxy stays in the array until the next update so that removing bodies
+	// does not have to search the array, the queries skip proxies without a body
+	dgNode* const proxy = body->m_collisionCell;
+	dgAssert (proxy->m_body == body);
+	body->m_collisionCell = NULL;
+	proxy->m_body = NULL;
+	m_deadProxiesCount ++;
+}
+
+void dgBroadPhaseSweepAndPrune::UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex)
+{
+	dgNode* const proxy = body->m_collisionCell;
+	if (!dgBoxInclusionTest (body->m_minAABB, body->m_maxAABB, proxy->m_minBox, proxy->m_maxBox)) {
+		// the order along the sweep axis is restored before the next pair search
+		proxy->SetAABB(body->m_minAABB, body->m_maxAABB);
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::InvalidateCache ()
+{
+	RemoveDeadProxies ();
+	SelectSortAxis ();
+	SortProxies (true);
+}
+
+void dgBroadPhaseSweepAndPrune::PrepareCollidingPairs ()
+{
+	RemoveDeadProxies ();
+	bool axisChanged = SelectSortAxis ();
+	SortProxies (axisChanged || (m_newProxiesCount > (m_proxiesCount >> 3)));
+}
+
+void dgBroadPhaseSweepAndPrune::RemoveDeadProxies ()
+{
+	if (m_deadProxiesCount) {
+		dgInt32 count = 0;
+		for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+			dgNode* const proxy = m_proxies[i];
+			if (proxy->m_body) {
+				m_proxies[count] = proxy;
+				count ++;
+			} else {
+				delete proxy;
+			}
+		}
+		m_proxiesCount = count;
+		m_deadProxiesCount = 0;
+	}
+}
+
+bool dgBroadPhaseSweepAndPrune::SelectSortAxis ()
+{
+	dgVector median (dgFloat32 (0.0f));
+	dgVector varian (dgFloat32 (0.0f));
+	for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+		const dgNode* const proxy = m_proxies[i];
+		dgVector p ((proxy->m_minBox + proxy->m_maxBox).CompProduct4(dgVector::m_half));
+		median += p;
+		varian += p.CompProduct4(p);
+	}
+	varian = varian.Scale4 (dgFloat32 (m_proxiesCount)) - median.CompProduct4(median);
+
+	dgInt32 index = m_sortAxis;
+	dgFloat32 maxVarian = varian[m_sortAxis];
+	for (dgInt32 i = 0; i < 3; i ++) {
+		// only switch axis when the spread is clearly larger, re sorting on a different axis is expensive
+		if (varian[i] > (dgFloat32 (2.0f) * maxVarian)) {
+			index = i;
+			maxVarian = varian[i];
+		}
+	}
+
+	bool axisChanged = (index != m_sortAxis);
+	m_sortAxis = index;
+	return axisChanged;
+}
+
+dgInt32 dgBroadPhaseSweepAndPrune::CompareProxies (const dgNode* const proxyA, const dgNode* const proxyB, void* const context)
+{
+	dgInt32 axis = *((dgInt32*) context);
+	dgFloat32 valA = proxyA->m_minBox[axis];
+	dgFloat32 valB = proxyB->m_minBox[axis];
+	if (valA < valB) {
+		return -1;
+	}
+	if (valA > valB) {
+		return 1;
+	}
+	return 0;
+}
+
+void dgBroadPhaseSweepAndPrune::SortProxies (bool fullSort)
+{
+	if (m_proxiesCount) {
+		dgNode** const proxies = &m_proxies[0];
+		if (fullSort) {
+			dgSortIndirect (proxies, m_proxiesCount, CompareProxies, &m_sortAxis);
+		} else {
+			// bodies move little from one step to the next, so the array is almost sorted
+			const dgInt32 axis = m_sortAxis;
+			for (dgInt32 i = 1; i < m_proxiesCount; i ++) {
+				dgNode* const proxy = proxies[i];
+				dgFloat32 val = proxy->m_minBox[axis];
+				dgInt32 j = i;
+				for (; j && (proxies[j - 1]->m_minBox[axis] > val); j --) {
+					proxies[j] = proxies[j - 1];
+				}
+				proxies[j] = proxy;
+			}
+		}
+	}
+	m_newProxiesCount = 0;
+
+#ifdef _DEBUG
+	for (dgInt32 i = 1; i < m_proxiesCount; i ++) {
+		dgAssert (m_proxies[i - 1]->m_minBox[m_sortAxis] <= m_proxies[i]->m_minBox[m_sortAxis]);
+	}
+#endif
+}
+
+void dgBroadPhaseSweepAndPrune::SubmitPairs (dgNode* const proxy, dgInt32 firstIndex, const dgVector& timestep2, dgInt32 threadID)
+{
+	dgBody* const body0 = proxy->m_body;
+	const dgInt32 axis = m_sortAxis;
+	const dgFloat32 maxValue = proxy->m_maxBox[axis];
+	for (dgInt32 i = firstIndex; i < m_proxiesCount; i ++) {
+		dgNode* const proxy1 = m_proxies[i];
+		if (proxy1->m_minBox[axis] >= maxValue) {
+			break;
+		}
+		if ((proxy1 != proxy) && dgOverlapTest (proxy1->m_minBox, proxy1->m_maxBox, body0->m_minAABB, body0->m_maxAABB)) {
+			dgBody* const body1 = proxy1->m_body;
+			if (TestOverlaping (body0, body1)) {
+				AddPair (body0, body1, timestep2, threadID);
+			}
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::FindCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgAssert (!m_deadProxiesCount);
+	dgAssert (!m_newProxiesCount);
+
+	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
+	// each proxy only tests the ones that follow it in the sweep, so every pair is reported once
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_proxiesAtomicCounter, DG_SWEEP_AND_PRUNE_CHUNK_SIZE); i < m_proxiesCount; i = dgAtomicExchangeAndAdd(&descriptor->m_proxiesAtomicCounter, DG_SWEEP_AND_PRUNE_CHUNK_SIZE)) {
+		const dgInt32 count = dgMin (i + DG_SWEEP_AND_PRUNE_CHUNK_SIZE, m_proxiesCount);
+		for (dgInt32 j = i; j < count; j ++) {
+			dgNode* const proxy = m_proxies[j];
+			if (!proxy->m_body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
+				SubmitPairs (proxy, j + 1, timestep2, threadID);
+			}
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgList<dgBody*>::dgListNode* node = NULL;
+	{
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_newBodiesNodes;
+		if (node) {
+			descriptor->m_newBodiesNodes = node->GetNext();
+		}
+	}
+
+	dgVector timestep2 (descriptor->m_timestep * descriptor->m_timestep * dgFloat32 (4.0f));
+	while(node) {
+		dgBody* const body = node->GetInfo();
+		if (body->m_collisionCell) {
+			if (!body->m_collision->IsType (dgCollision::dgCollisionNull_RTTI)) {
+				// the proxies below do not bound the generated body from the left, test all of them
+				SubmitPairs (body->m_collisionCell, 0, timestep2, threadID);
+			}
+		}
+
+		dgThreadHiveScopeLock lock (m_world, &m_criticalSectionLock, false);
+		node = descriptor->m_newBodiesNodes;
+		if (node) {
+			descriptor->m_newBodiesNodes = node->GetNext();
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::ForEachBodyInAABB (const dgVector& minBox, const dgVector& maxBox, OnBodiesInAABB callback, void* const userData) const
+{
+	dgBody* const sentinel = m_world->GetSentinelBody();
+	for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+		const dgNode* const proxy = m_proxies[i];
+		dgBody* const body = proxy->m_body;
+		if (body && (body != sentinel) && dgOverlapTest (proxy->m_minBox, proxy->m_maxBox, minBox, maxBox)) {
+			if (dgOverlapTest (body->m_minAABB, body->m_maxAABB, minBox, maxBox)) {
+				if (!callback (body, userData)) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::RayCast (const dgVector& l0, const dgVector& l1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const
+{
+	if (filter) {
+		dgVector segment (l1 - l0);
+		dgFloat32 dist2 = segment % segment;
+		if (dist2 > dgFloat32 (1.0e-8f)) {
+			dgFastRayTest ray (l0, l1);
+			dgFloat32 maxParam = dgFloat32 (1.2f);
+
+			dgLineBox line;
+			line.m_l0 = l0;
+			line.m_l1 = l1;
+
+			dgVector test (line.m_l0 <= line.m_l1);
+			line.m_boxL0 = (line.m_l0 & test) | line.m_l1.AndNot(test);
+			line.m_boxL1 = (line.m_l1 & test) | line.m_l0.AndNot(test);
+
+			const dgBody* const sentinel = m_world->GetSentinelBody();
+			for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+				const dgNode* const proxy = m_proxies[i];
+				const dgBody* const body = proxy->m_body;
+				if (body && (body != sentinel)) {
+					dgFloat32 dist = ray.BoxIntersect(proxy->m_minBox, proxy->m_maxBox);
+					if (dist < maxParam) {
+						dgFloat32 param = body->RayCast (line, filter, prefilter, userData, maxParam);
+						if (param < maxParam) {
+							maxParam = param;
+							if (maxParam < dgFloat32 (1.0e-8f)) {
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::RayCastPacket (dgRayPacket& packet) const
+{
+	const dgBody* const sentinel = m_world->GetSentinelBody();
+	for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+		const dgNode* const proxy = m_proxies[i];
+		const dgBody* const body = proxy->m_body;
+		if (body && (body != sentinel)) {
+			dgInt32 rayMask = packet.BoxTest (proxy->m_minBox, proxy->m_maxBox);
+			if (rayMask) {
+				packet.CastBody (body, rayMask);
+			}
+		}
+	}
+}
+
+void dgBroadPhaseSweepAndPrune::ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const
+{
+	if (filter && shape->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
+		dgVector boxP0;
+		dgVector boxP1;
+		shape->CalcAABB(shape->GetLocalMatrix() * matrix, boxP0, boxP1);
+
+		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
+		dgFloat32 maxParam = dgFloat32 (1.02f);
+		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
+		dgFloat32 quantizeStep = dgMax (dgFloat32 (1.0f) / velocA.DotProduct4(velocA).m_x, dgFloat32 (0.001f));
+
+		const dgBody* const sentinel = m_world->GetSentinelBody();
+		for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+			const dgNode* const proxy = m_proxies[i];
+			dgBody* const body = proxy->m_body;
+			if (body && (body != sentinel)) {
+				dgVector minBox (proxy->m_minBox - boxP1);
+				dgVector maxBox (proxy->m_maxBox - boxP0);
+				dgFloat32 dist = ray.BoxIntersect(minBox, maxBox);
+				if (dist < maxParam) {
+					if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
+						dgFloat32 param = body->ConvexRayCast (ray, shape,boxP0, boxP1, matrix, velocA, filter, prefilter, userData, maxParam, threadId);
+						if (param < maxParam) {
+							param = dgMin (param + quantizeStep, dgFloat32 (1.0f));
+							maxParam = param;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+dgInt32 dgBroadPhaseSweepAndPrune::ConvexCast (dgCollisionInstance* const shape, const dgMatrix& matrix, const dgVector& target, dgFloat32& timeToImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const
+{
+	dgInt32 totalCount = 0;
+	if (m_proxiesCount) {
+		dgVector boxP0;
+		dgVector boxP1;
+		dgAssert (matrix.TestOrthogonal());
+		shape->CalcAABB(matrix, boxP0, boxP1);
+
+		dgVector velocA((target - matrix.m_posit) & dgVector::m_triplexMask);
+		dgFloat32 time = dgFloat32 (1.0f);
+		dgFloat32 maxParam = dgFloat32 (1.2f);
+		dgFastRayTest ray (dgVector (dgFloat32 (0.0f)), velocA);
+
+		const dgBody* const sentinel = m_world->GetSentinelBody();
+		for (dgInt32 i = 0; i < m_proxiesCount; i ++) {
+			const dgNode* const proxy = m_proxies[i];
+			dgBody* const body = proxy->m_body;
+			if (body && (body != sentinel)) {
+				dgVector minBox (proxy->m_minBox - boxP1);
+				dgVector maxBox (proxy->m_maxBox - boxP0);
+				dgFloat32 dist = ray.BoxIntersect(minBox, maxBox);
+				if (dist < maxParam) {
+					if (!PREFILTER_RAYCAST (prefilter, body, shape, userData)) {
+						totalCount = ConvexCastBody (body, shape, matrix, velocA, time, maxParam, info, totalCount, maxContacts, threadIndex);
+						if (maxParam < 1.0e-8f) {
+							break;
+						}
+					}
+				}
+			}
+		}
+		timeToImpact = maxParam;
+	}
+	return totalCount;
+}
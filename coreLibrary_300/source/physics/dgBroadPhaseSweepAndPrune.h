@@ -0,0 +1,71 @@
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __DG_BROADPHASE_SWEEP_AND_PRUNE_H_
+#define __DG_BROADPHASE_SWEEP_AND_PRUNE_H_
+
+#include "dgPhysicsStdafx.h"
+#include "dgBroadPhase.h"
+
+
+// incremental sweep and prune, the body proxies are kept sorted by the lower bound of their box
+// along the axis of largest spread, and the order is restored each step with an insertion sort.
+// it is cheaper than the tree for scenes of similar sized bodies moving coherently,
+// but ray casts and box queries are linear on the number of bodies.
+class dgBroadPhaseSweepAndPrune: public dgBroadPhase
+{
+	public:
+	DG_CLASS_ALLOCATOR(allocator);
+
+	dgBroadPhaseSweepAndPrune(dgWorld* const world);
+	virtual ~dgBroadPhaseSweepAndPrune();
+
+	virtual dgType GetType () const;
+
+	virtual void RayCast (const dgVector& p0, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData) const;
+	virtual void ConvexRayCast (dgCollisionInstance* const shape, const dgMatrix& matrx, const dgVector& p1, OnRayCastAction filter, OnRayPrecastAction prefilter, void* const userData, dgInt32 threadId) const;
+	virtual dgInt32 ConvexCast (dgCollisionInstance* const shape, const dgMatrix& p0, const dgVector& p1, dgFloat32& timetoImpact, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const;
+	virtual void ForEachBodyInAABB (const dgVector& q0, const dgVector& q1, OnBodiesInAABB callback, void* const userData) const;
+
+	protected:
+	virtual void Add (dgBody* const body);
+	virtual void Remove (dgBody* const body);
+	virtual void InvalidateCache ();
+	virtual void UpdateBodyBroadphase(dgBody* const body, dgInt32 threadIndex);
+	virtual void PrepareCollidingPairs ();
+	virtual void FindCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	virtual void FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const desctiptor, dgInt32 threadID);
+	virtual void RayCastPacket (dgRayPacket& packet) const;
+
+	void RemoveDeadProxies ();
+	bool SelectSortAxis ();
+	void SortProxies (bool fullSort);
+	void SubmitPairs (dgNode* const proxy, dgInt32 firstIndex, const dgVector& timestep2, dgInt32 threadID);
+	static dgInt32 CompareProxies (const dgNode* const proxyA, const dgNode* const proxyB, void* const context);
+
+	dgArray<dgNode*> m_proxies;
+	dgInt32 m_proxiesCount;
+	dgInt32 m_deadProxiesCount;
+	dgInt32 m_newProxiesCount;
+	dgInt32 m_sortAxis;
+};
+
+#endif
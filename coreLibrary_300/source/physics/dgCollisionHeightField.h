@@ -1,153 +1,300 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#ifndef __DGCOLLISION_HEIGHT_FIELD__
-#define __DGCOLLISION_HEIGHT_FIELD__
-
-#include "dgCollision.h"
-#include "dgCollisionMesh.h"
-
-class dgCollisionHeightField;
-typedef dgFloat32 (*dgCollisionHeightFieldRayCastCallback) (const dgBody* const body, const dgCollisionHeightField* const heightFieldCollision, dgFloat32 interception, dgInt32 row, dgInt32 col, dgVector* const normal, int faceId, void* const usedData);
-
-
-class dgCollisionHeightField: public dgCollisionMesh
-{
-	public:
-	enum dgElevationType
-	{
-		m_float32Bit = 0,
-		m_unsigned16Bit,
-	};
-
-	enum dgCollisionHeightFieldGridConstruction
-	{
-		m_normalDiagonals = 0,
-		m_invertedDiagonals,
-		m_alternateOddRowsDiagonals,
-		m_alternateEvenRowsDiagonals,
-		m_alternateOddColumsDiagonals,
-		m_alternateEvenColumsDiagonals,
-		m_starDiagonals,
-		m_starInvertexDiagonals,
-	};
-	dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 contructionMode, 
-							const void* const elevationMap, dgElevationType elevationDataType, dgFloat32 verticalScale, 
-							const dgInt8* const atributeMap, dgFloat32 horizontalScale);
-
-	dgCollisionHeightField (dgWorld* const world, dgDeserialize deserialization, void* const userData, dgInt32 revisionNumber);
-
-	virtual ~dgCollisionHeightField(void);
-
-	void SetCollisionRayCastCallback (dgCollisionHeightFieldRayCastCallback rayCastCallback);
-	dgCollisionHeightFieldRayCastCallback GetDebugRayCastCallback() const { return m_userRayCastCallback;} 
-
-
-	private:
-	class dgPerIntanceData
-	{
-		public:
-		dgWorld* m_world;
-		dgInt32 m_refCount;
-		dgInt32 m_vertexCount[DG_MAX_THREADS_HIVE_COUNT];
-		dgVector *m_vertex[DG_MAX_THREADS_HIVE_COUNT];
-	};
-
-	void CalculateAABB();
-	
-	void AllocateVertex(dgWorld* const world, dgInt32 thread) const;
-	void CalculateMinExtend2d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
-	void CalculateMinExtend3d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
-	dgFloat32 RayCastCell (const dgFastRayTest& ray, dgInt32 xIndex0, dgInt32 zIndex0, dgVector& normalOut, dgFloat32 maxT) const;
-
-	virtual void Serialize(dgSerialize callback, void* const userData) const;
-	virtual dgFloat32 RayCast (const dgVector& localP0, const dgVector& localP1, dgFloat32 maxT, dgContactPoint& contactOut, const dgBody* const body, void* const userData, OnRayPrecastAction preFilter) const;
-	virtual void GetCollidingFaces (dgPolygonMeshDesc* const data) const;
-
-	virtual void GetCollisionInfo(dgCollisionInfo* const info) const;
-	virtual dgVector SupportVertex (const dgVector& dir, dgInt32* const vertexIndex) const;
-	virtual void DebugCollision (const dgMatrix& matrixPtr, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const;
-	void GetVertexListIndexList (const dgVector& p0, const dgVector& p1, dgMeshVertexListIndexList &data) const;
-	void GetLocalAABB (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
-
-	dgVector m_minBox;
-	dgVector m_maxBox;
-
-	dgInt32 m_width;
-	dgInt32 m_height;
-	dgInt32 m_diagonalMode;
-	dgInt8* m_atributeMap;
-	dgInt8* m_diagonals;
-	void* m_elevationMap;
-	dgFloat32 m_verticalScale;
-	dgFloat32 m_horizontalScale;
-	dgFloat32 m_horizontalScaleInv;
-	dgCollisionHeightFieldRayCastCallback m_userRayCastCallback;
-	dgElevationType m_elevationDataType;
-
-	static dgVector m_yMask;
-	static dgVector m_padding;
-	static dgInt32 m_cellIndices[][4];
-	static dgInt32 m_verticalEdgeMap[][7];
-	static dgInt32 m_horizontalEdgeMap[][7];
-	
-	dgPerIntanceData* m_instanceData;
-	friend class dgCollisionCompound;
-};
-
-
-DG_INLINE void dgCollisionHeightField::CalculateMinExtend2d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const
-{
-	dgVector q0 (p0.GetMin(p1) - m_padding);
-	dgVector q1 (p0.GetMax(p1) + m_padding);
-
-	boxP0 = ((q0.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) & m_yMask) + dgVector(dgFloat32 (-1.0e10f)).AndNot(m_yMask)) & dgVector::m_triplexMask;
-	boxP1 = (((q1.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) + dgVector(m_horizontalScale)) & m_yMask) + dgVector(dgFloat32 (1.0e10f)).AndNot(m_yMask)) & dgVector::m_triplexMask;
-
-	dgVector minBox ((m_minBox & m_yMask) + boxP0.AndNot(m_yMask));
-	dgVector maxBox ((m_maxBox & m_yMask) + boxP1.AndNot(m_yMask));
-	boxP0 = boxP0.GetMax (minBox);
-	boxP1 = boxP1.GetMin (maxBox);
-}
-
-
-DG_INLINE void dgCollisionHeightField::CalculateMinExtend3d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const
-{
-	dgAssert (p0.m_x <= p1.m_x);
-	dgAssert (p0.m_y <= p1.m_y);
-	dgAssert (p0.m_z <= p1.m_z);
-	dgAssert (p0.m_w == dgFloat32 (0.0f));
-	dgAssert (p1.m_w == dgFloat32 (0.0f));
-
-	dgVector q0 (p0 - m_padding);
-	dgVector q1 (p1 + m_padding);
-
-	boxP0 = (q0.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) & m_yMask) + q0.AndNot(m_yMask);
-	boxP1 = ((q1.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) + dgVector(m_horizontalScale)) & m_yMask) + q1.AndNot(m_yMask);
-
-	dgVector minBox ((m_minBox & m_yMask) + boxP0.AndNot(m_yMask));
-	dgVector maxBox ((m_maxBox & m_yMask) + boxP1.AndNot(m_yMask));
-	boxP0 = boxP0.GetMax (minBox);
-	boxP1 = boxP1.GetMin (maxBox);
-}
-
-
-#endif
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __DGCOLLISION_HEIGHT_FIELD__
+#define __DGCOLLISION_HEIGHT_FIELD__
+
+#include "dgCollision.h"
+#include "dgCollisionMesh.h"
+
+#define DG_HEIGHTFIELD_BLOCK_SIZE			8
+#define DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS	32
+#define DG_HEIGHTFIELD_DEFAULT_TILE_BUDGET	64
+
+class dgCollisionHeightField;
+typedef dgFloat32 (*dgCollisionHeightFieldRayCastCallback) (const dgBody* const body, const dgCollisionHeightField* const heightFieldCollision, dgFloat32 interception, dgInt32 row, dgInt32 col, dgVector* const normal, int faceId, void* const usedData);
+typedef void (*dgCollisionHeightFieldLoadTileCallback) (void* const userData, dgInt32 xTile, dgInt32 zTile, void* const elevation, dgInt8* const atributes);
+
+
+class dgCollisionHeightField: public dgCollisionMesh
+{
+	public:
+	enum dgElevationType
+	{
+		m_float32Bit = 0,
+		m_unsigned16Bit,
+	};
+
+	enum dgCollisionHeightFieldGridConstruction
+	{
+		m_normalDiagonals = 0,
+		m_invertedDiagonals,
+		m_alternateOddRowsDiagonals,
+		m_alternateEvenRowsDiagonals,
+		m_alternateOddColumsDiagonals,
+		m_alternateEvenColumsDiagonals,
+		m_starDiagonals,
+		m_starInvertexDiagonals,
+	};
+	dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 contructionMode, 
+							const void* const elevationMap, dgElevationType elevationDataType, dgFloat32 verticalScale, 
+							const dgInt8* const atributeMap, dgFloat32 horizontalScale);
+
+	dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 tileSize, dgInt32 contructionMode, 
+							dgElevationType elevationDataType, dgFloat32 minElevation, dgFloat32 maxElevation, dgFloat32 verticalScale, dgFloat32 horizontalScale,
+							dgCollisionHeightFieldLoadTileCallback loadTile, void* const loadTileUserData, const void* const elevationImage, const dgInt8* const atributeImage);
+
+	dgCollisionHeightField (dgWorld* const world, dgDeserialize deserialization, void* const userData, dgInt32 revisionNumber);
+
+	virtual ~dgCollisionHeightField(void);
+
+	void SetCollisionRayCastCallback (dgCollisionHeightFieldRayCastCallback rayCastCallback);
+	dgCollisionHeightFieldRayCastCallback GetDebugRayCastCallback() const { return m_userRayCastCallback;} 
+
+	bool IsTiled() const { return m_tileCache ? true : false;}
+	void SetTileCacheBudget (dgInt32 maxTiles);
+	dgInt32 GetTileCacheBudget () const;
+	dgInt32 GetResidentTileCount () const;
+	void PrefetchTiles (const dgCollisionInstance* const instance, const dgVector& worldP0, const dgVector& worldP1, dgUnsigned32 lru) const;
+	static void TrimTileCaches (dgWorld* const world, dgUnsigned32 lru);
+
+
+	private:
+	class dgPerIntanceData
+	{
+		public:
+		dgWorld* m_world;
+		dgCollisionHeightField* m_tiledFields;
+		dgInt32 m_refCount;
+		dgInt32 m_vertexCount[DG_MAX_THREADS_HIVE_COUNT];
+		dgVector *m_vertex[DG_MAX_THREADS_HIVE_COUNT];
+	};
+
+	// elevation bounds of a square block of cells, level zero blocks span DG_HEIGHTFIELD_BLOCK_SIZE cells, 
+	// each level above doubles the block size until one block covers the whole map
+	class dgHeightBlock
+	{
+		public:
+		dgFloat32 m_minHeight;
+		dgFloat32 m_maxHeight;
+	};
+
+	// a tile covers (tileSize + 1) x (tileSize + 1) samples, neighbor tiles duplicate the samples on their common edge
+	class dgHeightFieldTile
+	{
+		public:
+		void* m_elevation;
+		dgInt8* m_atributes;
+		dgInt8* m_diagonals;
+		dgUnsigned32 m_lru;
+		dgInt32 m_resident;
+	};
+
+	class dgTileCache
+	{
+		public:
+		DG_CLASS_ALLOCATOR(allocator)
+
+		dgHeightFieldTile* m_tiles;
+		dgInt32* m_residentTiles;
+		dgCollisionHeightField* m_next;
+		dgCollisionHeightField* m_prev;
+		dgCollisionHeightFieldLoadTileCallback m_loadTile;
+		void* m_userData;
+		const void* m_elevationImage;
+		const dgInt8* m_atributeImage;
+		dgFloat32 m_minElevation;
+		dgFloat32 m_maxElevation;
+		dgInt32 m_tileShift;
+		dgInt32 m_tileStride;
+		dgInt32 m_xTiles;
+		dgInt32 m_zTiles;
+		dgInt32 m_budget;
+		dgInt32 m_residentCount;
+		dgInt32 m_residentCapacity;
+		dgUnsigned32 m_lru;
+		dgThread::dgCriticalSection m_lock;
+	};
+
+	void AttachInstanceData (dgWorld* const world);
+	dgInt8 CalculateDiagonal (dgInt32 x, dgInt32 z) const;
+	dgFloat32 GetElevation (dgInt32 x, dgInt32 z) const;
+	dgInt32 GetAtribute (dgInt32 x, dgInt32 z) const;
+	dgInt32 GetDiagonal (dgInt32 x, dgInt32 z) const;
+	const dgHeightFieldTile& GetTile (dgInt32 x, dgInt32 z, dgInt32& index) const;
+	void LoadTile (dgInt32 xTile, dgInt32 zTile) const;
+	void EvictTile (dgInt32 tileIndex) const;
+	void TrimTileCache (dgUnsigned32 lru) const;
+	static dgInt32 CompareTilesLru (const dgInt32* const indexA, const dgInt32* const indexB, void* const context);
+
+	void CalculateAABB();
+	void BuildHeightPyramid();
+	const dgHeightBlock& GetHeightBlock (dgInt32 level, dgInt32 xBlock, dgInt32 zBlock) const;
+	void ScanElevation (dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, dgFloat32& minHeight, dgFloat32& maxHeight) const;
+	void CalculateMinMaxHeight (dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, dgFloat32& minHeight, dgFloat32& maxHeight) const;
+	void CalculateBlockMinMaxHeight (dgInt32 level, dgInt32 xBlock, dgInt32 zBlock, dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, dgFloat32& minHeight, dgFloat32& maxHeight) const;
+	dgFloat32 RayCastBlock (const dgFastRayTest& ray, dgInt32 level, dgInt32 xBlock, dgInt32 zBlock, dgVector& normalOut, dgInt32& xIndexOut, dgInt32& zIndexOut, dgFloat32 maxT) const;
+	
+	void AllocateVertex(dgWorld* const world, dgInt32 thread) const;
+	void CalculateMinExtend2d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
+	void CalculateMinExtend3d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
+	dgFloat32 RayCastCell (const dgFastRayTest& ray, dgInt32 xIndex0, dgInt32 zIndex0, dgVector& normalOut, dgFloat32 maxT) const;
+
+	virtual void Serialize(dgSerialize callback, void* const userData) const;
+	void SerializeTiles (dgSerialize callback, void* const userData) const;
+	void ReleaseSerializedTiles (dgInt32 zTile, const dgInt8* const residentTiles) const;
+	virtual dgFloat32 RayCast (const dgVector& localP0, const dgVector& localP1, dgFloat32 maxT, dgContactPoint& contactOut, const dgBody* const body, void* const userData, OnRayPrecastAction preFilter) const;
+	virtual void GetCollidingFaces (dgPolygonMeshDesc* const data) const;
+
+	virtual void GetCollisionInfo(dgCollisionInfo* const info) const;
+	virtual dgVector SupportVertex (const dgVector& dir, dgInt32* const vertexIndex) const;
+	virtual void DebugCollision (const dgMatrix& matrixPtr, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const;
+	void DebugCollisionTiles (const dgMatrix& matrix, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const;
+	void GetVertexListIndexList (const dgVector& p0, const dgVector& p1, dgMeshVertexListIndexList &data) const;
+	void GetLocalAABB (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
+
+	dgVector m_minBox;
+	dgVector m_maxBox;
+
+	dgInt32 m_width;
+	dgInt32 m_height;
+	dgInt32 m_diagonalMode;
+	dgInt8* m_atributeMap;
+	dgInt8* m_diagonals;
+	void* m_elevationMap;
+	dgFloat32 m_verticalScale;
+	dgFloat32 m_horizontalScale;
+	dgFloat32 m_horizontalScaleInv;
+	dgCollisionHeightFieldRayCastCallback m_userRayCastCallback;
+	dgElevationType m_elevationDataType;
+
+	dgHeightBlock* m_heightPyramid;
+	dgTileCache* m_tileCache;
+	dgInt32 m_pyramidBlockSize;
+	dgInt32 m_pyramidLevels;
+	dgInt32 m_pyramidOffset[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+	dgInt32 m_pyramidWidth[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+	dgInt32 m_pyramidHeight[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+
+	static dgVector m_yMask;
+	static dgVector m_padding;
+	static dgInt32 m_cellIndices[][4];
+	static dgInt32 m_verticalEdgeMap[][7];
+	static dgInt32 m_horizontalEdgeMap[][7];
+	
+	dgPerIntanceData* m_instanceData;
+	friend class dgCollisionCompound;
+};
+
+
+DG_INLINE void dgCollisionHeightField::CalculateMinExtend2d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const
+{
+	dgVector q0 (p0.GetMin(p1) - m_padding);
+	dgVector q1 (p0.GetMax(p1) + m_padding);
+
+	boxP0 = ((q0.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) & m_yMask) + dgVector(dgFloat32 (-1.0e10f)).AndNot(m_yMask)) & dgVector::m_triplexMask;
+	boxP1 = (((q1.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) + dgVector(m_horizontalScale)) & m_yMask) + dgVector(dgFloat32 (1.0e10f)).AndNot(m_yMask)) & dgVector::m_triplexMask;
+
+	dgVector minBox ((m_minBox & m_yMask) + boxP0.AndNot(m_yMask));
+	dgVector maxBox ((m_maxBox & m_yMask) + boxP1.AndNot(m_yMask));
+	boxP0 = boxP0.GetMax (minBox);
+	boxP1 = boxP1.GetMin (maxBox);
+}
+
+
+DG_INLINE void dgCollisionHeightField::CalculateMinExtend3d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const
+{
+	dgAssert (p0.m_x <= p1.m_x);
+	dgAssert (p0.m_y <= p1.m_y);
+	dgAssert (p0.m_z <= p1.m_z);
+	dgAssert (p0.m_w == dgFloat32 (0.0f));
+	dgAssert (p1.m_w == dgFloat32 (0.0f));
+
+	dgVector q0 (p0 - m_padding);
+	dgVector q1 (p1 + m_padding);
+
+	boxP0 = (q0.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) & m_yMask) + q0.AndNot(m_yMask);
+	boxP1 = ((q1.Scale4(m_horizontalScaleInv).Floor().Scale4(m_horizontalScale) + dgVector(m_horizontalScale)) & m_yMask) + q1.AndNot(m_yMask);
+
+	dgVector minBox ((m_minBox & m_yMask) + boxP0.AndNot(m_yMask));
+	dgVector maxBox ((m_maxBox & m_yMask) + boxP1.AndNot(m_yMask));
+	boxP0 = boxP0.GetMax (minBox);
+	boxP1 = boxP1.GetMin (maxBox);
+}
+
+DG_INLINE const dgCollisionHeightField::dgHeightBlock& dgCollisionHeightField::GetHeightBlock (dgInt32 level, dgInt32 xBlock, dgInt32 zBlock) const
+{
+	dgAssert (level < m_pyramidLevels);
+	dgAssert (xBlock < m_pyramidWidth[level]);
+	dgAssert (zBlock < m_pyramidHeight[level]);
+	return m_heightPyramid[m_pyramidOffset[level] + zBlock * m_pyramidWidth[level] + xBlock];
+}
+
+DG_INLINE const dgCollisionHeightField::dgHeightFieldTile& dgCollisionHeightField::GetTile (dgInt32 x, dgInt32 z, dgInt32& index) const
+{
+	// the last row and column of vertices belong to the last tile
+	const dgInt32 shift = m_tileCache->m_tileShift;
+	const dgInt32 xTile = dgMin (x >> shift, m_tileCache->m_xTiles - 1);
+	const dgInt32 zTile = dgMin (z >> shift, m_tileCache->m_zTiles - 1);
+	dgHeightFieldTile& tile = m_tileCache->m_tiles[zTile * m_tileCache->m_xTiles + xTile];
+	if (!tile.m_resident) {
+		LoadTile (xTile, zTile);
+	}
+	if (tile.m_lru != m_tileCache->m_lru) {
+		tile.m_lru = m_tileCache->m_lru;
+	}
+	index = (z - (zTile << shift)) * m_tileCache->m_tileStride + x - (xTile << shift);
+	return tile;
+}
+
+DG_INLINE dgFloat32 dgCollisionHeightField::GetElevation (dgInt32 x, dgInt32 z) const
+{
+	if (m_tileCache) {
+		dgInt32 index;
+		const dgHeightFieldTile& tile = GetTile (x, z, index);
+		return (m_elevationDataType == m_float32Bit) ? ((dgFloat32*)tile.m_elevation)[index] : dgFloat32 (((dgUnsigned16*)tile.m_elevation)[index]);
+	}
+	const dgInt32 index = z * m_width + x;
+	return (m_elevationDataType == m_float32Bit) ? ((dgFloat32*)m_elevationMap)[index] : dgFloat32 (((dgUnsigned16*)m_elevationMap)[index]);
+}
+
+DG_INLINE dgInt32 dgCollisionHeightField::GetAtribute (dgInt32 x, dgInt32 z) const
+{
+	if (m_tileCache) {
+		dgInt32 index;
+		const dgHeightFieldTile& tile = GetTile (x, z, index);
+		return tile.m_atributes[index];
+	}
+	return m_atributeMap[z * m_width + x];
+}
+
+DG_INLINE dgInt32 dgCollisionHeightField::GetDiagonal (dgInt32 x, dgInt32 z) const
+{
+	if (m_tileCache) {
+		dgInt32 index;
+		const dgHeightFieldTile& tile = GetTile (x, z, index);
+		return tile.m_diagonals[index];
+	}
+	return m_diagonals[z * m_width + x];
+}
+
+
+#endif
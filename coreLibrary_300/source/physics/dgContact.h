@@ -1,307 +1,478 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#ifndef __DGCONTACT_H__
-#define __DGCONTACT_H__
-
-
-#include "dgConstraint.h"
-
-class dgBody;
-class dgWorld;
-class dgContact; 
-class dgContactPoint; 
-class dgContactMaterial;
-class dgPolygonMeshDesc;
-class dgCollisionInstance;
-
-
-#define DG_MAX_CONTATCS					128
-#define DG_RESTING_CONTACT_PENETRATION	dgFloat32 (1.0f / 256.0f)
-
-class dgActiveContacts: public dgList<dgContact*>
-{
-	public:
-	dgActiveContacts (dgMemoryAllocator* const allocator)
-		:dgList<dgContact*>(allocator)
-	{
-	}
-};
-
-class dgCollidingPairCollector
-{
-	public: 
-	class dgPair 
-	{
-		public:
-		dgContact* m_contact;
-		dgContactPoint* m_contactBuffer;
-		dgFloat32 m_timeOfImpact;
-		dgInt32 m_contactCount				: 16;
-		dgInt32 m_isDeformable				: 1;
-		dgInt32 m_cacheIsValid				: 1;
-	};
-
-
-	dgCollidingPairCollector ();
-	~dgCollidingPairCollector ();
-
-	void Init ();
-	void AddPair (dgContact* const contatJoint, dgInt32 threadIndex);
-	
-	dgInt32 m_count;
-	dgInt32 m_maxSize;
-	dgBody* m_sentinel;
-	dgThread::dgCriticalSection m_lock;
-};
-
-
-DG_MSC_VECTOR_ALIGMENT
-class dgContactPoint 
-{
-	public:
-	dgVector m_point;
-	dgVector m_normal;
-	const dgBody* m_body0;
-	const dgBody* m_body1;
-	const dgCollisionInstance* m_collision0;
-	const dgCollisionInstance* m_collision1;
-	dgInt64 m_shapeId0;
-	dgInt64 m_shapeId1;
-	dgFloat32 m_penetration;
-}DG_GCC_VECTOR_ALIGMENT;
-
-DG_MSC_VECTOR_ALIGMENT
-class dgCollisionParamProxy
-{	
-	public:
-	dgCollisionParamProxy(dgContact* const contact, dgContactPoint* const contactBuffer, dgInt32 threadIndex, bool ccdMode, bool intersectionTestOnly)
-		:m_contactJoint(contact)
-		,m_contacts(contactBuffer)
-		,m_polyMeshData(NULL)		
-		,m_threadIndex(threadIndex)
-		,m_continueCollision(ccdMode)
-		,m_intersectionTestOnly(intersectionTestOnly)
-	{
-	}
-
-	dgMatrix m_matrix;
-	dgVector m_normal;
-	dgVector m_closestPointBody0;
-	dgVector m_closestPointBody1;
-	dgUnsigned64 m_shapeFaceID;
-	dgContact* m_contactJoint;
-	dgBody* m_floatingBody;
-	dgBody* m_referenceBody;
-	dgCollisionInstance* m_floatingCollision;
-	dgCollisionInstance* m_referenceCollision;
-	dgContactPoint* m_contacts;
-	dgPolygonMeshDesc* m_polyMeshData;
-	
-	dgFloat32 m_timestep;
-	dgFloat32 m_skinThickness;
-	dgInt32 m_threadIndex;
-	dgInt32 m_maxContacts;
-	bool m_continueCollision;
-	bool m_intersectionTestOnly;
-
-}DG_GCC_VECTOR_ALIGMENT;
-
-
-class dgClothPatchMaterial
-{
-	public:
-	dgFloat32 m_damper;
-	dgFloat32 m_stiffness;
-};
-
-
-DG_MSC_VECTOR_ALIGMENT 
-class dgContactMaterial: public dgContactPoint
-{
-	public:
-
-	enum {
-		m_collisionEnable = 1<<0,
-		m_friction0Enable = 1<<1,
-		m_friction1Enable = 1<<2,
-		m_override0Accel  = 1<<3,
-		m_override1Accel  = 1<<4,
-		m_overrideNormalAccel = 1<<5,
-	};
-
-	typedef void (dgApi *OnContactCallback) (dgContact& contactJoint, dgFloat32 timestep, dgInt32 threadIndex);
-	typedef bool (dgApi *OnAABBOverlap) (const dgContactMaterial& material, const dgBody& body0, const dgBody& body1, dgInt32 threadIndex);
-	typedef bool (dgApi *OnCompoundCollisionPrefilter) (const dgContactMaterial& material, const dgBody* bodyA, const void* collisionNodeA, const dgBody* bodyB, const void* collisionNodeB, dgInt32 threadIndex);
-
-	dgContactMaterial();
-	void* GetUserData () const; 
-	void SetUserData (void* const userData); 
-	void SetCollisionCallback (OnAABBOverlap abbOvelap, OnContactCallback callback); 
-	void SetCompoundCollisionCallback (OnCompoundCollisionPrefilter abbCompounndOvelap); 
-
-	dgVector m_dir0;
-	dgVector m_dir1;
-	dgForceImpactPair m_normal_Force;
-	dgForceImpactPair m_dir0_Force;
-	dgForceImpactPair m_dir1_Force;
-	dgFloat32 m_softness;
-	dgFloat32 m_restitution;
-	dgFloat32 m_staticFriction0;
-	dgFloat32 m_staticFriction1;
-	dgFloat32 m_dynamicFriction0;
-	dgFloat32 m_dynamicFriction1;
-	dgFloat32 m_skinThickness;
-	dgInt32 m_flags;
-
-	private:
-	void *m_userData;
-	OnAABBOverlap m_aabbOverlap;
-	OnContactCallback m_contactPoint;
-	OnCompoundCollisionPrefilter m_compoundAABBOverlap;
-
-	friend class dgWorld;
-	friend class dgBroadPhase;
-	friend class dgCollisionScene;
-	friend class dgCollisionCompound;
-	friend class dgWorldDynamicUpdate;
-	friend class dgSolverWorlkerThreads;
-	friend class dgCollidingPairCollector;
-	friend class dgBroadPhaseMaterialCallbackWorkerThread;
-	
-}DG_GCC_VECTOR_ALIGMENT;
-
-
-
-DG_MSC_VECTOR_ALIGMENT 
-class dgContact: public dgConstraint, public dgList<dgContactMaterial>
-{
-	public:
-    dgFloat32 GetClosestDistance() const;
-	dgFloat32 GetTimeOfImpact() const;
-	void SetTimeOfImpact(dgFloat32 timetoImpact);
-	const dgContactMaterial* GetMaterial() const;
-
-	protected:
-	dgContact(dgWorld* const world, const dgContactMaterial* const material);
-	virtual ~dgContact();
-
-	DG_CLASS_ALLOCATOR(allocator)
-
-	virtual void ResetMaxDOF();
-	virtual void GetInfo (dgConstraintInfo* const info) const;
-	virtual dgUnsigned32 JacobianDerivative (dgContraintDescritor& params); 
-	virtual void JointAccelerations (dgJointAccelerationDecriptor* const params); 
-	virtual void JointVelocityCorrection(dgJointAccelerationDecriptor* const params); 
-	
-	virtual bool IsDeformable() const ;
-	virtual void SetDestructorCallback (OnConstraintDestroy destructor);
-
-	void JacobianContactDerivative (dgContraintDescritor& params, const dgContactMaterial& contact, dgInt32 normalIndex, dgInt32& frictionIndex); 
-	void CalculatePointDerivative (dgInt32 index, dgContraintDescritor& desc, const dgVector& dir, const dgPointParam& param) const;
-
-	void AppendToActiveList();
-	void SwapBodies();
-
-	dgVector m_positAcc;
-	dgQuaternion m_rotationAcc;
-	dgVector m_separtingVector;
-	dgFloat32 m_closestDistance;
-	dgFloat32 m_timeOfImpact;
-	dgWorld* m_world;
-	const dgContactMaterial* m_material;
-	dgActiveContacts::dgListNode* m_contactNode;
-	dgUnsigned32 m_broadphaseLru;
-	dgUnsigned32 m_isNewContact				: 1;
-
-
-    friend class dgBody;
-	friend class dgWorld;
-	friend class dgBroadPhase;
-	friend class dgContactSolver;
-	friend class dgActiveContacts;
-	friend class dgCollisionScene;
-	friend class dgCollisionConvex;
-	friend class dgCollisionCompound;
-	friend class dgWorldDynamicUpdate;
-	friend class dgSolverWorlkerThreads;
-	friend class dgCollisionConvexPolygon;
-	friend class dgCollidingPairCollector;
-}DG_GCC_VECTOR_ALIGMENT;
-
-inline void dgContactMaterial::SetCollisionCallback (OnAABBOverlap aabbOverlap, OnContactCallback contact) 
-{
-	m_aabbOverlap = aabbOverlap;
-	m_contactPoint = contact;
-}
-
-inline void dgContactMaterial::SetCompoundCollisionCallback (OnCompoundCollisionPrefilter aabbOverlap)
-{
-	m_compoundAABBOverlap = aabbOverlap;
-}
-
-inline void* dgContactMaterial::GetUserData () const
-{
-	return m_userData;
-}
-
-inline void dgContactMaterial::SetUserData (void* const userData)
-{
-	m_userData = userData;
-}
-
-
-inline bool dgContact::IsDeformable() const 
-{
-	return false;
-}
-
-inline void dgContact::SetDestructorCallback (OnConstraintDestroy destructor)
-{
-}
-
-inline const dgContactMaterial* dgContact::GetMaterial() const
-{
-	return m_material;
-}
-
-inline void dgContact::SetTimeOfImpact(dgFloat32 timetoImpact)
-{
-	m_timeOfImpact = timetoImpact;
-}
-
-inline dgFloat32 dgContact::GetTimeOfImpact() const
-{
-	return m_timeOfImpact;
-}
-
-inline dgFloat32 dgContact::GetClosestDistance() const
-{
-    return m_closestDistance;
-}
-
-inline void dgContact::ResetMaxDOF()
-{
-	m_maxDOF = 0;
-}
-
-#endif 
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __DGCONTACT_H__
+#define __DGCONTACT_H__
+
+
+#include "dgConstraint.h"
+
+class dgBody;
+class dgWorld;
+class dgContact; 
+class dgContactPoint; 
+class dgContactMaterial;
+class dgPolygonMeshDesc;
+class dgCollisionInstance;
+
+
+#define DG_MAX_CONTATCS					128
+#define DG_MAX_CONTACT_MANIFOLD_POINTS	(DG_CONSTRAINT_MAX_ROWS / 3)
+#define DG_RESTING_CONTACT_PENETRATION	dgFloat32 (1.0f / 256.0f)
+#define DG_CONTACT_TASK_MAX_COUNT		32
+#define DG_CONTACT_TASK_MIN_COUNT		4
+#define DG_CONTACT_TASK_FACE_BATCH		128
+
+class dgActiveContacts: public dgList<dgContact*>
+{
+	public:
+	dgActiveContacts (dgMemoryAllocator* const allocator)
+		:dgList<dgContact*>(allocator)
+	{
+	}
+};
+
+class dgCollidingPairCollector
+{
+	public: 
+	class dgPair 
+	{
+		public:
+		dgContact* m_contact;
+		dgContactPoint* m_contactBuffer;
+		dgFloat32 m_timeOfImpact;
+		dgInt32 m_contactCount				: 16;
+		dgInt32 m_isDeformable				: 1;
+		dgInt32 m_cacheIsValid				: 1;
+	};
+
+
+	dgCollidingPairCollector ();
+	~dgCollidingPairCollector ();
+
+	void Init ();
+	void AddPair (dgContact* const contatJoint, dgInt32 threadIndex);
+	
+	dgInt32 m_count;
+	dgInt32 m_maxSize;
+	dgBody* m_sentinel;
+	dgThread::dgCriticalSection m_lock;
+};
+
+
+// a part of the narrow phase of a large pair, either a sub tree of a compound or a slice of the box of a hull 
+// colliding with a polygon soup. the broadphase runs the parts of a pair on all worker threads, 
+// and merges their contacts before the pair is processed
+class dgContactTask
+{
+	public:
+	dgCollidingPairCollector::dgPair* m_pair;
+	dgContactPoint* m_contacts;
+	void* m_node;
+	dgFloat32 m_closestDistance;
+	dgInt32 m_slice;
+	dgInt32 m_sliceCount;
+	dgInt32 m_faceCount;
+	dgInt32 m_contactCount;
+	dgInt32 m_contactActive;
+	dgInt32 m_isNewContact;
+};
+
+class dgContactTaskBatch
+{
+	public:
+	dgContactTaskBatch (dgInt32 maxCount)
+		:m_count(0)
+		,m_maxCount(dgMin (maxCount, DG_CONTACT_TASK_MAX_COUNT))
+	{
+	}
+
+	void AddTask (void* const node, dgInt32 slice, dgInt32 sliceCount)
+	{
+		dgAssert (m_count < m_maxCount);
+		dgContactTask& task = m_tasks[m_count];
+		task.m_pair = NULL;
+		task.m_contacts = NULL;
+		task.m_node = node;
+		task.m_slice = slice;
+		task.m_sliceCount = sliceCount;
+		task.m_faceCount = 0;
+		task.m_contactCount = 0;
+		m_count ++;
+	}
+
+	dgContactTask m_tasks[DG_CONTACT_TASK_MAX_COUNT];
+	dgInt32 m_count;
+	dgInt32 m_maxCount;
+};
+
+
+DG_MSC_VECTOR_ALIGMENT
+class dgContactPoint 
+{
+	public:
+	dgVector m_point;
+	dgVector m_normal;
+	const dgBody* m_body0;
+	const dgBody* m_body1;
+	const dgCollisionInstance* m_collision0;
+	const dgCollisionInstance* m_collision1;
+	dgInt64 m_shapeId0;
+	dgInt64 m_shapeId1;
+	dgFloat32 m_penetration;
+}DG_GCC_VECTOR_ALIGMENT;
+
+DG_MSC_VECTOR_ALIGMENT
+class dgCollisionParamProxy
+{	
+	public:
+	dgCollisionParamProxy(dgContact* const contact, dgContactPoint* const contactBuffer, dgInt32 threadIndex, bool ccdMode, bool intersectionTestOnly)
+		:m_contactJoint(contact)
+		,m_contacts(contactBuffer)
+		,m_polyMeshData(NULL)		
+		,m_splitTasks(NULL)
+		,m_task(NULL)
+		,m_threadIndex(threadIndex)
+		,m_continueCollision(ccdMode)
+		,m_intersectionTestOnly(intersectionTestOnly)
+	{
+	}
+
+	dgMatrix m_matrix;
+	dgVector m_normal;
+	dgVector m_closestPointBody0;
+	dgVector m_closestPointBody1;
+	dgUnsigned64 m_shapeFaceID;
+	dgContact* m_contactJoint;
+	dgBody* m_floatingBody;
+	dgBody* m_referenceBody;
+	dgCollisionInstance* m_floatingCollision;
+	dgCollisionInstance* m_referenceCollision;
+	dgContactPoint* m_contacts;
+	dgPolygonMeshDesc* m_polyMeshData;
+	dgContactTaskBatch* m_splitTasks;
+	const dgContactTask* m_task;
+	
+	dgFloat32 m_timestep;
+	dgFloat32 m_skinThickness;
+	dgInt32 m_threadIndex;
+	dgInt32 m_maxContacts;
+	bool m_continueCollision;
+	bool m_intersectionTestOnly;
+
+}DG_GCC_VECTOR_ALIGMENT;
+
+
+class dgClothPatchMaterial
+{
+	public:
+	dgFloat32 m_damper;
+	dgFloat32 m_stiffness;
+};
+
+
+DG_MSC_VECTOR_ALIGMENT 
+class dgContactMaterial: public dgContactPoint
+{
+	public:
+
+	enum {
+		m_collisionEnable = 1<<0,
+		m_friction0Enable = 1<<1,
+		m_friction1Enable = 1<<2,
+		m_override0Accel  = 1<<3,
+		m_override1Accel  = 1<<4,
+		m_overrideNormalAccel = 1<<5,
+		m_speculativeContact = 1<<6,
+	};
+
+	typedef void (dgApi *OnContactCallback) (dgContact& contactJoint, dgFloat32 timestep, dgInt32 threadIndex);
+	typedef bool (dgApi *OnAABBOverlap) (const dgContactMaterial& material, const dgBody& body0, const dgBody& body1, dgInt32 threadIndex);
+	typedef bool (dgApi *OnCompoundCollisionPrefilter) (const dgContactMaterial& material, const dgBody* bodyA, const void* collisionNodeA, const dgBody* bodyB, const void* collisionNodeB, dgInt32 threadIndex);
+
+	dgContactMaterial();
+	void* GetUserData () const; 
+	void SetUserData (void* const userData); 
+	void SetCollisionCallback (OnAABBOverlap abbOvelap, OnContactCallback callback); 
+	void SetCompoundCollisionCallback (OnCompoundCollisionPrefilter abbCompounndOvelap); 
+
+	dgVector m_dir0;
+	dgVector m_dir1;
+	dgForceImpactPair m_normal_Force;
+	dgForceImpactPair m_dir0_Force;
+	dgForceImpactPair m_dir1_Force;
+	dgFloat32 m_softness;
+	dgFloat32 m_restitution;
+	dgFloat32 m_staticFriction0;
+	dgFloat32 m_staticFriction1;
+	dgFloat32 m_dynamicFriction0;
+	dgFloat32 m_dynamicFriction1;
+	dgFloat32 m_skinThickness;
+	dgInt32 m_flags;
+
+	private:
+	void *m_userData;
+	OnAABBOverlap m_aabbOverlap;
+	OnContactCallback m_contactPoint;
+	OnCompoundCollisionPrefilter m_compoundAABBOverlap;
+
+	friend class dgWorld;
+	friend class dgBroadPhase;
+	friend class dgCollisionScene;
+	friend class dgCollisionCompound;
+	friend class dgWorldDynamicUpdate;
+	friend class dgSolverWorlkerThreads;
+	friend class dgCollidingPairCollector;
+	friend class dgBroadPhaseMaterialCallbackWorkerThread;
+	
+}DG_GCC_VECTOR_ALIGMENT;
+
+
+
+// fixed capacity contact manifold stored inline in the contact joint.
+// points live in a contiguous array and keep their slot for the life of the contact,
+// so persistence from frame to frame does not allocate and the accumulated forces stay with the point.
+// iteration order is the order of insertion, and removing a point does not invalidate the others.
+DG_MSC_VECTOR_ALIGMENT 
+class dgContactManifold
+{
+	public:
+	dgContactManifold();
+
+	dgInt32 GetCount() const;
+	dgInt32 GetSlot (const dgContactMaterial* const point) const;
+
+	dgContactMaterial* GetFirst() const;
+	dgContactMaterial* GetNext (const dgContactMaterial* const point) const;
+
+	dgContactMaterial* Append ();
+	void Remove (dgContactMaterial* const point);
+	void RemoveAll ();
+
+	private:
+	dgContactMaterial m_points[DG_MAX_CONTACT_MANIFOLD_POINTS];
+	dgInt32 m_next[DG_MAX_CONTACT_MANIFOLD_POINTS];
+	dgInt32 m_prev[DG_MAX_CONTACT_MANIFOLD_POINTS];
+	dgInt32 m_freeSlots[DG_MAX_CONTACT_MANIFOLD_POINTS];
+	dgInt32 m_first;
+	dgInt32 m_last;
+	dgInt32 m_count;
+}DG_GCC_VECTOR_ALIGMENT;
+
+
+DG_MSC_VECTOR_ALIGMENT 
+class dgContact: public dgConstraint, public dgContactManifold
+{
+	public:
+    dgFloat32 GetClosestDistance() const;
+	dgFloat32 GetTimeOfImpact() const;
+	void SetTimeOfImpact(dgFloat32 timetoImpact);
+	const dgContactMaterial* GetMaterial() const;
+
+	protected:
+	dgContact(dgWorld* const world, const dgContactMaterial* const material);
+	virtual ~dgContact();
+
+	DG_CLASS_ALLOCATOR(allocator)
+
+	virtual void ResetMaxDOF();
+	virtual void GetInfo (dgConstraintInfo* const info) const;
+	virtual dgUnsigned32 JacobianDerivative (dgContraintDescritor& params); 
+	virtual void JointAccelerations (dgJointAccelerationDecriptor* const params); 
+	virtual void JointVelocityCorrection(dgJointAccelerationDecriptor* const params); 
+	
+	virtual bool IsDeformable() const ;
+	virtual void SetDestructorCallback (OnConstraintDestroy destructor);
+
+	void JacobianContactDerivative (dgContraintDescritor& params, const dgContactMaterial& contact, dgInt32 normalIndex, dgInt32& frictionIndex); 
+	void CalculatePointDerivative (dgInt32 index, dgContraintDescritor& desc, const dgVector& dir, const dgPointParam& param) const;
+
+	void AppendToActiveList();
+	void SwapBodies();
+
+	dgVector m_positAcc;
+	dgQuaternion m_rotationAcc;
+	dgVector m_separtingVector;
+	dgFloat32 m_closestDistance;
+	dgFloat32 m_timeOfImpact;
+	dgFloat32 m_speculativeMargin;
+	dgWorld* m_world;
+	const dgContactMaterial* m_material;
+	dgActiveContacts::dgListNode* m_contactNode;
+	dgUnsigned32 m_broadphaseLru;
+	dgInt32 m_collidingFaceCount;
+	dgUnsigned32 m_pairCost;
+	dgUnsigned32 m_isNewContact				: 1;
+
+
+    friend class dgBody;
+	friend class dgWorld;
+	friend class dgBroadPhase;
+	friend class dgContactSolver;
+	friend class dgActiveContacts;
+	friend class dgCollisionScene;
+	friend class dgCollisionConvex;
+	friend class dgCollisionCompound;
+	friend class dgWorldDynamicUpdate;
+	friend class dgSolverWorlkerThreads;
+	friend class dgCollisionConvexPolygon;
+	friend class dgCollidingPairCollector;
+}DG_GCC_VECTOR_ALIGMENT;
+
+inline void dgContactMaterial::SetCollisionCallback (OnAABBOverlap aabbOverlap, OnContactCallback contact) 
+{
+	m_aabbOverlap = aabbOverlap;
+	m_contactPoint = contact;
+}
+
+inline void dgContactMaterial::SetCompoundCollisionCallback (OnCompoundCollisionPrefilter aabbOverlap)
+{
+	m_compoundAABBOverlap = aabbOverlap;
+}
+
+inline void* dgContactMaterial::GetUserData () const
+{
+	return m_userData;
+}
+
+inline void dgContactMaterial::SetUserData (void* const userData)
+{
+	m_userData = userData;
+}
+
+
+inline dgContactManifold::dgContactManifold()
+	:m_first(-1)
+	,m_last(-1)
+	,m_count(0)
+{
+	for (dgInt32 i = 0; i < DG_MAX_CONTACT_MANIFOLD_POINTS; i ++) {
+		m_freeSlots[i] = DG_MAX_CONTACT_MANIFOLD_POINTS - 1 - i;
+	}
+}
+
+inline dgInt32 dgContactManifold::GetCount() const
+{
+	return m_count;
+}
+
+inline dgInt32 dgContactManifold::GetSlot (const dgContactMaterial* const point) const
+{
+	dgInt32 slot = dgInt32 (point - m_points);
+	dgAssert ((slot >= 0) && (slot < DG_MAX_CONTACT_MANIFOLD_POINTS));
+	return slot;
+}
+
+inline dgContactMaterial* dgContactManifold::GetFirst() const
+{
+	return (m_first >= 0) ? (dgContactMaterial*) &m_points[m_first] : NULL;
+}
+
+inline dgContactMaterial* dgContactManifold::GetNext (const dgContactMaterial* const point) const
+{
+	dgInt32 next = m_next[GetSlot (point)];
+	return (next >= 0) ? (dgContactMaterial*) &m_points[next] : NULL;
+}
+
+inline dgContactMaterial* dgContactManifold::Append ()
+{
+	dgAssert (m_count < DG_MAX_CONTACT_MANIFOLD_POINTS);
+	m_count ++;
+	dgInt32 slot = m_freeSlots[DG_MAX_CONTACT_MANIFOLD_POINTS - m_count];
+
+	m_next[slot] = -1;
+	m_prev[slot] = m_last;
+	if (m_last >= 0) {
+		m_next[m_last] = slot;
+	} else {
+		m_first = slot;
+	}
+	m_last = slot;
+
+	// a recycled slot must not carry the accumulated forces of the point that used it before
+	m_points[slot] = dgContactMaterial();
+	return &m_points[slot];
+}
+
+inline void dgContactManifold::Remove (dgContactMaterial* const point)
+{
+	dgAssert (m_count > 0);
+	dgInt32 slot = GetSlot (point);
+	dgInt32 next = m_next[slot];
+	dgInt32 prev = m_prev[slot];
+	if (prev >= 0) {
+		m_next[prev] = next;
+	} else {
+		m_first = next;
+	}
+	if (next >= 0) {
+		m_prev[next] = prev;
+	} else {
+		m_last = prev;
+	}
+	m_freeSlots[DG_MAX_CONTACT_MANIFOLD_POINTS - m_count] = slot;
+	m_count --;
+}
+
+inline void dgContactManifold::RemoveAll ()
+{
+	while (m_first >= 0) {
+		Remove (&m_points[m_first]);
+	}
+}
+
+
+inline bool dgContact::IsDeformable() const 
+{
+	return false;
+}
+
+inline void dgContact::SetDestructorCallback (OnConstraintDestroy destructor)
+{
+}
+
+inline const dgContactMaterial* dgContact::GetMaterial() const
+{
+	return m_material;
+}
+
+inline void dgContact::SetTimeOfImpact(dgFloat32 timetoImpact)
+{
+	m_timeOfImpact = timetoImpact;
+}
+
+inline dgFloat32 dgContact::GetTimeOfImpact() const
+{
+	return m_timeOfImpact;
+}
+
+inline dgFloat32 dgContact::GetClosestDistance() const
+{
+    return m_closestDistance;
+}
+
+inline void dgContact::ResetMaxDOF()
+{
+	m_maxDOF = 0;
+}
+
+#endif 
+
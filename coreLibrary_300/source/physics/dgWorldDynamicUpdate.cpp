@@ -1,974 +1,1202 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgPhysicsStdafx.h"
-
-#include "dgBody.h"
-#include "dgWorld.h"
-#include "dgBroadPhase.h"
-#include "dgConstraint.h"
-#include "dgDynamicBody.h"
-#include "dgCollisionInstance.h"
-#include "dgBilateralConstraint.h"
-#include "dgWorldDynamicUpdate.h"
-#include "dgCollisionDeformableMesh.h"
-
-
-#ifdef _NEWTON_AMP
-#include "dgAmpInstance.h"
-#endif
-
-
-
-#define DG_CCD_EXTRA_CONTACT_COUNT			(8 * 3)
-#define DG_PARALLEL_JOINT_COUNT_CUT_OFF		(128)
-
-
-dgVector dgWorldDynamicUpdate::m_velocTol (dgFloat32 (1.0e-18f));
-
-class dgWorldDynamicUpdateSyncDescriptor
-{
-	public:
-	dgWorldDynamicUpdateSyncDescriptor()
-	{
-		memset (this, 0, sizeof (dgWorldDynamicUpdateSyncDescriptor));
-	}
-
-	dgFloat32 m_timestep;
-	dgInt32 m_atomicCounter;
-	
-	dgInt32 m_islandCount;
-	dgInt32 m_firstIsland;
-	dgThread::dgCriticalSection* m_criticalSection;
-};
-
-
-//////////////////////////////////////////////////////////////////////
-// Construction/Destruction
-//////////////////////////////////////////////////////////////////////
-
-dgBody* dgWorld::GetIslandBody (const void* const islandPtr, dgInt32 index) const
-{
-	const dgIslandCallbackStruct* const island = (dgIslandCallbackStruct*)islandPtr;
-
-	char* const ptr = &((char*)island->m_bodyArray)[island->m_strideInByte * index];
-	dgBody** const bodyPtr = (dgBody**)ptr;
-	return (index < island->m_count) ? ((index >= 0) ? *bodyPtr : NULL) : NULL;
-}
-
-
-dgWorldDynamicUpdate::dgWorldDynamicUpdate()
-	:m_bodies(0)
-	,m_joints(0)
-	,m_islands(0)
-	,m_markLru(0)
-//	,m_rowCountAtomicIndex(0)
-	,m_softBodyCriticalSectionLock()
-{
-}
-
-
-void dgWorldDynamicUpdate::UpdateDynamics(dgFloat32 timestep)
-{
-	dgWorld* const world = (dgWorld*) this;
-	dgUnsigned32 updateTime = world->m_getPerformanceCount();
-
-	world->m_dynamicsLru = world->m_dynamicsLru + DG_BODY_LRU_STEP;
-
-	m_bodies = 0;
-	m_joints = 0;
-	m_islands = 0;
-	m_markLru = world->m_dynamicsLru;
-
-	dgUnsigned32 lru = m_markLru - 1;
-
-	dgBodyMasterList& me = *world;
-
-	world->m_pairMemoryBuffer.ExpandCapacityIfNeessesary (4 * me.GetCount(), sizeof (dgBody*));
-
-	dgAssert (me.GetFirst()->GetInfo().GetBody() == world->m_sentinelBody);
-
-	dgBody* const sentinelBody = world->m_sentinelBody;
-	sentinelBody->m_index = 0; 
-	sentinelBody->m_dynamicsLru = m_markLru;
-
-	for (dgBodyMasterList::dgListNode* node = me.GetLast(); node; node = node->GetPrev()) {
-		const dgBodyMasterListRow& graphNode = node->GetInfo();
-		dgBody* const body = graphNode.GetBody();	
-
-		//if ((body->GetType() == dgBody::m_kinamticBody) || (body->GetInvMass().m_w == dgFloat32(0.0f))) {
-		if (body->GetInvMass().m_w == dgFloat32(0.0f)) {
-#ifdef _DEBUG
-			for (; node; node = node->GetPrev()) {
-				//dgAssert ((body->GetType() == dgBody::m_kinamticBody) ||(node->GetInfo().GetBody()->GetInvMass().m_w == dgFloat32(0.0f)));
-				dgAssert (node->GetInfo().GetBody()->GetInvMass().m_w == dgFloat32(0.0f));
-			}
-#endif
-			break;
-		}
-
-		if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
-			dgDynamicBody* const dynamicBody = (dgDynamicBody*) body;
-			if (dynamicBody->m_dynamicsLru < lru) {
-				if (!(dynamicBody->m_freeze | dynamicBody->m_spawnnedFromCallback | dynamicBody->m_sleeping)) {
-					SpanningTree (dynamicBody, timestep);
-				}
-			}
-			dynamicBody->m_spawnnedFromCallback = false;
-		}
-	}
-
-	dgInt32 maxRowCount = 0;
-	dgIsland* const islandsArray = (dgIsland*) &world->m_islandMemory[0];
-	for (dgInt32 i = 0; i < m_islands; i ++) {
-		islandsArray[i].m_rowsStart = maxRowCount;
-		maxRowCount += islandsArray[i].m_rowsCount;
-	}
-	m_solverMemory.Init (world, maxRowCount, m_bodies);
-
-//	m_rowCountAtomicIndex = 0;
-
-	dgInt32 threadCount = world->GetThreadCount();	
-
-	dgWorldDynamicUpdateSyncDescriptor descriptor;
-	descriptor.m_timestep = timestep;
-	descriptor.m_firstIsland = 0;
-	descriptor.m_islandCount = m_islands;
-	descriptor.m_atomicCounter = 0;
-
-	sentinelBody->m_resting = true;
-	sentinelBody->m_active = false;
-	sentinelBody->m_equilibrium = true;
-	for (dgInt32 i = 0; i < threadCount; i ++) {
-		world->QueueJob (FindActiveJointAndBodies, &descriptor, world);
-	}
-	world->SynchronizationBarrier();
-
-	dgSort (islandsArray, m_islands, CompareIslands); 
-
-	dgUnsigned32 dynamicsTime = world->m_getPerformanceCount();
-	world->m_perfomanceCounters[m_dynamicsBuildSpanningTreeTicks] = dynamicsTime - updateTime;
-
-	if (!(world->m_amp && (world->m_hardwaredIndex > 0))) {
-		dgInt32 useParallel = world->m_useParallelSolver && (threadCount > 1);
-
-useParallel = 0;
-		dgInt32 index = 0;
-		if (useParallel) {
-			useParallel = useParallel && m_joints;
-			useParallel = useParallel && ((threadCount * islandsArray[0].m_jointCount) >= m_joints);
-			useParallel = useParallel && (islandsArray[0].m_jointCount > DG_PARALLEL_JOINT_COUNT_CUT_OFF);
-			while (useParallel) {
-				CalculateReactionForcesParallel(&islandsArray[index], timestep);
-				index ++;
-				useParallel = useParallel && (index < m_islands);
-				useParallel = useParallel && ((threadCount * islandsArray[index].m_jointCount) >= m_joints);
-				useParallel = useParallel && (islandsArray[index].m_jointCount > DG_PARALLEL_JOINT_COUNT_CUT_OFF);
-			}
-		}
-
-		if (index < m_islands) {
-			descriptor.m_firstIsland = index;
-			descriptor.m_islandCount = m_islands - index;
-			descriptor.m_atomicCounter = 0;
-			for (dgInt32 i = 0; i < threadCount; i ++) {
-				world->QueueJob (CalculateIslandReactionForcesKernel, &descriptor, world);
-			}
-			world->SynchronizationBarrier();
-		}
-	} else {
-		#ifdef _NEWTON_AMP 
-			
-			world->m_amp->ConstraintSolver (m_islands, islandsArray, timestep);
-		#endif
-	}
-
-	dgUnsigned32 ticks = world->m_getPerformanceCount();
-	world->m_perfomanceCounters[m_dynamicsSolveSpanningTreeTicks] = ticks - dynamicsTime;
-	world->m_perfomanceCounters[m_dynamicsTicks] = ticks - updateTime;
-
-	// integrate soft body dynamics phase 2
-	dgDeformableBodiesUpdate* const softBodyList = world;
-    softBodyList->SolveConstraintsAndIntegrate (timestep);
-	world->m_perfomanceCounters[m_softBodyTicks] += (world->m_getPerformanceCount() - ticks);
-}
-
-
-
-void dgJacobianMemory::Init (dgWorld* const world, dgInt32 rowsCount, dgInt32 bodyCount)
-{
-	world->m_solverMatrixMemory.ExpandCapacityIfNeessesary (rowsCount, sizeof (dgJacobianMatrixElement));
-	m_memory = (dgJacobianMatrixElement*) &world->m_solverMatrixMemory[0];
-
-	world->m_solverRightSideMemory.ExpandCapacityIfNeessesary (bodyCount + 8, sizeof (dgJacobian));
-	m_internalForces = (dgJacobian*) &world->m_solverRightSideMemory[0];
-	dgAssert (bodyCount <= (((world->m_solverRightSideMemory.GetBytesCapacity() - 16) / dgInt32 (sizeof (dgJacobian))) & (-8)));
-
-	dgAssert ((dgUnsigned64(m_memory) & 0x01f) == 0);
-	dgAssert ((dgUnsigned64(m_internalForces) & 0x01f) == 0);
-}
-
-// sort from high to low
-dgInt32 dgWorldDynamicUpdate::CompareIslands (const dgIsland* const islandA, const dgIsland* const islandB, void* notUsed)
-{
-	dgInt32 countA = islandA->m_jointCount + (islandA->m_hasExactSolverJoints << 28);
-	dgInt32 countB = islandB->m_jointCount + (islandB->m_hasExactSolverJoints << 28);
-
-	if (countA < countB) {
-		return 1;
-	}
-	if (countA > countB) {
-		return -1;
-	}
-	return 0;
-}
-
-
-
-void dgWorldDynamicUpdate::SpanningTree (dgDynamicBody* const body, dgFloat32 timestep)
-{
-	dgInt32 bodyCount = 0;
-	dgInt32 jointCount = 0;
-	dgInt32 staticCount = 0;
-	dgUnsigned32 lruMark = m_markLru - 1;
-	dgInt32 isInEquilibrium = 1;
-	dgInt32 hasExactSolverJoints = 0;
-	dgFloat32 haviestMass = dgFloat32 (0.0f);
-
-	dgDynamicBody* heaviestBody = NULL;
-	dgWorld* const world = (dgWorld*) this;
-	dgQueue<dgDynamicBody*> queue ((dgDynamicBody**) &world->m_pairMemoryBuffer[0], dgInt32 ((world->m_pairMemoryBuffer.GetBytesCapacity()>>1)/sizeof (void*)));
-	
-	dgDynamicBody** const staticPool = &queue.m_pool[queue.m_mod];
-
-	body->m_dynamicsLru = lruMark;
-
-	queue.Insert (body);
-	while (!queue.IsEmpty()) {
-		dgInt32 count = queue.m_firstIndex - queue.m_lastIndex;
-		if (count < 0) {
-			dgAssert (0);
-			count += queue.m_mod;
-		}
-
-		dgInt32 index = queue.m_lastIndex;
-		queue.Reset ();
-
-		for (dgInt32 j = 0; j < count; j ++) {
-			dgDynamicBody* const srcBody = queue.m_pool[index];
-			dgAssert (srcBody);
-			dgAssert (srcBody->GetInvMass().m_w > dgFloat32 (0.0f));
-			dgAssert (srcBody->m_dynamicsLru == lruMark);
-			dgAssert (srcBody->m_masterNode);
-
-			dgInt32 bodyIndex = m_bodies + bodyCount;
-			world->m_bodiesMemory.ExpandCapacityIfNeessesary(bodyIndex, sizeof (dgBodyInfo));
-			dgBodyInfo* const bodyArray = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-			bodyArray[bodyIndex].m_body = srcBody;
-
-			srcBody->m_sleeping = false;
-
-			if (srcBody->m_mass.m_w > haviestMass) {
-				haviestMass = srcBody->m_mass.m_w;
-				heaviestBody = srcBody;
-			}
-
-			bodyCount ++;
-
-			for (dgBodyMasterListRow::dgListNode* jointNode = srcBody->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
-				dgBodyMasterListCell* const cell = &jointNode->GetInfo();
-				dgConstraint* const constraint = cell->m_joint;
-				dgAssert (constraint);
-				dgBody* const linkBody = cell->m_bodyNode;
-				dgAssert ((constraint->m_body0 == srcBody) || (constraint->m_body1 == srcBody));
-				dgAssert ((constraint->m_body0 == linkBody) || (constraint->m_body1 == linkBody));
-				const dgContact* const contact = (constraint->GetId() == dgConstraint::m_contactConstraint) ? (dgContact*)constraint : NULL;
-				if (linkBody->IsCollidable() && (!contact || contact->m_maxDOF || (srcBody->m_continueCollisionMode | linkBody->m_continueCollisionMode))) { 
-					dgDynamicBody* const body = (dgDynamicBody*)linkBody;
-
-					isInEquilibrium &= srcBody->m_equilibrium;
-					isInEquilibrium &= srcBody->m_autoSleep;
-
-					isInEquilibrium &= body->m_equilibrium;
-					isInEquilibrium &= body->m_autoSleep;
-
-					if (body->m_dynamicsLru < lruMark) {
-						body->m_dynamicsLru = lruMark;
-						if (body->m_invMass.m_w > dgFloat32 (0.0f)) { 
-							queue.Insert (body);
-						} else {
-							dgInt32 duplicateBody = 0;
-							for (; duplicateBody < staticCount; duplicateBody ++) {
-								if (staticPool[duplicateBody] == srcBody) {
-									break;
-								}
-							}
-							if (duplicateBody == staticCount) {
-								staticPool[staticCount] = srcBody;
-								staticCount ++;
-								dgAssert (srcBody->m_invMass.m_w > dgFloat32 (0.0f));
-							}
-
-							
-							dgAssert (dgInt32 (constraint->m_dynamicsLru) != m_markLru);
-
-							dgInt32 jointIndex = m_joints + jointCount; 
-
-							world->m_jointsMemory.ExpandCapacityIfNeessesary(jointIndex, sizeof (dgJointInfo));
-
-							hasExactSolverJoints |= constraint->m_useExactSolver;
-							
-							constraint->m_index = dgUnsigned32 (jointCount);
-							dgJointInfo* const constraintArray = (dgJointInfo*) &world->m_jointsMemory[0];
-							constraintArray[jointIndex].m_joint = constraint;
-							jointCount ++;
-
-							dgAssert (constraint->m_body0);
-							dgAssert (constraint->m_body1);
-						}
-
-					} else if (body->m_invMass.m_w == dgFloat32 (0.0f)) { 
-						dgInt32 duplicateBody = 0;
-						for (; duplicateBody < staticCount; duplicateBody ++) {
-							if (staticPool[duplicateBody] == srcBody) {
-								break;
-							}
-						}
-						if (duplicateBody == staticCount) {
-							staticPool[staticCount] = srcBody;
-							staticCount ++;
-							dgAssert (srcBody->m_invMass.m_w > dgFloat32 (0.0f));
-						}
-					
-						dgAssert (dgInt32 (constraint->m_dynamicsLru) != m_markLru);
-
-						dgInt32 jointIndex = m_joints + jointCount; 
-						world->m_jointsMemory.ExpandCapacityIfNeessesary(jointIndex, sizeof (dgJointInfo));
-
-						hasExactSolverJoints |= constraint->m_useExactSolver;
-						
-						constraint->m_index = dgUnsigned32 (jointCount);
-						dgJointInfo* const constraintArray = (dgJointInfo*) &world->m_jointsMemory[0];
-						constraintArray[jointIndex].m_joint = constraint;
-						jointCount ++;
-
-						dgAssert (constraint->m_body0);
-						dgAssert (constraint->m_body1);
-					}
-				}
-			}
-
-			index ++;
-			if (index >= queue.m_mod) {
-				dgAssert (0);
-				index = 0;
-			}
-		}
-	}
-
-	if (!jointCount) {
-		//dgAssert (bodyCount == 1);
-		if (bodyCount == 1) {
-			isInEquilibrium &= body->m_equilibrium;
-			isInEquilibrium &= body->m_autoSleep;
-		}
-	}
-
-
-	dgBodyInfo* const bodyArray = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgJointInfo* const constraintArray = (dgJointInfo*) &world->m_jointsMemory[0];
-
-	if (isInEquilibrium) {
-		for (dgInt32 i = 0; i < bodyCount; i ++) {
-			dgBody* const body = bodyArray[m_bodies + i].m_body;
-			body->m_dynamicsLru = m_markLru;
-			body->m_sleeping = true;
-		}
-	} else {
-		if (world->m_islandUpdate) {
-			dgIslandCallbackStruct record;
-			record.m_world = world;
-			record.m_count = bodyCount;
-			record.m_strideInByte = sizeof (dgBodyInfo);
-			record.m_bodyArray = &bodyArray[m_bodies].m_body;
-			if (!world->m_islandUpdate (world, &record, bodyCount)) {
-				for (dgInt32 i = 0; i < bodyCount; i ++) {
-					dgBody* const body = bodyArray[m_bodies + i].m_body;
-					body->m_dynamicsLru = m_markLru;
-				}
-				return;
-			}
-		}
-
-		if (staticCount) {
-			queue.Reset ();
-			for (dgInt32 i = 0; i < staticCount; i ++) {
-				dgDynamicBody* const body = staticPool[i];
-				body->m_dynamicsLru = m_markLru;
-				queue.Insert (body);
-				dgAssert (dgInt32 (body->m_dynamicsLru) == m_markLru);
-			}
-
-			const dgInt32 vectorStride = dgInt32 (sizeof (dgVector) / sizeof (dgFloat32));
-			for (dgInt32 i = 0; i < jointCount; i ++) {
-				dgConstraint* const constraint = constraintArray[m_joints + i].m_joint;
-				constraint->m_dynamicsLru = m_markLru;
-				dgInt32 rows = (constraint->m_maxDOF + vectorStride - 1) & (-vectorStride);
-				constraintArray[m_joints + i].m_pairCount = dgInt16 (rows);
-			}
-		} else {
-			dgAssert (heaviestBody);
-			queue.Insert (heaviestBody);
-			heaviestBody->m_dynamicsLru = m_markLru;
-		}
-
-		BuildIsland (queue, timestep, jointCount, hasExactSolverJoints);
-	}
-}
-
-
-
-void dgWorldDynamicUpdate::BuildIsland (dgQueue<dgDynamicBody*>& queue, dgFloat32 timestep, dgInt32 jointCount, dgInt32 hasExactSolverJoints)
-{
-	dgInt32 bodyCount = 1;
-	dgUnsigned32 lruMark = m_markLru;
-
-	dgWorld* const world = (dgWorld*) this;
-	world->m_bodiesMemory.ExpandCapacityIfNeessesary(m_bodies, sizeof (dgBodyInfo));
-
-	dgBodyInfo* const bodyArray0 = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-
-	const dgInt32 vectorStride = dgInt32 (sizeof (dgVector) / sizeof (dgFloat32));
-
-	bodyArray0[m_bodies].m_body = world->m_sentinelBody;
-	dgAssert (world->m_sentinelBody->m_index == 0); 
-	dgAssert (dgInt32 (world->m_sentinelBody->m_dynamicsLru) == m_markLru); 
-
-	while (!queue.IsEmpty()) {
-
-		dgInt32 count = queue.m_firstIndex - queue.m_lastIndex;
-		if (count < 0) {
-			dgAssert (0);
-			count += queue.m_mod;
-		}
-
-		dgInt32 index = queue.m_lastIndex;
-		queue.Reset ();
-
-		for (dgInt32 j = 0; j < count; j ++) {
-
-			dgDynamicBody* const body = queue.m_pool[index];
-			dgAssert (body);
-			dgAssert (body->m_dynamicsLru == lruMark);
-			dgAssert (body->m_masterNode);
-
-			if (body->m_invMass.m_w > dgFloat32 (0.0f)) { 
-				dgInt32 bodyIndex = m_bodies + bodyCount;
-				world->m_bodiesMemory.ExpandCapacityIfNeessesary(bodyIndex, sizeof (dgBodyInfo));
-				dgBodyInfo* const bodyArray1 = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-
-				body->m_index = bodyCount; 
-				body->m_active = false;
-				body->m_resting = true;
-				bodyArray1[bodyIndex].m_body = body;
-				bodyCount ++;
-			}
-
-
-			for (dgBodyMasterListRow::dgListNode* jointNode = body->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
-				dgBodyMasterListCell* const cell = &jointNode->GetInfo();
-				dgConstraint* const constraint = cell->m_joint;
-				dgAssert (constraint);
-				dgBody* const linkBody = cell->m_bodyNode;
-				dgAssert ((constraint->m_body0 == body) || (constraint->m_body1 == body));
-				dgAssert ((constraint->m_body0 == linkBody) || (constraint->m_body1 == linkBody));
-				const dgContact* const contact = (constraint->GetId() == dgConstraint::m_contactConstraint) ? (dgContact*)constraint : NULL;
-				dgInt32 ccdMode = contact ? (body->m_continueCollisionMode | linkBody->m_continueCollisionMode) : 0;
-				if (linkBody->IsCollidable() && (!contact || contact->m_maxDOF || ccdMode)) { 
-					dgDynamicBody* const body = (dgDynamicBody*)linkBody;
-
-					if (constraint->m_dynamicsLru != lruMark) {
-						constraint->m_dynamicsLru = lruMark;
-
-						dgInt32 jointIndex = m_joints + jointCount; 
-						world->m_jointsMemory.ExpandCapacityIfNeessesary(jointIndex, sizeof (dgJointInfo));
-
-						hasExactSolverJoints |= constraint->m_useExactSolver;
-						
-						constraint->m_index = dgUnsigned32 (jointCount);
-						dgJointInfo* const constraintArray = (dgJointInfo*) &world->m_jointsMemory[0];
-						constraintArray[jointIndex].m_joint = constraint;
-
-						//dgInt32 rows = dgInt32 ((constraint->m_maxDOF & (dgInt32 (sizeof (dgVector) / sizeof (dgFloat32)) - 1)) ? ((constraint->m_maxDOF & (-dgInt32 (sizeof (dgVector) / sizeof (dgFloat32)))) + dgInt32 (sizeof (dgVector) / sizeof (dgFloat32))) : constraint->m_maxDOF);
-						dgInt32 rows = (constraint->m_maxDOF + vectorStride - 1) & (-vectorStride);
-						//rowsCount += (rows + (ccdMode ? DG_CCD_EXTRA_CONTACT_COUNT : 0));
- 						constraintArray[jointIndex].m_pairCount = dgInt16 (rows);
-
-						jointCount ++;
-
-						dgAssert (constraint->m_body0);
-						dgAssert (constraint->m_body1);
-					}
-
-					if (body->m_dynamicsLru != lruMark) {
-						if (body->m_invMass.m_w > dgFloat32 (0.0f)) { 
-							queue.Insert (body);
-							body->m_dynamicsLru = lruMark;
-						}
-					}
-				}
-			}
-
-			index ++;
-			if (index >= queue.m_mod) {
-				dgAssert (0);
-				index = 0;
-			}
-		}
-	}
-
-	if (bodyCount > 1) {
-		world->m_islandMemory.ExpandCapacityIfNeessesary (m_islands, sizeof (dgIsland));
-		dgIsland* const islandArray = (dgIsland*) &world->m_islandMemory[0];
-
-		islandArray[m_islands].m_bodyStart = m_bodies;
-		islandArray[m_islands].m_jointStart = m_joints;
-		islandArray[m_islands].m_bodyCount = bodyCount;
-		islandArray[m_islands].m_jointCount = jointCount;
-		
-		islandArray[m_islands].m_rowsStart = 0;
-
-		islandArray[m_islands].m_hasExactSolverJoints = hasExactSolverJoints;
-		islandArray[m_islands].m_isContinueCollision = false;
-
-		dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-		dgJointInfo* const constraintArray = &constraintArrayPtr[m_joints];
-
-		dgInt32 rowsCount = 0;
-		dgInt32 isContinueCollisionIsland = 0;
-		for (dgInt32 i = 0; i < jointCount; i ++) {
-			dgConstraint* const joint = constraintArray[i].m_joint;
-			rowsCount += constraintArray[i].m_pairCount;
-			if (joint->GetId() == dgConstraint::m_contactConstraint) {
-				const dgBody* const body0 = joint->m_body0;
-				const dgBody* const body1 = joint->m_body1;
-				if (body0->m_continueCollisionMode | body1->m_continueCollisionMode) {
-					dgInt32 ccdJoint = false;
-					const dgVector& veloc0 = body0->m_veloc;
-					const dgVector& veloc1 = body1->m_veloc;
-
-					const dgVector& omega0 = body0->m_omega;
-					const dgVector& omega1 = body1->m_omega;
-
-					const dgVector& com0 = body0->m_globalCentreOfMass;
-					const dgVector& com1 = body1->m_globalCentreOfMass;
-
-					const dgCollisionInstance* const collision0 = body0->m_collision;
-					const dgCollisionInstance* const collision1 = body1->m_collision;
-					dgFloat32 dist = dgMax (body0->m_collision->GetBoxMinRadius(), body1->m_collision->GetBoxMinRadius()) * dgFloat32 (0.25f);
-
-					dgVector relVeloc (veloc1 - veloc0);
-					dgVector relOmega (omega1 - omega0);
-					dgVector relVelocMag2 (relVeloc.DotProduct4 (relVeloc));
-					dgVector relOmegaMag2 (relOmega.DotProduct4 (relOmega));
-
-					if ((relOmegaMag2.m_w > dgFloat32 (1.0f)) || ((relVelocMag2.m_w * timestep * timestep) > (dist * dist))) {
-						dgTriplex normals[16];
-						dgTriplex points[16];
-						dgInt64 attrib0[16];
-						dgInt64 attrib1[16];
-						dgFloat32 penetrations[16];
-						dgFloat32 timeToImpact = timestep;
-						const dgInt32 ccdContactCount = world->CollideContinue (collision0, body0->m_matrix, veloc0, omega0, collision1, body1->m_matrix, veloc1, omega1, 
-																				timeToImpact, points, normals, penetrations, attrib0, attrib1, 6, 0);
-
-						for (dgInt32 j = 0; j < ccdContactCount; j ++) {
-							dgVector point (&points[j].m_x);
-							dgVector normal (&normals[j].m_x);
-							dgVector vel0 (veloc0 + omega0 * (point - com0));
-							dgVector vel1 (veloc1 + omega1 * (point - com1));
-							dgVector vRel (vel1 - vel0);
-							dgFloat32 contactDistTravel = vRel.DotProduct4(normal).m_w * timestep;
-							ccdJoint |= (contactDistTravel > dist);
-						}
-					}
-					//ccdJoint = body0->m_continueCollisionMode | body1->m_continueCollisionMode;
-					isContinueCollisionIsland |= ccdJoint;
-					rowsCount += DG_CCD_EXTRA_CONTACT_COUNT;
-				}
-			}
-		}
-		if (isContinueCollisionIsland) {
-			rowsCount = dgMax(rowsCount, 64);
-		}
-		islandArray[m_islands].m_rowsCount = rowsCount;
-		islandArray[m_islands].m_isContinueCollision = isContinueCollisionIsland;
-
-
-		if (hasExactSolverJoints) {
-			dgInt32 contactJointCount = 0;
-			for (dgInt32 i = 0; i < jointCount; i ++) {
-				dgConstraint* const joint = constraintArray[i].m_joint;
-				contactJointCount += (joint->GetId() == dgConstraint::m_contactConstraint); 
-			}
-
-			for (dgInt32 i = 0; i < jointCount; i ++) {
-				dgConstraint* const joint = constraintArray[i].m_joint;
-				if (joint->m_useExactSolver) {
-					dgAssert (joint->IsBilateral());
-					dgBilateralConstraint* const bilateralJoint = (dgBilateralConstraint*) joint;
-					if (bilateralJoint->m_useExactSolver && (bilateralJoint->m_useExactSolverContactLimit < contactJointCount)) {
-						islandArray[m_islands].m_hasExactSolverJoints = 0;
-						break;
-					}
-				}
-			}
-		}
-
-
-
-		m_islands ++;
-		m_bodies += bodyCount;
-		m_joints += jointCount;
-	}
-}
-
-
-void dgWorldDynamicUpdate::FindActiveJointAndBodies (dgIsland* const island)
-{
-	dgWorld* const world = (dgWorld*) this;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-
-
-	dgInt32 jointCount = island->m_jointCount;
-//	if (jointCount > 100000000) {
-	if (jointCount > DG_SMALL_ISLAND_COUNT) {
-		for (dgInt32 i = 0; i < jointCount; i ++) {
-			dgJointInfo* const jointInfo = &constraintArray[i];
-			dgConstraint* const joint = jointInfo->m_joint;
-
-			dgInt32 m0 = (joint->m_body0->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body0->m_index: 0;
-			dgInt32 m1 = (joint->m_body1->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body1->m_index: 0;
-
-			jointInfo->m_m0 = m0;
-			jointInfo->m_m1 = m1;
-
-			dgBody* const body0 = bodyArray[m0].m_body;
-			dgBody* const body1 = bodyArray[m1].m_body;
-
-			bool resting = body0->m_equilibrium & body1->m_equilibrium & ((joint->GetId() == dgConstraint::m_contactConstraint) ? true : false);
-			body0->m_resting &= (resting | !m0);
-			body1->m_resting &= (resting | !m1);
-			body0->m_active |= !(!m0);
-			body1->m_active |= !(!m1);
-			joint->m_solverActive = true;
-		}
-	} else if (jointCount){
-		for (dgInt32 i = 0; i < jointCount; i ++) {
-			dgJointInfo* const jointInfo = &constraintArray[i];
-			dgConstraint* const joint = jointInfo->m_joint;
-			dgInt32 m0 = (joint->m_body0->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body0->m_index: 0;
-			dgInt32 m1 = (joint->m_body1->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body1->m_index: 0;
-			jointInfo->m_m0 = m0;
-			jointInfo->m_m1 = m1;
-			joint->m_solverActive = true;
-		}
-
-		dgInt32 bodyCount = island->m_bodyCount;
-		for (dgInt32 i = 1; i < bodyCount; i ++) {
-			dgBody* const body = bodyArray[i].m_body;
-			body->m_active = true;
-			//body->m_resting = body->m_equilibrium;
-			body->m_resting = false;
-		}
-
-	} else {
-		dgAssert (island->m_bodyCount == 2);
-		dgBody* const body = bodyArray[1].m_body;
-		body->m_active = true;
-		//body->m_resting = body->m_equilibrium;
-		body->m_resting = false;
-	}
-}
-
-
-void dgWorldDynamicUpdate::FindActiveJointAndBodies (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgWorldDynamicUpdateSyncDescriptor* const descriptor = (dgWorldDynamicUpdateSyncDescriptor*) context;
-
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgInt32 count = descriptor->m_islandCount;
-	dgIsland* const islands = &((dgIsland*)&world->m_islandMemory[0])[descriptor->m_firstIsland];
-
-	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1)) {
-		dgIsland* const island = &islands[i]; 
-		world->FindActiveJointAndBodies (island); 
-	}
-}
-
-
-
-void dgWorldDynamicUpdate::CalculateIslandReactionForcesKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgWorldDynamicUpdateSyncDescriptor* const descriptor = (dgWorldDynamicUpdateSyncDescriptor*) context;
-
-	dgFloat32 timestep = descriptor->m_timestep;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgInt32 count = descriptor->m_islandCount;
-	dgIsland* const islands = &((dgIsland*)&world->m_islandMemory[0])[descriptor->m_firstIsland];
-
-	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1)) {
-		dgIsland* const island = &islands[i]; 
-		world->CalculateIslandReactionForces (island, timestep, threadID);
-	}
-}
-
-dgInt32 dgWorldDynamicUpdate::GetJacobianDerivatives (dgContraintDescritor& constraintParamOut, dgJointInfo* const jointInfo, dgConstraint* const constraint, dgJacobianMatrixElement* const matrixRow, dgInt32 rowCount) const
-{
-	if (constraint->m_solverActive) {
-		dgInt32 dof = dgInt32(constraint->m_maxDOF);
-		dgAssert(dof <= DG_CONSTRAINT_MAX_ROWS);
-		for (dgInt32 i = 0; i < dof; i++) {
-			constraintParamOut.m_forceBounds[i].m_low = DG_MIN_BOUND;
-			constraintParamOut.m_forceBounds[i].m_upper = DG_MAX_BOUND;
-			constraintParamOut.m_forceBounds[i].m_jointForce = NULL;
-			constraintParamOut.m_forceBounds[i].m_normalIndex = DG_BILATERAL_CONSTRAINT;
-		}
-
-		dgAssert(constraint->m_body0);
-		dgAssert(constraint->m_body1);
-
-		constraint->m_body0->m_inCallback = true;
-		constraint->m_body1->m_inCallback = true;
-
-		dof = dgInt32(constraint->JacobianDerivative(constraintParamOut));
-
-		constraint->m_body0->m_inCallback = false;
-		constraint->m_body1->m_inCallback = false;
-
-		//dgAssert(jointInfo->m_m0 < island->m_bodyCount);
-		//dgAssert(jointInfo->m_m1 < island->m_bodyCount);
-		//dgAssert(constraint->m_index == dgUnsigned32(j));
-
-		jointInfo->m_pairStart = rowCount;
-		jointInfo->m_pairCount = dgInt16 (dof);
-		jointInfo->m_pairActiveCount = dgInt16 (dof);
-
-		for (dgInt32 i = 0; i < dof; i++) {
-			dgJacobianMatrixElement* const row = &matrixRow[rowCount];
-			dgAssert(constraintParamOut.m_forceBounds[i].m_jointForce);
-			row->m_Jt = constraintParamOut.m_jacobian[i];
-
-			dgAssert(constraintParamOut.m_jointStiffness[i] >= dgFloat32(0.1f));
-			dgAssert(constraintParamOut.m_jointStiffness[i] <= dgFloat32(100.0f));
-
-			row->m_diagDamp = constraintParamOut.m_jointStiffness[i];
-			row->m_coordenateAccel = constraintParamOut.m_jointAccel[i];
-			row->m_accelIsMotor = constraintParamOut.m_isMotor[i];
-			row->m_restitution = constraintParamOut.m_restitution[i];
-			row->m_penetration = constraintParamOut.m_penetration[i];
-			row->m_penetrationStiffness = constraintParamOut.m_penetrationStiffness[i];
-			row->m_lowerBoundFrictionCoefficent = constraintParamOut.m_forceBounds[i].m_low;
-			row->m_upperBoundFrictionCoefficent = constraintParamOut.m_forceBounds[i].m_upper;
-			row->m_jointFeebackForce = constraintParamOut.m_forceBounds[i].m_jointForce;
-
-			row->m_normalForceIndex = constraintParamOut.m_forceBounds[i].m_normalIndex;
-			rowCount++;
-		}
-		rowCount = (rowCount & (dgInt32(sizeof (dgVector) / sizeof (dgFloat32)) - 1)) ? ((rowCount & (-dgInt32(sizeof (dgVector) / sizeof (dgFloat32)))) + dgInt32(sizeof (dgVector) / sizeof (dgFloat32))) : rowCount;
-		dgAssert((rowCount & (dgInt32(sizeof (dgVector) / sizeof (dgFloat32)) - 1)) == 0);
-	}
-	return rowCount;
-}
-
-void dgWorldDynamicUpdate::GetJacobianDerivatives (const dgIsland* const island, dgInt32 threadIndex, dgInt32 rowCount, dgFloat32 timestep) const
-{
-	dgContraintDescritor constraintParams;
-	dgWorld* const world = (dgWorld*) this;
-
-	constraintParams.m_world = world; 
-	constraintParams.m_threadIndex = threadIndex;
-	constraintParams.m_timestep = timestep;
-	constraintParams.m_invTimestep = (timestep > dgFloat32 (1.0e-5f)) ? dgFloat32 (1.0f / timestep) : dgFloat32 (0.0f);
-
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-
-	dgJacobianMatrixElement* const matrixRow = &m_solverMemory.m_memory[island->m_rowsStart];
-	dgInt32 jointCount = island->m_jointCount;
-	for (dgInt32 j = 0; j < jointCount; j ++) {
-		dgJointInfo* const jointInfo = &constraintArray[j];
-		dgConstraint* const constraint = jointInfo->m_joint;
-
-		dgAssert(jointInfo->m_m0 < island->m_bodyCount);
-		dgAssert(jointInfo->m_m1 < island->m_bodyCount);
-		dgAssert (constraint->m_index == dgUnsigned32(j));
-
-		rowCount = GetJacobianDerivatives (constraintParams, jointInfo, constraint, matrixRow, rowCount);
-		dgAssert (rowCount <= island->m_rowsCount);
-	}
-}
-
-void dgWorldDynamicUpdate::IntegrateArray (const dgIsland* const island, dgFloat32 accelTolerance, dgFloat32 timestep, dgInt32 threadIndex) const
-{
-	bool isAutoSleep = true;
-	bool stackSleeping = true;
-	dgInt32 sleepCounter = 10000;
-
-	dgWorld* const world = (dgWorld*) this;
-
-	dgFloat32 forceDamp = DG_FREEZZING_VELOCITY_DRAG;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart + 1]; 
-	dgInt32 count = island->m_bodyCount - 1;
-	if (count <= 2) {
-		bool autosleep = bodyArray[0].m_body->m_autoSleep;
-		if (count == 2) {
-			autosleep &= bodyArray[1].m_body->m_autoSleep;
-		}
-		if (!autosleep) {
-			forceDamp = dgFloat32 (0.9999f);
-		}
-	}
-
-	dgFloat32 maxAccel = dgFloat32 (0.0f);
-	dgFloat32 maxAlpha = dgFloat32 (0.0f);
-	dgFloat32 maxSpeed = dgFloat32 (0.0f);
-	dgFloat32 maxOmega = dgFloat32 (0.0f);
-
-	dgFloat32 speedFreeze = world->m_freezeSpeed2;
-	dgFloat32 accelFreeze = world->m_freezeAccel2 * ((island->m_jointCount <= DG_SMALL_ISLAND_COUNT) ? dgFloat32 (0.05f) : dgFloat32 (1.0f));
-	dgVector forceDampVect (forceDamp, forceDamp, forceDamp, dgFloat32 (0.0f));
-	for (dgInt32 i = 0; i < count; i ++) {
-		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-
-		dgVector isMovingMask = (body->m_veloc | body->m_omega | body->m_accel | body->m_alpha) & dgVector::m_signMask;
-		if (((isMovingMask.TestZero().GetSignMask() & 7) != 7) && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
-			dgAssert (body->m_invMass.m_w);
-			body->IntegrateVelocity(timestep);
-
-			dgFloat32 accel2 = body->m_accel % body->m_accel;
-			dgFloat32 alpha2 = body->m_alpha % body->m_alpha;
-			dgFloat32 speed2 = body->m_veloc % body->m_veloc;
-			dgFloat32 omega2 = body->m_omega % body->m_omega;
-
-			maxAccel = dgMax (maxAccel, accel2);
-			maxAlpha = dgMax (maxAlpha, alpha2);
-			maxSpeed = dgMax (maxSpeed, speed2);
-			maxOmega = dgMax (maxOmega, omega2);
-
-			bool equilibrium = (accel2 < accelFreeze) && (alpha2 < accelFreeze) && (speed2 < speedFreeze) && (omega2 < speedFreeze);
-
-			if (equilibrium) {
-				dgVector veloc (body->m_veloc.CompProduct4(forceDampVect));
-				dgVector omega = body->m_omega.CompProduct4 (forceDampVect);
-				body->m_veloc = (dgVector (veloc.DotProduct4(veloc)) > m_velocTol) & veloc;
-				body->m_omega = (dgVector (omega.DotProduct4(omega)) > m_velocTol) & omega;
-			}
-
-			body->m_equilibrium = dgUnsigned32 (equilibrium);
-			stackSleeping &= equilibrium;
-			isAutoSleep &= body->m_autoSleep;
-
-			sleepCounter = dgMin (sleepCounter, body->m_sleepingCounter);
-
-			body->UpdateMatrix (timestep, threadIndex);
-		}
-	}
-
-	if (isAutoSleep && (island->m_jointCount > DG_SMALL_ISLAND_COUNT)) {
-		if (stackSleeping) {
-			for (dgInt32 i = 0; i < count; i ++) {
-				dgBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-				if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
-					body->m_netForce = dgVector::m_zero;
-					body->m_netTorque = dgVector::m_zero;
-					body->m_veloc = dgVector::m_zero;
-					body->m_omega = dgVector::m_zero;
-				}
-			}
-		} else {
-			if ((maxAccel > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxAccel) ||
-				(maxAlpha > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxAlpha) ||
-				(maxSpeed > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxVeloc) ||
-				(maxOmega > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxOmega)) {
-					for (dgInt32 i = 0; i < count; i ++) {
-						dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
-							body->m_sleepingCounter = 0;
-						}
-					}
-			} else {
-				dgInt32 index = 0;
-				for (dgInt32 i = 0; i < DG_SLEEP_ENTRIES; i ++) {
-					if ((maxAccel <= world->m_sleepTable[i].m_maxAccel) &&
-						(maxAlpha <= world->m_sleepTable[i].m_maxAlpha) &&
-						(maxSpeed <= world->m_sleepTable[i].m_maxVeloc) &&
-						(maxOmega <= world->m_sleepTable[i].m_maxOmega)) {
-							index = i;
-							break;
-					}
-				}
-
-				dgInt32 timeScaleSleepCount = dgInt32 (dgFloat32 (60.0f) * sleepCounter * timestep);
-				if (timeScaleSleepCount > world->m_sleepTable[index].m_steps) {
-					for (dgInt32 i = 0; i < count; i ++) {
-						dgBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
-							body->m_netForce = dgVector::m_zero;
-							body->m_netTorque = dgVector::m_zero;
-							body->m_veloc = dgVector::m_zero;
-							body->m_omega = dgVector::m_zero;
-							body->m_equilibrium = true;
-						}
-					}
-				} else {
-					sleepCounter ++;
-					for (dgInt32 i = 0; i < count; i ++) {
-						dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
-							body->m_sleepingCounter = sleepCounter;
-						}
-					}
-				}
-			}
-		}
-	}
-}
-
-/*
-dgInt32 dgWorldDynamicUpdate::SortJointInfoByBatchIndex (const dgParallelJointMap* const indirectIndexA, const dgParallelJointMap* const indirectIndexB, void* const context)
-{
-	if (indirectIndexA->m_bashIndex < indirectIndexB->m_bashIndex) {
-		return -1;
-	}
-	if (indirectIndexA->m_bashIndex > indirectIndexB->m_bashIndex) {
-		return 1;
-	}
-	return 0;
-}
-*/
-
-
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgPhysicsStdafx.h"
+
+#include "dgBody.h"
+#include "dgWorld.h"
+#include "dgBroadPhase.h"
+#include "dgConstraint.h"
+#include "dgDynamicBody.h"
+#include "dgCollisionInstance.h"
+#include "dgBilateralConstraint.h"
+#include "dgWorldDynamicUpdate.h"
+#include "dgCollisionDeformableMesh.h"
+
+
+#ifdef _NEWTON_AMP
+#include "dgAmpInstance.h"
+#endif
+
+
+
+#define DG_CCD_EXTRA_CONTACT_COUNT			(8 * 3)
+#define DG_PARALLEL_JOINT_COUNT_CUT_OFF		(128)
+
+
+dgVector dgWorldDynamicUpdate::m_velocTol (dgFloat32 (1.0e-18f));
+
+class dgWorldDynamicUpdateSyncDescriptor
+{
+	public:
+	dgWorldDynamicUpdateSyncDescriptor()
+	{
+		memset (this, 0, sizeof (dgWorldDynamicUpdateSyncDescriptor));
+	}
+
+	dgFloat32 m_timestep;
+	dgInt32 m_atomicCounter;
+	
+	dgInt32 m_islandCount;
+	dgInt32 m_firstIsland;
+	dgThread::dgCriticalSection* m_criticalSection;
+};
+
+class dgIslandGraphSyncData
+{
+	public:
+	dgIslandGraphSyncData()
+	{
+		memset (this, 0, sizeof (dgIslandGraphSyncData));
+	}
+
+	dgFloat32 m_timestep;
+	dgInt32 m_atomicCounter;
+	dgInt32 m_count;
+	dgInt32 m_rebuild;
+	dgInt32 m_edgeRemoved;
+	dgIslandGraphNode* m_graph;
+	dgIslandGraphSet* m_sets;
+	dgDynamicBody** m_members;
+	dgInt32* m_islandMembers;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+dgBody* dgWorld::GetIslandBody (const void* const islandPtr, dgInt32 index) const
+{
+	const dgIslandCallbackStruct* const island = (dgIslandCallbackStruct*)islandPtr;
+
+	char* const ptr = &((char*)island->m_bodyArray)[island->m_strideInByte * index];
+	dgBody** const bodyPtr = (dgBody**)ptr;
+	return (index < island->m_count) ? ((index >= 0) ? *bodyPtr : NULL) : NULL;
+}
+
+
+dgWorldDynamicUpdate::dgWorldDynamicUpdate()
+	:m_bodies(0)
+	,m_joints(0)
+	,m_islands(0)
+	,m_markLru(0)
+	,m_islandGraphCount(0)
+//	,m_rowCountAtomicIndex(0)
+	,m_softBodyCriticalSectionLock()
+{
+}
+
+
+void dgWorldDynamicUpdate::UpdateDynamics(dgFloat32 timestep)
+{
+	dgWorld* const world = (dgWorld*) this;
+	dgUnsigned32 updateTime = world->m_getPerformanceCount();
+
+	world->m_dynamicsLru = world->m_dynamicsLru + DG_BODY_LRU_STEP;
+
+	m_bodies = 0;
+	m_joints = 0;
+	m_islands = 0;
+	m_markLru = world->m_dynamicsLru;
+
+	dgAssert (world->dgBodyMasterList::GetFirst()->GetInfo().GetBody() == world->m_sentinelBody);
+
+	dgBody* const sentinelBody = world->m_sentinelBody;
+	sentinelBody->m_index = 0; 
+	sentinelBody->m_dynamicsLru = m_markLru;
+
+	BuildIslands (timestep);
+	AllocateSolverIterations ();
+
+	dgInt32 maxRowCount = 0;
+	dgIsland* const islandsArray = (dgIsland*) &world->m_islandMemory[0];
+	for (dgInt32 i = 0; i < m_islands; i ++) {
+		islandsArray[i].m_rowsStart = maxRowCount;
+		maxRowCount += islandsArray[i].m_rowsCount;
+	}
+	m_solverMemory.Init (world, maxRowCount, m_bodies);
+
+//	m_rowCountAtomicIndex = 0;
+
+	dgInt32 threadCount = world->GetThreadCount();	
+
+	dgWorldDynamicUpdateSyncDescriptor descriptor;
+	descriptor.m_timestep = timestep;
+	descriptor.m_firstIsland = 0;
+	descriptor.m_islandCount = m_islands;
+	descriptor.m_atomicCounter = 0;
+
+	sentinelBody->m_resting = true;
+	sentinelBody->m_active = false;
+	sentinelBody->m_equilibrium = true;
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		world->QueueJob (FindActiveJointAndBodies, &descriptor, world);
+	}
+	world->SynchronizationBarrier();
+
+	dgSort (islandsArray, m_islands, CompareIslands); 
+
+	dgUnsigned32 dynamicsTime = world->m_getPerformanceCount();
+	world->m_perfomanceCounters[m_dynamicsBuildSpanningTreeTicks] = dynamicsTime - updateTime;
+
+	if (!(world->m_amp && (world->m_hardwaredIndex > 0))) {
+		dgInt32 useParallel = world->m_useParallelSolver && (threadCount > 1);
+		dgInt32 index = 0;
+		if (useParallel) {
+			// only large islands solved with the iterative solver go wide, exact solver and continue collision islands run serial
+			useParallel = useParallel && m_joints && world->m_solverMode;
+			while (useParallel && (index < m_islands)) {
+				const dgIsland& island = islandsArray[index];
+				useParallel = useParallel && ((threadCount * island.m_jointCount) >= m_joints);
+				useParallel = useParallel && (island.m_jointCount > DG_PARALLEL_JOINT_COUNT_CUT_OFF);
+				useParallel = useParallel && !island.m_hasExactSolverJoints && !island.m_isContinueCollision;
+				if (useParallel) {
+					CalculateReactionForcesParallel(&island, timestep);
+					index ++;
+				}
+			}
+		}
+
+		if (index < m_islands) {
+			descriptor.m_firstIsland = index;
+			descriptor.m_islandCount = m_islands - index;
+			descriptor.m_atomicCounter = 0;
+			for (dgInt32 i = 0; i < threadCount; i ++) {
+				world->QueueJob (CalculateIslandReactionForcesKernel, &descriptor, world);
+			}
+			world->SynchronizationBarrier();
+		}
+	} else {
+		#ifdef _NEWTON_AMP 
+			
+			world->m_amp->ConstraintSolver (m_islands, islandsArray, timestep);
+		#endif
+	}
+
+	dgUnsigned32 ticks = world->m_getPerformanceCount();
+	world->m_perfomanceCounters[m_dynamicsSolveSpanningTreeTicks] = ticks - dynamicsTime;
+	world->m_perfomanceCounters[m_dynamicsTicks] = ticks - updateTime;
+
+	// integrate soft body dynamics phase 2
+	dgDeformableBodiesUpdate* const softBodyList = world;
+    softBodyList->SolveConstraintsAndIntegrate (timestep);
+	world->m_perfomanceCounters[m_softBodyTicks] += (world->m_getPerformanceCount() - ticks);
+}
+
+
+dgInt32 dgWorldDynamicUpdate::GetIslandCount () const
+{
+	return m_islands;
+}
+
+// the stats of the islands solved in the last update, the body count does not include the sentinel body
+void dgWorldDynamicUpdate::GetIslandSolverStats (dgInt32 islandIndex, dgInt32& bodyCount, dgInt32& jointCount, dgInt32& passes, dgFloat32& residual) const
+{
+	dgAssert (islandIndex >= 0);
+	dgAssert (islandIndex < m_islands);
+	const dgWorld* const world = (dgWorld*) this;
+	const dgIsland* const island = &((dgIsland*) &world->m_islandMemory[0])[islandIndex];
+	bodyCount = island->m_bodyCount - 1;
+	jointCount = island->m_jointCount;
+	passes = island->m_solverPasses;
+	residual = island->m_solverResidual;
+}
+
+
+// without a budget every island runs up to DG_BASE_ITERATION_COUNT passes per sub step.
+// With a budget the joint passes of the step are handed out to the iterative islands in proportion to their joint count, 
+// weighted by the residual their bodies ended the last step with, so islands that did not converge get a larger share.
+// Each island gets at least one pass per sub step, and passes an island does not need roll over to its next sub steps.
+void dgWorldDynamicUpdate::AllocateSolverIterations ()
+{
+	dgWorld* const world = (dgWorld*) this;
+	dgIsland* const islandsArray = (dgIsland*) &world->m_islandMemory[0];
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+
+	const dgInt32 budget = world->m_solverIterationBudget;
+	const dgInt32 subSteps = dgInt32 (world->m_solverMode + LINEAR_SOLVER_SUB_STEPS);
+	const dgFloat32 maxErrorScale = dgFloat32 (DG_BUDGET_MAX_ITERATION_COUNT / DG_BASE_ITERATION_COUNT);
+
+	dgFloat32 totalWeight = dgFloat32 (0.0f);
+	for (dgInt32 i = 0; i < m_islands; i ++) {
+		dgIsland* const island = &islandsArray[i];
+		island->m_solverIterations = subSteps * DG_BASE_ITERATION_COUNT;
+		island->m_solverPasses = 0;
+		island->m_solverResidual = dgFloat32 (0.0f);
+		if (budget && world->m_solverMode && island->m_jointCount && !island->m_hasExactSolverJoints) {
+			const dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+			for (dgInt32 j = 1; j < island->m_bodyCount; j ++) {
+				const dgDynamicBody* const body = (dgDynamicBody*) bodyArray[j].m_body;
+				island->m_solverResidual = dgMax (island->m_solverResidual, body->m_solverResidual);
+			}
+			totalWeight += dgFloat32 (island->m_jointCount) * dgClamp (island->m_solverResidual / DG_SOLVER_MAX_ERROR, dgFloat32 (1.0f), maxErrorScale);
+		}
+	}
+
+	if (totalWeight > dgFloat32 (0.0f)) {
+		const dgFloat32 passesPerWeight = dgFloat32 (budget) / totalWeight;
+		for (dgInt32 i = 0; i < m_islands; i ++) {
+			dgIsland* const island = &islandsArray[i];
+			if (world->m_solverMode && island->m_jointCount && !island->m_hasExactSolverJoints) {
+				const dgFloat32 errorScale = dgClamp (island->m_solverResidual / DG_SOLVER_MAX_ERROR, dgFloat32 (1.0f), maxErrorScale);
+				const dgInt32 passes = dgInt32 (passesPerWeight * errorScale);
+				island->m_solverIterations = dgClamp (passes, subSteps, subSteps * DG_BUDGET_MAX_ITERATION_COUNT);
+			}
+		}
+	}
+}
+
+
+dgInt32 dgWorldDynamicUpdate::GetSolverPassCount (const dgIsland* const island, dgInt32 passesLeft, dgInt32 stepsLeft) const
+{
+	const dgWorld* const world = (dgWorld*) this;
+	if (!world->m_solverIterationBudget) {
+		return DG_BASE_ITERATION_COUNT;
+	}
+	dgAssert (passesLeft >= stepsLeft);
+	return dgMin (passesLeft / stepsLeft, DG_BUDGET_MAX_ITERATION_COUNT);
+}
+
+
+// records the passes the island used and its remaining acceleration error, the bodies keep the error for the next step budget 
+void dgWorldDynamicUpdate::SaveSolverStats (const dgIsland* const island, dgInt32 passes, dgFloat32 residual) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	dgIsland* const islandStats = (dgIsland*) island;
+	islandStats->m_solverPasses = passes;
+	islandStats->m_solverResidual = residual;
+
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+	for (dgInt32 i = 1; i < island->m_bodyCount; i ++) {
+		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+		body->m_solverResidual = residual;
+	}
+}
+
+
+void dgJacobianMemory::Init (dgWorld* const world, dgInt32 rowsCount, dgInt32 bodyCount)
+{
+	m_memory = (dgJacobianMatrixElement*) world->m_frameArena.Alloc (rowsCount * dgInt32 (sizeof (dgJacobianMatrixElement)));
+	m_internalForces = (dgJacobian*) world->m_frameArena.Alloc ((bodyCount + 8) * dgInt32 (sizeof (dgJacobian)));
+	m_bodyState.Init (world, bodyCount + 8);
+
+	dgAssert ((dgUnsigned64(m_memory) & 0x01f) == 0);
+	dgAssert ((dgUnsigned64(m_internalForces) & 0x01f) == 0);
+}
+
+void dgBodyStateArray::Init (dgWorld* const world, dgInt32 bodyCount)
+{
+	dgFrameArena& arena = world->GetFrameArena();
+	m_invInertia = (dgMatrix*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgMatrix)));
+	m_invMass = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_veloc = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_omega = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_veloc0 = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_omega0 = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_externalForce = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_externalTorque = (dgVector*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgVector)));
+	m_resting = (dgInt32*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgInt32)));
+	m_active = (dgInt32*) arena.Alloc (bodyCount * dgInt32 (sizeof (dgInt32)));
+}
+
+dgBodyStateArray dgBodyStateArray::GetIslandState (const dgIsland* const island) const
+{
+	const dgInt32 start = island->m_bodyStart;
+	dgBodyStateArray state;
+	state.m_invInertia = &m_invInertia[start];
+	state.m_invMass = &m_invMass[start];
+	state.m_veloc = &m_veloc[start];
+	state.m_omega = &m_omega[start];
+	state.m_veloc0 = &m_veloc0[start];
+	state.m_omega0 = &m_omega0[start];
+	state.m_externalForce = &m_externalForce[start];
+	state.m_externalTorque = &m_externalTorque[start];
+	state.m_resting = &m_resting[start];
+	state.m_active = &m_active[start];
+	return state;
+}
+
+void dgBodyStateArray::Gather (dgInt32 index, const dgBody* const body)
+{
+	m_invInertia[index] = body->m_invWorldInertiaMatrix;
+	m_invMass[index] = dgVector (body->m_invMass.m_w);
+	m_veloc[index] = body->m_veloc;
+	m_omega[index] = body->m_omega;
+	m_veloc0[index] = body->m_veloc;
+	m_omega0[index] = body->m_omega;
+	if (body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+		m_externalForce[index] = ((dgDynamicBody*)body)->m_accel;
+		m_externalTorque[index] = ((dgDynamicBody*)body)->m_alpha;
+	} else {
+		m_externalForce[index] = dgVector::m_zero;
+		m_externalTorque[index] = dgVector::m_zero;
+	}
+	m_resting[index] = body->m_resting;
+	m_active[index] = body->m_active;
+}
+
+void dgBodyStateArray::SetVelocity (dgInt32 index, dgBody* const body, const dgVector& veloc, const dgVector& omega)
+{
+	m_veloc[index] = veloc;
+	m_omega[index] = omega;
+	body->m_veloc = veloc;
+	body->m_omega = omega;
+}
+
+void dgBodyStateArray::ClearResting (dgInt32 index, dgBody* const body)
+{
+	m_resting[index] = 0;
+	body->m_resting = false;
+}
+
+
+// sort from high to low
+dgInt32 dgWorldDynamicUpdate::CompareIslands (const dgIsland* const islandA, const dgIsland* const islandB, void* notUsed)
+{
+	dgInt32 countA = islandA->m_jointCount + (islandA->m_hasExactSolverJoints << 28);
+	dgInt32 countB = islandB->m_jointCount + (islandB->m_hasExactSolverJoints << 28);
+
+	if (countA < countB) {
+		return 1;
+	}
+	if (countA > countB) {
+		return -1;
+	}
+	return 0;
+}
+
+
+
+DG_INLINE bool dgWorldDynamicUpdate::IsIslandEdge (const dgConstraint* const constraint, const dgBody* const body, const dgBody* const linkBody)
+{
+	// an edge to a static body needs the static body to be collidable, an edge between two dynamic bodies needs either of them to be
+	const dgContact* const contact = (constraint->GetId() == dgConstraint::m_contactConstraint) ? (dgContact*)constraint : NULL;
+	bool isActive = !contact || contact->m_maxDOF || (body->m_continueCollisionMode | linkBody->m_continueCollisionMode);
+	bool isCollidable = linkBody->IsCollidable() || ((linkBody->m_invMass.m_w > dgFloat32 (0.0f)) && body->IsCollidable());
+	return isActive && isCollidable;
+}
+
+DG_INLINE dgInt32 dgWorldDynamicUpdate::FindIslandRoot (dgIslandGraphNode* const graph, dgInt32 index)
+{
+	dgInt32 parent = graph[index].m_parent;
+	while (parent != index) {
+		// path halving, a link is only ever replaced by another link to an ancestor in the same set
+		dgInt32 grandParent = graph[parent].m_parent;
+		dgAtomicCompareAndSwap (&graph[index].m_parent, parent, grandParent);
+		index = grandParent;
+		parent = graph[index].m_parent;
+	}
+	return index;
+}
+
+void dgWorldDynamicUpdate::MergeIslandSets (dgIslandGraphNode* const graph, dgInt32 index0, dgInt32 index1)
+{
+	for (;;) {
+		dgInt32 root0 = FindIslandRoot (graph, index0);
+		dgInt32 root1 = FindIslandRoot (graph, index1);
+		if (root0 == root1) {
+			break;
+		}
+		// the higher root always links to the lower one, so the root of a set does not depend on the order the edges are merged
+		if (root0 < root1) {
+			dgSwap (root0, root1);
+		}
+		if (dgAtomicCompareAndSwap (&graph[root0].m_parent, root0, root1)) {
+			break;
+		}
+		index0 = root0;
+		index1 = root1;
+	}
+}
+
+void dgWorldDynamicUpdate::ResetIslandGraphKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgIslandGraphSyncData* const data = (dgIslandGraphSyncData*) context;
+	dgIslandGraphNode* const graph = data->m_graph;
+	dgIslandGraphSet* const sets = data->m_sets;
+	const dgInt32 count = data->m_count;
+	const dgInt32 rebuild = data->m_rebuild;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH); i < count; i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH)) {
+		const dgInt32 batchEnd = dgMin (i + DG_ISLAND_GRAPH_BATCH, count);
+		for (dgInt32 j = i; j < batchEnd; j ++) {
+			if (rebuild) {
+				graph[j].m_parent = j;
+			}
+			memset (&sets[j], 0, sizeof (dgIslandGraphSet));
+		}
+	}
+}
+
+void dgWorldDynamicUpdate::MergeIslandEdgesKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgIslandGraphSyncData* const data = (dgIslandGraphSyncData*) context;
+	dgIslandGraphNode* const graph = data->m_graph;
+	const dgInt32 count = data->m_count;
+	const dgInt32 rebuild = data->m_rebuild;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH); i < count; i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH)) {
+		const dgInt32 batchEnd = dgMin (i + DG_ISLAND_GRAPH_BATCH, count);
+		for (dgInt32 j = i; j < batchEnd; j ++) {
+			dgDynamicBody* const body = graph[j].m_body;
+			dgAssert (body->m_index == j);
+			for (dgBodyMasterListRow::dgListNode* jointNode = body->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
+				dgBodyMasterListCell* const cell = &jointNode->GetInfo();
+				dgConstraint* const constraint = cell->m_joint;
+				const dgBody* const linkBody = cell->m_bodyNode;
+				// each edge between two dynamic bodies is visited once, from the body with the lower index
+				if ((linkBody->m_invMass.m_w > dgFloat32 (0.0f)) && (linkBody->m_index > j)) {
+					dgInt32 isEdge = IsIslandEdge (constraint, body, linkBody) ? 1 : 0;
+					if (isEdge) {
+						if (rebuild | !constraint->m_islandEdge) {
+							MergeIslandSets (graph, j, linkBody->m_index);
+						}
+					} else if (constraint->m_islandEdge) {
+						data->m_edgeRemoved = 1;
+					}
+					constraint->m_islandEdge = isEdge;
+				}
+			}
+		}
+	}
+}
+
+void dgWorldDynamicUpdate::CollapseIslandGraphKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgIslandGraphSyncData* const data = (dgIslandGraphSyncData*) context;
+	dgIslandGraphNode* const graph = data->m_graph;
+	dgIslandGraphSet* const sets = data->m_sets;
+	const dgInt32 count = data->m_count;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH); i < count; i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, DG_ISLAND_GRAPH_BATCH)) {
+		const dgInt32 batchEnd = dgMin (i + DG_ISLAND_GRAPH_BATCH, count);
+		for (dgInt32 j = i; j < batchEnd; j ++) {
+			dgInt32 root = FindIslandRoot (graph, j);
+			graph[j].m_parent = root;
+
+			dgDynamicBody* const body = graph[j].m_body;
+			dgInt32 jointCount = 0;
+			dgInt32 isRestless = !(body->m_equilibrium & body->m_autoSleep);
+			for (dgBodyMasterListRow::dgListNode* jointNode = body->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
+				dgBodyMasterListCell* const cell = &jointNode->GetInfo();
+				const dgConstraint* const constraint = cell->m_joint;
+				const dgBody* const linkBody = cell->m_bodyNode;
+				if (linkBody->m_invMass.m_w == dgFloat32 (0.0f)) {
+					if (IsIslandEdge (constraint, body, linkBody)) {
+						jointCount ++;
+						isRestless |= !(linkBody->m_equilibrium & linkBody->m_autoSleep);
+					}
+				} else if (linkBody->m_index > j) {
+					jointCount += constraint->m_islandEdge;
+				}
+			}
+
+			dgInt32 isAwake = 0;
+			if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+				isAwake = !(body->m_freeze | body->m_spawnnedFromCallback | body->m_sleeping);
+				body->m_spawnnedFromCallback = false;
+			}
+
+			dgIslandGraphSet* const set = &sets[root];
+			dgAtomicExchangeAndAdd (&set->m_bodyCount, 1);
+			if (jointCount) {
+				dgAtomicExchangeAndAdd (&set->m_jointCount, jointCount);
+			}
+			if (isAwake) {
+				dgAtomicExchangeAndAdd (&set->m_awakeCount, 1);
+			}
+			if (isRestless) {
+				dgAtomicExchangeAndAdd (&set->m_restlessCount, 1);
+			}
+		}
+	}
+}
+
+void dgWorldDynamicUpdate::BuildIslandsKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgIslandGraphSyncData* const data = (dgIslandGraphSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgIsland* const islands = (dgIsland*) &world->m_islandMemory[0];
+	const dgInt32 count = world->m_islands;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&data->m_atomicCounter, 1)) {
+		dgIsland* const island = &islands[i];
+		world->BuildIsland (island, &data->m_members[data->m_islandMembers[i]], island->m_bodyCount - 1, data->m_timestep, threadID);
+	}
+}
+
+
+void dgWorldDynamicUpdate::BuildIslandGraph (dgIslandGraphSyncData* const syncData)
+{
+	dgWorld* const world = (dgWorld*) this;
+	dgBodyMasterList& me = *world;
+
+	// the dynamic bodies are at the end of the master list, their position is their node index in the graph.
+	// the previous graph can be reused only if no body moved and no merged edge was destroyed
+	dgInt32 count = 0;
+	dgInt32 rebuild = me.m_islandEdgeRemoved;
+	for (dgBodyMasterList::dgListNode* node = me.GetLast(); node; node = node->GetPrev()) {
+		dgBody* const body = node->GetInfo().GetBody();	
+		if (body->GetInvMass().m_w == dgFloat32(0.0f)) {
+#ifdef _DEBUG
+			for (; node; node = node->GetPrev()) {
+				dgAssert (node->GetInfo().GetBody()->GetInvMass().m_w == dgFloat32(0.0f));
+			}
+#endif
+			break;
+		}
+
+		world->m_islandGraphMemory.ExpandCapacityIfNeessesary (count, sizeof (dgIslandGraphNode));
+		dgIslandGraphNode* const graph = (dgIslandGraphNode*) &world->m_islandGraphMemory[0];
+		rebuild |= (count >= m_islandGraphCount) || (graph[count].m_body != body);
+		graph[count].m_body = (dgDynamicBody*) body;
+		body->m_index = count;
+		count ++;
+	}
+	rebuild |= (count != m_islandGraphCount);
+	m_islandGraphCount = count;
+	me.m_islandEdgeRemoved = 0;
+
+	syncData->m_count = count;
+	syncData->m_rebuild = rebuild;
+	syncData->m_graph = (dgIslandGraphNode*) &world->m_islandGraphMemory[0];
+	syncData->m_sets = (dgIslandGraphSet*) world->m_frameArena.Alloc (dgMax (count, 1) * dgInt32 (sizeof (dgIslandGraphSet)));
+
+	const dgInt32 threadCount = world->GetThreadCount();
+	for (dgInt32 pass = 0; pass < 2; pass ++) {
+		syncData->m_atomicCounter = 0;
+		for (dgInt32 i = 0; i < threadCount; i ++) {
+			world->QueueJob (ResetIslandGraphKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+
+		syncData->m_atomicCounter = 0;
+		syncData->m_edgeRemoved = 0;
+		for (dgInt32 i = 0; i < threadCount; i ++) {
+			world->QueueJob (MergeIslandEdgesKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+
+		// an incremental merge is only valid if edges were added, a removed edge may have split a set
+		if (syncData->m_rebuild || !syncData->m_edgeRemoved) {
+			break;
+		}
+		syncData->m_rebuild = 1;
+	}
+
+	syncData->m_atomicCounter = 0;
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		world->QueueJob (CollapseIslandGraphKernel, syncData, world);
+	}
+	world->SynchronizationBarrier();
+}
+
+
+void dgWorldDynamicUpdate::BuildIslands (dgFloat32 timestep)
+{
+	dgWorld* const world = (dgWorld*) this;
+
+	dgIslandGraphSyncData syncData;
+	syncData.m_timestep = timestep;
+	BuildIslandGraph (&syncData);
+
+	const dgInt32 count = syncData.m_count;
+	const dgIslandGraphNode* const graph = syncData.m_graph;
+	dgIslandGraphSet* const sets = syncData.m_sets;
+
+	// the sets with at least one awake body are the island candidates, list their members in graph order
+	dgInt32 memberCount = 0;
+	dgInt32 candidateCount = 0;
+	for (dgInt32 i = 0; i < count; i ++) {
+		if ((graph[i].m_parent == i) && sets[i].m_awakeCount) {
+			sets[i].m_memberStart = memberCount;
+			memberCount += sets[i].m_bodyCount;
+			candidateCount ++;
+		}
+	}
+
+	dgDynamicBody** const members = (dgDynamicBody**) world->m_frameArena.Alloc (dgMax (memberCount, 1) * dgInt32 (sizeof (dgDynamicBody*)));
+	dgInt32* const islandMembers = (dgInt32*) world->m_frameArena.Alloc (dgMax (candidateCount, 1) * dgInt32 (sizeof (dgInt32)));
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgIslandGraphSet* const set = &sets[graph[i].m_parent];
+		if (set->m_awakeCount) {
+			dgDynamicBody* const body = graph[i].m_body;
+			body->m_sleeping = false;
+			members[set->m_memberStart + set->m_memberCount] = body;
+			set->m_memberCount ++;
+		}
+	}
+
+	for (dgInt32 i = 0; i < count; i ++) {
+		if ((graph[i].m_parent == i) && sets[i].m_awakeCount) {
+			const dgIslandGraphSet* const set = &sets[i];
+			dgDynamicBody** const setMembers = &members[set->m_memberStart];
+			dgAssert (set->m_memberCount == set->m_bodyCount);
+
+			if (!set->m_restlessCount) {
+				for (dgInt32 j = 0; j < set->m_bodyCount; j ++) {
+					dgDynamicBody* const body = setMembers[j];
+					body->m_dynamicsLru = m_markLru;
+					body->m_sleeping = true;
+				}
+				continue;
+			}
+
+			if (world->m_islandUpdate) {
+				dgBodyInfo* const bodyArray = (dgBodyInfo*) world->m_frameArena.Alloc (set->m_bodyCount * dgInt32 (sizeof (dgBodyInfo)));
+				for (dgInt32 j = 0; j < set->m_bodyCount; j ++) {
+					bodyArray[j].m_body = setMembers[j];
+				}
+				dgIslandCallbackStruct record;
+				record.m_world = world;
+				record.m_count = set->m_bodyCount;
+				record.m_strideInByte = sizeof (dgBodyInfo);
+				record.m_bodyArray = &bodyArray[0].m_body;
+				if (!world->m_islandUpdate (world, &record, set->m_bodyCount)) {
+					for (dgInt32 j = 0; j < set->m_bodyCount; j ++) {
+						setMembers[j]->m_dynamicsLru = m_markLru;
+					}
+					continue;
+				}
+			}
+
+			world->m_islandMemory.ExpandCapacityIfNeessesary (m_islands, sizeof (dgIsland));
+			dgIsland* const island = &((dgIsland*) &world->m_islandMemory[0])[m_islands];
+			island->m_bodyStart = m_bodies;
+			island->m_jointStart = m_joints;
+			island->m_bodyCount = set->m_bodyCount + 1;
+			island->m_jointCount = set->m_jointCount;
+			islandMembers[m_islands] = set->m_memberStart;
+
+			m_islands ++;
+			m_bodies += island->m_bodyCount;
+			m_joints += island->m_jointCount;
+		}
+	}
+
+	world->m_bodiesMemory.ExpandCapacityIfNeessesary (m_bodies, sizeof (dgBodyInfo));
+	world->m_jointsMemory.ExpandCapacityIfNeessesary (m_joints, sizeof (dgJointInfo));
+
+	// each island writes to its own range of the body and joint arrays, so they are built concurrently
+	syncData.m_atomicCounter = 0;
+	syncData.m_members = members;
+	syncData.m_islandMembers = islandMembers;
+	const dgInt32 threadCount = world->GetThreadCount();
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		world->QueueJob (BuildIslandsKernel, &syncData, world);
+	}
+	world->SynchronizationBarrier();
+}
+
+
+void dgWorldDynamicUpdate::AddIslandJoint (dgJointInfo* const constraintArray, dgConstraint* const constraint, dgInt32& jointCount, dgInt32& hasExactSolverJoints) const
+{
+	const dgInt32 vectorStride = dgInt32 (sizeof (dgVector) / sizeof (dgFloat32));
+
+	constraint->m_dynamicsLru = m_markLru;
+	constraint->m_index = dgUnsigned32 (jointCount);
+	hasExactSolverJoints |= constraint->m_useExactSolver;
+
+	dgInt32 rows = (constraint->m_maxDOF + vectorStride - 1) & (-vectorStride);
+	constraintArray[jointCount].m_joint = constraint;
+	constraintArray[jointCount].m_pairCount = dgInt16 (rows);
+	jointCount ++;
+
+	dgAssert (constraint->m_body0);
+	dgAssert (constraint->m_body1);
+}
+
+
+void dgWorldDynamicUpdate::BuildIsland (dgIsland* const island, dgDynamicBody** const members, dgInt32 memberCount, dgFloat32 timestep, dgInt32 threadID)
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgUnsigned32 lruMark = m_markLru;
+
+	dgBodyInfo* const bodyArray = &((dgBodyInfo*) &world->m_bodiesMemory[0])[island->m_bodyStart]; 
+	dgJointInfo* const constraintArray = &((dgJointInfo*) &world->m_jointsMemory[0])[island->m_jointStart];
+
+	dgDynamicBody** const pool = (dgDynamicBody**) world->m_frameArena.Alloc ((memberCount + 1) * dgInt32 (sizeof (dgDynamicBody*)), threadID);
+	dgQueue<dgDynamicBody*> queue (pool, memberCount + 1);
+
+	dgInt32 jointCount = 0;
+	dgInt32 hasExactSolverJoints = 0;
+
+	// the breadth first traversal starts from the bodies touching static bodies, or from the heaviest body 
+	// when there are none, so that the bodies and joints are ordered from the ground up
+	dgDynamicBody* heaviestBody = members[0];
+	for (dgInt32 i = 0; i < memberCount; i ++) {
+		dgDynamicBody* const body = members[i];
+		dgAssert (body->m_invMass.m_w > dgFloat32 (0.0f));
+		if (body->m_mass.m_w > heaviestBody->m_mass.m_w) {
+			heaviestBody = body;
+		}
+
+		bool isGrounded = false;
+		for (dgBodyMasterListRow::dgListNode* jointNode = body->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
+			dgBodyMasterListCell* const cell = &jointNode->GetInfo();
+			dgConstraint* const constraint = cell->m_joint;
+			const dgBody* const linkBody = cell->m_bodyNode;
+			if ((linkBody->m_invMass.m_w == dgFloat32 (0.0f)) && IsIslandEdge (constraint, body, linkBody)) {
+				AddIslandJoint (constraintArray, constraint, jointCount, hasExactSolverJoints);
+				isGrounded = true;
+			}
+		}
+		if (isGrounded) {
+			body->m_dynamicsLru = lruMark;
+			queue.Insert (body);
+		}
+	}
+	if (queue.IsEmpty()) {
+		heaviestBody->m_dynamicsLru = lruMark;
+		queue.Insert (heaviestBody);
+	}
+
+	dgInt32 bodyCount = 1;
+	bodyArray[0].m_body = world->m_sentinelBody;
+	dgAssert (world->m_sentinelBody->m_index == 0); 
+	while (!queue.IsEmpty()) {
+		dgDynamicBody* const body = queue.Remove();
+		dgAssert (body->m_dynamicsLru == lruMark);
+		dgAssert (body->m_masterNode);
+
+		body->m_index = bodyCount; 
+		body->m_active = false;
+		body->m_resting = true;
+		bodyArray[bodyCount].m_body = body;
+		bodyCount ++;
+
+		for (dgBodyMasterListRow::dgListNode* jointNode = body->m_masterNode->GetInfo().GetFirst(); jointNode; jointNode = jointNode->GetNext()) {
+			dgBodyMasterListCell* const cell = &jointNode->GetInfo();
+			dgConstraint* const constraint = cell->m_joint;
+			dgAssert (constraint);
+			dgBody* const linkBody = cell->m_bodyNode;
+			dgAssert ((constraint->m_body0 == body) || (constraint->m_body1 == body));
+			dgAssert ((constraint->m_body0 == linkBody) || (constraint->m_body1 == linkBody));
+			if (IsIslandEdge (constraint, body, linkBody)) { 
+				if (constraint->m_dynamicsLru != lruMark) {
+					AddIslandJoint (constraintArray, constraint, jointCount, hasExactSolverJoints);
+				}
+
+				if ((linkBody->m_dynamicsLru != lruMark) && (linkBody->m_invMass.m_w > dgFloat32 (0.0f))) {
+					linkBody->m_dynamicsLru = lruMark;
+					queue.Insert ((dgDynamicBody*)linkBody);
+				}
+			}
+		}
+	}
+	dgAssert (bodyCount == island->m_bodyCount);
+	dgAssert (jointCount == island->m_jointCount);
+
+	island->m_rowsStart = 0;
+	island->m_hasExactSolverJoints = hasExactSolverJoints;
+	island->m_isContinueCollision = false;
+
+	dgInt32 rowsCount = 0;
+	dgInt32 isContinueCollisionIsland = 0;
+	for (dgInt32 i = 0; i < jointCount; i ++) {
+		dgConstraint* const joint = constraintArray[i].m_joint;
+		rowsCount += constraintArray[i].m_pairCount;
+		if (joint->GetId() == dgConstraint::m_contactConstraint) {
+			const dgBody* const body0 = joint->m_body0;
+			const dgBody* const body1 = joint->m_body1;
+			// pairs in speculative contact mode already carry their swept contacts, they are solved as regular contacts
+			const bool isSpeculative = (((dgContact*)joint)->GetMaterial()->m_flags & dgContactMaterial::m_speculativeContact) ? true : false;
+			if ((body0->m_continueCollisionMode | body1->m_continueCollisionMode) && !isSpeculative) {
+				dgInt32 ccdJoint = false;
+				const dgVector& veloc0 = body0->m_veloc;
+				const dgVector& veloc1 = body1->m_veloc;
+
+				const dgVector& omega0 = body0->m_omega;
+				const dgVector& omega1 = body1->m_omega;
+
+				const dgVector& com0 = body0->m_globalCentreOfMass;
+				const dgVector& com1 = body1->m_globalCentreOfMass;
+
+				const dgCollisionInstance* const collision0 = body0->m_collision;
+				const dgCollisionInstance* const collision1 = body1->m_collision;
+				dgFloat32 dist = dgMax (body0->m_collision->GetBoxMinRadius(), body1->m_collision->GetBoxMinRadius()) * dgFloat32 (0.25f);
+
+				dgVector relVeloc (veloc1 - veloc0);
+				dgVector relOmega (omega1 - omega0);
+				dgVector relVelocMag2 (relVeloc.DotProduct4 (relVeloc));
+				dgVector relOmegaMag2 (relOmega.DotProduct4 (relOmega));
+
+				if ((relOmegaMag2.m_w > dgFloat32 (1.0f)) || ((relVelocMag2.m_w * timestep * timestep) > (dist * dist))) {
+					dgTriplex normals[16];
+					dgTriplex points[16];
+					dgInt64 attrib0[16];
+					dgInt64 attrib1[16];
+					dgFloat32 penetrations[16];
+					dgFloat32 timeToImpact = timestep;
+					const dgInt32 ccdContactCount = world->CollideContinue (collision0, body0->m_matrix, veloc0, omega0, collision1, body1->m_matrix, veloc1, omega1, 
+																			timeToImpact, points, normals, penetrations, attrib0, attrib1, 6, threadID);
+
+					for (dgInt32 j = 0; j < ccdContactCount; j ++) {
+						dgVector point (&points[j].m_x);
+						dgVector normal (&normals[j].m_x);
+						dgVector vel0 (veloc0 + omega0 * (point - com0));
+						dgVector vel1 (veloc1 + omega1 * (point - com1));
+						dgVector vRel (vel1 - vel0);
+						dgFloat32 contactDistTravel = vRel.DotProduct4(normal).m_w * timestep;
+						ccdJoint |= (contactDistTravel > dist);
+					}
+				}
+				//ccdJoint = body0->m_continueCollisionMode | body1->m_continueCollisionMode;
+				isContinueCollisionIsland |= ccdJoint;
+				rowsCount += DG_CCD_EXTRA_CONTACT_COUNT;
+			}
+		}
+	}
+	if (isContinueCollisionIsland) {
+		rowsCount = dgMax(rowsCount, 64);
+	}
+	island->m_rowsCount = rowsCount;
+	island->m_isContinueCollision = isContinueCollisionIsland;
+
+	if (hasExactSolverJoints) {
+		dgInt32 contactJointCount = 0;
+		for (dgInt32 i = 0; i < jointCount; i ++) {
+			dgConstraint* const joint = constraintArray[i].m_joint;
+			contactJointCount += (joint->GetId() == dgConstraint::m_contactConstraint); 
+		}
+
+		for (dgInt32 i = 0; i < jointCount; i ++) {
+			dgConstraint* const joint = constraintArray[i].m_joint;
+			if (joint->m_useExactSolver) {
+				dgAssert (joint->IsBilateral());
+				dgBilateralConstraint* const bilateralJoint = (dgBilateralConstraint*) joint;
+				if (bilateralJoint->m_useExactSolver && (bilateralJoint->m_useExactSolverContactLimit < contactJointCount)) {
+					island->m_hasExactSolverJoints = 0;
+					break;
+				}
+			}
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::FindActiveJointAndBodies (dgIsland* const island)
+{
+	dgWorld* const world = (dgWorld*) this;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+
+
+	dgInt32 jointCount = island->m_jointCount;
+//	if (jointCount > 100000000) {
+	if (jointCount > DG_SMALL_ISLAND_COUNT) {
+		for (dgInt32 i = 0; i < jointCount; i ++) {
+			dgJointInfo* const jointInfo = &constraintArray[i];
+			dgConstraint* const joint = jointInfo->m_joint;
+
+			dgInt32 m0 = (joint->m_body0->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body0->m_index: 0;
+			dgInt32 m1 = (joint->m_body1->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body1->m_index: 0;
+
+			jointInfo->m_m0 = m0;
+			jointInfo->m_m1 = m1;
+
+			dgBody* const body0 = bodyArray[m0].m_body;
+			dgBody* const body1 = bodyArray[m1].m_body;
+
+			bool resting = body0->m_equilibrium & body1->m_equilibrium & ((joint->GetId() == dgConstraint::m_contactConstraint) ? true : false);
+			body0->m_resting &= (resting | !m0);
+			body1->m_resting &= (resting | !m1);
+			body0->m_active |= !(!m0);
+			body1->m_active |= !(!m1);
+			joint->m_solverActive = true;
+		}
+	} else if (jointCount){
+		for (dgInt32 i = 0; i < jointCount; i ++) {
+			dgJointInfo* const jointInfo = &constraintArray[i];
+			dgConstraint* const joint = jointInfo->m_joint;
+			dgInt32 m0 = (joint->m_body0->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body0->m_index: 0;
+			dgInt32 m1 = (joint->m_body1->GetInvMass().m_w != dgFloat32(0.0f)) ? joint->m_body1->m_index: 0;
+			jointInfo->m_m0 = m0;
+			jointInfo->m_m1 = m1;
+			joint->m_solverActive = true;
+		}
+
+		dgInt32 bodyCount = island->m_bodyCount;
+		for (dgInt32 i = 1; i < bodyCount; i ++) {
+			dgBody* const body = bodyArray[i].m_body;
+			body->m_active = true;
+			//body->m_resting = body->m_equilibrium;
+			body->m_resting = false;
+		}
+
+	} else {
+		dgAssert (island->m_bodyCount == 2);
+		dgBody* const body = bodyArray[1].m_body;
+		body->m_active = true;
+		//body->m_resting = body->m_equilibrium;
+		body->m_resting = false;
+	}
+}
+
+
+void dgWorldDynamicUpdate::FindActiveJointAndBodies (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgWorldDynamicUpdateSyncDescriptor* const descriptor = (dgWorldDynamicUpdateSyncDescriptor*) context;
+
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgInt32 count = descriptor->m_islandCount;
+	dgIsland* const islands = &((dgIsland*)&world->m_islandMemory[0])[descriptor->m_firstIsland];
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1)) {
+		dgIsland* const island = &islands[i]; 
+		world->FindActiveJointAndBodies (island); 
+	}
+}
+
+
+
+void dgWorldDynamicUpdate::CalculateIslandReactionForcesKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgWorldDynamicUpdateSyncDescriptor* const descriptor = (dgWorldDynamicUpdateSyncDescriptor*) context;
+
+	dgFloat32 timestep = descriptor->m_timestep;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgInt32 count = descriptor->m_islandCount;
+	dgIsland* const islands = &((dgIsland*)&world->m_islandMemory[0])[descriptor->m_firstIsland];
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1); i < count; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, 1)) {
+		dgIsland* const island = &islands[i]; 
+		world->CalculateIslandReactionForces (island, timestep, threadID);
+	}
+}
+
+dgInt32 dgWorldDynamicUpdate::GetJacobianDerivatives (dgContraintDescritor& constraintParamOut, dgJointInfo* const jointInfo, dgConstraint* const constraint, dgJacobianMatrixElement* const matrixRow, dgInt32 rowCount) const
+{
+	if (constraint->m_solverActive) {
+		dgInt32 dof = dgInt32(constraint->m_maxDOF);
+		dgAssert(dof <= DG_CONSTRAINT_MAX_ROWS);
+		for (dgInt32 i = 0; i < dof; i++) {
+			constraintParamOut.m_forceBounds[i].m_low = DG_MIN_BOUND;
+			constraintParamOut.m_forceBounds[i].m_upper = DG_MAX_BOUND;
+			constraintParamOut.m_forceBounds[i].m_jointForce = NULL;
+			constraintParamOut.m_forceBounds[i].m_normalIndex = DG_BILATERAL_CONSTRAINT;
+		}
+
+		dgAssert(constraint->m_body0);
+		dgAssert(constraint->m_body1);
+
+		constraint->m_body0->m_inCallback = true;
+		constraint->m_body1->m_inCallback = true;
+
+		dof = dgInt32(constraint->JacobianDerivative(constraintParamOut));
+
+		constraint->m_body0->m_inCallback = false;
+		constraint->m_body1->m_inCallback = false;
+
+		//dgAssert(jointInfo->m_m0 < island->m_bodyCount);
+		//dgAssert(jointInfo->m_m1 < island->m_bodyCount);
+		//dgAssert(constraint->m_index == dgUnsigned32(j));
+
+		jointInfo->m_pairStart = rowCount;
+		jointInfo->m_pairCount = dgInt16 (dof);
+		jointInfo->m_pairActiveCount = dgInt16 (dof);
+
+		for (dgInt32 i = 0; i < dof; i++) {
+			dgJacobianMatrixElement* const row = &matrixRow[rowCount];
+			dgAssert(constraintParamOut.m_forceBounds[i].m_jointForce);
+			row->m_Jt = constraintParamOut.m_jacobian[i];
+
+			dgAssert(constraintParamOut.m_jointStiffness[i] >= dgFloat32(0.1f));
+			dgAssert(constraintParamOut.m_jointStiffness[i] <= dgFloat32(100.0f));
+
+			row->m_diagDamp = constraintParamOut.m_jointStiffness[i];
+			row->m_coordenateAccel = constraintParamOut.m_jointAccel[i];
+			row->m_accelIsMotor = constraintParamOut.m_isMotor[i];
+			row->m_restitution = constraintParamOut.m_restitution[i];
+			row->m_penetration = constraintParamOut.m_penetration[i];
+			row->m_penetrationStiffness = constraintParamOut.m_penetrationStiffness[i];
+			row->m_lowerBoundFrictionCoefficent = constraintParamOut.m_forceBounds[i].m_low;
+			row->m_upperBoundFrictionCoefficent = constraintParamOut.m_forceBounds[i].m_upper;
+			row->m_jointFeebackForce = constraintParamOut.m_forceBounds[i].m_jointForce;
+
+			row->m_normalForceIndex = constraintParamOut.m_forceBounds[i].m_normalIndex;
+			rowCount++;
+		}
+		rowCount = (rowCount & (dgInt32(sizeof (dgVector) / sizeof (dgFloat32)) - 1)) ? ((rowCount & (-dgInt32(sizeof (dgVector) / sizeof (dgFloat32)))) + dgInt32(sizeof (dgVector) / sizeof (dgFloat32))) : rowCount;
+		dgAssert((rowCount & (dgInt32(sizeof (dgVector) / sizeof (dgFloat32)) - 1)) == 0);
+	}
+	return rowCount;
+}
+
+void dgWorldDynamicUpdate::GetJacobianDerivatives (const dgIsland* const island, dgInt32 threadIndex, dgInt32 rowCount, dgFloat32 timestep) const
+{
+	dgContraintDescritor constraintParams;
+	dgWorld* const world = (dgWorld*) this;
+
+	constraintParams.m_world = world; 
+	constraintParams.m_threadIndex = threadIndex;
+	constraintParams.m_timestep = timestep;
+	constraintParams.m_invTimestep = (timestep > dgFloat32 (1.0e-5f)) ? dgFloat32 (1.0f / timestep) : dgFloat32 (0.0f);
+
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+
+	dgJacobianMatrixElement* const matrixRow = &m_solverMemory.m_memory[island->m_rowsStart];
+	dgInt32 jointCount = island->m_jointCount;
+	for (dgInt32 j = 0; j < jointCount; j ++) {
+		dgJointInfo* const jointInfo = &constraintArray[j];
+		dgConstraint* const constraint = jointInfo->m_joint;
+
+		dgAssert(jointInfo->m_m0 < island->m_bodyCount);
+		dgAssert(jointInfo->m_m1 < island->m_bodyCount);
+		dgAssert (constraint->m_index == dgUnsigned32(j));
+
+		rowCount = GetJacobianDerivatives (constraintParams, jointInfo, constraint, matrixRow, rowCount);
+		dgAssert (rowCount <= island->m_rowsCount);
+	}
+}
+
+void dgWorldDynamicUpdate::IntegrateArray (const dgIsland* const island, dgFloat32 accelTolerance, dgFloat32 timestep, dgInt32 threadIndex) const
+{
+	bool isAutoSleep = true;
+	bool stackSleeping = true;
+	dgInt32 sleepCounter = 10000;
+
+	dgWorld* const world = (dgWorld*) this;
+
+	dgFloat32 forceDamp = DG_FREEZZING_VELOCITY_DRAG;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart + 1]; 
+	dgInt32 count = island->m_bodyCount - 1;
+	if (count <= 2) {
+		bool autosleep = bodyArray[0].m_body->m_autoSleep;
+		if (count == 2) {
+			autosleep &= bodyArray[1].m_body->m_autoSleep;
+		}
+		if (!autosleep) {
+			forceDamp = dgFloat32 (0.9999f);
+		}
+	}
+
+	dgFloat32 maxAccel = dgFloat32 (0.0f);
+	dgFloat32 maxAlpha = dgFloat32 (0.0f);
+	dgFloat32 maxSpeed = dgFloat32 (0.0f);
+	dgFloat32 maxOmega = dgFloat32 (0.0f);
+
+	dgFloat32 speedFreeze = world->m_freezeSpeed2;
+	dgFloat32 accelFreeze = world->m_freezeAccel2 * ((island->m_jointCount <= DG_SMALL_ISLAND_COUNT) ? dgFloat32 (0.05f) : dgFloat32 (1.0f));
+	dgVector forceDampVect (forceDamp, forceDamp, forceDamp, dgFloat32 (0.0f));
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+
+		dgVector isMovingMask = (body->m_veloc | body->m_omega | body->m_accel | body->m_alpha) & dgVector::m_signMask;
+		if (((isMovingMask.TestZero().GetSignMask() & 7) != 7) && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+			dgAssert (body->m_invMass.m_w);
+			body->IntegrateVelocity(timestep);
+
+			dgFloat32 accel2 = body->m_accel % body->m_accel;
+			dgFloat32 alpha2 = body->m_alpha % body->m_alpha;
+			dgFloat32 speed2 = body->m_veloc % body->m_veloc;
+			dgFloat32 omega2 = body->m_omega % body->m_omega;
+
+			maxAccel = dgMax (maxAccel, accel2);
+			maxAlpha = dgMax (maxAlpha, alpha2);
+			maxSpeed = dgMax (maxSpeed, speed2);
+			maxOmega = dgMax (maxOmega, omega2);
+
+			bool equilibrium = (accel2 < accelFreeze) && (alpha2 < accelFreeze) && (speed2 < speedFreeze) && (omega2 < speedFreeze);
+
+			if (equilibrium) {
+				dgVector veloc (body->m_veloc.CompProduct4(forceDampVect));
+				dgVector omega = body->m_omega.CompProduct4 (forceDampVect);
+				body->m_veloc = (dgVector (veloc.DotProduct4(veloc)) > m_velocTol) & veloc;
+				body->m_omega = (dgVector (omega.DotProduct4(omega)) > m_velocTol) & omega;
+			}
+
+			body->m_equilibrium = dgUnsigned32 (equilibrium);
+			stackSleeping &= equilibrium;
+			isAutoSleep &= body->m_autoSleep;
+
+			sleepCounter = dgMin (sleepCounter, body->m_sleepingCounter);
+
+			body->UpdateMatrix (timestep, threadIndex);
+		}
+	}
+
+	if (isAutoSleep && (island->m_jointCount > DG_SMALL_ISLAND_COUNT)) {
+		if (stackSleeping) {
+			for (dgInt32 i = 0; i < count; i ++) {
+				dgBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+				if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+					body->m_netForce = dgVector::m_zero;
+					body->m_netTorque = dgVector::m_zero;
+					body->m_veloc = dgVector::m_zero;
+					body->m_omega = dgVector::m_zero;
+				}
+			}
+		} else {
+			if ((maxAccel > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxAccel) ||
+				(maxAlpha > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxAlpha) ||
+				(maxSpeed > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxVeloc) ||
+				(maxOmega > world->m_sleepTable[DG_SLEEP_ENTRIES - 1].m_maxOmega)) {
+					for (dgInt32 i = 0; i < count; i ++) {
+						dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+							body->m_sleepingCounter = 0;
+						}
+					}
+			} else {
+				dgInt32 index = 0;
+				for (dgInt32 i = 0; i < DG_SLEEP_ENTRIES; i ++) {
+					if ((maxAccel <= world->m_sleepTable[i].m_maxAccel) &&
+						(maxAlpha <= world->m_sleepTable[i].m_maxAlpha) &&
+						(maxSpeed <= world->m_sleepTable[i].m_maxVeloc) &&
+						(maxOmega <= world->m_sleepTable[i].m_maxOmega)) {
+							index = i;
+							break;
+					}
+				}
+
+				dgInt32 timeScaleSleepCount = dgInt32 (dgFloat32 (60.0f) * sleepCounter * timestep);
+				if (timeScaleSleepCount > world->m_sleepTable[index].m_steps) {
+					for (dgInt32 i = 0; i < count; i ++) {
+						dgBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+							body->m_netForce = dgVector::m_zero;
+							body->m_netTorque = dgVector::m_zero;
+							body->m_veloc = dgVector::m_zero;
+							body->m_omega = dgVector::m_zero;
+							body->m_equilibrium = true;
+						}
+					}
+				} else {
+					sleepCounter ++;
+					for (dgInt32 i = 0; i < count; i ++) {
+						dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+						if (body->m_active && body->IsRTTIType (dgBody::m_dynamicBodyRTTI)) {
+							body->m_sleepingCounter = sleepCounter;
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -1,753 +1,932 @@
-/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely, subject to the following restrictions:
-* 
-* 1. The origin of this software must not be misrepresented; you must not
-* claim that you wrote the original software. If you use this software
-* in a product, an acknowledgment in the product documentation would be
-* appreciated but is not required.
-* 
-* 2. Altered source versions must be plainly marked as such, and must not be
-* misrepresented as being the original software.
-* 
-* 3. This notice may not be removed or altered from any source distribution.
-*/
-
-#include "dgPhysicsStdafx.h"
-
-#include "dgBody.h"
-#include "dgWorld.h"
-#include "dgConstraint.h"
-#include "dgDynamicBody.h"
-#include "dgWorldDynamicUpdate.h"
-
-#define dgParalletSolverStackPoolSize (1<<8)
-
-void dgWorldDynamicUpdate::CalculateReactionForcesParallel (const dgIsland* const island, dgFloat32 timestep) const
-{
-	dgParallelSolverSyncData syncData;
-
-	dgWorld* const world = (dgWorld*) this;
-
-	world->m_pairMemoryBuffer.ExpandCapacityIfNeessesary (island->m_jointCount + 1024, sizeof (dgInt32));
-	syncData.m_bodyLocks = (dgInt32*) (&world->m_pairMemoryBuffer[0]);
-	memset (syncData.m_bodyLocks, 0, island->m_bodyCount * sizeof (syncData.m_bodyLocks[0]));
-
-	dgInt32 bodyCount = island->m_bodyCount - 1;
-	dgInt32 jointsCount = island->m_jointCount;
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-
-	dgInt32 index = island->m_jointStart;
-	for (dgInt32 i = 0; i < jointsCount; i ++) {
-		dgConstraint* const joint = constraintArray[i].m_joint;
-		joint->m_index = index;
-		index ++;
-	}
-	
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-	internalForces[0].m_linear = dgVector::m_zero;
-	internalForces[0].m_angular = dgVector::m_zero;
-
-	const dgInt32 maxPasses = dgInt32 (world->m_solverMode + LINEAR_SOLVER_SUB_STEPS);
-	syncData.m_timestep = timestep;
-	syncData.m_invTimestep = (timestep > dgFloat32 (0.0f)) ? dgFloat32 (1.0f) / timestep : dgFloat32 (0.0f);
-	syncData.m_invStepRK = (dgFloat32 (1.0f) / dgFloat32 (maxPasses));
-	syncData.m_timestepRK = syncData.m_timestep * syncData.m_invStepRK;
-	syncData.m_invTimestepRK = syncData.m_invTimestep * dgFloat32 (maxPasses);
-	syncData.m_maxPasses = maxPasses;
-
-	syncData.m_bodyCount = bodyCount;
-	syncData.m_jointCount = jointsCount;
-	syncData.m_atomicIndex = 0;
-	syncData.m_island = island;
-
-	InitilizeBodyArrayParallel (&syncData);
-	BuildJacobianMatrixParallel (&syncData);
-	SolverInitInternalForcesParallel (&syncData);
-	CalculateForcesGameModeParallel (&syncData);
-	IntegrateInslandParallel(&syncData); 
-}
-
-void dgWorldDynamicUpdate::InitilizeBodyArrayParallel (dgParallelSolverSyncData* const syncData) const
-{
-	dgWorld* const world = (dgWorld*) this;
-	const dgInt32 threadCounts = world->GetThreadCount();	
-
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-	internalForces[0].m_linear = dgVector(dgFloat32(0.0f));
-	internalForces[0].m_angular = dgVector(dgFloat32(0.0f));
-
-	syncData->m_atomicIndex = 0;
-	for (dgInt32 i = 0; i < threadCounts; i ++) {
-		world->QueueJob (InitializeBodyArrayParallelKernel, syncData, world);
-	}
-	world->SynchronizationBarrier();
-}
-
-void dgWorldDynamicUpdate::InitializeBodyArrayParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
-
-	const dgIsland* const island = syncData->m_island;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-
-	if (syncData->m_timestep != dgFloat32 (0.0f)) {
-		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount; i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgAssert (bodyArray[0].m_body->IsRTTIType (dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_accel % ((dgDynamicBody*)bodyArray[0].m_body)->m_accel) == dgFloat32 (0.0f));
-			dgAssert (bodyArray[0].m_body->IsRTTIType (dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_alpha % ((dgDynamicBody*)bodyArray[0].m_body)->m_alpha) == dgFloat32 (0.0f));
-
-			dgInt32 index = i + 1;
-			dgBody* const body = bodyArray[index].m_body;
-			if (!body->m_equilibrium) {
-				dgAssert (body->m_invMass.m_w > dgFloat32 (0.0f));
-				body->AddDampingAcceleration();
-				body->CalcInvInertiaMatrix ();
-			}
-
-			if (body->m_active) {
-				// re use these variables for temp storage 
-				body->m_netForce = body->m_veloc;
-				body->m_netTorque = body->m_omega;
-				internalForces[index].m_linear = dgVector::m_zero;
-				internalForces[index].m_angular = dgVector::m_zero;
-			}
-		}
-	} else {
-		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount; i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgAssert(bodyArray[0].m_body->IsRTTIType(dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_accel % ((dgDynamicBody*)bodyArray[0].m_body)->m_accel) == dgFloat32(0.0f));
-			dgAssert(bodyArray[0].m_body->IsRTTIType(dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_alpha % ((dgDynamicBody*)bodyArray[0].m_body)->m_alpha) == dgFloat32(0.0f));
-
-			dgInt32 index = i + 1;
-			dgBody* const body = bodyArray[index].m_body;
-			if (!body->m_equilibrium) {
-				dgAssert(body->m_invMass.m_w > dgFloat32(0.0f));
-				body->CalcInvInertiaMatrix();
-			}
-
-			if (body->m_active) {
-				 //re use these variables for temp storage 
-				body->m_netForce = body->m_veloc;
-				body->m_netTorque = body->m_omega;
-				internalForces[index].m_linear = dgVector::m_zero;
-				internalForces[index].m_angular = dgVector::m_zero;
-			}
-		}
-	}
-}
-
-
-void dgWorldDynamicUpdate::BuildJacobianMatrixParallel (dgParallelSolverSyncData* const syncData) const
-{
-	dgWorld* const world = (dgWorld*) this;
-	const dgInt32 threadCounts = world->GetThreadCount();	
-
-	syncData->m_atomicIndex = 0;
-	for (dgInt32 i = 0; i < threadCounts; i ++) {
-		world->QueueJob (BuildJacobianMatrixParallelKernel, syncData, world);
-	}
-	world->SynchronizationBarrier();
-}
-
-
-void dgWorldDynamicUpdate::BuildJacobianMatrixParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
-	const dgIsland* const island = syncData->m_island;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[0];
-	dgAssert (syncData->m_jointCount);
-
-	dgContraintDescritor constraintParams;
-	constraintParams.m_world = world;
-	constraintParams.m_threadIndex = threadID;
-	constraintParams.m_timestep = syncData->m_timestep;
-	constraintParams.m_invTimestep = syncData->m_invTimestep;
-
-	dgFloat32 forceOrImpulseScale = (syncData->m_timestep > dgFloat32 (0.0f)) ? dgFloat32 (1.0f) : dgFloat32 (0.0f);
-	for (dgInt32 jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1); jointIndex < syncData->m_jointCount;  jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgJointInfo* const jointInfo = &constraintArray[jointIndex];
-		dgConstraint* const constraint = jointInfo->m_joint;
-
-		dgInt32 rowBase = dgAtomicExchangeAndAdd(&syncData->m_jacobianMatrixRowAtomicIndex, jointInfo->m_pairCount);
-
-		world->GetJacobianDerivatives(constraintParams, jointInfo, constraint, matrixRow, rowBase);
-
-		dgAssert (jointInfo->m_m0 >= 0);
-		dgAssert (jointInfo->m_m1 >= 0);
-		dgAssert (jointInfo->m_m0 != jointInfo->m_m1);
-		dgAssert (jointInfo->m_m0 < island->m_bodyCount);
-		dgAssert (jointInfo->m_m1 < island->m_bodyCount);
-		world->BuildJacobianMatrix (bodyArray, jointInfo, matrixRow, forceOrImpulseScale);
-	}
-}
-
-
-void dgWorldDynamicUpdate::SolverInitInternalForcesParallel (dgParallelSolverSyncData* const syncData) const
-{
-	dgWorld* const world = (dgWorld*) this;
-	const dgInt32 threadCounts = world->GetThreadCount();	
-
-	syncData->m_atomicIndex = 0;
-	for (dgInt32 i = 0; i < threadCounts; i ++) {
-		world->QueueJob (SolverInitInternalForcesParallelKernel, syncData, world);
-	}
-	world->SynchronizationBarrier();
-}
-
-
-void dgWorldDynamicUpdate::SolverInitInternalForcesParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	const dgIsland* const island = syncData->m_island;
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[0];
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-
-	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_jointCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgJointInfo* const jointInfo = &constraintArray[i];
-		if (jointInfo->m_joint->m_solverActive) {
-			dgJacobian y0;
-			dgJacobian y1;
-			world->InitJointForce (jointInfo, matrixRow, y0, y1);
-			const dgInt32 m0 = jointInfo->m_m0;
-			const dgInt32 m1 = jointInfo->m_m1;
-			dgAssert (m0 != m1);
-			dgSpinLock(&syncData->m_lock, false);
-				internalForces[m0].m_linear += y0.m_linear;
-				internalForces[m0].m_angular += y0.m_angular;
-				internalForces[m1].m_linear += y1.m_linear;
-				internalForces[m1].m_angular += y1.m_angular;
-			dgSpinUnlock(&syncData->m_lock);
-		}
-	}
-}
-
-
-
-void dgWorldDynamicUpdate::CalculateJointsAccelParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	const dgIsland* const island = syncData->m_island;
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[0];
-
-	dgJointAccelerationDecriptor joindDesc;
-	joindDesc.m_timeStep = syncData->m_timestepRK;
-	joindDesc.m_invTimeStep = syncData->m_invTimestepRK;
-	joindDesc.m_firstPassCoefFlag = syncData->m_firstPassCoef;
-
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
-	if (joindDesc.m_firstPassCoefFlag == dgFloat32 (0.0f)) {
-		for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgJointInfo* const jointInfo = &constraintArray[curJoint];
-			dgConstraint* const constraint = jointInfo->m_joint;
-			if (constraint->m_solverActive) {
-				joindDesc.m_rowsCount = jointInfo->m_pairCount;
-				joindDesc.m_rowMatrix = &matrixRow[jointInfo->m_pairStart];
-				constraint->JointAccelerations(&joindDesc);
-			}
-		}
-	} else {
-		const dgIsland* const island = syncData->m_island;
-		dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-		const dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-
-		for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgJointInfo* const jointInfo = &constraintArray[curJoint];
-			dgConstraint* const constraint = jointInfo->m_joint;
-			if (constraint->m_solverActive) {
-				const dgInt32 m0 = jointInfo->m_m0;
-				const dgInt32 m1 = jointInfo->m_m1;
-				const dgBody* const body0 = bodyArray[m0].m_body;
-				const dgBody* const body1 = bodyArray[m1].m_body;
-				if (!(body0->m_resting & body1->m_resting)) {
-					joindDesc.m_rowsCount = jointInfo->m_pairCount;
-					joindDesc.m_rowMatrix = &matrixRow[jointInfo->m_pairStart];
-					constraint->JointAccelerations(&joindDesc);
-				}
-			}
-		}
-	}
-}
-
-
-void dgWorldDynamicUpdate::CalculateJointsVelocParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-
-	const dgIsland* const island = syncData->m_island;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-
-	dgVector speedFreeze2 (world->m_freezeSpeed2 * dgFloat32 (0.1f));
-	dgVector freezeOmega2 (world->m_freezeOmega2 * dgFloat32 (0.1f));
-	//dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgFloat32 (-1.0f): dgFloat32 (0.0f));
-	dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgVector (-1, -1, -1, -1) : dgFloat32 (0.0f));
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-
-	if (syncData->m_timestepRK != dgFloat32 (0.0f)) {
-		dgVector timestep4 (syncData->m_timestepRK);
-		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-			dgAssert (body->m_index == i);
-			if (body->m_active) {
-				dgVector force(internalForces[i].m_linear);
-				dgVector torque(internalForces[i].m_angular);
-				if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
-					force += body->m_accel;
-					torque += body->m_alpha;
-				}
-
-				dgVector velocStep((force.Scale4(body->m_invMass.m_w)).CompProduct4(timestep4));
-				dgVector omegaStep((body->m_invWorldInertiaMatrix.RotateVector(torque)).CompProduct4(timestep4));
-				if (!body->m_resting) {
-					body->m_veloc += velocStep;
-					body->m_omega += omegaStep;
-				} else {
-					dgVector velocStep2(velocStep.DotProduct4(velocStep));
-					dgVector omegaStep2(omegaStep.DotProduct4(omegaStep));
-					dgVector test((velocStep2 > speedFreeze2) | (omegaStep2 > speedFreeze2) | forceActiveMask);
-					if (test.GetSignMask()) {
-						body->m_resting = false;
-					}
-				}
-			}
-		}
-	} else {
-		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-			dgBody* const body = bodyArray[i].m_body;
-			if (body->m_active) {
-				const dgVector& linearMomentum = internalForces[i].m_linear;
-				const dgVector& angularMomentum = internalForces[i].m_angular;
-
-				body->m_veloc += linearMomentum.Scale4(body->m_invMass.m_w);
-				body->m_omega += body->m_invWorldInertiaMatrix.RotateVector(angularMomentum);
-			}
-		}
-	}
-}
-
-/*
-void dgWorldDynamicUpdate::CalculateJointsImpulseVelocParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-
-	const dgIsland* const island = syncData->m_island;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-	//dgJacobian* const internalVeloc = &world->m_solverMemory.m_internalVeloc[0];
-
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgInt32 index = i + 1;
-		dgAssert (index);
-		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[index].m_body;
-		dgAssert (body->m_index == index);
-
-		const dgVector& linearMomentum = internalForces[index].m_linear;
-		const dgVector& angularMomentum = internalForces[index].m_angular;
-
-		body->m_veloc += linearMomentum.Scale4(body->m_invMass.m_w);
-		body->m_omega += body->m_invWorldInertiaMatrix.RotateVector (angularMomentum);
-
-		//internalVeloc[index].m_linear += body->m_veloc;
-		//internalVeloc[index].m_angular += body->m_omega;
-	}
-}
-*/
-
-void dgWorldDynamicUpdate::UpdateFeedbackForcesParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	const dgIsland* const island = syncData->m_island;
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[0];
-
-	dgInt32 hasJointFeeback = 0;
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-	
-	for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgJointInfo* const jointInfo = &constraintArray[curJoint];
-		dgConstraint* const constraint = jointInfo->m_joint;
-		if (constraint->m_solverActive) {
-			const dgInt32 first = jointInfo->m_pairStart;
-			const dgInt32 count = jointInfo->m_pairCount;
-
-			for (dgInt32 j = 0; j < count; j++) {
-				dgJacobianMatrixElement* const row = &matrixRow[j + first];
-				dgFloat32 val = row->m_force;
-				dgAssert(dgCheckFloat(val));
-				row->m_jointFeebackForce[0].m_force = val;
-				row->m_jointFeebackForce[0].m_impact = row->m_maxImpact * syncData->m_timestepRK;
-			}
-			hasJointFeeback |= (constraint->m_updaFeedbackCallback ? 1 : 0);
-		}
-	}
-	syncData->m_hasJointFeeback[threadID] = hasJointFeeback;
-}
-
-
-void dgWorldDynamicUpdate::UpdateBodyVelocityParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-
-	const dgIsland* const island = syncData->m_island;
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-
-	dgFloat32 maxAccNorm2 = DG_SOLVER_MAX_ERROR * DG_SOLVER_MAX_ERROR;
-
-	//dgFloat32 invTimestepSrc = dgFloat32 (1.0f) / syncData->m_timestep;
-	dgFloat32 invTimestepSrc = syncData->m_invTimestep;
-
-	dgVector invTime (invTimestepSrc);
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-	dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgVector (-1, -1, -1, -1) : dgFloat32 (0.0f));
-	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount; i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
-		if (body->m_active) {
-			// the initial velocity and angular velocity were stored in net force and net torque, for memory saving
-			dgVector accel = (body->m_veloc - body->m_netForce).CompProduct4(invTime);
-			dgVector alpha = (body->m_omega - body->m_netTorque).CompProduct4(invTime);
-			dgVector accelTest((accel.DotProduct4(accel) > maxAccNorm2) | (alpha.DotProduct4(alpha) > maxAccNorm2) | forceActiveMask);
-			//if ((accel % accel) < maxAccNorm2) {
-			//	accel = dgVector::m_zero;
-			//}
-			//if ((alpha % alpha) < maxAccNorm2) {
-			//	alpha = dgVector::m_zero;
-			//}
-			accel = accel & accelTest;
-			alpha = alpha & accelTest;
-
-			if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
-				body->m_accel = accel;
-				body->m_alpha = alpha;
-			}
-			body->m_netForce = accel.Scale4(body->m_mass[3]);
-
-			alpha = body->m_matrix.UnrotateVector(alpha);
-			body->m_netTorque = body->m_matrix.RotateVector(alpha.CompProduct4(body->m_mass));
-		}
-	}
-}
-
-
-void dgWorldDynamicUpdate::KinematicCallbackUpdateParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-	const dgIsland* const island = syncData->m_island;
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_jointCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-		dgInt32 curJoint = i;
-		if (constraintArray[curJoint].m_joint->m_updaFeedbackCallback) {
-			constraintArray[curJoint].m_joint->m_updaFeedbackCallback (*constraintArray[curJoint].m_joint, syncData->m_timestep, threadID);
-		}
-	}
-}
-
-
-void dgWorldDynamicUpdate::IntegrateInslandParallel(dgParallelSolverSyncData* const syncData) const
-{
-	dgWorld* const world = (dgWorld*) this;
-//	dgWorldDynamicUpdate::IntegrateInslandParallelKernel (syncData, world, 0);
-	world->IntegrateArray (syncData->m_island, DG_SOLVER_MAX_ERROR, syncData->m_timestep, 0); 
-}
-
-
-void dgWorldDynamicUpdate::CalculateForcesGameModeParallel (dgParallelSolverSyncData* const syncData) const
-{
-	dgWorld* const world = (dgWorld*) this;
-	const dgInt32 threadCounts = world->GetThreadCount();	
-
-	dgInt32 maxPasses = syncData->m_maxPasses;
-	syncData->m_firstPassCoef = dgFloat32 (0.0f);
-	for (dgInt32 step = 0; step < maxPasses; step ++) {
-
-		syncData->m_atomicIndex = 0;
-		for (dgInt32 i = 0; i < threadCounts; i ++) {
-			world->QueueJob (CalculateJointsAccelParallelKernel, syncData, world);
-		}
-		world->SynchronizationBarrier();
-		syncData->m_firstPassCoef = dgFloat32 (1.0f);
-
-		dgFloat32 accNorm = DG_SOLVER_MAX_ERROR * dgFloat32 (2.0f);
-		for (dgInt32 passes = 0; (passes < DG_BASE_ITERATION_COUNT) && (accNorm > DG_SOLVER_MAX_ERROR); passes ++) {
-			for (dgInt32 i = 0; i < threadCounts; i ++) {
-				syncData->m_accelNorm[i] = dgVector (dgFloat32 (0.0f));
-			}
-			syncData->m_atomicIndex = 0;
-			for (dgInt32 i = 0; i < threadCounts; i ++) {
-				world->QueueJob (CalculateJointsForceParallelKernel, syncData, world);
-			}
-			world->SynchronizationBarrier();
-
-			accNorm = dgFloat32 (0.0f);
-			for (dgInt32 i = 0; i < threadCounts; i ++) {
-				accNorm = dgMax (accNorm, syncData->m_accelNorm[i].m_x);
-			}
-		}
-
-		syncData->m_atomicIndex = 1;
-		for (dgInt32 j = 0; j < threadCounts; j ++) {
-			world->QueueJob (CalculateJointsVelocParallelKernel, syncData, world);
-		}
-		world->SynchronizationBarrier();
-	}
-
-	if (syncData->m_timestepRK != dgFloat32 (0.0f)) {
-		syncData->m_atomicIndex = 0;
-		for (dgInt32 j = 0; j < threadCounts; j ++) {
-			world->QueueJob (UpdateFeedbackForcesParallelKernel, syncData, world);
-		}
-		world->SynchronizationBarrier();
-
-		dgInt32 hasJointFeeback = 0;
-		for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
-			hasJointFeeback |= syncData->m_hasJointFeeback[i];
-		}
-
-		syncData->m_atomicIndex = 1;
-		for (dgInt32 j = 0; j < threadCounts; j++) {
-			world->QueueJob(UpdateBodyVelocityParallelKernel, syncData, world);
-		}
-		world->SynchronizationBarrier();
-
-		if (hasJointFeeback) {
-			syncData->m_atomicIndex = 0;
-			for (dgInt32 j = 0; j < threadCounts; j++) {
-				world->QueueJob(KinematicCallbackUpdateParallelKernel, syncData, world);
-			}
-			world->SynchronizationBarrier();
-		}
-
-	} else {
-		const dgInt32 count = syncData->m_bodyCount;
-		const dgIsland* const island = syncData->m_island;
-		dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*)&world->m_bodiesMemory[0];
-		dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-		for (dgInt32 i = 1; i < count; i++) {
-			dgBody* const body = bodyArray[i].m_body;
-			if (body->m_active) {
-				body->m_netForce = dgVector::m_zero;
-				body->m_netTorque = dgVector::m_zero;
-			}
-		}
-	}
-}
-
-
-void dgWorldDynamicUpdate::CalculateJointsForceParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
-{
-	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
-	dgWorld* const world = (dgWorld*) worldContext;
-
-	const dgIsland* const island = syncData->m_island;
-	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[0];
-	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
-	const dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
-	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
-	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
-	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[0];
-	const int jointCount = syncData->m_jointCount;
-	dgInt32* const globalLock  = &syncData->m_lock;
-	
-
-	dgInt32 pool [dgParalletSolverStackPoolSize];
-	dgQueue<dgInt32> queue(pool, dgParalletSolverStackPoolSize);
-
-	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
-	dgVector accNorm (syncData->m_accelNorm[threadID]);
-
-#if 1
-	dgInt32* const bodyLocks = syncData->m_bodyLocks;
-	queue.Insert(dgAtomicExchangeAndAdd(atomicIndex, 1));
-	while (!queue.IsEmpty()) {
-		dgInt32 jointIndex = queue.Remove();
-		if (jointIndex < jointCount) {
-			dgSpinLock(globalLock, false);
-			dgInt32 m0 = constraintArray[jointIndex].m_m0;
-			dgInt32 m1 = constraintArray[jointIndex].m_m1;
-			dgInt32 test0 = syncData->m_bodyLocks[m0];
-			dgInt32 test1 = syncData->m_bodyLocks[m1];
-			while (test0 | test1) {
-				queue.Insert(jointIndex);
-				jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1);
-				if (jointIndex < jointCount) {
-					m0 = constraintArray[jointIndex].m_m0;
-					m1 = constraintArray[jointIndex].m_m1;
-					test0 = syncData->m_bodyLocks[m0];
-					test1 = syncData->m_bodyLocks[m1];
-				} else {
-					m0 = 0;
-					m1 = 0;
-					test0 = 0;
-					test1 = 0;
-				}
-			}
-			bodyLocks[m0] = m0 > 0;
-			bodyLocks[m1] = m1 > 0;
-			if (queue.IsEmpty()) {
-				queue.Insert(dgAtomicExchangeAndAdd(atomicIndex, 1));
-			}
-			dgSpinUnlock(globalLock);
-			if (m0 != m1) {
-				dgJointInfo* const jointInfo = &constraintArray[jointIndex];
-				dgAssert(jointInfo->m_m0 == m0);
-				dgAssert(jointInfo->m_m1 == m1);
-
-				world->CalculateJointForce (jointInfo, bodyArray, internalForces, matrixRow, accNorm);
-
-				dgSpinUnlock(&bodyLocks[m0]);
-				dgSpinUnlock(&bodyLocks[m1]);
-			}
-		}
-	}
-
-#else
-
-	for (dgInt32 jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1); jointIndex < jointCount;  jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
-
-		dgSpinLock(globalLock, false);
-		dgInt32 m0 = constraintArray[jointIndex].m_m0;
-		dgInt32 m1 = constraintArray[jointIndex].m_m1;
-//			dgInt32 test0;
-//			dgInt32 test1;
-//			do {
-//				test0 = bodyLocks[m0];
-//				test1 = bodyLocks[m1];
-//			} while (test0 | test1);
-//			bodyLocks[m0] = m0 > 0;
-//			bodyLocks[m1] = m1 > 0;
-			
-		const dgBody* const body0 = bodyArray[m0].m_body;
-		const dgBody* const body1 = bodyArray[m1].m_body;
-
-		if (!(body0->m_resting & body1->m_resting)) {
-			dgInt32 index = constraintArray[jointIndex].m_pairStart;
-			dgInt32 rowsCount = constraintArray[jointIndex].m_pairCount;
-
-			dgVector linearM0 (internalForces[m0].m_linear);
-			dgVector angularM0 (internalForces[m0].m_angular);
-			dgVector linearM1 (internalForces[m1].m_linear);
-			dgVector angularM1 (internalForces[m1].m_angular);
-
-			const dgVector invMass0 (body0->m_invMass[3]);
-			const dgMatrix& invInertia0 = body0->m_invWorldInertiaMatrix;
-
-			const dgVector invMass1 (body1->m_invMass[3]);
-			const dgMatrix& invInertia1 = body1->m_invWorldInertiaMatrix;
-
-			for (dgInt32 k = 0; k < rowsCount; k ++) {
-				dgJacobianMatrixElement* const row = &matrixRow[index];
-
-				dgAssert (row->m_Jt.m_jacobianM0.m_linear.m_w == dgFloat32 (0.0f));
-				dgAssert (row->m_Jt.m_jacobianM0.m_angular.m_w == dgFloat32 (0.0f));
-				dgAssert (row->m_Jt.m_jacobianM1.m_linear.m_w == dgFloat32 (0.0f));
-				dgAssert (row->m_Jt.m_jacobianM1.m_angular.m_w == dgFloat32 (0.0f));
-
-				//dgVector JMinvJacobianLinearM0 (row->m_Jt.m_jacobianM0.m_linear.Scale3 (invMass0));
-				//dgVector JMinvJacobianAngularM0 (invInertia0.UnrotateVector (row->m_Jt.m_jacobianM0.m_angular));
-				//dgVector JMinvJacobianLinearM1 (row->m_Jt.m_jacobianM1.m_linear.Scale3 (invMass1));
-				//dgVector JMinvJacobianAngularM1 (invInertia1.UnrotateVector (row->m_Jt.m_jacobianM1.m_angular));
-
-				dgVector JMinvJacobianLinearM0 (row->m_Jt.m_jacobianM0.m_linear.CompProduct4 (invMass0));
-				dgVector JMinvJacobianAngularM0 (invInertia0.RotateVector (row->m_Jt.m_jacobianM0.m_angular));
-				dgVector JMinvJacobianLinearM1 (row->m_Jt.m_jacobianM1.m_linear.CompProduct4 (invMass1));
-				dgVector JMinvJacobianAngularM1 (invInertia1.RotateVector (row->m_Jt.m_jacobianM1.m_angular));
-
-				dgVector a (JMinvJacobianLinearM0.CompProduct4(linearM0) + JMinvJacobianAngularM0.CompProduct4(angularM0) + JMinvJacobianLinearM1.CompProduct4(linearM1) + JMinvJacobianAngularM1.CompProduct4(angularM1));
-
-				//dgFloat32 a = row->m_coordenateAccel - acc.m_x - acc.m_y - acc.m_z - row->m_force * row->m_diagDamp;
-				a = dgVector (row->m_coordenateAccel  - row->m_force * row->m_diagDamp) - a.AddHorizontal();
-
-				//dgFloat32 f = row->m_force + row->m_invDJMinvJt * a;
-				dgVector f (row->m_force + row->m_invDJMinvJt * a.m_x);
-
-				dgInt32 frictionIndex = row->m_normalForceIndex;
-				dgAssert (((frictionIndex < 0) && (normalForce[frictionIndex] == dgFloat32 (1.0f))) || ((frictionIndex >= 0) && (normalForce[frictionIndex] >= dgFloat32 (0.0f))));
-
-				dgFloat32 frictionNormal = normalForce[frictionIndex];
-				dgVector lowerFrictionForce = (frictionNormal * row->m_lowerBoundFrictionCoefficent);
-				dgVector upperFrictionForce = (frictionNormal * row->m_upperBoundFrictionCoefficent);
-
-				//if (f > upperFrictionForce) {
-				//	a = dgFloat32 (0.0f);
-				//	f = upperFrictionForce;
-				//} else if (f < lowerFrictionForce) {
-				//	a = dgFloat32 (0.0f);
-				//	f = lowerFrictionForce;
-				//}
-				a = a.AndNot((f > upperFrictionForce) | (f < lowerFrictionForce));
-				f = f.GetMax(lowerFrictionForce).GetMin(upperFrictionForce);
-
-				accNorm = accNorm.GetMax(a.Abs());
-				dgAssert (accNorm.m_x >= dgAbsf (a.m_x));
-
-				// no early out for parallel solver
-				//accNorm = accNorm.GetMax(a.Abs());
-				//dgAssert (accNorm.m_x >= dgAbsf (a.m_x));
-
-				//dgFloat32 prevValue = f - row->m_force;
-				dgVector prevValue (f - dgVector (row->m_force));
-
-				row->m_force = f.m_x;
-				normalForce[k] = f.m_x;
-				row->m_maxImpact = f.Abs().GetMax (row->m_maxImpact).m_x;
-
-				linearM0 += row->m_Jt.m_jacobianM0.m_linear.CompProduct4 (prevValue);
-				angularM0 += row->m_Jt.m_jacobianM0.m_angular.CompProduct4 (prevValue);
-				linearM1 += row->m_Jt.m_jacobianM1.m_linear.CompProduct4 (prevValue);
-				angularM1 += row->m_Jt.m_jacobianM1.m_angular.CompProduct4 (prevValue);
-				index ++;
-			}
-
-			internalForces[m0].m_linear = linearM0;
-			internalForces[m0].m_angular = angularM0;
-
-			internalForces[m1].m_linear = linearM1;
-			internalForces[m1].m_angular = angularM1;
-		}
-
-		//dgSpinUnlock (&bodyLocks[m0]);
-		//dgSpinUnlock (&bodyLocks[m1]);
-
-		dgSpinUnlock(globalLock);
-	}
-#endif
-
-	syncData->m_accelNorm[threadID] = accNorm;
-}
+/* Copyright (c) <2003-2011> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgPhysicsStdafx.h"
+
+#include "dgBody.h"
+#include "dgWorld.h"
+#include "dgConstraint.h"
+#include "dgDynamicBody.h"
+#include "dgWorldDynamicUpdate.h"
+
+
+void dgWorldDynamicUpdate::CalculateReactionForcesParallel (const dgIsland* const island, dgFloat32 timestep) const
+{
+	dgParallelSolverSyncData syncData;
+
+	dgWorld* const world = (dgWorld*) this;
+
+	dgInt32 bodyCount = island->m_bodyCount;
+	dgInt32 jointsCount = island->m_jointCount;
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+
+	CreateParallelArrayBatchArrays (&syncData, constraintArray, island);
+	dgAssert (syncData.m_rowCount <= island->m_rowsCount);
+
+	const dgInt32 maxPasses = dgInt32 (world->m_solverMode + LINEAR_SOLVER_SUB_STEPS);
+	syncData.m_timestep = timestep;
+	syncData.m_invTimestep = (timestep > dgFloat32 (0.0f)) ? dgFloat32 (1.0f) / timestep : dgFloat32 (0.0f);
+	syncData.m_invStepRK = (dgFloat32 (1.0f) / dgFloat32 (maxPasses));
+	syncData.m_timestepRK = syncData.m_timestep * syncData.m_invStepRK;
+	syncData.m_invTimestepRK = syncData.m_invTimestep * dgFloat32 (maxPasses);
+	syncData.m_maxPasses = maxPasses;
+
+	syncData.m_bodyCount = bodyCount;
+	syncData.m_jointCount = jointsCount;
+	syncData.m_atomicIndex = 0;
+	syncData.m_island = island;
+
+	InitilizeBodyArrayParallel (&syncData);
+	BuildJacobianMatrixParallel (&syncData);
+	SolverInitInternalForcesParallel (&syncData);
+	CalculateForcesGameModeParallel (&syncData);
+	IntegrateInslandParallel(&syncData); 
+}
+
+
+void dgWorldDynamicUpdate::CreateParallelArrayBatchArrays (dgParallelSolverSyncData* const syncData, dgJointInfo* const constraintArray, const dgIsland* const island) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgInt32 bodyCount = island->m_bodyCount;
+	const dgInt32 jointCount = island->m_jointCount;
+
+	// scratch memory: a batch mask per body, a batch index per joint and a copy of the joint array for sorting
+	const dgInt32 maskSizeInBytes = ((bodyCount + jointCount) * dgInt32 (sizeof (dgInt32)) + 15) & -16;
+	dgUnsigned32* const bodyBatchMask = (dgUnsigned32*) world->m_frameArena.Alloc (maskSizeInBytes);
+	dgInt32* const batchIndex = (dgInt32*) &bodyBatchMask[bodyCount];
+	dgJointInfo* const sortBuffer = (dgJointInfo*) world->m_frameArena.Alloc (jointCount * dgInt32 (sizeof (dgJointInfo)));
+	memset (bodyBatchMask, 0, bodyCount * sizeof (bodyBatchMask[0]));
+
+	dgInt32 batchCount[DG_PARALLEL_MAX_BATCHES];
+	memset (batchCount, 0, sizeof (batchCount));
+
+	// greedy coloring, each joint goes to the first batch not used by either of its bodies.
+	// the sentinel body stands for all static bodies and the solver never writes to it, so it is shared by all batches
+	const dgInt32 serialBatch = DG_PARALLEL_MAX_BATCHES - 1;
+	for (dgInt32 i = 0; i < jointCount; i ++) {
+		const dgInt32 m0 = constraintArray[i].m_m0;
+		const dgInt32 m1 = constraintArray[i].m_m1;
+		const dgUnsigned32 usedBatches = bodyBatchMask[m0] | bodyBatchMask[m1];
+
+		dgInt32 batch = 0;
+		while ((batch < serialBatch) && (usedBatches & (dgUnsigned32 (1) << batch))) {
+			batch ++;
+		}
+		if (batch < serialBatch) {
+			const dgUnsigned32 bit = dgUnsigned32 (1) << batch;
+			bodyBatchMask[m0] |= bit;
+			bodyBatchMask[m1] |= bit;
+			bodyBatchMask[0] = 0;
+		}
+		batchIndex[i] = batch;
+		batchCount[batch] ++;
+	}
+
+	SortJointInfoByBatchIndex (syncData, constraintArray, sortBuffer, batchIndex, batchCount, jointCount);
+}
+
+
+void dgWorldDynamicUpdate::SortJointInfoByBatchIndex (dgParallelSolverSyncData* const syncData, dgJointInfo* const constraintArray, dgJointInfo* const sortBuffer, const dgInt32* const batchIndex, const dgInt32* const batchCount, dgInt32 jointCount) const
+{
+	// a counting sort keeps the joints of each batch in island order, 
+	// this way the solution does not depend on the number of threads 
+	dgInt32 batchStart[DG_PARALLEL_MAX_BATCHES];
+	dgInt32 batchesCount = 0;
+	dgInt32 start = 0;
+	for (dgInt32 i = 0; i < DG_PARALLEL_MAX_BATCHES; i ++) {
+		batchStart[i] = start;
+		if (batchCount[i]) {
+			syncData->m_jointBatches[batchesCount] = start;
+			batchesCount ++;
+			start += batchCount[i];
+		}
+	}
+	dgAssert (start == jointCount);
+	syncData->m_jointBatches[batchesCount] = start;
+	syncData->m_batchesCount = batchesCount;
+	syncData->m_hasSerialBatch = batchCount[DG_PARALLEL_MAX_BATCHES - 1] ? 1 : 0;
+
+	for (dgInt32 i = 0; i < jointCount; i ++) {
+		const dgInt32 index = batchStart[batchIndex[i]];
+		batchStart[batchIndex[i]] = index + 1;
+		sortBuffer[index] = constraintArray[i];
+	}
+
+	// joints of a colored batch are independent, so their order does not change the solution. 
+	// Ordering them by row count lets the blocks of the simd pass hold joints of similar size
+	const dgInt32 parallelBatches = batchesCount - syncData->m_hasSerialBatch;
+	for (dgInt32 i = 0; i < parallelBatches; i ++) {
+		const dgInt32 batchBase = syncData->m_jointBatches[i];
+		dgSort (&sortBuffer[batchBase], syncData->m_jointBatches[i + 1] - batchBase, CompareJointInfoRows);
+	}
+
+	// reserve the jacobian rows of each joint in the new order
+	dgInt32 rowCount = 0;
+	for (dgInt32 i = 0; i < jointCount; i ++) {
+		dgJointInfo* const jointInfo = &constraintArray[i];
+		*jointInfo = sortBuffer[i];
+		jointInfo->m_joint->m_index = dgUnsigned32 (i);
+		jointInfo->m_pairStart = rowCount;
+		rowCount += jointInfo->m_pairCount;
+	}
+	syncData->m_rowCount = rowCount;
+}
+
+
+dgInt32 dgWorldDynamicUpdate::CompareJointInfoRows (const dgJointInfo* const infoA, const dgJointInfo* const infoB, void* notUsed)
+{
+	if (infoA->m_pairCount < infoB->m_pairCount) {
+		return 1;
+	}
+	if (infoA->m_pairCount > infoB->m_pairCount) {
+		return -1;
+	}
+	return 0;
+}
+
+
+void dgWorldDynamicUpdate::DispatchParallelBatches (dgParallelSolverSyncData* const syncData, dgWorkerThreadTaskCallback kernel) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgInt32 threadCounts = world->GetThreadCount();	
+
+	const dgInt32 parallelBatches = syncData->m_batchesCount - syncData->m_hasSerialBatch;
+	for (dgInt32 i = 0; i < parallelBatches; i ++) {
+		syncData->m_currentBatch = i;
+		syncData->m_atomicIndex = syncData->m_jointBatches[i];
+		for (dgInt32 j = 0; j < threadCounts; j ++) {
+			world->QueueJob (kernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+	}
+
+	if (syncData->m_hasSerialBatch) {
+		// joints in this batch may share bodies, solve them in order on the calling thread
+		syncData->m_currentBatch = parallelBatches;
+		syncData->m_atomicIndex = syncData->m_jointBatches[parallelBatches];
+		kernel (syncData, world, 0);
+	}
+}
+
+
+void dgWorldDynamicUpdate::InitilizeBodyArrayParallel (dgParallelSolverSyncData* const syncData) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgInt32 threadCounts = world->GetThreadCount();	
+
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[syncData->m_island->m_bodyStart];
+	internalForces[0].m_linear = dgVector::m_zero;
+	internalForces[0].m_angular = dgVector::m_zero;
+
+	const dgIsland* const island = syncData->m_island;
+	const dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyStateArray bodyState (m_solverMemory.m_bodyState.GetIslandState (island));
+	bodyState.Gather (0, bodyArrayPtr[island->m_bodyStart].m_body);
+
+	syncData->m_atomicIndex = 1;
+	for (dgInt32 i = 0; i < threadCounts; i ++) {
+		world->QueueJob (InitializeBodyArrayParallelKernel, syncData, world);
+	}
+	world->SynchronizationBarrier();
+}
+
+void dgWorldDynamicUpdate::InitializeBodyArrayParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
+
+	const dgIsland* const island = syncData->m_island;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[island->m_bodyStart];
+	dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+
+	if (syncData->m_timestep != dgFloat32 (0.0f)) {
+		for (dgInt32 index = dgAtomicExchangeAndAdd(atomicIndex, 1); index < syncData->m_bodyCount; index = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgAssert (bodyArray[0].m_body->IsRTTIType (dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_accel % ((dgDynamicBody*)bodyArray[0].m_body)->m_accel) == dgFloat32 (0.0f));
+			dgAssert (bodyArray[0].m_body->IsRTTIType (dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_alpha % ((dgDynamicBody*)bodyArray[0].m_body)->m_alpha) == dgFloat32 (0.0f));
+
+			dgBody* const body = bodyArray[index].m_body;
+			if (!body->m_equilibrium) {
+				dgAssert (body->m_invMass.m_w > dgFloat32 (0.0f));
+				body->AddDampingAcceleration();
+				body->CalcInvInertiaMatrix ();
+			}
+
+			bodyState.Gather (index, body);
+			if (body->m_active) {
+				internalForces[index].m_linear = dgVector::m_zero;
+				internalForces[index].m_angular = dgVector::m_zero;
+			}
+		}
+	} else {
+		for (dgInt32 index = dgAtomicExchangeAndAdd(atomicIndex, 1); index < syncData->m_bodyCount; index = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgAssert(bodyArray[0].m_body->IsRTTIType(dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_accel % ((dgDynamicBody*)bodyArray[0].m_body)->m_accel) == dgFloat32(0.0f));
+			dgAssert(bodyArray[0].m_body->IsRTTIType(dgBody::m_dynamicBodyRTTI) || (((dgDynamicBody*)bodyArray[0].m_body)->m_alpha % ((dgDynamicBody*)bodyArray[0].m_body)->m_alpha) == dgFloat32(0.0f));
+
+			dgBody* const body = bodyArray[index].m_body;
+			if (!body->m_equilibrium) {
+				dgAssert(body->m_invMass.m_w > dgFloat32(0.0f));
+				body->CalcInvInertiaMatrix();
+			}
+
+			bodyState.Gather (index, body);
+			if (body->m_active) {
+				internalForces[index].m_linear = dgVector::m_zero;
+				internalForces[index].m_angular = dgVector::m_zero;
+			}
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::BuildJacobianMatrixParallel (dgParallelSolverSyncData* const syncData) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgInt32 threadCounts = world->GetThreadCount();	
+
+	syncData->m_atomicIndex = 0;
+	for (dgInt32 i = 0; i < threadCounts; i ++) {
+		world->QueueJob (BuildJacobianMatrixParallelKernel, syncData, world);
+	}
+	world->SynchronizationBarrier();
+}
+
+
+void dgWorldDynamicUpdate::BuildJacobianMatrixParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
+	const dgIsland* const island = syncData->m_island;
+	const dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[island->m_rowsStart];
+	dgAssert (syncData->m_jointCount);
+
+	dgContraintDescritor constraintParams;
+	constraintParams.m_world = world;
+	constraintParams.m_threadIndex = threadID;
+	constraintParams.m_timestep = syncData->m_timestep;
+	constraintParams.m_invTimestep = syncData->m_invTimestep;
+
+	dgFloat32 forceOrImpulseScale = (syncData->m_timestep > dgFloat32 (0.0f)) ? dgFloat32 (1.0f) : dgFloat32 (0.0f);
+	for (dgInt32 jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1); jointIndex < syncData->m_jointCount;  jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		dgJointInfo* const jointInfo = &constraintArray[jointIndex];
+		dgConstraint* const constraint = jointInfo->m_joint;
+
+		// the rows of each joint were reserved when the joints were sorted into batches
+		dgInt32 rowBase = jointInfo->m_pairStart;
+#ifdef _DEBUG
+		// the joint rewrites its row count, the rows it generates must fit in the ones reserved for it
+		dgInt32 maxRows = jointInfo->m_pairCount;
+		dgInt32 rowCount = world->GetJacobianDerivatives(constraintParams, jointInfo, constraint, matrixRow, rowBase);
+		dgAssert ((rowCount - rowBase) <= maxRows);
+#else
+		world->GetJacobianDerivatives(constraintParams, jointInfo, constraint, matrixRow, rowBase);
+#endif
+
+		dgAssert (jointInfo->m_m0 >= 0);
+		dgAssert (jointInfo->m_m1 >= 0);
+		dgAssert (jointInfo->m_m0 != jointInfo->m_m1);
+		dgAssert (jointInfo->m_m0 < island->m_bodyCount);
+		dgAssert (jointInfo->m_m1 < island->m_bodyCount);
+		world->BuildJacobianMatrix (bodyState, jointInfo, matrixRow, forceOrImpulseScale);
+	}
+}
+
+
+void dgWorldDynamicUpdate::SolverInitInternalForcesParallel (dgParallelSolverSyncData* const syncData) const
+{
+	DispatchParallelBatches (syncData, SolverInitInternalForcesParallelKernel);
+}
+
+
+void dgWorldDynamicUpdate::SolverInitInternalForcesParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgIsland* const island = syncData->m_island;
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[island->m_bodyStart];
+	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[island->m_rowsStart];
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+
+	// joints in a batch do not share bodies, so they can accumulate their forces without locks
+	const dgInt32 batchEnd = syncData->m_jointBatches[syncData->m_currentBatch + 1];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < batchEnd;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		dgJointInfo* const jointInfo = &constraintArray[i];
+		if (jointInfo->m_joint->m_solverActive) {
+			dgJacobian y0;
+			dgJacobian y1;
+			world->InitJointForce (jointInfo, matrixRow, y0, y1);
+			const dgInt32 m0 = jointInfo->m_m0;
+			const dgInt32 m1 = jointInfo->m_m1;
+			dgAssert (m0 != m1);
+			if (m0) {
+				internalForces[m0].m_linear += y0.m_linear;
+				internalForces[m0].m_angular += y0.m_angular;
+			}
+			if (m1) {
+				internalForces[m1].m_linear += y1.m_linear;
+				internalForces[m1].m_angular += y1.m_angular;
+			}
+		}
+	}
+}
+
+
+
+void dgWorldDynamicUpdate::CalculateJointsAccelParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgIsland* const island = syncData->m_island;
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[island->m_rowsStart];
+
+	dgJointAccelerationDecriptor joindDesc;
+	joindDesc.m_timeStep = syncData->m_timestepRK;
+	joindDesc.m_invTimeStep = syncData->m_invTimestepRK;
+	joindDesc.m_firstPassCoefFlag = syncData->m_firstPassCoef;
+
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex; 
+	if (joindDesc.m_firstPassCoefFlag == dgFloat32 (0.0f)) {
+		for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgJointInfo* const jointInfo = &constraintArray[curJoint];
+			dgConstraint* const constraint = jointInfo->m_joint;
+			if (constraint->m_solverActive) {
+				joindDesc.m_rowsCount = jointInfo->m_pairCount;
+				joindDesc.m_rowMatrix = &matrixRow[jointInfo->m_pairStart];
+				constraint->JointAccelerations(&joindDesc);
+			}
+		}
+	} else {
+		const dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+
+		for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgJointInfo* const jointInfo = &constraintArray[curJoint];
+			dgConstraint* const constraint = jointInfo->m_joint;
+			if (constraint->m_solverActive) {
+				const dgInt32 m0 = jointInfo->m_m0;
+				const dgInt32 m1 = jointInfo->m_m1;
+				if (!(bodyState.m_resting[m0] & bodyState.m_resting[m1])) {
+					joindDesc.m_rowsCount = jointInfo->m_pairCount;
+					joindDesc.m_rowMatrix = &matrixRow[jointInfo->m_pairStart];
+					constraint->JointAccelerations(&joindDesc);
+				}
+			}
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::CalculateJointsVelocParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+
+	const dgIsland* const island = syncData->m_island;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[island->m_bodyStart];
+	dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+
+	dgVector speedFreeze2 (world->m_freezeSpeed2 * dgFloat32 (0.1f));
+	dgVector freezeOmega2 (world->m_freezeOmega2 * dgFloat32 (0.1f));
+	//dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgFloat32 (-1.0f): dgFloat32 (0.0f));
+	dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgVector (-1, -1, -1, -1) : dgFloat32 (0.0f));
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+
+	if (syncData->m_timestepRK != dgFloat32 (0.0f)) {
+		dgVector timestep4 (syncData->m_timestepRK);
+		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgAssert (bodyArray[i].m_body->m_index == i);
+			if (bodyState.m_active[i]) {
+				dgVector force(internalForces[i].m_linear + bodyState.m_externalForce[i]);
+				dgVector torque(internalForces[i].m_angular + bodyState.m_externalTorque[i]);
+
+				dgVector velocStep((force.CompProduct4(bodyState.m_invMass[i])).CompProduct4(timestep4));
+				dgVector omegaStep((bodyState.m_invInertia[i].RotateVector(torque)).CompProduct4(timestep4));
+				if (!bodyState.m_resting[i]) {
+					bodyState.SetVelocity (i, bodyArray[i].m_body, bodyState.m_veloc[i] + velocStep, bodyState.m_omega[i] + omegaStep);
+				} else {
+					dgVector velocStep2(velocStep.DotProduct4(velocStep));
+					dgVector omegaStep2(omegaStep.DotProduct4(omegaStep));
+					dgVector test((velocStep2 > speedFreeze2) | (omegaStep2 > speedFreeze2) | forceActiveMask);
+					if (test.GetSignMask()) {
+						bodyState.ClearResting (i, bodyArray[i].m_body);
+					}
+				}
+			}
+		}
+	} else {
+		for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			if (bodyState.m_active[i]) {
+				const dgVector& linearMomentum = internalForces[i].m_linear;
+				const dgVector& angularMomentum = internalForces[i].m_angular;
+
+				bodyState.SetVelocity (i, bodyArray[i].m_body, bodyState.m_veloc[i] + linearMomentum.CompProduct4(bodyState.m_invMass[i]), bodyState.m_omega[i] + bodyState.m_invInertia[i].RotateVector(angularMomentum));
+			}
+		}
+	}
+}
+
+/*
+void dgWorldDynamicUpdate::CalculateJointsImpulseVelocParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+
+	const dgIsland* const island = syncData->m_island;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[island->m_bodyStart];
+	//dgJacobian* const internalVeloc = &world->m_solverMemory.m_internalVeloc[0];
+
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		dgInt32 index = i + 1;
+		dgAssert (index);
+		dgDynamicBody* const body = (dgDynamicBody*) bodyArray[index].m_body;
+		dgAssert (body->m_index == index);
+
+		const dgVector& linearMomentum = internalForces[index].m_linear;
+		const dgVector& angularMomentum = internalForces[index].m_angular;
+
+		body->m_veloc += linearMomentum.Scale4(body->m_invMass.m_w);
+		body->m_omega += body->m_invWorldInertiaMatrix.RotateVector (angularMomentum);
+
+		//internalVeloc[index].m_linear += body->m_veloc;
+		//internalVeloc[index].m_angular += body->m_omega;
+	}
+}
+*/
+
+void dgWorldDynamicUpdate::UpdateFeedbackForcesParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgIsland* const island = syncData->m_island;
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[island->m_rowsStart];
+
+	dgInt32 hasJointFeeback = 0;
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+	
+	for (dgInt32 curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1); curJoint < syncData->m_jointCount;  curJoint = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		dgJointInfo* const jointInfo = &constraintArray[curJoint];
+		dgConstraint* const constraint = jointInfo->m_joint;
+		if (constraint->m_solverActive) {
+			const dgInt32 first = jointInfo->m_pairStart;
+			const dgInt32 count = jointInfo->m_pairCount;
+
+			for (dgInt32 j = 0; j < count; j++) {
+				dgJacobianMatrixElement* const row = &matrixRow[j + first];
+				dgFloat32 val = row->m_force;
+				dgAssert(dgCheckFloat(val));
+				row->m_jointFeebackForce[0].m_force = val;
+				row->m_jointFeebackForce[0].m_impact = row->m_maxImpact * syncData->m_timestepRK;
+			}
+			hasJointFeeback |= (constraint->m_updaFeedbackCallback ? 1 : 0);
+		}
+	}
+	syncData->m_hasJointFeeback[threadID] = hasJointFeeback;
+}
+
+
+void dgWorldDynamicUpdate::UpdateBodyVelocityParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+
+	const dgIsland* const island = syncData->m_island;
+	dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*) &world->m_bodiesMemory[0]; 
+	dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+
+	const dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+
+	dgFloat32 maxAccNorm2 = DG_SOLVER_MAX_ERROR * DG_SOLVER_MAX_ERROR;
+
+	//dgFloat32 invTimestepSrc = dgFloat32 (1.0f) / syncData->m_timestep;
+	dgFloat32 invTimestepSrc = syncData->m_invTimestep;
+
+	dgVector invTime (invTimestepSrc);
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+	dgVector forceActiveMask ((syncData->m_jointCount <= DG_SMALL_ISLAND_COUNT) ?  dgVector (-1, -1, -1, -1) : dgFloat32 (0.0f));
+	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_bodyCount; i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		if (bodyState.m_active[i]) {
+			dgDynamicBody* const body = (dgDynamicBody*) bodyArray[i].m_body;
+			dgVector accel = (bodyState.m_veloc[i] - bodyState.m_veloc0[i]).CompProduct4(invTime);
+			dgVector alpha = (bodyState.m_omega[i] - bodyState.m_omega0[i]).CompProduct4(invTime);
+			dgVector accelTest((accel.DotProduct4(accel) > maxAccNorm2) | (alpha.DotProduct4(alpha) > maxAccNorm2) | forceActiveMask);
+			//if ((accel % accel) < maxAccNorm2) {
+			//	accel = dgVector::m_zero;
+			//}
+			//if ((alpha % alpha) < maxAccNorm2) {
+			//	alpha = dgVector::m_zero;
+			//}
+			accel = accel & accelTest;
+			alpha = alpha & accelTest;
+
+			if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+				body->m_accel = accel;
+				body->m_alpha = alpha;
+			}
+			body->m_netForce = accel.Scale4(body->m_mass[3]);
+
+			alpha = body->m_matrix.UnrotateVector(alpha);
+			body->m_netTorque = body->m_matrix.RotateVector(alpha.CompProduct4(body->m_mass));
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::KinematicCallbackUpdateParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+	const dgIsland* const island = syncData->m_island;
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+	for (dgInt32 i = dgAtomicExchangeAndAdd(atomicIndex, 1); i < syncData->m_jointCount;  i = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+		dgInt32 curJoint = i;
+		if (constraintArray[curJoint].m_joint->m_updaFeedbackCallback) {
+			constraintArray[curJoint].m_joint->m_updaFeedbackCallback (*constraintArray[curJoint].m_joint, syncData->m_timestep, threadID);
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::IntegrateInslandParallel(dgParallelSolverSyncData* const syncData) const
+{
+	dgWorld* const world = (dgWorld*) this;
+//	dgWorldDynamicUpdate::IntegrateInslandParallelKernel (syncData, world, 0);
+	world->IntegrateArray (syncData->m_island, DG_SOLVER_MAX_ERROR, syncData->m_timestep, 0); 
+}
+
+
+void dgWorldDynamicUpdate::CalculateForcesGameModeParallel (dgParallelSolverSyncData* const syncData) const
+{
+	dgWorld* const world = (dgWorld*) this;
+	const dgInt32 threadCounts = world->GetThreadCount();	
+
+	dgInt32 maxPasses = syncData->m_maxPasses;
+	syncData->m_firstPassCoef = dgFloat32 (0.0f);
+	dgInt32 passesLeft = syncData->m_island->m_solverIterations;
+	dgFloat32 residual = dgFloat32 (0.0f);
+	for (dgInt32 step = 0; step < maxPasses; step ++) {
+
+		syncData->m_atomicIndex = 0;
+		for (dgInt32 i = 0; i < threadCounts; i ++) {
+			world->QueueJob (CalculateJointsAccelParallelKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+		syncData->m_firstPassCoef = dgFloat32 (1.0f);
+
+		dgInt32 passes = 0;
+		const dgInt32 maxIterations = GetSolverPassCount (syncData->m_island, passesLeft, maxPasses - step);
+		dgFloat32 accNorm = DG_SOLVER_MAX_ERROR * dgFloat32 (2.0f);
+		for (; (passes < maxIterations) && (accNorm > DG_SOLVER_MAX_ERROR); passes ++) {
+			for (dgInt32 i = 0; i < threadCounts; i ++) {
+				syncData->m_accelNorm[i] = dgVector (dgFloat32 (0.0f));
+			}
+			DispatchParallelBatches (syncData, CalculateJointsForceParallelKernel);
+
+			accNorm = dgFloat32 (0.0f);
+			for (dgInt32 i = 0; i < threadCounts; i ++) {
+				accNorm = dgMax (accNorm, syncData->m_accelNorm[i].m_x);
+			}
+		}
+		passesLeft -= passes;
+		residual = dgMax (residual, accNorm);
+
+		syncData->m_atomicIndex = 1;
+		for (dgInt32 j = 0; j < threadCounts; j ++) {
+			world->QueueJob (CalculateJointsVelocParallelKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+	}
+	SaveSolverStats (syncData->m_island, syncData->m_island->m_solverIterations - passesLeft, residual);
+
+	if (syncData->m_timestepRK != dgFloat32 (0.0f)) {
+		syncData->m_atomicIndex = 0;
+		for (dgInt32 j = 0; j < threadCounts; j ++) {
+			world->QueueJob (UpdateFeedbackForcesParallelKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+
+		dgInt32 hasJointFeeback = 0;
+		for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+			hasJointFeeback |= syncData->m_hasJointFeeback[i];
+		}
+
+		syncData->m_atomicIndex = 1;
+		for (dgInt32 j = 0; j < threadCounts; j++) {
+			world->QueueJob(UpdateBodyVelocityParallelKernel, syncData, world);
+		}
+		world->SynchronizationBarrier();
+
+		if (hasJointFeeback) {
+			syncData->m_atomicIndex = 0;
+			for (dgInt32 j = 0; j < threadCounts; j++) {
+				world->QueueJob(KinematicCallbackUpdateParallelKernel, syncData, world);
+			}
+			world->SynchronizationBarrier();
+		}
+
+	} else {
+		const dgInt32 count = syncData->m_bodyCount;
+		const dgIsland* const island = syncData->m_island;
+		dgBodyInfo* const bodyArrayPtr = (dgBodyInfo*)&world->m_bodiesMemory[0];
+		dgBodyInfo* const bodyArray = &bodyArrayPtr[island->m_bodyStart];
+		for (dgInt32 i = 1; i < count; i++) {
+			dgBody* const body = bodyArray[i].m_body;
+			if (body->m_active) {
+				body->m_netForce = dgVector::m_zero;
+				body->m_netTorque = dgVector::m_zero;
+			}
+		}
+	}
+}
+
+
+void dgWorldDynamicUpdate::CalculateJointsForceParallelKernel (void* const context, void* const worldContext, dgInt32 threadID)
+{
+	dgParallelSolverSyncData* const syncData = (dgParallelSolverSyncData*) context;
+	dgWorld* const world = (dgWorld*) worldContext;
+
+	const dgIsland* const island = syncData->m_island;
+	dgJacobianMatrixElement* const matrixRow = &world->m_solverMemory.m_memory[island->m_rowsStart];
+	const dgBodyStateArray bodyState (world->m_solverMemory.m_bodyState.GetIslandState (island));
+	dgJointInfo* const constraintArrayPtr = (dgJointInfo*) &world->m_jointsMemory[0];
+	dgJointInfo* const constraintArray = &constraintArrayPtr[island->m_jointStart];
+	dgJacobian* const internalForces = &world->m_solverMemory.m_internalForces[island->m_bodyStart];
+
+	dgInt32* const atomicIndex = &syncData->m_atomicIndex;
+	dgVector accNorm (syncData->m_accelNorm[threadID]);
+
+	const dgInt32 batchEnd = syncData->m_jointBatches[syncData->m_currentBatch + 1];
+	if (syncData->m_hasSerialBatch && (syncData->m_currentBatch == (syncData->m_batchesCount - 1))) {
+		for (dgInt32 jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1); jointIndex < batchEnd;  jointIndex = dgAtomicExchangeAndAdd(atomicIndex, 1)) {
+			dgJointInfo* const jointInfo = &constraintArray[jointIndex];
+			world->CalculateJointForce (jointInfo, bodyState, internalForces, matrixRow, accNorm);
+		}
+	} else {
+		// joints of a colored batch do not share dynamic bodies, take them in blocks and solve each block in simd lanes
+		for (dgInt32 jointIndex = dgAtomicExchangeAndAdd(atomicIndex, DG_SOLVER_BLOCK_LANES); jointIndex < batchEnd;  jointIndex = dgAtomicExchangeAndAdd(atomicIndex, DG_SOLVER_BLOCK_LANES)) {
+			const dgInt32 count = dgMin (batchEnd - jointIndex, DG_SOLVER_BLOCK_LANES);
+			if (count > 1) {
+				world->CalculateJointForceBlock (&constraintArray[jointIndex], count, bodyState, internalForces, matrixRow, accNorm);
+			} else {
+				world->CalculateJointForce (&constraintArray[jointIndex], bodyState, internalForces, matrixRow, accNorm);
+			}
+		}
+	}
+
+	syncData->m_accelNorm[threadID] = accNorm;
+}
+
+
+// same pass as CalculateJointForce for a block of up to DG_SOLVER_BLOCK_LANES joints of one colored batch.
+// Row k of each joint goes to one lane of a dgVector, so the Gauss-Seidel chains of the joints run side by side 
+// instead of waiting on each other. The joints do not share dynamic bodies, so each lane sees the same values 
+// the scalar pass would see and the forces only differ from it by rounding.
+// Lanes of joints with fewer rows read a zero row, which leaves the forces of the lane unchanged.
+void dgWorldDynamicUpdate::CalculateJointForceBlock (dgJointInfo* const jointInfoArray, dgInt32 jointCount, const dgBodyStateArray& bodyState, dgJacobian* const internalForces, dgJacobianMatrixElement* const matrixRow, dgVector& norm) const
+{
+	dgAssert (jointCount <= DG_SOLVER_BLOCK_LANES);
+
+	dgInt32 m0[DG_SOLVER_BLOCK_LANES];
+	dgInt32 m1[DG_SOLVER_BLOCK_LANES];
+	dgInt32 rowStart[DG_SOLVER_BLOCK_LANES];
+	dgInt32 rowCount[DG_SOLVER_BLOCK_LANES];
+	dgFloat32 cacheForce[DG_SOLVER_BLOCK_LANES][DG_CONSTRAINT_MAX_ROWS + 4];
+
+	dgInt32 maxRows = 0;
+	for (dgInt32 i = 0; i < DG_SOLVER_BLOCK_LANES; i ++) {
+		m0[i] = 0;
+		m1[i] = 0;
+		rowStart[i] = 0;
+		rowCount[i] = 0;
+		cacheForce[i][0] = dgFloat32(1.0f);
+		cacheForce[i][1] = dgFloat32(1.0f);
+		cacheForce[i][2] = dgFloat32(1.0f);
+		cacheForce[i][3] = dgFloat32(1.0f);
+		if (i < jointCount) {
+			const dgJointInfo* const jointInfo = &jointInfoArray[i];
+			if (jointInfo->m_joint->m_solverActive) {
+				const dgInt32 index0 = jointInfo->m_m0;
+				const dgInt32 index1 = jointInfo->m_m1;
+				if (!(bodyState.m_resting[index0] & bodyState.m_resting[index1])) {
+					m0[i] = index0;
+					m1[i] = index1;
+					rowStart[i] = jointInfo->m_pairStart;
+					rowCount[i] = jointInfo->m_pairCount;
+					maxRows = dgMax (maxRows, rowCount[i]);
+				}
+			}
+		}
+	}
+
+	if (!maxRows) {
+		return;
+	}
+
+	// lanes with fewer rows than the block read this row, it contributes no force to its bodies
+	dgJacobianMatrixElement zeroRow;
+	zeroRow.m_Jt.m_jacobianM0.m_linear = dgVector::m_zero;
+	zeroRow.m_Jt.m_jacobianM0.m_angular = dgVector::m_zero;
+	zeroRow.m_Jt.m_jacobianM1.m_linear = dgVector::m_zero;
+	zeroRow.m_Jt.m_jacobianM1.m_angular = dgVector::m_zero;
+	zeroRow.m_force = dgFloat32 (0.0f);
+	zeroRow.m_accel = dgFloat32 (0.0f);
+	zeroRow.m_deltaAccel = dgFloat32 (0.0f);
+	zeroRow.m_deltaForce = dgFloat32 (0.0f);
+	zeroRow.m_diagDamp = dgFloat32 (0.0f);
+	zeroRow.m_invDJMinvJt = dgFloat32 (0.0f);
+	zeroRow.m_restitution = dgFloat32 (0.0f);
+	zeroRow.m_penetration = dgFloat32 (0.0f);
+	zeroRow.m_coordenateAccel = dgFloat32 (0.0f);
+	zeroRow.m_penetrationStiffness = dgFloat32 (0.0f);
+	zeroRow.m_lowerBoundFrictionCoefficent = dgFloat32 (0.0f);
+	zeroRow.m_upperBoundFrictionCoefficent = dgFloat32 (0.0f);
+	zeroRow.m_maxImpact = dgFloat32 (0.0f);
+	zeroRow.m_jointFeebackForce = NULL;
+	zeroRow.m_normalForceIndex = -1;
+	zeroRow.m_accelIsMotor = false;
+
+	// body quantities of the block, each vector holds one component of the four lanes
+	dgVector linearM0x;
+	dgVector linearM0y;
+	dgVector linearM0z;
+	dgVector linearM0w;
+	dgVector angularM0x;
+	dgVector angularM0y;
+	dgVector angularM0z;
+	dgVector angularM0w;
+	dgVector linearM1x;
+	dgVector linearM1y;
+	dgVector linearM1z;
+	dgVector linearM1w;
+	dgVector angularM1x;
+	dgVector angularM1y;
+	dgVector angularM1z;
+	dgVector angularM1w;
+	dgVector::Transpose4x4 (linearM0x, linearM0y, linearM0z, linearM0w, internalForces[m0[0]].m_linear, internalForces[m0[1]].m_linear, internalForces[m0[2]].m_linear, internalForces[m0[3]].m_linear);
+	dgVector::Transpose4x4 (angularM0x, angularM0y, angularM0z, angularM0w, internalForces[m0[0]].m_angular, internalForces[m0[1]].m_angular, internalForces[m0[2]].m_angular, internalForces[m0[3]].m_angular);
+	dgVector::Transpose4x4 (linearM1x, linearM1y, linearM1z, linearM1w, internalForces[m1[0]].m_linear, internalForces[m1[1]].m_linear, internalForces[m1[2]].m_linear, internalForces[m1[3]].m_linear);
+	dgVector::Transpose4x4 (angularM1x, angularM1y, angularM1z, angularM1w, internalForces[m1[0]].m_angular, internalForces[m1[1]].m_angular, internalForces[m1[2]].m_angular, internalForces[m1[3]].m_angular);
+
+	const dgVector invMass0 (bodyState.m_invMass[m0[0]].m_x, bodyState.m_invMass[m0[1]].m_x, bodyState.m_invMass[m0[2]].m_x, bodyState.m_invMass[m0[3]].m_x);
+	const dgVector invMass1 (bodyState.m_invMass[m1[0]].m_x, bodyState.m_invMass[m1[1]].m_x, bodyState.m_invMass[m1[2]].m_x, bodyState.m_invMass[m1[3]].m_x);
+
+	// invInertia[j * 4 + c] is component c of the inertia matrix row j for the four lanes
+	dgVector invInertia0[12];
+	dgVector invInertia1[12];
+	for (dgInt32 j = 0; j < 3; j ++) {
+		dgVector::Transpose4x4 (invInertia0[j * 4 + 0], invInertia0[j * 4 + 1], invInertia0[j * 4 + 2], invInertia0[j * 4 + 3], bodyState.m_invInertia[m0[0]][j], bodyState.m_invInertia[m0[1]][j], bodyState.m_invInertia[m0[2]][j], bodyState.m_invInertia[m0[3]][j]);
+		dgVector::Transpose4x4 (invInertia1[j * 4 + 0], invInertia1[j * 4 + 1], invInertia1[j * 4 + 2], invInertia1[j * 4 + 3], bodyState.m_invInertia[m1[0]][j], bodyState.m_invInertia[m1[1]][j], bodyState.m_invInertia[m1[2]][j], bodyState.m_invInertia[m1[3]][j]);
+	}
+
+	dgVector accNorm (dgVector::m_zero);
+	for (dgInt32 k = 0; k < maxRows; k ++) {
+		dgJacobianMatrixElement* const row0 = (k < rowCount[0]) ? &matrixRow[rowStart[0] + k] : &zeroRow;
+		dgJacobianMatrixElement* const row1 = (k < rowCount[1]) ? &matrixRow[rowStart[1] + k] : &zeroRow;
+		dgJacobianMatrixElement* const row2 = (k < rowCount[2]) ? &matrixRow[rowStart[2] + k] : &zeroRow;
+		dgJacobianMatrixElement* const row3 = (k < rowCount[3]) ? &matrixRow[rowStart[3] + k] : &zeroRow;
+
+		dgVector jacobianLinearM0x;
+		dgVector jacobianLinearM0y;
+		dgVector jacobianLinearM0z;
+		dgVector jacobianAngularM0x;
+		dgVector jacobianAngularM0y;
+		dgVector jacobianAngularM0z;
+		dgVector jacobianLinearM1x;
+		dgVector jacobianLinearM1y;
+		dgVector jacobianLinearM1z;
+		dgVector jacobianAngularM1x;
+		dgVector jacobianAngularM1y;
+		dgVector jacobianAngularM1z;
+		dgVector unused;
+		dgVector::Transpose4x4 (jacobianLinearM0x, jacobianLinearM0y, jacobianLinearM0z, unused, row0->m_Jt.m_jacobianM0.m_linear, row1->m_Jt.m_jacobianM0.m_linear, row2->m_Jt.m_jacobianM0.m_linear, row3->m_Jt.m_jacobianM0.m_linear);
+		dgVector::Transpose4x4 (jacobianAngularM0x, jacobianAngularM0y, jacobianAngularM0z, unused, row0->m_Jt.m_jacobianM0.m_angular, row1->m_Jt.m_jacobianM0.m_angular, row2->m_Jt.m_jacobianM0.m_angular, row3->m_Jt.m_jacobianM0.m_angular);
+		dgVector::Transpose4x4 (jacobianLinearM1x, jacobianLinearM1y, jacobianLinearM1z, unused, row0->m_Jt.m_jacobianM1.m_linear, row1->m_Jt.m_jacobianM1.m_linear, row2->m_Jt.m_jacobianM1.m_linear, row3->m_Jt.m_jacobianM1.m_linear);
+		dgVector::Transpose4x4 (jacobianAngularM1x, jacobianAngularM1y, jacobianAngularM1z, unused, row0->m_Jt.m_jacobianM1.m_angular, row1->m_Jt.m_jacobianM1.m_angular, row2->m_Jt.m_jacobianM1.m_angular, row3->m_Jt.m_jacobianM1.m_angular);
+
+		dgVector JMinvJacobianAngularM0 (invInertia0[0].CompProduct4(jacobianAngularM0x) + invInertia0[4].CompProduct4(jacobianAngularM0y) + invInertia0[8].CompProduct4(jacobianAngularM0z));
+		dgVector JMinvJacobianAngularM1 (invInertia1[0].CompProduct4(jacobianAngularM1x) + invInertia1[4].CompProduct4(jacobianAngularM1y) + invInertia1[8].CompProduct4(jacobianAngularM1z));
+		dgVector ax (jacobianLinearM0x.CompProduct4(invMass0).CompProduct4(linearM0x) + JMinvJacobianAngularM0.CompProduct4(angularM0x) + jacobianLinearM1x.CompProduct4(invMass1).CompProduct4(linearM1x) + JMinvJacobianAngularM1.CompProduct4(angularM1x));
+
+		JMinvJacobianAngularM0 = invInertia0[1].CompProduct4(jacobianAngularM0x) + invInertia0[5].CompProduct4(jacobianAngularM0y) + invInertia0[9].CompProduct4(jacobianAngularM0z);
+		JMinvJacobianAngularM1 = invInertia1[1].CompProduct4(jacobianAngularM1x) + invInertia1[5].CompProduct4(jacobianAngularM1y) + invInertia1[9].CompProduct4(jacobianAngularM1z);
+		dgVector ay (jacobianLinearM0y.CompProduct4(invMass0).CompProduct4(linearM0y) + JMinvJacobianAngularM0.CompProduct4(angularM0y) + jacobianLinearM1y.CompProduct4(invMass1).CompProduct4(linearM1y) + JMinvJacobianAngularM1.CompProduct4(angularM1y));
+
+		JMinvJacobianAngularM0 = invInertia0[2].CompProduct4(jacobianAngularM0x) + invInertia0[6].CompProduct4(jacobianAngularM0y) + invInertia0[10].CompProduct4(jacobianAngularM0z);
+		JMinvJacobianAngularM1 = invInertia1[2].CompProduct4(jacobianAngularM1x) + invInertia1[6].CompProduct4(jacobianAngularM1y) + invInertia1[10].CompProduct4(jacobianAngularM1z);
+		dgVector az (jacobianLinearM0z.CompProduct4(invMass0).CompProduct4(linearM0z) + JMinvJacobianAngularM0.CompProduct4(angularM0z) + jacobianLinearM1z.CompProduct4(invMass1).CompProduct4(linearM1z) + JMinvJacobianAngularM1.CompProduct4(angularM1z));
+
+		const dgVector force (row0->m_force, row1->m_force, row2->m_force, row3->m_force);
+		const dgVector diagDamp (row0->m_diagDamp, row1->m_diagDamp, row2->m_diagDamp, row3->m_diagDamp);
+		const dgVector coordenateAccel (row0->m_coordenateAccel, row1->m_coordenateAccel, row2->m_coordenateAccel, row3->m_coordenateAccel);
+		const dgVector invDJMinvJt (row0->m_invDJMinvJt, row1->m_invDJMinvJt, row2->m_invDJMinvJt, row3->m_invDJMinvJt);
+
+		dgVector a (coordenateAccel - force.CompProduct4(diagDamp) - (ax + ay + az));
+		dgVector f (force + invDJMinvJt.CompProduct4(a));
+
+		// friction rows read the normal force of an earlier row of the same joint, the negative indices read one
+		dgAssert ((row0->m_normalForceIndex >= 0) || (cacheForce[0][row0->m_normalForceIndex + 4] == dgFloat32(1.0f)));
+		dgAssert ((row1->m_normalForceIndex >= 0) || (cacheForce[1][row1->m_normalForceIndex + 4] == dgFloat32(1.0f)));
+		dgAssert ((row2->m_normalForceIndex >= 0) || (cacheForce[2][row2->m_normalForceIndex + 4] == dgFloat32(1.0f)));
+		dgAssert ((row3->m_normalForceIndex >= 0) || (cacheForce[3][row3->m_normalForceIndex + 4] == dgFloat32(1.0f)));
+		const dgVector frictionNormal (cacheForce[0][row0->m_normalForceIndex + 4], cacheForce[1][row1->m_normalForceIndex + 4], cacheForce[2][row2->m_normalForceIndex + 4], cacheForce[3][row3->m_normalForceIndex + 4]);
+		const dgVector lowerFrictionForce (frictionNormal.CompProduct4(dgVector (row0->m_lowerBoundFrictionCoefficent, row1->m_lowerBoundFrictionCoefficent, row2->m_lowerBoundFrictionCoefficent, row3->m_lowerBoundFrictionCoefficent)));
+		const dgVector upperFrictionForce (frictionNormal.CompProduct4(dgVector (row0->m_upperBoundFrictionCoefficent, row1->m_upperBoundFrictionCoefficent, row2->m_upperBoundFrictionCoefficent, row3->m_upperBoundFrictionCoefficent)));
+
+		a = a.AndNot((f > upperFrictionForce) | (f < lowerFrictionForce));
+		f = f.GetMax(lowerFrictionForce).GetMin(upperFrictionForce);
+		accNorm = accNorm.GetMax(a.Abs());
+
+		const dgVector maxImpact (f.Abs().GetMax(dgVector (row0->m_maxImpact, row1->m_maxImpact, row2->m_maxImpact, row3->m_maxImpact)));
+		row0->m_force = f.m_x;
+		row1->m_force = f.m_y;
+		row2->m_force = f.m_z;
+		row3->m_force = f.m_w;
+		row0->m_maxImpact = maxImpact.m_x;
+		row1->m_maxImpact = maxImpact.m_y;
+		row2->m_maxImpact = maxImpact.m_z;
+		row3->m_maxImpact = maxImpact.m_w;
+		cacheForce[0][k + 4] = f.m_x;
+		cacheForce[1][k + 4] = f.m_y;
+		cacheForce[2][k + 4] = f.m_z;
+		cacheForce[3][k + 4] = f.m_w;
+
+		const dgVector prevValue (f - force);
+		linearM0x += jacobianLinearM0x.CompProduct4(prevValue);
+		linearM0y += jacobianLinearM0y.CompProduct4(prevValue);
+		linearM0z += jacobianLinearM0z.CompProduct4(prevValue);
+		angularM0x += jacobianAngularM0x.CompProduct4(prevValue);
+		angularM0y += jacobianAngularM0y.CompProduct4(prevValue);
+		angularM0z += jacobianAngularM0z.CompProduct4(prevValue);
+		linearM1x += jacobianLinearM1x.CompProduct4(prevValue);
+		linearM1y += jacobianLinearM1y.CompProduct4(prevValue);
+		linearM1z += jacobianLinearM1z.CompProduct4(prevValue);
+		angularM1x += jacobianAngularM1x.CompProduct4(prevValue);
+		angularM1y += jacobianAngularM1y.CompProduct4(prevValue);
+		angularM1z += jacobianAngularM1z.CompProduct4(prevValue);
+	}
+
+	dgVector linear0[4];
+	dgVector angular0[4];
+	dgVector linear1[4];
+	dgVector angular1[4];
+	dgVector::Transpose4x4 (linear0[0], linear0[1], linear0[2], linear0[3], linearM0x, linearM0y, linearM0z, linearM0w);
+	dgVector::Transpose4x4 (angular0[0], angular0[1], angular0[2], angular0[3], angularM0x, angularM0y, angularM0z, angularM0w);
+	dgVector::Transpose4x4 (linear1[0], linear1[1], linear1[2], linear1[3], linearM1x, linearM1y, linearM1z, linearM1w);
+	dgVector::Transpose4x4 (angular1[0], angular1[1], angular1[2], angular1[3], angularM1x, angularM1y, angularM1z, angularM1w);
+
+	// the sentinel body is shared by the whole batch, it is never written
+	for (dgInt32 i = 0; i < DG_SOLVER_BLOCK_LANES; i ++) {
+		if (rowCount[i]) {
+			if (m0[i]) {
+				internalForces[m0[i]].m_linear = linear0[i];
+				internalForces[m0[i]].m_angular = angular0[i];
+			}
+			if (m1[i]) {
+				internalForces[m1[i]].m_linear = linear1[i];
+				internalForces[m1[i]].m_angular = angular1[i];
+			}
+		}
+	}
+
+	const dgFloat32 blockNorm = dgMax (dgMax (accNorm[0], accNorm[1]), dgMax (accNorm[2], accNorm[3]));
+	norm = norm.GetMax(dgVector (blockNorm));
+}
@@ -1,22 +1,22 @@
-/* Copyright (c) <2009> <Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely
-*/
-
-
-// CustomControllerManager.h: interface for the CustomControllerManager class.
-//
-//////////////////////////////////////////////////////////////////////
-
-
-#include <CustomJointLibraryStdAfx.h>
-#include <CustomJoint.h>
-#include <CustomControllerManager.h>
-
-
+/* Copyright (c) <2009> <Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely
+*/
+
+
+// CustomControllerManager.h: interface for the CustomControllerManager class.
+//
+//////////////////////////////////////////////////////////////////////
+
+
+#include <CustomJointLibraryStdAfx.h>
+#include <CustomJoint.h>
+#include <CustomControllerManager.h>
+
+
@@ -1,21 +1,21 @@
-/* Copyright (c) <2009> <Newton Game Dynamics>
-* 
-* This software is provided 'as-is', without any express or implied
-* warranty. In no event will the authors be held liable for any damages
-* arising from the use of this software.
-* 
-* Permission is granted to anyone to use this software for any purpose,
-* including commercial applications, and to alter it and redistribute it
-* freely
-*/
-
-// stdafx.cpp : source file that includes just the standard includes
-// JointLibrary.pch will be the pre-compiled header
-// stdafx.obj will contain the pre-compiled type information
-
-
-#include "CustomJointLibraryStdAfx.h"
-
-// TODO: reference any additional headers you need in STDAFX.H
-// and not in this file
-
+/* Copyright (c) <2009> <Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely
+*/
+
+// stdafx.cpp : source file that includes just the standard includes
+// JointLibrary.pch will be the pre-compiled header
+// stdafx.obj will contain the pre-compiled type information
+
+
+#include "CustomJointLibraryStdAfx.h"
+
+// TODO: reference any additional headers you need in STDAFX.H
+// and not in this file
+